@@ -59,13 +59,19 @@ export const COVERAGE_DATA: CoverageCategory[] = [
             },
             {
                 name: 'DiffieHellman',
-                status: 'implemented',
-                note: 'Use crypto.generateKeys or crypto.diffieHellman instead'
+                status: 'implemented'
             },
             {
                 name: 'ECDH',
-                status: 'implemented',
-                note: 'Use simple ECDH methods instead'
+                subItems: [
+                    { name: 'computeSecret', status: 'implemented' },
+                    { name: 'convertKey', status: 'implemented' },
+                    { name: 'generateKeys', status: 'implemented' },
+                    { name: 'getPrivateKey', status: 'implemented' },
+                    { name: 'getPublicKey', status: 'implemented' },
+                    { name: 'setPrivateKey', status: 'implemented' },
+                    { name: 'setPublicKey', status: 'implemented' }
+                ]
             },
             {
                 name: 'Hash',
@@ -123,9 +129,9 @@ export const COVERAGE_DATA: CoverageCategory[] = [
             { name: 'constants', status: 'implemented' },
             { name: 'createCipheriv', status: 'implemented' },
             { name: 'createDecipheriv', status: 'implemented' },
-            { name: 'createDiffieHellman', status: 'missing' },
-            { name: 'createDiffieHellmanGroup', status: 'missing' },
-            { name: 'createECDH', status: 'missing' },
+            { name: 'createDiffieHellman', status: 'implemented' },
+            { name: 'createDiffieHellmanGroup', status: 'implemented' },
+            { name: 'createECDH', status: 'implemented' },
             { name: 'createHash', status: 'implemented' },
             { name: 'createHmac', status: 'implemented' },
             { name: 'createPrivateKey', status: 'implemented' },
@@ -191,7 +197,7 @@ export const COVERAGE_DATA: CoverageCategory[] = [
             { name: 'getCipherInfo', status: 'missing' },
             { name: 'getCiphers', status: 'implemented' },
             { name: 'getCurves', status: 'missing' },
-            { name: 'getDiffieHellman', status: 'missing' },
+            { name: 'getDiffieHellman', status: 'implemented' },
             { name: 'getFips', status: 'missing' },
             { name: 'getHashes', status: 'implemented' },
             { name: 'getRandomValues', status: 'implemented' },
@@ -0,0 +1,62 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import rnqc from 'react-native-quick-crypto';
+import type { CompressCipherAlgorithm } from 'react-native-quick-crypto';
+import { deflate } from 'pako';
+import type { BenchFn } from '../../types/benchmarks';
+import { Bench } from 'tinybench';
+
+const key = rnqc.randomBytes(32);
+const iv = rnqc.randomBytes(12);
+
+// JSON is what we compress before encrypting in practice; make it ~1MB
+const json = Buffer.from(
+  JSON.stringify(
+    Array.from({ length: 16000 }, (_, i) => ({
+      id: i,
+      name: `user-${i % 100}`,
+      email: `user-${i % 100}@example.com`,
+      active: i % 3 === 0,
+    })),
+  ),
+);
+
+const compressEncrypt = (
+  name: string,
+  algorithm: CompressCipherAlgorithm,
+): BenchFn => {
+  return () => {
+    const bench = new Bench({
+      name,
+      iterations: 1,
+      warmupIterations: 0,
+    });
+
+    bench
+      .add('rnqc', () => {
+        rnqc.compressAndEncrypt(algorithm, key, iv, json);
+      })
+      .add('rnqc streaming', () => {
+        const cipher = rnqc.createCompressCipheriv(algorithm, key, iv);
+        cipher.update(json);
+        cipher.final();
+        cipher.getAuthTag();
+      })
+      .add('pako + rnqc cipher', () => {
+        const compressed = deflate(json);
+        const cipher = rnqc.createCipheriv(algorithm, key, iv);
+        cipher.update(compressed);
+        cipher.final();
+        cipher.getAuthTag();
+      });
+
+    return bench;
+  };
+};
+
+export default [
+  compressEncrypt('compress+encrypt aes256gcm 1MB JSON', 'aes-256-gcm'),
+  compressEncrypt(
+    'compress+encrypt chacha20-poly1305 1MB JSON',
+    'chacha20-poly1305',
+  ),
+];
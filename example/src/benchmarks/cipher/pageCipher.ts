@@ -0,0 +1,60 @@
+import rnqc from 'react-native-quick-crypto';
+import type { PageCipherAlgorithm } from 'react-native-quick-crypto';
+import type { BenchFn } from '../../types/benchmarks';
+import { Bench } from 'tinybench';
+
+const PAGE_SIZE = 4096;
+const PAGE_COUNT = 256; // 1MB of pages
+
+const pageNumbers = Array.from({ length: PAGE_COUNT }, (_, i) => i);
+const writeCounters = pageNumbers.map(() => 1);
+
+const pageCipher = (
+  name: string,
+  algorithm: PageCipherAlgorithm,
+  keyLen: number,
+): BenchFn => {
+  return () => {
+    const key = rnqc.randomBytes(keyLen);
+    const pc = rnqc.createPageCipher(algorithm, key, { pageSize: PAGE_SIZE });
+    const pages = rnqc.randomBytes(PAGE_SIZE * PAGE_COUNT);
+    const payload = PAGE_SIZE - pc.reserveSize;
+
+    const bench = new Bench({
+      name,
+      iterations: 1,
+      warmupIterations: 0,
+    });
+
+    bench
+      .add('rnqc', () => {
+        pc.encryptPages(pages, pageNumbers, writeCounters);
+      })
+      .add('rnqc parallel x4', async () => {
+        await pc.encryptPagesAsync(pages, pageNumbers, writeCounters, {
+          parallelism: 4,
+        });
+      })
+      .add('rnqc createCipheriv per page', () => {
+        for (let i = 0; i < PAGE_COUNT; i++) {
+          const iv = rnqc.randomBytes(algorithm.endsWith('xts') ? 16 : 12);
+          const cipher = rnqc.createCipheriv(algorithm, key, iv);
+          const start = i * PAGE_SIZE;
+          cipher.update(pages.subarray(start, start + payload));
+          cipher.final();
+        }
+      });
+
+    return bench;
+  };
+};
+
+export default [
+  pageCipher('page cipher aes256gcm 256x4KB', 'aes-256-gcm', 32),
+  pageCipher(
+    'page cipher chacha20-poly1305 256x4KB',
+    'chacha20-poly1305',
+    32,
+  ),
+  pageCipher('page cipher aes256xts 256x4KB', 'aes-256-xts', 64),
+];
@@ -0,0 +1,170 @@
+import rnqc from 'react-native-quick-crypto';
+import { Bench } from 'tinybench';
+import type { TaskResult } from 'tinybench';
+import { BenchmarkSuite } from '../benchmarks';
+import { statistics } from '../utils';
+
+// How async APIs scale when an app fires N promises at once, N = 1...64.
+// Each case submits N operations together, waits for all of them, and repeats
+// until OPERATIONS have run:
+//   rnqc        - per-operation latency (submit to resolve) and aggregate
+//                 throughput (completed operations / wall time)
+//   queue wait  - time each job sat in the native worker queue before a
+//                 thread picked it up
+// Queue wait growing with N means oversubscription; throughput flattening
+// while queue wait stays low means contention inside the jobs.
+
+type AsyncOperation = {
+  name: string;
+  queue: string; // key reported by takeQueueWaits()
+  setup: () => Promise<() => Promise<unknown>>;
+};
+
+type ConcurrencyCase = {
+  operation: AsyncOperation;
+  concurrency: number;
+};
+
+const OPERATIONS = 256;
+const levels = [1, 2, 4, 8, 16, 32, 64];
+
+// Node-style callback API as a promise-returning operation
+const callback =
+  (run: (cb: (err: Error | null) => void) => void) => (): Promise<void> =>
+    new Promise((resolve, reject) =>
+      run(err => (err ? reject(err) : resolve())),
+    );
+
+const operations: AsyncOperation[] = [
+  {
+    name: 'pbkdf2 sha256 1000x',
+    queue: 'pbkdf2',
+    setup: async () =>
+      callback(cb => rnqc.pbkdf2('password', 'salt', 1000, 32, 'sha256', cb)),
+  },
+  {
+    name: 'scrypt N=1024 r=8',
+    queue: 'scrypt',
+    setup: async () =>
+      callback(cb =>
+        rnqc.scrypt(
+          'password',
+          'salt',
+          32,
+          { N: 1024, r: 8, p: 1, maxmem: 32 * 1024 * 1024 },
+          cb,
+        ),
+      ),
+  },
+  {
+    name: 'randomFill 4KB',
+    queue: 'randomFill',
+    setup: async () =>
+      callback(cb => rnqc.randomFill(new Uint8Array(4096), cb)),
+  },
+  {
+    // One key pair for all calls, as WebCrypto and diffieHellman share one
+    name: 'ed25519 sign',
+    queue: 'ed.sign',
+    setup: async () => {
+      const ed = new rnqc.Ed('ed25519', {});
+      await ed.generateKeyPair();
+      const message = new Uint8Array(64).buffer;
+      return () => ed.sign(message);
+    },
+  },
+  {
+    name: 'ed25519 verify',
+    queue: 'ed.verify',
+    setup: async () => {
+      const ed = new rnqc.Ed('ed25519', {});
+      await ed.generateKeyPair();
+      const message = new Uint8Array(64).buffer;
+      const signature = await ed.sign(message);
+      return () => ed.verify(signature, message);
+    },
+  },
+];
+
+const caseName = ({ operation, concurrency }: ConcurrencyCase): string =>
+  `${operation.name} x${concurrency}`;
+
+// Shaped like a tinybench result so the existing result views render it
+const taskResult = (latency: number[], opsPerSecond: number): TaskResult => {
+  const stats = statistics(latency);
+  return {
+    latency: stats,
+    throughput: statistics([opsPerSecond]),
+    period: stats.mean,
+    totalTime: latency.reduce((acc, v) => acc + v, 0),
+    runtime: 'unknown',
+    runtimeVersion: 'native',
+  } as unknown as TaskResult;
+};
+
+const runCase = async (
+  run: () => Promise<unknown>,
+  { operation, concurrency }: ConcurrencyCase,
+) => {
+  const batches = Math.max(1, Math.floor(OPERATIONS / concurrency));
+  const latency: number[] = [];
+
+  rnqc.takeQueueWaits();
+  const start = performance.now();
+  for (let batch = 0; batch < batches; batch++) {
+    await Promise.all(
+      Array.from({ length: concurrency }, async () => {
+        const submitted = performance.now();
+        await run();
+        latency.push(performance.now() - submitted);
+      }),
+    );
+  }
+  const seconds = (performance.now() - start) / 1000;
+  const waits = rnqc.takeQueueWaits()[operation.queue] ?? [];
+
+  return {
+    us: taskResult(latency, latency.length / seconds),
+    queue: taskResult(waits.length > 0 ? waits : [0], NaN),
+  };
+};
+
+const cases: ConcurrencyCase[] = operations.flatMap(operation =>
+  levels.map(concurrency => ({ operation, concurrency })),
+);
+
+export class ConcurrencySuite extends BenchmarkSuite {
+  constructor() {
+    // run() drives the cases itself; the Bench list only names them
+    super(
+      'concurrency',
+      cases.map(c => () => new Bench({ name: caseName(c) })),
+      { 'queue wait': 'time each job waited for a native worker thread' },
+    );
+  }
+
+  async run() {
+    this.results = [];
+    rnqc.setQueueWaitTracking(true);
+    try {
+      for (const operation of operations) {
+        const run = await operation.setup();
+        await run(); // warm-up
+        for (const c of cases.filter(x => x.operation === operation)) {
+          const { us, queue } = await runCase(run, c);
+          this.addResult({
+            errorMsg: undefined,
+            challenger: 'queue wait',
+            notes: this.notes?.['queue wait'] ?? '',
+            benchName: caseName(c),
+            them: queue,
+            us,
+          });
+        }
+      }
+    } finally {
+      rnqc.setQueueWaitTracking(false);
+    }
+    this.state = 'done';
+  }
+}
@@ -0,0 +1,87 @@
+import rnqc from 'react-native-quick-crypto';
+import type { DiffieHellmanGroupName } from 'react-native-quick-crypto';
+import { Bench } from 'tinybench';
+import type { BenchFn } from '../../types/benchmarks';
+
+// What apps without a native DH fall back to: square-and-multiply on BigInt
+const modPow = (base: bigint, exponent: bigint, modulus: bigint): bigint => {
+  let result = 1n;
+  base %= modulus;
+  while (exponent > 0n) {
+    if (exponent & 1n) {
+      result = (result * base) % modulus;
+    }
+    base = (base * base) % modulus;
+    exponent >>= 1n;
+  }
+  return result;
+};
+
+const toBigInt = (value: Buffer | string) =>
+  BigInt(`0x${Buffer.from(value as Buffer).toString('hex') || '0'}`);
+
+const computeSecret = (group: DiffieHellmanGroupName): BenchFn => {
+  return () => {
+    const alice = rnqc.getDiffieHellman(group);
+    const bob = rnqc.getDiffieHellman(group);
+    alice.generateKeys();
+    bob.generateKeys();
+    const peer = bob.getPublicKey() as Buffer;
+
+    const p = toBigInt(alice.getPrime());
+    const x = toBigInt(alice.getPrivateKey());
+    const y = toBigInt(peer);
+
+    const bench = new Bench({
+      name: `dh ${group} computeSecret`,
+      time: 1000,
+    });
+
+    bench
+      .add('rnqc', () => {
+        alice.computeSecret(peer);
+      })
+      .add('js bigint', () => {
+        modPow(y, x, p);
+      });
+
+    bench.warmupTime = 100;
+    return bench;
+  };
+};
+
+// 16 peers per call; one native call against 16 computeSecret() calls
+const computeSecrets = (group: DiffieHellmanGroupName): BenchFn => {
+  return () => {
+    const server = rnqc.getDiffieHellman(group);
+    server.generateKeys();
+    const peers = Array.from({ length: 16 }, () => {
+      const client = rnqc.getDiffieHellman(group);
+      return client.generateKeys();
+    });
+
+    const bench = new Bench({
+      name: `dh ${group} 16 peers`,
+      time: 1000,
+    });
+
+    bench
+      .add('rnqc', () => {
+        server.computeSecrets(peers);
+      })
+      .add('computeSecret loop', () => {
+        for (const peer of peers) {
+          server.computeSecret(peer);
+        }
+      });
+
+    bench.warmupTime = 100;
+    return bench;
+  };
+};
+
+export default [
+  computeSecret('modp14'),
+  computeSecret('modp15'),
+  computeSecrets('modp14'),
+];
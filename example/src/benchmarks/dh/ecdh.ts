@@ -0,0 +1,65 @@
+import rnqc from 'react-native-quick-crypto';
+import { p256 as noble } from '@noble/curves/p256';
+import { Bench } from 'tinybench';
+import type { BenchFn } from '../../types/benchmarks';
+
+const TIME_MS = 1000;
+
+const ecdh_p256_computeSecret: BenchFn = () => {
+  const alice = rnqc.createECDH('prime256v1');
+  const bob = rnqc.createECDH('prime256v1');
+  alice.generateKeys();
+  const peer = bob.generateKeys('buffer', 'compressed') as Buffer;
+  const privateKey = new Uint8Array(alice.getPrivateKey() as Buffer);
+  const peerBytes = new Uint8Array(peer);
+
+  const bench = new Bench({
+    name: 'ecdh p256 computeSecret (compressed peer)',
+    time: TIME_MS,
+  });
+
+  bench
+    .add('rnqc', () => {
+      alice.computeSecret(peer);
+    })
+    .add('@noble/curves/p256', () => {
+      noble.getSharedSecret(privateKey, peerBytes).subarray(1);
+    });
+
+  bench.warmupTime = 100;
+  return bench;
+};
+
+// 16 compressed keys to uncompressed; one native call against a loop
+const ecdh_p256_convertKeys: BenchFn = () => {
+  const keys = Array.from({ length: 16 }, () => {
+    const ecdh = rnqc.createECDH('prime256v1');
+    return ecdh.generateKeys('buffer', 'compressed') as Buffer;
+  });
+  const nobleKeys = keys.map(key => new Uint8Array(key));
+
+  const bench = new Bench({
+    name: 'ecdh p256 decompress 16 keys',
+    time: TIME_MS,
+  });
+
+  bench
+    .add('rnqc', () => {
+      rnqc.ECDH.convertKeys(keys, 'prime256v1');
+    })
+    .add('convertKey loop', () => {
+      for (const key of keys) {
+        rnqc.ECDH.convertKey(key, 'prime256v1');
+      }
+    })
+    .add('@noble/curves/p256', () => {
+      for (const key of nobleKeys) {
+        noble.ProjectivePoint.fromHex(key).toRawBytes(false);
+      }
+    });
+
+  bench.warmupTime = 100;
+  return bench;
+};
+
+export default [ecdh_p256_computeSecret, ecdh_p256_convertKeys];
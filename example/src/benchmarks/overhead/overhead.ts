@@ -0,0 +1,157 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import rnqc from 'react-native-quick-crypto';
+import type { NativeBenchmarkOperation } from 'react-native-quick-crypto';
+import { Bench } from 'tinybench';
+import type { TaskResult } from 'tinybench';
+import { BenchmarkSuite } from '../benchmarks';
+import { statistics } from '../utils';
+
+// Separates JSI boundary cost from crypto cost. Every operation runs three
+// ways across a size sweep:
+//   rnqc         - the public JS API, one JSI call chain per operation
+//   no-op        - a native call that does nothing with the same buffer
+//   native-only  - the same crypto work timed inside C++, no JSI per call
+// Where rnqc ~ no-op, per-call overhead dominates and the API wants batching.
+
+type Operation = {
+  name: string;
+  native: NativeBenchmarkOperation;
+  run: (data: Buffer) => void;
+};
+
+type OverheadCase = {
+  operation: Operation;
+  size: number;
+};
+
+const key = rnqc.randomBytes(32);
+const iv = rnqc.randomBytes(12);
+
+const operations: Operation[] = [
+  {
+    name: 'noop',
+    native: 'noop',
+    run: data => rnqc.benchmarkNoop(data.buffer as ArrayBuffer),
+  },
+  {
+    name: 'hash sha256',
+    native: 'sha256',
+    run: data => rnqc.createHash('sha256').update(data).digest(),
+  },
+  {
+    name: 'hmac sha256',
+    native: 'hmac-sha256',
+    run: data => rnqc.createHmac('sha256', key).update(data).digest(),
+  },
+  {
+    name: 'cipher aes-256-gcm',
+    native: 'aes-256-gcm',
+    run: data => {
+      const cipher = rnqc.createCipheriv('aes-256-gcm', key, iv);
+      cipher.update(data);
+      cipher.final();
+    },
+  },
+  {
+    name: 'randomFillSync',
+    native: 'randomFill',
+    run: data => rnqc.randomFillSync(data),
+  },
+];
+
+const KB = 1024;
+const MB = 1024 * KB;
+const sizes = [0, 64, KB, 16 * KB, 256 * KB, MB, 16 * MB, 64 * MB];
+
+// Fixed sample counts so p99/p999 mean the same thing for every task;
+// large inputs get fewer samples to keep the suite under a few minutes
+const samplesFor = (size: number): number => {
+  if (size >= 16 * MB) return 10;
+  if (size >= MB) return 100;
+  return 2000;
+};
+
+const formatSize = (size: number): string => {
+  if (size >= MB) return `${size / MB}MB`;
+  if (size >= KB) return `${size / KB}KB`;
+  return `${size}B`;
+};
+
+const caseName = ({ operation, size }: OverheadCase): string =>
+  `${operation.name} ${formatSize(size)}`;
+
+const jsiBench = (c: OverheadCase): Bench => {
+  const data = Buffer.alloc(c.size, 0x61);
+  const buffer = data.buffer as ArrayBuffer;
+  const bench = new Bench({
+    name: caseName(c),
+    iterations: samplesFor(c.size),
+    time: 0,
+    warmupIterations: Math.min(samplesFor(c.size), 20),
+  });
+
+  bench
+    .add('rnqc', () => c.operation.run(data))
+    .add('no-op', () => rnqc.benchmarkNoop(buffer));
+  return bench;
+};
+
+// Natively measured samples, shaped like a tinybench result so the
+// existing result views can render them next to the JS-side tasks
+const nativeResult = (c: OverheadCase): TaskResult => {
+  const data = Buffer.alloc(c.size, 0x61);
+  const latency = Array.from(
+    rnqc.benchmarkNative(
+      c.operation.native,
+      data.buffer as ArrayBuffer,
+      samplesFor(c.size),
+    ),
+  );
+  const throughput = latency.map(ms => (ms > 0 ? 1000 / ms : 0));
+  const stats = statistics(latency);
+  return {
+    latency: stats,
+    throughput: statistics(throughput),
+    period: stats.mean,
+    totalTime: latency.reduce((acc, v) => acc + v, 0),
+    runtime: 'unknown',
+    runtimeVersion: 'native',
+  } as unknown as TaskResult;
+};
+
+export class OverheadSuite extends BenchmarkSuite {
+  private cases: OverheadCase[];
+
+  constructor() {
+    const cases = operations.flatMap(operation =>
+      sizes.map(size => ({ operation, size })),
+    );
+    super(
+      'overhead',
+      cases.map(c => () => jsiBench(c)),
+      {
+        'no-op': 'JSI call with the same buffer that does no work',
+        'native-only': 'same work timed in C++, no JSI crossing per call',
+      },
+    );
+    this.cases = cases;
+  }
+
+  async run() {
+    this.results = [];
+    for (const c of this.cases) {
+      const b = jsiBench(c);
+      await b.run();
+      this.processResults(b);
+      this.addResult({
+        errorMsg: undefined,
+        challenger: 'native-only',
+        notes: this.notes?.['native-only'] ?? '',
+        benchName: b.name,
+        them: nativeResult(c),
+        us: b.tasks.find(t => t.name === 'rnqc')?.result,
+      });
+    }
+    this.state = 'done';
+  }
+}
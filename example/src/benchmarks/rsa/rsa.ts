@@ -0,0 +1,65 @@
+import rnqc from 'react-native-quick-crypto';
+import { Bench } from 'tinybench';
+import type { BenchFn } from '../../types/benchmarks';
+
+// Keygen time varies a lot from key to key, so these run a fixed number of
+// keys and the latency percentiles are the interesting part. `rnqc` is the
+// default (single search, 2 primes); the challengers change one option.
+
+const keygen = (modulusLength: number, iterations: number): BenchFn => {
+  return () => {
+    const bench = new Bench({
+      name: `rsa-${modulusLength} generateKeyPair`,
+      iterations,
+      time: 0,
+    });
+
+    const generate = (options: { primes?: number; parallelism?: number }) =>
+      new Promise<void>((resolve, reject) =>
+        rnqc.generateKeyPair('rsa', { modulusLength, ...options }, err =>
+          err ? reject(err) : resolve(),
+        ),
+      );
+
+    bench
+      .add('rnqc', () => generate({}))
+      .add('parallel x4', () => generate({ parallelism: 4 }))
+      .add('3 primes', () => generate({ primes: 3 }));
+
+    bench.warmupTime = 0;
+    bench.warmupIterations = 1;
+    return bench;
+  };
+};
+
+const sign = (modulusLength: number): BenchFn => {
+  return () => {
+    const privateKey = (primes: number) =>
+      rnqc.generateKeyPairSync('rsa', {
+        modulusLength,
+        primes,
+        privateKeyEncoding: { type: 'pkcs8', format: 'pem' },
+      }).privateKey as string;
+    const twoPrimes = privateKey(2);
+    const threePrimes = privateKey(3);
+    const data = Buffer.from('hello world');
+
+    const bench = new Bench({
+      name: `rsa-${modulusLength} sign sha256`,
+      time: 1000,
+    });
+
+    bench
+      .add('rnqc', () => {
+        rnqc.createSign('SHA256').update(data).sign(twoPrimes);
+      })
+      .add('3 primes', () => {
+        rnqc.createSign('SHA256').update(data).sign(threePrimes);
+      });
+
+    bench.warmupTime = 100;
+    return bench;
+  };
+};
+
+export default [keygen(2048, 20), keygen(4096, 5), sign(2048), sign(4096)];
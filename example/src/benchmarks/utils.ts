@@ -12,3 +12,41 @@ export const formatNumber = (
 export const calculateTimes = (us: number, them: number): number => {
   return us < them ? 1 + (them - us) / us : 1 + (us - them) / them;
 };
+
+export const percentile = (sorted: number[], p: number): number =>
+  sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))] ?? NaN;
+
+// tinybench-shaped statistics over raw samples, so natively or externally
+// measured numbers render in the same result views
+export const statistics = (samples: number[]) => {
+  const sorted = [...samples].sort((a, b) => a - b);
+  const n = sorted.length;
+  const mean = sorted.reduce((acc, v) => acc + v, 0) / n;
+  const variance =
+    n > 1 ? sorted.reduce((acc, v) => acc + (v - mean) ** 2, 0) / (n - 1) : 0;
+  const sd = Math.sqrt(variance);
+  const sem = sd / Math.sqrt(n);
+  return {
+    samples: sorted,
+    min: sorted[0] ?? NaN,
+    max: sorted[n - 1] ?? NaN,
+    mean,
+    variance,
+    sd,
+    sem,
+    df: n - 1,
+    critical: 1.96,
+    moe: sem * 1.96,
+    rme: mean === 0 ? 0 : ((sem * 1.96) / mean) * 100,
+    aad: sorted.reduce((acc, v) => acc + Math.abs(v - mean), 0) / n,
+    mad: percentile(
+      sorted.map(v => Math.abs(v - percentile(sorted, 0.5))).sort(),
+      0.5,
+    ),
+    p50: percentile(sorted, 0.5),
+    p75: percentile(sorted, 0.75),
+    p99: percentile(sorted, 0.99),
+    p995: percentile(sorted, 0.995),
+    p999: percentile(sorted, 0.999),
+  };
+};
@@ -8,7 +8,22 @@ type BenchmarkResultItemProps = {
   result: BenchmarkResult;
 };
 
-type Key = 'throughput' | 'latency';
+type Row = {
+  label: string;
+  key: 'throughput' | 'latency';
+  stat: 'mean' | 'p50' | 'p99' | 'p999';
+  places: number;
+};
+
+// Tail latency matters more than the mean for interactive callers, so the
+// percentiles sit next to it
+const rows: Row[] = [
+  { label: 'throughput (ops/s)', key: 'throughput', stat: 'mean', places: 2 },
+  { label: 'latency (ms)', key: 'latency', stat: 'mean', places: 3 },
+  { label: 'latency p50 (ms)', key: 'latency', stat: 'p50', places: 3 },
+  { label: 'latency p99 (ms)', key: 'latency', stat: 'p99', places: 3 },
+  { label: 'latency p999 (ms)', key: 'latency', stat: 'p999', places: 3 },
+];
 
 export const BenchmarkResultItemHeader: React.FC = () => {
   return (
@@ -48,11 +63,10 @@ export const BenchmarkResultItem: React.FC<BenchmarkResultItemProps> = ({
 
   const hasComparison = result.them !== undefined;
 
-  const rows = ['throughput', 'latency'].map((key, i) => {
-    const us = result.us![key as Key].mean;
-    const them = hasComparison ? result.them![key as Key].mean : 0;
+  const items = rows.map(({ label, key, stat, places }, i) => {
+    const us = result.us![key][stat];
+    const them = hasComparison ? result.them![key][stat] : 0;
     const comparison = key === 'throughput' ? us > them : us < them;
-    const places = key === 'throughput' ? 2 : 3;
     const times = hasComparison ? calculateTimes(us, them) : 0;
     const emoji = comparison ? '🐇' : '🐢';
     const timesType = comparison ? 'faster' : 'slower';
@@ -63,7 +77,7 @@ export const BenchmarkResultItem: React.FC<BenchmarkResultItemProps> = ({
         <View style={styles.itemContainer}>
           <Text style={styles.text}>{emoji}</Text>
           <Text style={[styles.text, styles.description]}>
-            {key} {key === 'throughput' ? '(ops/s)' : '(ms)'}
+            {label}
           </Text>
           {hasComparison && (
             <Text style={[styles.value, timesStyle]}>
@@ -84,7 +98,7 @@ export const BenchmarkResultItem: React.FC<BenchmarkResultItemProps> = ({
       <View style={styles.subContainer}>
         <Text style={[styles.sub, styles.benchName]}>{result.benchName}</Text>
       </View>
-      {rows}
+      {items}
       <View style={styles.subContainer}>
         <Text style={[styles.sub, styles.subLabel]}>challenger</Text>
         <Text style={[styles.sub, styles.subValue]}>{result.challenger}</Text>
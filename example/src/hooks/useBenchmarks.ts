@@ -2,12 +2,19 @@ import { useEffect, useState } from 'react';
 import { BenchmarkSuite } from '../benchmarks/benchmarks';
 import blake3 from '../benchmarks/blake3/blake3';
 import cipher from '../benchmarks/cipher/cipher';
+import compress from '../benchmarks/cipher/compress';
+import { ConcurrencySuite } from '../benchmarks/concurrency/concurrency';
+import pageCipher from '../benchmarks/cipher/pageCipher';
+import dh from '../benchmarks/dh/dh';
+import ecdh from '../benchmarks/dh/ecdh';
 import ed from '../benchmarks/ed/ed25519';
 import hkdf from '../benchmarks/hkdf/hkdf';
 import hash from '../benchmarks/hash/hash';
 import hmac from '../benchmarks/hmac/hmac';
+import { OverheadSuite } from '../benchmarks/overhead/overhead';
 import pbkdf2 from '../benchmarks/pbkdf2/pbkdf2';
 import random from '../benchmarks/random/randomBytes';
+import rsa from '../benchmarks/rsa/rsa';
 import scrypt from '../benchmarks/scrypt/scrypt';
 import xsalsa20 from '../benchmarks/cipher/xsalsa20';
 
@@ -26,18 +33,38 @@ export const useBenchmarks = (): [
   useEffect(() => {
     const newSuites: BenchmarkSuite[] = [];
     newSuites.push(new BenchmarkSuite('blake3', blake3));
-    newSuites.push(new BenchmarkSuite('cipher', [...xsalsa20, ...cipher]));
+    newSuites.push(
+      new BenchmarkSuite('cipher', [
+        ...xsalsa20,
+        ...cipher,
+        ...compress,
+        ...pageCipher,
+      ]),
+    );
+    newSuites.push(new ConcurrencySuite());
+    newSuites.push(
+      new BenchmarkSuite('dh', [...dh, ...ecdh], {
+        'js bigint': 'square-and-multiply with BigInt, same private key',
+      }),
+    );
     newSuites.push(new BenchmarkSuite('ed', ed));
     newSuites.push(new BenchmarkSuite('pbkdf2', pbkdf2));
     newSuites.push(new BenchmarkSuite('hash', hash));
     newSuites.push(new BenchmarkSuite('hmac', hmac));
     newSuites.push(new BenchmarkSuite('hkdf', hkdf));
+    newSuites.push(new OverheadSuite());
     newSuites.push(
       new BenchmarkSuite('random', random, {
         'browserify/randombytes':
           'polyfilled with RNQC, so a somewhat senseless benchmark',
       }),
     );
+    newSuites.push(
+      new BenchmarkSuite('rsa', rsa, {
+        'single thread': 'parallelism: 1, one prime search at a time',
+        '3 primes': 'multi-prime key (primes: 3)',
+      }),
+    );
     newSuites.push(new BenchmarkSuite('scrypt', scrypt));
     setSuites(newSuites);
   }, []);
@@ -5,16 +5,25 @@ import { TestsContext } from '../tests/util';
 import '../tests/blake3/blake3_tests';
 import '../tests/cipher/cipher_tests';
 import '../tests/cipher/chacha_tests';
+import '../tests/cipher/compress_tests';
+import '../tests/cipher/key_rotation_tests';
+import '../tests/cipher/page_cipher_tests';
 import '../tests/cipher/xsalsa20_tests';
+import '../tests/dh/dh_tests';
+import '../tests/dh/ecdh_tests';
 import '../tests/hash/hash_tests';
 import '../tests/hmac/hmac_tests';
+import '../tests/hmac/mac_tests';
 import '../tests/hkdf/hkdf_tests';
 import '../tests/jose/jose';
 import '../tests/keys/create_keys';
 import '../tests/keys/generate_key';
 import '../tests/keys/generate_keypair';
+import '../tests/keys/key_wrap';
 import '../tests/keys/public_cipher';
 import '../tests/keys/sign_verify_streaming';
+import '../tests/noise/noise_tests';
+import '../tests/oprf/oprf_tests';
 import '../tests/pbkdf2/pbkdf2_tests';
 import '../tests/random/random_tests';
 import '../tests/scrypt/scrypt_tests';
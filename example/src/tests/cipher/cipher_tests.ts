@@ -2,6 +2,7 @@ import { Buffer } from '@craftzdog/react-native-buffer';
 import {
   getCiphers,
   createCipheriv,
+  createDecipheriv,
   randomFillSync,
 } from 'react-native-quick-crypto';
 import { expect } from 'chai';
@@ -133,3 +134,56 @@ test(SUITE, 'GCM getAuthTag', () => {
   const tag = cipher.getAuthTag();
   expect(tag.length).to.equal(16);
 });
+
+test(SUITE, 'update with a subarray encrypts only the view', () => {
+  const key = Buffer.alloc(32, 1);
+  const iv = Buffer.alloc(16, 2);
+  const plaintext = Buffer.from('0123456789abcdef0123456789abcdef');
+  const backing = Buffer.concat([Buffer.alloc(7), plaintext, Buffer.alloc(9)]);
+  const view = backing.subarray(7, 7 + plaintext.length);
+
+  const encrypt = (data: Buffer) => {
+    const cipher = createCipheriv('aes-256-cbc', key, iv);
+    return Buffer.concat([cipher.update(data), cipher.final()]).toString('hex');
+  };
+  expect(encrypt(view)).to.equal(encrypt(Buffer.from(plaintext)));
+});
+
+test(SUITE, 'updateAsync/finalAsync match update/final', async () => {
+  const key = Buffer.alloc(32, 1);
+  const iv = Buffer.alloc(12, 2);
+  const plaintext = Buffer.alloc(4 * 1024 * 1024 + 3, 0x61);
+
+  const sync = createCipheriv('aes-256-gcm', key, iv);
+  const expected = Buffer.concat([sync.update(plaintext), sync.final()]);
+
+  const cipher = createCipheriv('aes-256-gcm', key, iv);
+  const ciphertext = Buffer.concat([
+    await cipher.updateAsync(plaintext),
+    await cipher.finalAsync(),
+  ]);
+  expect(ciphertext.toString('hex')).to.equal(expected.toString('hex'));
+  expect(cipher.getAuthTag().toString('hex')).to.equal(
+    sync.getAuthTag().toString('hex'),
+  );
+
+  const decipher = createDecipheriv('aes-256-gcm', key, iv);
+  decipher.setAuthTag(cipher.getAuthTag());
+  const decrypted = Buffer.concat([
+    await decipher.updateAsync(ciphertext),
+    await decipher.finalAsync(),
+  ]);
+  expect(decrypted.equals(plaintext)).to.equal(true);
+});
+
+test(SUITE, 'updateAsync rejects reentrant use', async () => {
+  const cipher = createCipheriv(
+    'aes-256-cbc',
+    Buffer.alloc(32, 1),
+    Buffer.alloc(16, 2),
+  );
+  const pending = cipher.updateAsync(Buffer.alloc(8 * 1024 * 1024));
+  expect(() => cipher.update(Buffer.alloc(16))).to.throw(/busy/);
+  await pending;
+  expect(() => cipher.update(Buffer.alloc(16))).to.not.throw();
+});
@@ -0,0 +1,149 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  compressAndEncrypt,
+  createCompressCipheriv,
+  createDecipheriv,
+  createDecompressDecipheriv,
+  decryptAndDecompress,
+  randomBytes,
+} from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'cipher';
+
+const json = Buffer.from(
+  JSON.stringify(
+    Array.from({ length: 2000 }, (_, i) => ({
+      id: i,
+      name: `user-${i % 50}`,
+      active: i % 3 === 0,
+    })),
+  ),
+);
+
+const algorithms = [
+  { name: 'aes-256-gcm', keyLen: 32 },
+  { name: 'aes-128-gcm', keyLen: 16 },
+  { name: 'chacha20-poly1305', keyLen: 32 },
+] as const;
+
+for (const { name, keyLen } of algorithms) {
+  const key = randomBytes(keyLen);
+  const iv = randomBytes(12);
+  const aad = Buffer.from('record-header');
+
+  test(SUITE, `compress-then-encrypt ${name} one-shot round trip`, () => {
+    const { ciphertext, authTag } = compressAndEncrypt(name, key, iv, json, {
+      aad,
+    });
+    expect(ciphertext.length).to.be.lessThan(json.length);
+    expect(authTag.length).to.equal(16);
+
+    const plain = decryptAndDecompress(name, key, iv, ciphertext, authTag, {
+      aad,
+    });
+    expect(plain.equals(json)).to.equal(true);
+  });
+
+  test(SUITE, `compress-then-encrypt ${name} chunked matches one-shot`, () => {
+    const oneShot = compressAndEncrypt(name, key, iv, json);
+
+    const cipher = createCompressCipheriv(name, key, iv);
+    const parts: Buffer[] = [];
+    for (let i = 0; i < json.length; i += 1000) {
+      parts.push(cipher.update(json.subarray(i, i + 1000)));
+    }
+    parts.push(cipher.final());
+    const chunked = Buffer.concat(parts);
+    expect(chunked.equals(oneShot.ciphertext)).to.equal(true);
+    expect(cipher.getAuthTag().equals(oneShot.authTag)).to.equal(true);
+
+    const decipher = createDecompressDecipheriv(name, key, iv);
+    decipher.setAuthTag(oneShot.authTag);
+    const out: Buffer[] = [];
+    for (let i = 0; i < chunked.length; i += 333) {
+      out.push(decipher.update(chunked.subarray(i, i + 333)));
+    }
+    out.push(decipher.final());
+    expect(Buffer.concat(out).equals(json)).to.equal(true);
+  });
+}
+
+test(SUITE, 'compress-then-encrypt output is a zlib stream under AEAD', () => {
+  const key = randomBytes(32);
+  const iv = randomBytes(12);
+  const { ciphertext, authTag } = compressAndEncrypt(
+    'aes-256-gcm',
+    key,
+    iv,
+    json,
+  );
+
+  const decipher = createDecipheriv('aes-256-gcm', key, iv);
+  decipher.setAuthTag(authTag);
+  const compressed = Buffer.concat([
+    decipher.update(ciphertext),
+    decipher.final(),
+  ]);
+  // zlib header: CM=8 (deflate), 32K window
+  expect(compressed[0]).to.equal(0x78);
+});
+
+test(SUITE, 'compress-then-encrypt rejects tampered ciphertext', () => {
+  const key = randomBytes(32);
+  const iv = randomBytes(12);
+  const { ciphertext, authTag } = compressAndEncrypt(
+    'chacha20-poly1305',
+    key,
+    iv,
+    json,
+  );
+  ciphertext[ciphertext.length - 1]! ^= 0x01;
+  expect(() =>
+    decryptAndDecompress('chacha20-poly1305', key, iv, ciphertext, authTag),
+  ).to.throw();
+});
+
+test(SUITE, 'compress-then-encrypt enforces maxOutputLength', () => {
+  const key = randomBytes(32);
+  const iv = randomBytes(12);
+  // 4 MiB of zeros compresses to a few KB
+  const bomb = Buffer.alloc(4 * 1024 * 1024);
+  const { ciphertext, authTag } = compressAndEncrypt(
+    'aes-256-gcm',
+    key,
+    iv,
+    bomb,
+    { level: 9 },
+  );
+  expect(ciphertext.length).to.be.lessThan(16 * 1024);
+
+  expect(() =>
+    decryptAndDecompress('aes-256-gcm', key, iv, ciphertext, authTag, {
+      maxOutputLength: 1024 * 1024,
+    }),
+  ).to.throw(/maxOutputLength/);
+
+  const plain = decryptAndDecompress(
+    'aes-256-gcm',
+    key,
+    iv,
+    ciphertext,
+    authTag,
+    { maxOutputLength: bomb.length },
+  );
+  expect(plain.length).to.equal(bomb.length);
+});
+
+test(SUITE, 'compress-then-encrypt rejects non-AEAD ciphers', () => {
+  expect(() =>
+    compressAndEncrypt(
+      // @ts-expect-error testing an unsupported algorithm
+      'aes-256-cbc',
+      randomBytes(32),
+      randomBytes(16),
+      json,
+    ),
+  ).to.throw(/AEAD/);
+});
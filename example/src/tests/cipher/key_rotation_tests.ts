@@ -0,0 +1,199 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  createCipheriv,
+  createDecipheriv,
+  createKeyRotation,
+  randomBytes,
+  reencryptBatch,
+} from 'react-native-quick-crypto';
+import type { RecordCipherAlgorithm } from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'cipher';
+
+// nonce (12) || ciphertext || tag (16)
+const seal = (
+  algorithm: RecordCipherAlgorithm,
+  key: Buffer,
+  plaintext: Buffer,
+  aad?: Buffer,
+): Buffer => {
+  const nonce = randomBytes(12);
+  const cipher = createCipheriv(algorithm, key, nonce, { authTagLength: 16 });
+  if (aad) {
+    cipher.setAAD(aad);
+  }
+  const body = Buffer.concat([cipher.update(plaintext), cipher.final()]);
+  return Buffer.concat([nonce, body, cipher.getAuthTag()]);
+};
+
+const open = (
+  algorithm: RecordCipherAlgorithm,
+  key: Buffer,
+  record: Buffer,
+  aad?: Buffer,
+): Buffer => {
+  const decipher = createDecipheriv(algorithm, key, record.subarray(0, 12), {
+    authTagLength: 16,
+  });
+  decipher.setAuthTag(record.subarray(record.length - 16));
+  if (aad) {
+    decipher.setAAD(aad);
+  }
+  return Buffer.concat([
+    decipher.update(record.subarray(12, record.length - 16)),
+    decipher.final(),
+  ]);
+};
+
+const makeRecords = (
+  algorithm: RecordCipherAlgorithm,
+  key: Buffer,
+  count: number,
+) => {
+  const plaintexts = Array.from({ length: count }, (_, i) =>
+    randomBytes((i * 37) % 300),
+  );
+  return {
+    plaintexts,
+    records: plaintexts.map(p => seal(algorithm, key, p)),
+  };
+};
+
+test(SUITE, 'reencryptBatch moves records to the new key', () => {
+  const oldKey = randomBytes(32);
+  const newKey = randomBytes(32);
+  const { plaintexts, records } = makeRecords('aes-256-gcm', oldKey, 20);
+
+  const result = reencryptBatch(oldKey, newKey, records, { counter: 5 });
+  expect(result.counter).to.equal(25);
+  result.records.forEach((record, i) => {
+    expect(record.length).to.equal(records[i]!.length);
+    expect(open('aes-256-gcm', newKey, record).equals(plaintexts[i]!)).to.equal(
+      true,
+    );
+  });
+});
+
+test(SUITE, 'reencryptBatch nonces come from the new key counter', () => {
+  const oldKey = randomBytes(32);
+  const { records } = makeRecords('aes-256-gcm', oldKey, 3);
+  const prefix = Buffer.from([0xde, 0xad, 0xbe, 0xef]);
+
+  const result = reencryptBatch(oldKey, randomBytes(32), records, {
+    noncePrefix: prefix,
+    counter: 0x1_0000_0001,
+  });
+  result.records.forEach((record, i) => {
+    const nonce = Buffer.alloc(12);
+    prefix.copy(nonce);
+    nonce.writeUInt32BE(1, 4);
+    nonce.writeUInt32BE(1 + i, 8);
+    expect(record.subarray(0, 12).equals(nonce)).to.equal(true);
+  });
+});
+
+test(SUITE, 'reencryptBatch switches algorithm and keeps aad', () => {
+  const oldKey = randomBytes(16);
+  const newKey = randomBytes(32);
+  const ids = [Buffer.from('row-1'), Buffer.from('row-2')];
+  const plaintexts = [Buffer.from('alice'), Buffer.from('bob')];
+  const records = plaintexts.map((p, i) =>
+    seal('aes-128-gcm', oldKey, p, ids[i]),
+  );
+
+  const result = reencryptBatch(oldKey, newKey, records, {
+    oldAlgorithm: 'aes-128-gcm',
+    algorithm: 'chacha20-poly1305',
+    aad: ids,
+    counter: 0,
+  });
+  result.records.forEach((record, i) => {
+    expect(
+      open('chacha20-poly1305', newKey, record, ids[i]).equals(plaintexts[i]!),
+    ).to.equal(true);
+  });
+  // aad is bound under the new key too
+  expect(() =>
+    open('chacha20-poly1305', newKey, result.records[0]!, ids[1]),
+  ).to.throw();
+});
+
+test(SUITE, 'key rotation parallel batches match serial', async () => {
+  const oldKey = randomBytes(32);
+  const newKey = randomBytes(32);
+  const { plaintexts, records } = makeRecords('chacha20-poly1305', oldKey, 64);
+
+  const rotation = createKeyRotation(oldKey, newKey, {
+    algorithm: 'chacha20-poly1305',
+    counter: 0,
+  });
+  const serial = rotation.reencryptBatch(records);
+  const parallel = await rotation.reencryptBatchAsync(records, {
+    parallelism: 4,
+  });
+  expect(rotation.counter).to.equal(128);
+  parallel.forEach((record, i) => {
+    // same plaintext, fresh nonce
+    expect(record.subarray(0, 12).equals(serial[i]!.subarray(0, 12))).to.equal(
+      false,
+    );
+    expect(
+      open('chacha20-poly1305', newKey, record).equals(plaintexts[i]!),
+    ).to.equal(true);
+  });
+});
+
+test(SUITE, 'reencryptBatch rejects tampered records', () => {
+  const oldKey = randomBytes(32);
+  const { records } = makeRecords('aes-256-gcm', oldKey, 4);
+  records[1]![13]! ^= 0xff;
+  records[3]![records[3]!.length - 1]! ^= 0xff;
+
+  const rotation = createKeyRotation(oldKey, randomBytes(32), { counter: 0 });
+  expect(() => rotation.reencryptBatch(records)).to.throw(
+    /authenticate 2 record\(s\): 1, 3/,
+  );
+  // the failed batch still spent its nonces
+  expect(rotation.counter).to.equal(4);
+});
+
+test(SUITE, 'reencryptBatch validates its inputs', () => {
+  const key = randomBytes(32);
+  expect(() =>
+    reencryptBatch(key, key, [randomBytes(27)], { counter: 0 }),
+  ).to.throw(/Invalid record 0/);
+  expect(() =>
+    reencryptBatch(key, key, [], { noncePrefix: randomBytes(8), counter: 0 }),
+  ).to.throw(/noncePrefix must be exactly 4 bytes/);
+  expect(() =>
+    createKeyRotation(key, key, {
+      algorithm: 'aes-256-cbc' as RecordCipherAlgorithm,
+      counter: 0,
+    }),
+  ).to.throw(/supports AES-GCM and ChaCha20-Poly1305/);
+});
+
+test(SUITE, 'reencryptBatch never restarts nonces on its own', () => {
+  const oldKey = randomBytes(32);
+  const newKey = randomBytes(32);
+  const { records } = makeRecords('aes-256-gcm', oldKey, 4);
+
+  const first = reencryptBatch(oldKey, newKey, records, { counter: 0 });
+  // a second rotation under the same key must pass the saved counter
+  type Options = Parameters<typeof reencryptBatch>[3];
+  expect(() => reencryptBatch(oldKey, newKey, records, {} as Options)).to.throw(
+    /counter is required/,
+  );
+  expect(() => createKeyRotation(oldKey, newKey, {} as Options)).to.throw(
+    /counter is required/,
+  );
+
+  // even a caller that does restart from 0 gets a fresh random prefix
+  const again = reencryptBatch(oldKey, newKey, records, { counter: 0 });
+  first.records.forEach((record, i) => {
+    const nonce = record.subarray(0, 12);
+    expect(nonce.equals(again.records[i]!.subarray(0, 12))).to.equal(false);
+  });
+});
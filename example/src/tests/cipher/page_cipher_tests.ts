@@ -0,0 +1,146 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  createDecipheriv,
+  createPageCipher,
+  randomBytes,
+} from 'react-native-quick-crypto';
+import type { PageCipherAlgorithm } from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'cipher';
+const PAGE_SIZE = 4096;
+
+const algorithms: { name: PageCipherAlgorithm; keyLen: number }[] = [
+  { name: 'aes-256-gcm', keyLen: 32 },
+  { name: 'chacha20-poly1305', keyLen: 32 },
+  { name: 'aes-256-xts', keyLen: 64 },
+];
+
+const makePages = (count: number) => randomBytes(count * PAGE_SIZE);
+
+for (const { name, keyLen } of algorithms) {
+  const key = randomBytes(keyLen);
+
+  test(SUITE, `page cipher ${name} round trip in place`, () => {
+    const pc = createPageCipher(name, key, { pageSize: PAGE_SIZE });
+    const pages = makePages(8);
+    const original = Buffer.from(pages);
+    const payload = PAGE_SIZE - pc.reserveSize;
+    const numbers = [0, 1, 2, 3, 100, 101, 102, 103];
+
+    pc.encryptPages(pages, numbers, [1, 1, 1, 1, 2, 2, 2, 2]);
+    expect(
+      pages.subarray(0, payload).equals(original.subarray(0, payload)),
+    ).to.equal(false);
+
+    pc.decryptPages(pages, numbers);
+    for (let i = 0; i < numbers.length; i++) {
+      const start = i * PAGE_SIZE;
+      expect(
+        pages
+          .subarray(start, start + payload)
+          .equals(original.subarray(start, start + payload)),
+      ).to.equal(true);
+    }
+  });
+
+  test(SUITE, `page cipher ${name} parallel matches serial`, async () => {
+    const pc = createPageCipher(name, key, { pageSize: PAGE_SIZE });
+    const numbers = Array.from({ length: 64 }, (_, i) => i);
+    const counters = numbers.map(() => 7);
+    const a = makePages(64);
+    const b = Buffer.from(a);
+
+    pc.encryptPages(a, numbers, counters);
+    const encrypted = await pc.encryptPagesAsync(b, numbers, counters, {
+      parallelism: 4,
+    });
+    expect(a.equals(encrypted)).to.equal(true);
+
+    const decrypted = await pc.decryptPagesAsync(encrypted, numbers, {
+      parallelism: 4,
+    });
+    pc.decryptPages(a, numbers);
+    expect(a.equals(decrypted)).to.equal(true);
+  });
+
+  test(SUITE, `page cipher ${name} async keeps input intact`, async () => {
+    const pc = createPageCipher(name, key, { pageSize: PAGE_SIZE });
+    const pages = makePages(4);
+    const original = Buffer.from(pages);
+
+    const numbers = [0, 1, 2, 3];
+    const encrypted = await pc.encryptPagesAsync(pages, numbers, [1, 1, 1, 1]);
+    expect(pages.equals(original)).to.equal(true);
+    expect(encrypted.equals(original)).to.equal(false);
+
+    const decrypted = await pc.decryptPagesAsync(encrypted, numbers);
+    const payload = PAGE_SIZE - pc.reserveSize;
+    expect(
+      decrypted.subarray(0, payload).equals(original.subarray(0, payload)),
+    ).to.equal(true);
+  });
+}
+
+test(SUITE, 'page cipher gcm page format matches createCipheriv', () => {
+  const key = randomBytes(32);
+  const pc = createPageCipher('aes-256-gcm', key, { pageSize: PAGE_SIZE });
+  const page = makePages(1);
+  const plain = Buffer.from(page.subarray(0, PAGE_SIZE - 20));
+  pc.encryptPages(page, [42], [3]);
+
+  // nonce = page number (u64 LE) || write counter (u32 LE)
+  const nonce = Buffer.alloc(12);
+  nonce.writeUInt32LE(42, 0);
+  nonce.writeUInt32LE(3, 8);
+  const trailer = page.subarray(PAGE_SIZE - 20);
+  expect(trailer.readUInt32LE(0)).to.equal(3);
+
+  const decipher = createDecipheriv('aes-256-gcm', key, nonce);
+  decipher.setAuthTag(Buffer.from(trailer.subarray(4)));
+  const out = Buffer.concat([
+    decipher.update(page.subarray(0, PAGE_SIZE - 20)),
+    decipher.final(),
+  ]);
+  expect(out.equals(plain)).to.equal(true);
+});
+
+test(SUITE, 'page cipher detects tampered and swapped pages', () => {
+  const pc = createPageCipher('aes-256-gcm', randomBytes(32), {
+    pageSize: PAGE_SIZE,
+  });
+  const pages = makePages(4);
+  pc.encryptPages(pages, [10, 11, 12, 13], [1, 1, 1, 1]);
+  pages[PAGE_SIZE * 2 + 5]! ^= 0xff;
+
+  expect(() => pc.decryptPages(pages, [10, 11, 13, 12])).to.throw(
+    /authenticate 2 page\(s\): 12, 13/,
+  );
+});
+
+test(SUITE, 'page cipher honours a larger reserveSize', () => {
+  const pc = createPageCipher('chacha20-poly1305', randomBytes(32), {
+    pageSize: PAGE_SIZE,
+    reserveSize: 32,
+  });
+  expect(pc.reserveSize).to.equal(32);
+  const pages = makePages(2);
+  // the bytes between payload and trailer are left untouched
+  const untouched = Buffer.from(
+    pages.subarray(PAGE_SIZE - 32, PAGE_SIZE - 20),
+  );
+  pc.encryptPages(pages, [0, 1], [0, 0]);
+  expect(
+    pages.subarray(PAGE_SIZE - 32, PAGE_SIZE - 20).equals(untouched),
+  ).to.equal(true);
+});
+
+test(SUITE, 'page cipher rejects mismatched buffer sizes', () => {
+  const pc = createPageCipher('aes-256-xts', randomBytes(64), {
+    pageSize: PAGE_SIZE,
+  });
+  expect(() => pc.encryptPages(makePages(2), [0, 1, 2])).to.throw(
+    /pageNumbers.length \* pageSize/,
+  );
+});
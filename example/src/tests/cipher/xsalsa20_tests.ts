@@ -1,5 +1,9 @@
 import { Buffer } from '@craftzdog/react-native-buffer';
-import { randomFillSync, xsalsa20 } from 'react-native-quick-crypto';
+import {
+  createCipheriv,
+  randomFillSync,
+  xsalsa20,
+} from 'react-native-quick-crypto';
 import { expect } from 'chai';
 import { test } from '../util';
 
@@ -25,3 +29,18 @@ test(SUITE, 'xsalsa20', () => {
   // test decrypted == data
   expect(decrypted).eql(data);
 });
+
+test(SUITE, 'xsalsa20 - updateAsync/finalAsync match xsalsa20', async () => {
+  const nonce = randomFillSync(Buffer.alloc(24));
+  const cipher = createCipheriv('xsalsa20', key32, nonce);
+  const ciphertext = Buffer.concat([
+    await cipher.updateAsync(plaintextBuffer),
+    await cipher.finalAsync(),
+  ]);
+  const expected = xsalsa20(
+    new Uint8Array(key32),
+    new Uint8Array(nonce),
+    new Uint8Array(plaintextBuffer),
+  );
+  expect(ciphertext.equals(Buffer.from(expected))).to.equal(true);
+});
@@ -0,0 +1,123 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  constants,
+  createDiffieHellman,
+  createDiffieHellmanAsync,
+  getDiffieHellman,
+} from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'dh';
+
+test(SUITE, 'known answer with p = 23, g = 5', () => {
+  const alice = createDiffieHellman(Buffer.from([23]), 5);
+  alice.setPrivateKey(Buffer.from([6]));
+  expect(alice.generateKeys('hex')).to.equal('08');
+  expect(alice.computeSecret(Buffer.from([19]), undefined, 'hex')).to.equal(
+    '02',
+  );
+});
+
+for (const group of ['modp14', 'modp15', 'ffdhe2048'] as const) {
+  test(SUITE, `${group} shared secret`, () => {
+    const alice = getDiffieHellman(group);
+    const bob = getDiffieHellman(group);
+    alice.generateKeys();
+    bob.generateKeys();
+
+    const aliceSecret = alice.computeSecret(bob.getPublicKey() as Buffer);
+    const bobSecret = bob.computeSecret(alice.getPublicKey('hex'), 'hex');
+    expect(Buffer.from(aliceSecret).equals(bobSecret as Buffer)).to.equal(true);
+    expect(aliceSecret.length).to.equal((alice.getPrime() as Buffer).length);
+    expect(alice.verifyError).to.equal(0);
+  });
+}
+
+test(SUITE, 'modp14 prime matches RFC 3526', () => {
+  const prime = getDiffieHellman('modp14').getPrime('hex') as string;
+  expect(prime.length).to.equal(512);
+  expect(prime.startsWith('ffffffffffffffffc90fdaa22168c234')).to.equal(true);
+  expect(prime.endsWith('15728e5a8aacaa68ffffffffffffffff')).to.equal(true);
+  expect(getDiffieHellman('modp14').getGenerator('hex')).to.equal('02');
+});
+
+test(SUITE, 'custom parameters interoperate with a group', () => {
+  const group = getDiffieHellman('modp14');
+  const alice = createDiffieHellman(
+    group.getPrime('hex') as string,
+    'hex',
+    group.getGenerator('hex') as string,
+    'hex',
+  );
+  alice.generateKeys();
+  group.generateKeys();
+  const a = alice.computeSecret(group.getPublicKey() as Buffer) as Buffer;
+  const b = group.computeSecret(alice.getPublicKey() as Buffer) as Buffer;
+  expect(a.equals(b)).to.equal(true);
+});
+
+test(SUITE, 'computeSecrets matches computeSecret', async () => {
+  const server = getDiffieHellman('modp14');
+  server.generateKeys();
+  const clients = [0, 1, 2].map(() => {
+    const client = getDiffieHellman('modp14');
+    client.generateKeys();
+    return client;
+  });
+  const publicKeys = clients.map(client => client.getPublicKey() as Buffer);
+
+  const batch = server.computeSecrets(publicKeys, undefined, 'hex');
+  const batchAsync = await server.computeSecretsAsync(
+    publicKeys,
+    undefined,
+    'hex',
+  );
+  clients.forEach((client, i) => {
+    const expected = client.computeSecret(
+      server.getPublicKey() as Buffer,
+      undefined,
+      'hex',
+    );
+    expect(batch[i]).to.equal(expected);
+    expect(batchAsync[i]).to.equal(expected);
+  });
+});
+
+test(SUITE, 'rejects degenerate public keys', () => {
+  const dh = getDiffieHellman('modp14');
+  dh.generateKeys();
+  expect(() => dh.computeSecret(Buffer.from([1]))).to.throw(/too small/);
+  const prime = dh.getPrime() as Buffer;
+  expect(() => dh.computeSecret(prime)).to.throw(/too large/);
+});
+
+test(SUITE, 'setPrivateKey restores the key pair', () => {
+  const original = getDiffieHellman('modp14');
+  original.generateKeys();
+  const restored = createDiffieHellman(
+    original.getPrime() as Buffer,
+    original.getGenerator() as Buffer,
+  );
+  restored.setPrivateKey(original.getPrivateKey() as Buffer);
+  expect(restored.generateKeys('hex')).to.equal(original.getPublicKey('hex'));
+});
+
+test(SUITE, 'createDiffieHellmanAsync generates a safe prime', async () => {
+  const dh = await createDiffieHellmanAsync(512);
+  expect((dh.getPrime() as Buffer).length).to.equal(64);
+  expect(dh.getGenerator('hex')).to.equal('02');
+  expect(dh.verifyError).to.equal(0);
+});
+
+test(SUITE, 'verifyError flags a composite prime', () => {
+  const dh = createDiffieHellman(Buffer.from([25]), 2);
+  expect(dh.verifyError & constants.DH_CHECK_P_NOT_PRIME).to.equal(
+    constants.DH_CHECK_P_NOT_PRIME,
+  );
+});
+
+test(SUITE, 'unknown group throws', () => {
+  // @ts-expect-error not a group name
+  expect(() => getDiffieHellman('modp3')).to.throw(/Unknown DH group/);
+});
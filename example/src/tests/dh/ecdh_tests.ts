@@ -0,0 +1,134 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import { ECDH, createECDH } from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'ecdh';
+
+// RFC 5903 section 8.1, ECDH on P-256
+const kPrivate =
+  'c88f01f510d9ac3f70a292daa2316de544e9aab8afe84049c62a9c57862d1433';
+const kPublic =
+  '04dad0b65394221cf9b051e1feca5787d098dfe637fc90b9ef945d0c3772581180' +
+  '5271a0461cdb8252d61f1c456fa3e59ab1f45b33accf5f58389e0577b8990bb3';
+const kPeerPublic =
+  '04d12dfb5289c8d4f81208b70270398c342296970a0bccb74c736fc7554494bf63' +
+  '56fbf3ca366cc23e8157854c13c58d6aac23f046ada30f8353e74f33039872ab';
+const kSecret =
+  'd6840f6b42f6edafd13116e0e12565202fef8e9ece7dce03812464d04b9442de';
+
+test(SUITE, 'known answer on prime256v1', () => {
+  const ecdh = createECDH('prime256v1');
+  ecdh.setPrivateKey(kPrivate, 'hex');
+  expect(ecdh.getPublicKey('hex')).to.equal(kPublic);
+  expect(ecdh.computeSecret(kPeerPublic, 'hex', 'hex')).to.equal(kSecret);
+});
+
+// Secret (field element) size in bytes
+const kCurves: Record<string, number> = {
+  prime256v1: 32,
+  secp384r1: 48,
+  secp521r1: 66,
+  secp256k1: 32,
+};
+
+for (const [curve, fieldBytes] of Object.entries(kCurves)) {
+  test(SUITE, `${curve} shared secret`, () => {
+    const alice = createECDH(curve);
+    const bob = createECDH(curve);
+    const alicePublic = alice.generateKeys();
+    const bobPublic = bob.generateKeys('hex', 'compressed');
+
+    const aliceSecret = alice.computeSecret(bobPublic, 'hex') as Buffer;
+    const bobSecret = bob.computeSecret(alicePublic) as Buffer;
+    expect(aliceSecret.equals(bobSecret)).to.equal(true);
+    expect(aliceSecret.length).to.equal(fieldBytes);
+  });
+}
+
+test(SUITE, 'convertKey round-trips every format', () => {
+  const compressed = ECDH.convertKey(
+    kPublic,
+    'prime256v1',
+    'hex',
+    'hex',
+    'compressed',
+  ) as string;
+  expect(compressed).to.equal(`03${kPublic.slice(2, 66)}`);
+  expect(ECDH.convertKey(compressed, 'prime256v1', 'hex', 'hex')).to.equal(
+    kPublic,
+  );
+  const hybrid = ECDH.convertKey(
+    compressed,
+    'prime256v1',
+    'hex',
+    'hex',
+    'hybrid',
+  ) as string;
+  expect(hybrid).to.equal(`07${kPublic.slice(2)}`);
+});
+
+test(SUITE, 'convertKeys matches convertKey', () => {
+  const keys = [0, 1, 2].map(() =>
+    createECDH('secp384r1').generateKeys('hex', 'compressed'),
+  );
+  const converted = ECDH.convertKeys(keys, 'secp384r1', 'hex', 'hex');
+  keys.forEach((key, i) => {
+    expect(converted[i]).to.equal(
+      ECDH.convertKey(key, 'secp384r1', 'hex', 'hex'),
+    );
+  });
+});
+
+test(SUITE, 'computeSecrets matches computeSecret', async () => {
+  const server = createECDH('prime256v1');
+  server.generateKeys();
+  const clients = [0, 1, 2].map(() => {
+    const client = createECDH('prime256v1');
+    client.generateKeys();
+    return client;
+  });
+  const publicKeys = clients.map(
+    client => client.getPublicKey(undefined, 'compressed') as Buffer,
+  );
+
+  const batch = server.computeSecrets(publicKeys, undefined, 'hex');
+  const batchAsync = await server.computeSecretsAsync(
+    publicKeys,
+    undefined,
+    'hex',
+  );
+  clients.forEach((client, i) => {
+    const expected = client.computeSecret(
+      server.getPublicKey() as Buffer,
+      undefined,
+      'hex',
+    );
+    expect(batch[i]).to.equal(expected);
+    expect(batchAsync[i]).to.equal(expected);
+  });
+});
+
+test(SUITE, 'rejects points that are not on the curve', () => {
+  const ecdh = createECDH('prime256v1');
+  ecdh.generateKeys();
+  const bad = Buffer.from(kPeerPublic, 'hex');
+  bad[40] ^= 1;
+  expect(() => ecdh.computeSecret(bad)).to.throw(/not valid/);
+  expect(() => ecdh.computeSecret(Buffer.from([0]))).to.throw(/not valid/);
+  expect(() => ECDH.convertKey(kPeerPublic, 'secp384r1', 'hex')).to.throw(
+    /not valid/,
+  );
+});
+
+test(SUITE, 'rejects out-of-range private keys', () => {
+  const ecdh = createECDH('prime256v1');
+  expect(() => ecdh.setPrivateKey(Buffer.alloc(32, 0xff))).to.throw(
+    /not valid/,
+  );
+  expect(() => ecdh.setPrivateKey(Buffer.alloc(32))).to.throw(/not valid/);
+});
+
+test(SUITE, 'unknown curve throws', () => {
+  expect(() => createECDH('prime257v1')).to.throw(/Invalid EC curve name/);
+});
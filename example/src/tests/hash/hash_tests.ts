@@ -283,3 +283,16 @@ test(SUITE, 'createHash with null outputLength', () => {
     createHash('shake128', { outputLength: null });
   }).to.throw(/Output length must be a number/);
 });
+
+test(SUITE, 'update with a subarray hashes only the view', () => {
+  const backing = Buffer.from('xxxxhello worldyyyy');
+  const view = backing.subarray(4, 15);
+  expect(createHash('sha256').update(view).digest('hex')).to.equal(
+    createHash('sha256').update('hello world').digest('hex'),
+  );
+  expect(
+    createHash('sha256')
+      .update(new Uint8Array(backing.buffer, backing.byteOffset + 4, 11))
+      .digest('hex'),
+  ).to.equal(createHash('sha256').update('hello world').digest('hex'));
+});
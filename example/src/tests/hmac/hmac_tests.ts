@@ -4,7 +4,12 @@
  */
 
 import { Buffer } from '@craftzdog/react-native-buffer';
-import crypto, { createHmac, type Encoding } from 'react-native-quick-crypto';
+import crypto, {
+  createHmac,
+  hmacMany,
+  hmacManyAsync,
+  type Encoding,
+} from 'react-native-quick-crypto';
 import { assert, expect } from 'chai';
 import { test } from '../util';
 
@@ -515,3 +520,56 @@ test(SUITE, 'digest with ucs2 encoding', () => {
     crypto.createHmac('sha256', 'w00t').digest().toString('ucs2'),
   );
 });
+
+test(SUITE, 'update with a subarray authenticates only the view', () => {
+  const view = Buffer.from('xxxxhello worldyyyy').subarray(4, 15);
+  expect(createHmac('sha256', 'key').update(view).digest('hex')).to.equal(
+    createHmac('sha256', 'key').update('hello world').digest('hex'),
+  );
+});
+
+// hmacMany
+
+const fieldValues = Array.from({ length: 300 }, (_, i) =>
+  i % 2 ? `user-${i}@example.com` : Buffer.from(`row ${i}`),
+);
+
+test(SUITE, 'hmacMany matches createHmac for every message', () => {
+  const tags = hmacMany('sha256', 'index-key', fieldValues);
+  expect(tags.length).to.equal(fieldValues.length * 32);
+  fieldValues.forEach((value, i) => {
+    expect(tags.subarray(i * 32, (i + 1) * 32).toString('hex')).to.equal(
+      createHmac('sha256', 'index-key').update(value).digest('hex'),
+    );
+  });
+});
+
+test(SUITE, 'hmacMany truncates tags', () => {
+  const full = hmacMany('sha512', 'k', ['a', 'b', 'c']);
+  const truncated = hmacMany('sha512', 'k', ['a', 'b', 'c'], 16);
+  expect(truncated.length).to.equal(48);
+  for (let i = 0; i < 3; i++) {
+    expect(truncated.subarray(i * 16, (i + 1) * 16)).to.deep.equal(
+      full.subarray(i * 64, i * 64 + 16),
+    );
+  }
+  expect(() => hmacMany('sha256', 'k', ['a'], 0)).to.throw(
+    /truncateTo must be an integer from 1 to 32/,
+  );
+  expect(() => hmacMany('sha256', 'k', ['a'], 33)).to.throw(/truncateTo/);
+});
+
+test(SUITE, 'hmacMany with an empty batch or empty key', () => {
+  expect(hmacMany('sha256', 'k', []).length).to.equal(0);
+  expect(hmacMany('sha256', '', ['']).toString('hex')).to.equal(
+    createHmac('sha256', '').update('').digest('hex'),
+  );
+  expect(() => hmacMany('sha123', 'k', ['a'])).to.throw(
+    /Unknown HMAC algorithm: sha123/,
+  );
+});
+
+test(SUITE, 'hmacManyAsync matches hmacMany', async () => {
+  const tags = await hmacManyAsync('sha256', 'index-key', fieldValues, 16);
+  expect(tags).to.deep.equal(hmacMany('sha256', 'index-key', fieldValues, 16));
+});
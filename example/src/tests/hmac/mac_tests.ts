@@ -0,0 +1,161 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  createCipheriv,
+  createHmac,
+  createMac,
+  mac,
+} from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'mac';
+
+const bytes = (length: number, start = 0) =>
+  Buffer.from(Array.from({ length }, (_, i) => (start + i) & 0xff));
+
+test(SUITE, 'HMAC matches createHmac (RFC 4231 case 2)', () => {
+  const tag = mac('HMAC', 'Jefe', 'what do ya want for nothing?', {
+    digest: 'SHA256',
+  });
+  expect(tag.toString('hex')).to.equal(
+    '5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843',
+  );
+  expect(tag.toString('hex')).to.equal(
+    createHmac('sha256', 'Jefe')
+      .update('what do ya want for nothing?')
+      .digest('hex'),
+  );
+});
+
+test(SUITE, 'CMAC known answers (RFC 4493)', () => {
+  const key = Buffer.from('2b7e151628aed2a6abf7158809cf4f3c', 'hex');
+  const cmac = createMac('CMAC', key, { cipher: 'AES-128-CBC' });
+  expect(cmac.macLength).to.equal(16);
+  const tags = cmac.computeMany([
+    Buffer.alloc(0),
+    Buffer.from('6bc1bee22e409f96e93d7e117393172a', 'hex'),
+  ]);
+  expect(tags.map(tag => tag.toString('hex'))).to.deep.equal([
+    'bb1d6929e95937287fa37d129b756746',
+    '070a16b46b4d4144f79bdd9dd04a287c',
+  ]);
+});
+
+test(SUITE, 'Poly1305 known answer (RFC 8439 2.5.2)', () => {
+  const key = Buffer.from(
+    '85d6be7857556d337f4452fe42d506a80103808afb0db2fd4abff6af4149f51b',
+    'hex',
+  );
+  const poly = createMac('POLY1305', key);
+  expect(
+    poly.compute('Cryptographic Forum Research Group').toString('hex'),
+  ).to.equal('a8061dc1305136c6c22b8baf0c0127a9');
+});
+
+test(SUITE, 'Poly1305 keys produce one tag', () => {
+  const poly = createMac('POLY1305', bytes(32));
+  poly.compute('first');
+  expect(() => poly.compute('second')).to.throw(/one-time/);
+  expect(() => createMac('POLY1305', bytes(32)).copy()).to.throw(/one-time/);
+  expect(() =>
+    createMac('POLY1305', bytes(32)).computeMany(['a', 'b']),
+  ).to.throw(/one-time/);
+});
+
+test(SUITE, 'SipHash-2-4 known answers', () => {
+  const sip = createMac('SIPHASH', bytes(16), { outputLength: 8 });
+  const tags = sip.computeMany([bytes(0), bytes(15)]);
+  expect(tags.map(tag => tag.toString('hex'))).to.deep.equal([
+    '310e0edd47db6f72',
+    'e545be4961ca29a1',
+  ]);
+});
+
+test(SUITE, 'KMAC128 known answers (NIST SP 800-185 samples)', () => {
+  const key = bytes(32, 0x40);
+  const data = bytes(4);
+  expect(
+    mac('KMAC-128', key, data, { outputLength: 32 }).toString('hex'),
+  ).to.equal(
+    'e5780b0d3ea6f7d3a429c5706aa43a00fadbd7d49628839e3187243f456ee14e',
+  );
+  expect(
+    mac('KMAC-128', key, data, {
+      outputLength: 32,
+      customization: 'My Tagged Application',
+    }).toString('hex'),
+  ).to.equal(
+    '3b1fba963cd8b0b59e8c1a6d71888b7143651af8ba0a7070c0979e2811324aa5',
+  );
+});
+
+test(SUITE, 'BLAKE2b keyed known answer', () => {
+  expect(mac('BLAKE2BMAC', bytes(64), '').toString('hex')).to.equal(
+    '10ebb67700b1868efb4417987acf4690ae9d972fb7a590c2f02871799aaa4786' +
+      'b5e996e8f0f4eb981fc214b005f42d2ff4233499391653df7aefcbc13fc51568',
+  );
+});
+
+test(SUITE, 'GMAC matches an AES-GCM tag over AAD only', () => {
+  const key = bytes(16, 7);
+  const ivs = [bytes(12, 1), bytes(12, 2)];
+  const messages = ['hello', 'a message longer than one block'];
+  const gmac = createMac('GMAC', key, { cipher: 'AES-128-GCM' });
+  const tags = gmac.computeMany(messages, ivs);
+  messages.forEach((message, i) => {
+    const gcm = createCipheriv('aes-128-gcm', key, ivs[i]!);
+    gcm.setAAD(Buffer.from(message));
+    gcm.final();
+    expect(tags[i]!.toString('hex')).to.equal(
+      gcm.getAuthTag().toString('hex'),
+    );
+  });
+});
+
+test(SUITE, 'GMAC needs an iv per message', () => {
+  const gmac = createMac('GMAC', bytes(16), { cipher: 'AES-128-GCM' });
+  expect(() => gmac.compute('x')).to.throw(/fresh iv/);
+  expect(() => gmac.computeMany(['x'], [bytes(12), bytes(12)])).to.throw(
+    /one iv per message/,
+  );
+});
+
+test(SUITE, 'streaming, copy and compute agree', () => {
+  const cmac = createMac('CMAC', bytes(32), { cipher: 'AES-256-CBC' });
+  const expected = cmac.compute('prefix|suffix-a').toString('hex');
+  const stream = createMac('CMAC', bytes(32), { cipher: 'AES-256-CBC' });
+  stream.update('prefix|');
+  const fork = stream.copy();
+  expect(stream.update('suffix-a').digest('hex')).to.equal(expected);
+  expect(fork.update('suffix-b').digest('hex')).to.equal(
+    cmac.compute('prefix|suffix-b').toString('hex'),
+  );
+  expect(() => stream.digest()).to.throw(/Digest already called/);
+  // one-shot calls after streaming still start from the key
+  expect(cmac.compute('prefix|suffix-a').toString('hex')).to.equal(expected);
+});
+
+test(SUITE, 'computeManyAsync matches computeMany', async () => {
+  const kmac = createMac('KMAC-256', bytes(32), { outputLength: 64 });
+  const messages = Array.from({ length: 8 }, (_, i) => bytes(i * 37, i));
+  const tags = await kmac.computeManyAsync(messages);
+  expect(tags.map(tag => tag.toString('hex'))).to.deep.equal(
+    kmac.computeMany(messages).map(tag => tag.toString('hex')),
+  );
+  expect(tags[0]!.length).to.equal(64);
+});
+
+test(SUITE, 'rejects parameters an algorithm does not take', () => {
+  expect(() => createMac('HMAC', 'key')).to.throw(/needs a digest/);
+  expect(() =>
+    createMac('CMAC', bytes(16), { cipher: 'AES-128-CBC', salt: 'salt' }),
+  ).to.throw(/does not take a salt/);
+  expect(() =>
+    createMac('CMAC', bytes(16), { cipher: 'AES-128-CBC' }).compute(
+      'x',
+      bytes(12),
+    ),
+  ).to.throw(/does not take an iv/);
+  // @ts-expect-error unknown algorithm
+  expect(() => createMac('NOPE', 'key')).to.throw(/Unknown MAC algorithm/);
+});
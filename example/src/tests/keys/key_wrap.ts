@@ -0,0 +1,113 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  createCipheriv,
+  createKeyWrap,
+  createSecretKey,
+  randomBytes,
+} from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'keys.keyWrap';
+
+const secret = (hex: string) => createSecretKey(Buffer.from(hex, 'hex'));
+
+// the aes*-wrap ciphers are the reference implementation
+const wrapOne = (kek: Buffer, key: Buffer, padded: boolean): Buffer => {
+  const name = `id-aes${kek.length * 8}-wrap${padded ? '-pad' : ''}`;
+  const iv = padded ? Buffer.from('a65959a6', 'hex') : Buffer.alloc(8, 0xa6);
+  const cipher = createCipheriv(name, kek, iv);
+  return Buffer.concat([cipher.update(key), cipher.final()]);
+};
+
+test(SUITE, 'wrapKeys matches the RFC 3394 test vector', () => {
+  const wrap = createKeyWrap(secret('000102030405060708090a0b0c0d0e0f'));
+  const [wrapped] = wrap.wrapKeys([secret('00112233445566778899aabbccddeeff')]);
+  expect(wrapped!.toString('hex')).to.equal(
+    '1fa68b0a8112b447aef34bd8fb5a7b829d3e862371d2cfe5',
+  );
+});
+
+test(SUITE, 'wrapKeys matches the RFC 5649 test vectors', () => {
+  const wrap = createKeyWrap(
+    secret('5840df6e29b02af1ab493b705bf16ea1ae8338f4dcc176a8'),
+    { padding: true },
+  );
+  const wrapped = wrap.wrapKeys([
+    secret('c37b7e6492584340bed12207808941155068f738'),
+    secret('466f7250617369'),
+  ]);
+  expect(wrapped[0]!.toString('hex')).to.equal(
+    '138bdeaa9b8fa7fc61f97742e72248ee5ae6ae5360d1ae6a5f54f373fa543b6a',
+  );
+  expect(wrapped[1]!.toString('hex')).to.equal(
+    'afbeb0f07dfbf5419200f2ccb50bb24f',
+  );
+});
+
+test(SUITE, 'batches of mixed lengths match the wrap ciphers', () => {
+  for (const padded of [false, true]) {
+    const kek = randomBytes(32);
+    const keys = Array.from({ length: 40 }, (_, i) =>
+      randomBytes(padded ? 1 + ((i * 7) % 50) : 16 + 8 * (i % 4)),
+    );
+    const wrap = createKeyWrap(createSecretKey(kek), {
+      padding: padded,
+      cacheSize: 0,
+    });
+    const wrapped = wrap.wrapKeys(keys.map(key => createSecretKey(key)));
+    const unwrapped = wrap.unwrapKeys(wrapped);
+    keys.forEach((key, i) => {
+      expect(wrapped[i]!.equals(wrapOne(kek, key, padded))).to.equal(true);
+      expect(unwrapped[i]!.export().equals(key)).to.equal(true);
+    });
+  }
+});
+
+test(SUITE, 'unwrapKeys serves repeated envelopes from the cache', async () => {
+  const kek = createSecretKey(randomBytes(32));
+  const deks = Array.from({ length: 8 }, () => randomBytes(32));
+  const wrapped = createKeyWrap(kek, { cacheSize: 0 }).wrapKeys(
+    deks.map(dek => createSecretKey(dek)),
+  );
+
+  const wrap = createKeyWrap(kek, { cacheSize: 4 });
+  const first = await wrap.unwrapKeysAsync(wrapped);
+  expect(wrap.cachedCount).to.equal(4);
+  const again = wrap.unwrapKeys(wrapped.slice(4));
+  deks.forEach((dek, i) => {
+    expect(first[i]!.export().equals(dek)).to.equal(true);
+  });
+  expect(again[0]!.export().equals(deks[4]!)).to.equal(true);
+
+  wrap.clearCache();
+  expect(wrap.cachedCount).to.equal(0);
+});
+
+test(SUITE, 'unwrapKeys rejects tampered envelopes', () => {
+  const kek = createSecretKey(randomBytes(16));
+  const wrap = createKeyWrap(kek, { cacheSize: 0 });
+  const wrapped = wrap.wrapKeys([
+    createSecretKey(randomBytes(32)),
+    createSecretKey(randomBytes(32)),
+    createSecretKey(randomBytes(16)),
+  ]);
+  wrapped[0]![3]! ^= 0x01;
+  wrapped[2]![wrapped[2]!.length - 1]! ^= 0x80;
+  expect(() => wrap.unwrapKeys(wrapped)).to.throw(
+    /Unable to unwrap 2 key\(s\): 0, 2/,
+  );
+});
+
+test(SUITE, 'key wrap validates its inputs', () => {
+  expect(() => createKeyWrap(createSecretKey(randomBytes(20)))).to.throw(
+    /Invalid KEK length/,
+  );
+  const wrap = createKeyWrap(createSecretKey(randomBytes(32)));
+  expect(() => wrap.wrapKeys([createSecretKey(randomBytes(12))])).to.throw(
+    /invalid length of 12 bytes/,
+  );
+  expect(() => wrap.unwrapKeys([randomBytes(20)])).to.throw(
+    /invalid length of 20 bytes/,
+  );
+});
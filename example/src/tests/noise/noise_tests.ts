@@ -0,0 +1,260 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  createNoiseHandshake,
+  generateNoiseKeyPair,
+} from 'react-native-quick-crypto';
+import type { NoiseHandshake } from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'noise';
+
+const XX = 'Noise_XX_25519_ChaChaPoly_SHA256';
+
+const key = (hex: string) => Buffer.from(hex, 'hex');
+const initiatorStatic = key(
+  'e61ef9919cde45dd5f82166404bd08e38bceb5dfdfded0a34c8df7ed542214d1',
+);
+const initiatorEphemeral = key(
+  '893e28b9dc6ca8d611ab664754b8ceb7bac5117349a4439a6b0569da977c464a',
+);
+const responderStatic = key(
+  '4a3acbfdb163dec651dfa3194dece676d437029c62a408b4c5ea9114246e4893',
+);
+const responderEphemeral = key(
+  'bbdb4cdbd309f1a1f2e1456967fe288cadd6f712d65dc7b7793d5e63da6b375b',
+);
+
+// Runs the handshake to completion and returns every message
+function run(initiator: NoiseHandshake, responder: NoiseHandshake): Buffer[] {
+  const messages: Buffer[] = [];
+  while (initiator.action !== 'split') {
+    const [writer, reader] =
+      initiator.action === 'write'
+        ? [initiator, responder]
+        : [responder, initiator];
+    const payload = Buffer.from(`payload ${messages.length}`);
+    const message = writer.writeMessage(payload);
+    expect(reader.readMessage(message).equals(payload)).to.equal(true);
+    messages.push(message);
+  }
+  expect(responder.action).to.equal('split');
+  return messages;
+}
+
+function pair(protocolName: string) {
+  const initiatorKeys = generateNoiseKeyPair();
+  const responderKeys = generateNoiseKeyPair();
+  const initiator = createNoiseHandshake(protocolName, 'initiator', {
+    staticPrivateKey: initiatorKeys.privateKey,
+  });
+  const responder = createNoiseHandshake(protocolName, 'responder', {
+    staticPrivateKey: responderKeys.privateKey,
+  });
+  run(initiator, responder);
+  return { initiator: initiator.split(), responder: responder.split() };
+}
+
+test(SUITE, 'XX with fixed keys matches a reference transcript', () => {
+  const prologue = Buffer.from('John Galt');
+  const initiator = createNoiseHandshake(XX, 'initiator', {
+    prologue,
+    staticPrivateKey: initiatorStatic,
+    ephemeralPrivateKey: initiatorEphemeral,
+  });
+  const responder = createNoiseHandshake(XX, 'responder', {
+    prologue,
+    staticPrivateKey: responderStatic,
+    ephemeralPrivateKey: responderEphemeral,
+  });
+  const first = initiator.writeMessage(key('4c756477696720766f6e204d69736573'));
+  expect(first.toString('hex')).to.equal(
+    'ca35def5ae56cec33dc2036731ab14896bc4c75dbb07a61f879f8e3afa4c7944' +
+      '4c756477696720766f6e204d69736573',
+  );
+  responder.readMessage(first);
+  initiator.readMessage(
+    responder.writeMessage(key('4d757272617920526f746862617264')),
+  );
+  const third = initiator.writeMessage(key('462e20412e20486179656b'));
+  expect(third.toString('hex')).to.equal(
+    'c7195ffacac1307ff99046f219750fc47693e23c3cb08b89c2af808b444850a8' +
+      '0ae475b9df0f169ae80a89be0865b57f58c9fea0d4ec82a286427402f113e4b6' +
+      'ae769a1d95941d49b25030',
+  );
+  responder.readMessage(third);
+  expect(initiator.handshakeHash.toString('hex')).to.equal(
+    'c8e5f64e846193be2a834104c2a009868d6c9f3bd3c186299888b488b2f1f58e',
+  );
+  expect(responder.handshakeHash.equals(initiator.handshakeHash)).to.equal(
+    true,
+  );
+  expect(responder.remoteStaticPublicKey!.length).to.equal(32);
+
+  const transport = initiator.split();
+  expect(
+    transport.encrypt(key('4b61726c2050656172736f6e')).toString('hex'),
+  ).to.equal('3f44e25d622842bf4271392186790ebafa43ac8f95f63ffd7ac7b8ba');
+  expect(initiator.action).to.equal('done');
+});
+
+test(SUITE, 'IK and the other suites complete and interoperate', () => {
+  for (const name of [
+    'Noise_IK_25519_ChaChaPoly_BLAKE2s',
+    'Noise_XX_25519_AESGCM_SHA512',
+    'Noise_KK_448_ChaChaPoly_BLAKE2b',
+    'Noise_NN_25519_AESGCM_SHA256',
+  ]) {
+    const dh = name.includes('_448_') ? '448' : '25519';
+    const initiatorKeys = generateNoiseKeyPair(dh);
+    const responderKeys = generateNoiseKeyPair(dh);
+    const usesStatic = !name.startsWith('Noise_NN');
+    // XX learns the responder's static key during the handshake
+    const knowsResponder = /_(IK|KK)_/.test(name);
+    const initiator = createNoiseHandshake(name, 'initiator', {
+      staticPrivateKey: usesStatic ? initiatorKeys.privateKey : undefined,
+      remoteStaticPublicKey: knowsResponder ? responderKeys.publicKey : undefined,
+    });
+    const responder = createNoiseHandshake(name, 'responder', {
+      staticPrivateKey: usesStatic ? responderKeys.privateKey : undefined,
+      remoteStaticPublicKey: name.includes('_KK_')
+        ? initiatorKeys.publicKey
+        : undefined,
+    });
+    run(initiator, responder);
+    if (usesStatic) {
+      const remote = responder.remoteStaticPublicKey!;
+      expect(remote.equals(initiatorKeys.publicKey)).to.equal(true);
+    }
+    const a = initiator.split();
+    const b = responder.split();
+    const message = Buffer.from('hello');
+    expect(b.decrypt(a.encrypt(message)).equals(message)).to.equal(true);
+    expect(a.decrypt(b.encrypt(message)).equals(message)).to.equal(true);
+  }
+});
+
+test(SUITE, 'transport batches share the nonce sequence', async () => {
+  const { initiator, responder } = pair('Noise_XX_25519_ChaChaPoly_BLAKE2s');
+  const messages = Array.from({ length: 50 }, (_, i) =>
+    Buffer.from(`message ${i}`),
+  );
+  const single = messages.slice(0, 10).map(m => initiator.encrypt(m));
+  const batch = initiator.encryptMany(messages.slice(10, 30));
+  const batchAsync = await initiator.encryptManyAsync(messages.slice(30));
+
+  const opened = [
+    ...responder.decryptMany(single),
+    ...batch.map(c => responder.decrypt(c)),
+    ...(await responder.decryptManyAsync(batchAsync)),
+  ];
+  opened.forEach((plaintext, i) => {
+    expect(plaintext.equals(messages[i]!)).to.equal(true);
+  });
+});
+
+test(SUITE, 'transport authenticates and rekeys', () => {
+  const { initiator, responder } = pair('Noise_XX_25519_ChaChaPoly_SHA256');
+  const ad = Buffer.from('header');
+  const sealed = initiator.encrypt('secret', ad);
+  expect(() => responder.decrypt(sealed)).to.throw(/Decryption failed/);
+  // a failed decrypt does not use up the nonce
+  expect(responder.decrypt(sealed, ad).toString()).to.equal('secret');
+
+  const tampered = initiator.encrypt('secret');
+  tampered[0] ^= 1;
+  expect(() => responder.decrypt(tampered)).to.throw(/Decryption failed/);
+
+  responder.rekeySend();
+  const afterRekey = responder.encrypt('rekeyed');
+  expect(() => initiator.decrypt(afterRekey)).to.throw(/Decryption failed/);
+  initiator.rekeyReceive();
+  expect(initiator.decrypt(afterRekey).toString()).to.equal('rekeyed');
+
+  expect(() => initiator.encrypt(Buffer.alloc(65520))).to.throw(/65519/);
+});
+
+test(SUITE, 'a failed batch does not use up the nonces', async () => {
+  const { initiator, responder } = pair('Noise_XX_25519_ChaChaPoly_SHA256');
+  const sealed = initiator.encryptMany(['a', 'b', 'c', 'd']);
+  const forged = sealed.map(c => Buffer.from(c));
+  forged[1]![0] ^= 1;
+
+  expect(() => responder.decryptMany(forged)).to.throw(/for message 1/);
+  let error: Error | undefined;
+  await responder.decryptManyAsync(forged.slice(1)).catch(e => {
+    error = e;
+  });
+  expect(error?.message).to.match(/for message 0/);
+
+  const opened = [
+    ...responder.decryptMany(sealed.slice(0, 2)),
+    ...(await responder.decryptManyAsync(sealed.slice(2))),
+  ];
+  expect(Buffer.concat(opened).toString()).to.equal('abcd');
+});
+
+test(SUITE, 'an oversized payload leaves the handshake usable', () => {
+  const initiator = createNoiseHandshake(XX, 'initiator', {
+    staticPrivateKey: initiatorStatic,
+  });
+  expect(() => initiator.writeMessage(Buffer.alloc(65535 - 31))).to.throw(
+    /65535 bytes/,
+  );
+  expect(initiator.action).to.equal('write');
+  expect(initiator.writeMessage(Buffer.alloc(65535 - 32)).length).to.equal(
+    65535,
+  );
+});
+
+test(SUITE, 'one-way patterns only send from the initiator', () => {
+  const responderKeys = generateNoiseKeyPair();
+  const initiator = createNoiseHandshake(
+    'Noise_N_25519_ChaChaPoly_SHA256',
+    'initiator',
+    { remoteStaticPublicKey: responderKeys.publicKey },
+  );
+  const responder = createNoiseHandshake(
+    'Noise_N_25519_ChaChaPoly_SHA256',
+    'responder',
+    { staticPrivateKey: responderKeys.privateKey },
+  );
+  run(initiator, responder);
+  const sender = initiator.split();
+  const receiver = responder.split();
+  expect(receiver.decrypt(sender.encrypt('one way')).toString()).to.equal(
+    'one way',
+  );
+  expect(() => receiver.encrypt('back')).to.throw(/one-way/);
+  expect(() => sender.decrypt(Buffer.alloc(16))).to.throw(/one-way/);
+});
+
+test(SUITE, 'handshake validates keys and message order', () => {
+  expect(() =>
+    createNoiseHandshake('Noise_XX_25519_ChaChaPoly_SHA256', 'initiator'),
+  ).to.throw(/needs a static private key/);
+  expect(() =>
+    createNoiseHandshake('Noise_IK_25519_ChaChaPoly_SHA256', 'initiator', {
+      staticPrivateKey: initiatorStatic,
+    }),
+  ).to.throw(/needs the remote static public key/);
+  expect(() =>
+    createNoiseHandshake('Noise_XXpsk3_25519_ChaChaPoly_SHA256', 'initiator'),
+  ).to.throw(/Noise/);
+
+  const initiator = createNoiseHandshake(XX, 'initiator', {
+    staticPrivateKey: initiatorStatic,
+  });
+  const responder = createNoiseHandshake(XX, 'responder', {
+    staticPrivateKey: responderStatic,
+  });
+  expect(() => responder.writeMessage()).to.throw(/next action is read/);
+  expect(() => initiator.split()).to.throw(/next action is write/);
+  const first = initiator.writeMessage();
+  responder.readMessage(first);
+  const second = responder.writeMessage();
+  second[40] ^= 1;
+  expect(() => initiator.readMessage(second)).to.throw(/Noise/);
+  expect(initiator.action).to.equal('done');
+  expect(() => initiator.writeMessage()).to.throw(/handshake failed/);
+});
@@ -0,0 +1,136 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import {
+  createOprfClient,
+  createOprfServer,
+  deriveOprfKeyPair,
+  generateOprfKeyPair,
+  hashToCurve,
+} from 'react-native-quick-crypto';
+import type { OprfSuite } from 'react-native-quick-crypto';
+import { expect } from 'chai';
+import { test } from '../util';
+
+const SUITE = 'oprf';
+
+const suites: OprfSuite[] = ['P256-SHA256', 'P384-SHA384', 'P521-SHA512'];
+
+const contacts = (count: number): string[] =>
+  Array.from({ length: count }, (_, i) => `+1555${1000000 + i}`);
+
+test(SUITE, 'hashToCurve matches the RFC 9380 P256 vectors', () => {
+  const [empty, abc] = hashToCurve(
+    'P256-SHA256',
+    ['', 'abc'],
+    'QUUX-V01-CS02-with-P256_XMD:SHA-256_SSWU_RO_',
+  );
+  expect(empty!.toString('hex')).to.equal(
+    '032c15230b26dbc6fc9a37051158c95b79656e17a1a920b11394ca91c44247d3e4',
+  );
+  expect(abc!.subarray(1).toString('hex')).to.equal(
+    '0bb8b87485551aa43ed54f009230450b492fead5f1cc91658775dac4a3388a0f',
+  );
+});
+
+test(SUITE, 'OPRF matches the RFC 9497 P256-SHA256 vector', () => {
+  const { privateKey } = deriveOprfKeyPair(
+    'P256-SHA256',
+    Buffer.alloc(32, 0xa3),
+    'test key',
+  );
+  expect(privateKey.toString('hex')).to.equal(
+    '159749d750713afe245d2d39ccfaae8381c53ce92d098a9375ee70739c7ac0bf',
+  );
+  // the output does not depend on the blind
+  const input = Buffer.from([0x00]);
+  const client = createOprfClient('P256-SHA256');
+  const blinded = client.blind([input]);
+  const evaluation = createOprfServer('P256-SHA256', privateKey).blindEvaluate(
+    blinded.blindedElements,
+  );
+  const [output] = client.finalize([input], blinded, evaluation);
+  expect(output!.toString('hex')).to.equal(
+    'a0b34de5fa4c5b6da07e72af73cc507cceeb48981b97b7285fc375345fe495dd',
+  );
+});
+
+test(SUITE, 'VOPRF batches verify and agree across clients', async () => {
+  for (const suite of suites) {
+    const { privateKey, publicKey } = generateOprfKeyPair(suite, {
+      verifiable: true,
+    });
+    const server = createOprfServer(suite, privateKey, { verifiable: true });
+    const inputs = contacts(20);
+
+    const first = createOprfClient(suite, { publicKey });
+    const blinded = first.blind(inputs);
+    const outputs = first.finalize(
+      inputs,
+      blinded,
+      server.blindEvaluate(blinded.blindedElements),
+    );
+
+    const second = createOprfClient(suite, { publicKey });
+    const reversed = [...inputs].reverse();
+    const blindedAsync = await second.blindAsync(reversed);
+    const outputsAsync = await second.finalizeAsync(
+      reversed,
+      blindedAsync,
+      server.blindEvaluate(blindedAsync.blindedElements),
+    );
+    outputs.forEach((output, i) => {
+      expect(output.equals(outputsAsync[inputs.length - 1 - i]!)).to.equal(
+        true,
+      );
+    });
+  }
+});
+
+test(SUITE, 'VOPRF rejects evaluations under another key', () => {
+  const suite = 'P256-SHA256';
+  const honest = generateOprfKeyPair(suite, { verifiable: true });
+  const other = generateOprfKeyPair(suite, { verifiable: true });
+  const inputs = contacts(5);
+  const client = createOprfClient(suite, { publicKey: honest.publicKey });
+  const blinded = client.blind(inputs);
+
+  const evaluation = createOprfServer(suite, other.privateKey, {
+    verifiable: true,
+  }).blindEvaluate(blinded.blindedElements);
+  expect(() => client.finalize(inputs, blinded, evaluation)).to.throw(
+    /Proof verification failed/,
+  );
+
+  const swapped = createOprfServer(suite, honest.privateKey, {
+    verifiable: true,
+  }).blindEvaluate(blinded.blindedElements);
+  [swapped.evaluatedElements[0], swapped.evaluatedElements[1]] = [
+    swapped.evaluatedElements[1]!,
+    swapped.evaluatedElements[0]!,
+  ];
+  expect(() => client.finalize(inputs, blinded, swapped)).to.throw(
+    /Proof verification failed/,
+  );
+  expect(() =>
+    client.finalize(inputs, blinded, {
+      evaluatedElements: swapped.evaluatedElements,
+    }),
+  ).to.throw(/missing its proof/);
+});
+
+test(SUITE, 'OPRF validates its inputs', () => {
+  expect(() => createOprfClient('ristretto255-SHA512' as OprfSuite)).to.throw(
+    /Unsupported OPRF suite/,
+  );
+  const client = createOprfClient('P256-SHA256');
+  const blinded = client.blind(['a', 'b']);
+  expect(() =>
+    client.finalize(['a', 'b'], blinded, {
+      evaluatedElements: [blinded.blindedElements[0]!, Buffer.alloc(33, 4)],
+    }),
+  ).to.throw(/invalid evaluated element 1/);
+  expect(() =>
+    client.finalize(['a', 'b'], blinded, {
+      evaluatedElements: [blinded.blindedElements[0]!],
+    }),
+  ).to.throw(/expected one/);
+});
@@ -152,6 +152,21 @@ test(SUITE, 'randomFillSync - deepStringEqual - Uint8Array', () => {
   expect(before.slice(0, 5)).to.equal(after.slice(0, 5));
 });
 
+test(SUITE, 'randomFillSync - fills only the window of a subarray', () => {
+  const backing = new Uint8Array(32);
+  const view = backing.subarray(8, 24);
+  crypto.randomFillSync(view, 4, 8);
+  expect(Buffer.from(backing.subarray(0, 12)).toString('hex')).to.equal(
+    '00'.repeat(12),
+  );
+  expect(Buffer.from(backing.subarray(20)).toString('hex')).to.equal(
+    '00'.repeat(12),
+  );
+  expect(Buffer.from(view.subarray(4, 12)).toString('hex')).not.to.equal(
+    '00'.repeat(8),
+  );
+});
+
 test(SUITE, 'randomFillSync - deepStringEqual - Buffer no size', () => {
   const buf = Buffer.alloc(10);
   const before = buf.toString('hex');
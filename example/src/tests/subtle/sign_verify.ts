@@ -869,6 +869,51 @@ test(SUITE, 'ed25519 - sign/verify - round trip sad', async () => {
   expect(verified).to.equal(false);
 });
 
+test(
+  SUITE,
+  'ed25519 - sign/verify - concurrent jobs on one instance run in order',
+  async () => {
+    const ed = new Ed('ed25519', {});
+    // not awaited: sign() must queue behind generateKeyPair() natively
+    const generated = ed.generateKeyPair();
+    const signatures = await Promise.all(
+      Array.from({ length: 16 }, () => ed.sign(data1.buffer)),
+    );
+    await generated;
+    const results = await Promise.all(
+      signatures.map(signature => ed.verify(signature, data1.buffer)),
+    );
+    expect(results.every(verified => verified)).to.equal(true);
+  },
+);
+
+test(
+  SUITE,
+  'ed25519 - sign/verify - explicit-key jobs on one instance run in parallel',
+  async () => {
+    const keys = Array.from({ length: 8 }, () => {
+      const ed = new Ed('ed25519', {});
+      ed.generateKeyPairSync();
+      return { pub: ed.getPublicKey(), priv: ed.getPrivateKey() };
+    });
+    // one keyless instance, as WebCrypto and diffieHellman share per curve
+    const shared = new Ed('ed25519', {});
+    const signatures = await Promise.all(
+      keys.map(({ priv }) => shared.sign(data1.buffer, priv)),
+    );
+    const results = await Promise.all(
+      signatures.map((signature, i) =>
+        shared.verify(signature, data1.buffer, keys[i]!.pub),
+      ),
+    );
+    expect(results.every(verified => verified)).to.equal(true);
+    // each signature belongs to its own key
+    expect(
+      await shared.verify(signatures[0]!, data1.buffer, keys[1]!.pub),
+    ).to.equal(false);
+  },
+);
+
 test(
   SUITE,
   'ed25519 - sign/verify - bad signature does not verify',
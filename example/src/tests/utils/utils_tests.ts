@@ -182,3 +182,54 @@ test(SUITE, 'timingSafeEqual should work for HMAC comparison use case', () => {
   expect(crypto.timingSafeEqual(hmac1, hmac2)).to.equal(true);
   expect(crypto.timingSafeEqual(hmac1, hmac3)).to.equal(false);
 });
+
+// --- prewarm Tests ---
+
+test(SUITE, 'prewarm resolves and is idempotent', async () => {
+  const first = crypto.prewarm();
+  expect(crypto.prewarm()).to.equal(first);
+  await first;
+  await crypto.prewarm();
+  const digest = crypto.createHash('sha256').update('abc').digest('hex');
+  expect(digest).to.equal(
+    'ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad',
+  );
+});
+
+// --- Capability Tests ---
+
+test(
+  SUITE,
+  'getCryptoCapabilities reports cpu, openssl and implementations',
+  () => {
+    const caps = crypto.getCryptoCapabilities();
+    for (const value of Object.values(caps.cpu)) {
+      expect(value).to.be.a('boolean');
+    }
+    expect(caps.openssl.version).to.match(/^OpenSSL \d+\.\d+/);
+    expect(caps.implementations.aes).to.be.a('string');
+    if (caps.cpu.aes) {
+      expect(caps.implementations.aes).to.equal('hardware');
+    }
+  },
+);
+
+test(SUITE, 'preferredAead picks a usable AEAD and caches it', async () => {
+  const first = await crypto.preferredAead();
+  expect(['aes-256-gcm', 'chacha20-poly1305']).to.include(first);
+  expect(await crypto.preferredAead()).to.equal(first);
+
+  const key = crypto.randomBytes(32);
+  const iv = crypto.randomBytes(12);
+  const cipher = crypto.createCipheriv(first, key, iv, { authTagLength: 16 });
+  const encrypted = Buffer.concat([cipher.update('hello'), cipher.final()]);
+  const decipher = crypto.createDecipheriv(first, key, iv, {
+    authTagLength: 16,
+  });
+  decipher.setAuthTag(cipher.getAuthTag());
+  const decrypted = Buffer.concat([
+    decipher.update(encrypted),
+    decipher.final(),
+  ]);
+  expect(decrypted.toString()).to.equal('hello');
+});
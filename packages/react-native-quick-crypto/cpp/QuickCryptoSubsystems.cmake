@@ -0,0 +1,107 @@
+# Optional subsystems that can be left out of the native library at build time.
+# Shared by android/CMakeLists.txt and host/CMakeLists.txt; the podspec keeps
+# the same table in Ruby.
+#
+#   -DQUICKCRYPTO_DISABLED_SUBSYSTEMS="blake3,mldsa"
+#
+# A disabled subsystem's sources are not compiled and its HybridObjects are not
+# registered (RNQC_DISABLE_<NAME> guards the nitrogen autolinking; the guards
+# come from scripts/guard-subsystems.js, which `bun specs` runs). Creating
+# one from JS then fails with Nitro's "no HybridObject registered" error.
+# Hash, HMAC, Cipher (all symmetric modes), Random and Utils are always built.
+#
+# Expects RNQC_ROOT to point at the package root. Sets:
+#   QUICKCRYPTO_SUBSYSTEM_SOURCES   sources of every enabled optional subsystem
+#   QUICKCRYPTO_DISABLED_SOURCES    sources of every disabled one
+#   QUICKCRYPTO_SUBSYSTEM_DEFINITIONS  RNQC_DISABLE_<NAME> for each disabled one
+# and quickcrypto_subsystem_enabled(<name> <out-var>).
+
+set(QUICKCRYPTO_DISABLED_SUBSYSTEMS "" CACHE STRING "Comma-separated optional subsystems to leave out")
+
+# blake3's own sources are architecture-specific and added by the caller
+set(QUICKCRYPTO_SUBSYSTEM_blake3 cpp/blake3/HybridBlake3.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_compress cpp/compress/HybridCompressCipher.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_dh cpp/dh/HybridDiffieHellman.cpp cpp/dh/HybridECDH.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_ec cpp/ec/HybridEcKeyPair.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_ed25519 cpp/ed25519/HybridEdKeyPair.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_hkdf cpp/hkdf/HybridHkdf.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_keys
+  cpp/keys/HybridKeyObjectHandle.cpp
+  cpp/keys/HybridKeyWrap.cpp
+  cpp/keys/KeyObjectData.cpp
+  cpp/sign/HybridSignHandle.cpp
+  cpp/sign/HybridVerifyHandle.cpp
+  deps/ncrypto/src/ncrypto.cpp
+)
+set(QUICKCRYPTO_SUBSYSTEM_mldsa cpp/mldsa/HybridMlDsaKeyPair.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_noise cpp/noise/HybridNoiseHandshake.cpp cpp/noise/HybridNoiseTransport.cpp cpp/noise/NoiseState.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_oprf cpp/oprf/HybridOprf.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_pagecipher cpp/cipher/HybridPageCipher.cpp cpp/cipher/HybridKeyRotation.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_pbkdf2
+  cpp/pbkdf2/HybridPbkdf2.cpp
+  cpp/pbkdf2/Pbkdf2Kernels.cpp
+  deps/fastpbkdf2/fastpbkdf2.c
+  deps/fastpbkdf2/fastpbkdf2_hw.c
+  deps/fastpbkdf2/fastpbkdf2_hw_sha512.c
+)
+set(QUICKCRYPTO_SUBSYSTEM_rsa cpp/rsa/HybridRsaKeyPair.cpp cpp/cipher/HybridRsaCipher.cpp)
+set(QUICKCRYPTO_SUBSYSTEM_scrypt cpp/scrypt/HybridScrypt.cpp)
+
+set(QUICKCRYPTO_SUBSYSTEMS blake3 compress dh ec ed25519 hkdf keys mldsa noise oprf pagecipher pbkdf2 rsa scrypt)
+
+# Key pair generators hand back KeyObjects, which live in `keys`
+set(QUICKCRYPTO_SUBSYSTEM_REQUIRES_keys ec ed25519 mldsa rsa)
+
+string(REPLACE "," ";" _rnqc_disabled "${QUICKCRYPTO_DISABLED_SUBSYSTEMS}")
+string(REPLACE " " "" _rnqc_disabled "${_rnqc_disabled}")
+foreach(_rnqc_name IN LISTS _rnqc_disabled)
+  if(NOT _rnqc_name IN_LIST QUICKCRYPTO_SUBSYSTEMS)
+    message(FATAL_ERROR "[QuickCrypto] Unknown subsystem '${_rnqc_name}', expected one of: ${QUICKCRYPTO_SUBSYSTEMS}")
+  endif()
+endforeach()
+if("keys" IN_LIST _rnqc_disabled)
+  foreach(_rnqc_name IN LISTS QUICKCRYPTO_SUBSYSTEM_REQUIRES_keys)
+    if(NOT _rnqc_name IN_LIST _rnqc_disabled)
+      message(FATAL_ERROR "[QuickCrypto] '${_rnqc_name}' needs 'keys'; disable it as well")
+    endif()
+  endforeach()
+endif()
+
+set(QUICKCRYPTO_SUBSYSTEM_SOURCES "")
+set(QUICKCRYPTO_DISABLED_SOURCES "")
+set(QUICKCRYPTO_SUBSYSTEM_DEFINITIONS "")
+foreach(_rnqc_name IN LISTS QUICKCRYPTO_SUBSYSTEMS)
+  set(_rnqc_sources "")
+  foreach(_rnqc_source IN LISTS QUICKCRYPTO_SUBSYSTEM_${_rnqc_name})
+    list(APPEND _rnqc_sources ${RNQC_ROOT}/${_rnqc_source})
+  endforeach()
+  if(_rnqc_name IN_LIST _rnqc_disabled)
+    string(TOUPPER ${_rnqc_name} _rnqc_upper)
+    list(APPEND QUICKCRYPTO_DISABLED_SOURCES ${_rnqc_sources})
+    list(APPEND QUICKCRYPTO_SUBSYSTEM_DEFINITIONS RNQC_DISABLE_${_rnqc_upper})
+  else()
+    list(APPEND QUICKCRYPTO_SUBSYSTEM_SOURCES ${_rnqc_sources})
+  endif()
+endforeach()
+
+# Regenerating the autolinking without scripts/guard-subsystems.js drops the
+# guards, and the disabled HybridObjects would then fail to link
+file(READ ${RNQC_ROOT}/nitrogen/generated/android/QuickCryptoOnLoad.cpp _rnqc_onload)
+foreach(_rnqc_definition IN LISTS QUICKCRYPTO_SUBSYSTEM_DEFINITIONS)
+  string(FIND "${_rnqc_onload}" "#ifndef ${_rnqc_definition}" _rnqc_found)
+  if(_rnqc_found EQUAL -1)
+    message(FATAL_ERROR "[QuickCrypto] The nitrogen autolinking has no ${_rnqc_definition} guard; run scripts/guard-subsystems.js")
+  endif()
+endforeach()
+
+if(_rnqc_disabled)
+  message(STATUS "[QuickCrypto] Disabled subsystems: ${_rnqc_disabled}")
+endif()
+
+function(quickcrypto_subsystem_enabled name out)
+  if(name IN_LIST _rnqc_disabled)
+    set(${out} OFF PARENT_SCOPE)
+  else()
+    set(${out} ON PARENT_SCOPE)
+  endif()
+endfunction()
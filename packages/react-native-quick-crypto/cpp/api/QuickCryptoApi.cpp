@@ -0,0 +1,609 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <openssl/crypto.h>
+#include <openssl/core_names.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/pem.h>
+#include <openssl/provider.h>
+#include <openssl/rand.h>
+#include <openssl/x509.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "LibraryContext.hpp"
+#include "QuickCryptoApi.hpp"
+#include "Utils.hpp"
+#ifndef RNQC_DISABLE_PBKDF2
+#include "Pbkdf2Kernels.hpp"
+#include "fastpbkdf2.h"
+#endif
+
+namespace margelo::nitro::crypto::api {
+
+namespace {
+
+  int toInt(size_t size, const char* what) {
+    if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      throw std::runtime_error(std::string(what) + " is too large");
+    }
+    return static_cast<int>(size);
+  }
+
+  std::shared_ptr<EVP_PKEY> wrapKey(EVP_PKEY* pkey, const char* error) {
+    if (pkey == nullptr) {
+      throw std::runtime_error(std::string(error) + ": " + getOpenSSLError());
+    }
+    return std::shared_ptr<EVP_PKEY>(pkey, EVP_PKEY_free);
+  }
+
+  std::vector<uint8_t> bioToVector(BIO* bio) {
+    BUF_MEM* mem = nullptr;
+    BIO_get_mem_ptr(bio, &mem);
+    std::vector<uint8_t> out(mem->data, mem->data + mem->length);
+    BIO_free(bio);
+    return out;
+  }
+
+  using CipherPtr = std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)>;
+
+  CipherPtr aeadCipher(Aead aead) {
+    const char* name = nullptr;
+    switch (aead) {
+      case Aead::Aes128Gcm:
+        name = "AES-128-GCM";
+        break;
+      case Aead::Aes192Gcm:
+        name = "AES-192-GCM";
+        break;
+      case Aead::Aes256Gcm:
+        name = "AES-256-GCM";
+        break;
+      case Aead::ChaCha20Poly1305:
+        name = "ChaCha20-Poly1305";
+        break;
+    }
+    if (name == nullptr) {
+      throw std::runtime_error("Unknown AEAD");
+    }
+    CipherPtr cipher(fetchCipher(name), EVP_CIPHER_free);
+    if (!cipher) {
+      throw std::runtime_error(std::string("Failed to fetch ") + name + ": " + getOpenSSLError());
+    }
+    return cipher;
+  }
+
+  using CipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+  CipherCtxPtr aeadInit(Aead aead, ByteSpan key, ByteSpan iv, ByteSpan aad, bool encrypt) {
+    CipherPtr cipher = aeadCipher(aead);
+    if (key.size() != static_cast<size_t>(EVP_CIPHER_get_key_length(cipher.get()))) {
+      throw std::runtime_error("Invalid key length for " + std::string(EVP_CIPHER_get0_name(cipher.get())));
+    }
+    if (iv.empty() || (aead == Aead::ChaCha20Poly1305 && iv.size() != 12)) {
+      throw std::runtime_error("Invalid IV length for " + std::string(EVP_CIPHER_get0_name(cipher.get())));
+    }
+
+    CipherCtxPtr ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+    if (!ctx || EVP_CipherInit_ex(ctx.get(), cipher.get(), nullptr, nullptr, nullptr, encrypt ? 1 : 0) != 1) {
+      throw std::runtime_error("Failed to initialize AEAD: " + getOpenSSLError());
+    }
+    if (EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_IVLEN, toInt(iv.size(), "IV"), nullptr) != 1 ||
+        EVP_CipherInit_ex(ctx.get(), nullptr, nullptr, key.data(), iv.data(), encrypt ? 1 : 0) != 1) {
+      throw std::runtime_error("Failed to set AEAD key/IV: " + getOpenSSLError());
+    }
+    if (!aad.empty()) {
+      int outl = 0;
+      if (EVP_CipherUpdate(ctx.get(), nullptr, &outl, aad.data(), toInt(aad.size(), "AAD")) != 1) {
+        throw std::runtime_error("Failed to set AAD: " + getOpenSSLError());
+      }
+    }
+    return ctx;
+  }
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Initialization
+
+void prewarm() {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    // Error strings, config and CPU capability probing (OPENSSL_cpuid_setup)
+    if (OPENSSL_init_crypto(OPENSSL_INIT_LOAD_CRYPTO_STRINGS | OPENSSL_INIT_LOAD_CONFIG, nullptr) != 1) {
+      throw std::runtime_error("Failed to initialize OpenSSL: " + getOpenSSLError());
+    }
+    // Kept loaded for the process lifetime; retain_fallbacks so an app's own
+    // provider config still behaves as if nothing had been loaded explicitly
+    if (OSSL_PROVIDER_try_load(nullptr, "default", 1) == nullptr) {
+      throw std::runtime_error("Failed to load the default provider: " + getOpenSSLError());
+    }
+    // Instantiates and seeds the public and private DRBGs
+    uint8_t seed;
+    if (RAND_bytes(&seed, 1) != 1) {
+      throw std::runtime_error("Failed to seed the random generator: " + getOpenSSLError());
+    }
+    // The module's own library context, then its method store: fetched
+    // methods stay there, so other threads' first fetch by name is a lookup.
+    // This thread's fetch cache is warm too; unknown names are skipped
+    libraryContext();
+    for (const char* name : {"SHA1", "SHA256", "SHA384", "SHA512"}) {
+      EVP_MD_free(fetchDigest(name));
+    }
+    for (const char* name : {"AES-128-GCM", "AES-256-GCM", "AES-256-CBC", "AES-256-CTR", "ChaCha20-Poly1305"}) {
+      EVP_CIPHER_free(fetchCipher(name));
+    }
+    EVP_MAC_free(fetchMac("HMAC"));
+    for (const char* name : {"HKDF", "PBKDF2", "SCRYPT"}) {
+      EVP_KDF_free(fetchKdf(name));
+    }
+    ERR_clear_error();
+  });
+}
+
+// -----------------------------------------------------------------------------
+// Random
+
+void randomBytes(MutableByteSpan out) {
+  if (out.empty()) {
+    return;
+  }
+  if (RAND_bytes(out.data(), toInt(out.size(), "Random output")) != 1) {
+    throw std::runtime_error("Failed to generate random bytes: " + getOpenSSLError());
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Hash
+
+struct Hash::Impl {
+  EVP_MD* md = nullptr;
+  EVP_MD_CTX* ctx = nullptr;
+  size_t output_length = 0;
+  bool xof = false;
+
+  ~Impl() {
+    EVP_MD_CTX_free(ctx);
+    EVP_MD_free(md);
+  }
+};
+
+Hash::Hash(const std::string& algorithm, size_t outputLength) : impl_(std::make_unique<Impl>()) {
+  impl_->md = fetchDigest(algorithm);
+  if (impl_->md == nullptr) {
+    throw std::runtime_error("Invalid Hash Algorithm: " + algorithm);
+  }
+  impl_->ctx = EVP_MD_CTX_new();
+  if (impl_->ctx == nullptr || EVP_DigestInit_ex(impl_->ctx, impl_->md, nullptr) != 1) {
+    throw std::runtime_error("Failed to initialize hash: " + getOpenSSLError());
+  }
+  impl_->xof = (EVP_MD_get_flags(impl_->md) & EVP_MD_FLAG_XOF) != 0;
+  impl_->output_length = impl_->xof && outputLength > 0 ? outputLength : static_cast<size_t>(EVP_MD_get_size(impl_->md));
+}
+
+Hash::~Hash() = default;
+Hash::Hash(Hash&&) noexcept = default;
+Hash& Hash::operator=(Hash&&) noexcept = default;
+
+size_t Hash::digestSize() const {
+  return impl_->output_length;
+}
+
+void Hash::update(ByteSpan data) {
+  if (EVP_DigestUpdate(impl_->ctx, data.data(), data.size()) != 1) {
+    throw std::runtime_error("Failed to update hash: " + getOpenSSLError());
+  }
+}
+
+size_t Hash::final(MutableByteSpan out) {
+  if (out.size() < impl_->output_length) {
+    throw std::runtime_error("Hash output buffer too small");
+  }
+  int ret;
+  if (impl_->xof) {
+    ret = EVP_DigestFinalXOF(impl_->ctx, out.data(), impl_->output_length);
+  } else {
+    unsigned int len = 0;
+    ret = EVP_DigestFinal_ex(impl_->ctx, out.data(), &len);
+  }
+  if (ret != 1) {
+    throw std::runtime_error("Failed to finalize hash: " + getOpenSSLError());
+  }
+  return impl_->output_length;
+}
+
+std::vector<uint8_t> Hash::final() {
+  std::vector<uint8_t> out(impl_->output_length);
+  final(out);
+  return out;
+}
+
+std::vector<uint8_t> Hash::digest(const std::string& algorithm, ByteSpan data) {
+  Hash hash(algorithm);
+  hash.update(data);
+  return hash.final();
+}
+
+// -----------------------------------------------------------------------------
+// HMAC
+
+struct Hmac::Impl {
+  EVP_MAC_CTX* ctx = nullptr;
+  size_t size = 0;
+
+  ~Impl() {
+    EVP_MAC_CTX_free(ctx);
+  }
+};
+
+Hmac::Hmac(const std::string& algorithm, ByteSpan key) : impl_(std::make_unique<Impl>()) {
+  EVP_MAC* mac = fetchMac("HMAC");
+  if (mac == nullptr) {
+    throw std::runtime_error("Failed to fetch HMAC: " + getOpenSSLError());
+  }
+  impl_->ctx = EVP_MAC_CTX_new(mac);
+  EVP_MAC_free(mac);
+  if (impl_->ctx == nullptr) {
+    throw std::runtime_error("Failed to create HMAC context: " + getOpenSSLError());
+  }
+
+  // Zero-length keys are valid for HMAC but OpenSSL wants a non-null pointer
+  static const uint8_t kEmptyKey = 0;
+  OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>(algorithm.c_str()), 0),
+      OSSL_PARAM_construct_end(),
+  };
+  if (EVP_MAC_init(impl_->ctx, key.empty() ? &kEmptyKey : key.data(), key.size(), params) != 1) {
+    throw std::runtime_error("Invalid HMAC digest or key: " + algorithm);
+  }
+  impl_->size = EVP_MAC_CTX_get_mac_size(impl_->ctx);
+}
+
+Hmac::~Hmac() = default;
+Hmac::Hmac(Hmac&&) noexcept = default;
+Hmac& Hmac::operator=(Hmac&&) noexcept = default;
+
+size_t Hmac::digestSize() const {
+  return impl_->size;
+}
+
+void Hmac::update(ByteSpan data) {
+  if (EVP_MAC_update(impl_->ctx, data.data(), data.size()) != 1) {
+    throw std::runtime_error("Failed to update HMAC: " + getOpenSSLError());
+  }
+}
+
+size_t Hmac::final(MutableByteSpan out) {
+  size_t len = 0;
+  if (EVP_MAC_final(impl_->ctx, out.data(), &len, out.size()) != 1) {
+    throw std::runtime_error("Failed to finalize HMAC: " + getOpenSSLError());
+  }
+  return len;
+}
+
+std::vector<uint8_t> Hmac::final() {
+  std::vector<uint8_t> out(impl_->size);
+  out.resize(final(MutableByteSpan(out)));
+  return out;
+}
+
+std::vector<uint8_t> Hmac::digest(const std::string& algorithm, ByteSpan key, ByteSpan data) {
+  Hmac hmac(algorithm, key);
+  hmac.update(data);
+  return hmac.final();
+}
+
+// -----------------------------------------------------------------------------
+// AEAD
+
+size_t aeadKeyLength(Aead aead) {
+  return static_cast<size_t>(EVP_CIPHER_get_key_length(aeadCipher(aead).get()));
+}
+
+void aeadSeal(Aead aead, ByteSpan key, ByteSpan iv, ByteSpan aad, ByteSpan plaintext, MutableByteSpan ciphertext, MutableByteSpan tag) {
+  if (ciphertext.size() < plaintext.size()) {
+    throw std::runtime_error("AEAD output buffer too small");
+  }
+  if (tag.size() < 4 || tag.size() > 16 || (aead == Aead::ChaCha20Poly1305 && tag.size() != 16)) {
+    throw std::runtime_error("Invalid AEAD tag length");
+  }
+  auto ctx = aeadInit(aead, key, iv, aad, true);
+
+  int outl = 0;
+  if (!plaintext.empty() &&
+      EVP_CipherUpdate(ctx.get(), ciphertext.data(), &outl, plaintext.data(), toInt(plaintext.size(), "Plaintext")) != 1) {
+    throw std::runtime_error("Failed to encrypt: " + getOpenSSLError());
+  }
+  int finl = 0;
+  if (EVP_CipherFinal_ex(ctx.get(), ciphertext.data() + outl, &finl) != 1) {
+    throw std::runtime_error("Failed to finalize encryption: " + getOpenSSLError());
+  }
+  if (EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_GET_TAG, static_cast<int>(tag.size()), tag.data()) != 1) {
+    throw std::runtime_error("Failed to get auth tag: " + getOpenSSLError());
+  }
+}
+
+bool aeadOpen(Aead aead, ByteSpan key, ByteSpan iv, ByteSpan aad, ByteSpan ciphertext, ByteSpan tag, MutableByteSpan plaintext) {
+  if (plaintext.size() < ciphertext.size()) {
+    throw std::runtime_error("AEAD output buffer too small");
+  }
+  if (tag.size() < 4 || tag.size() > 16 || (aead == Aead::ChaCha20Poly1305 && tag.size() != 16)) {
+    throw std::runtime_error("Invalid AEAD tag length");
+  }
+  auto ctx = aeadInit(aead, key, iv, aad, false);
+
+  int outl = 0;
+  if (!ciphertext.empty() &&
+      EVP_CipherUpdate(ctx.get(), plaintext.data(), &outl, ciphertext.data(), toInt(ciphertext.size(), "Ciphertext")) != 1) {
+    throw std::runtime_error("Failed to decrypt: " + getOpenSSLError());
+  }
+  if (EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_TAG, static_cast<int>(tag.size()), const_cast<uint8_t*>(tag.data())) != 1) {
+    throw std::runtime_error("Failed to set auth tag: " + getOpenSSLError());
+  }
+  int finl = 0;
+  if (EVP_CipherFinal_ex(ctx.get(), plaintext.data() + outl, &finl) != 1) {
+    // Never hand out unauthenticated plaintext
+    OPENSSL_cleanse(plaintext.data(), ciphertext.size());
+    clearOpenSSLErrors();
+    return false;
+  }
+  return true;
+}
+
+Aead preferredAead() {
+  static const Aead preferred = []() {
+    // Medium-sized records, where per-call setup and bulk speed both show up.
+    // Each candidate gets the best of a few rounds to ride out scheduling noise
+    constexpr size_t kRecordSize = 16 * 1024;
+    constexpr int kRecords = 8;
+    constexpr int kRounds = 3;
+    std::vector<uint8_t> key(32, 0x42);
+    std::vector<uint8_t> iv(12, 0x24);
+    std::vector<uint8_t> data(kRecordSize, 0x61);
+    uint8_t tag[16];
+
+    auto measure = [&](Aead aead) {
+      auto best = std::chrono::steady_clock::duration::max();
+      for (int round = 0; round < kRounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRecords; i++) {
+          aeadSeal(aead, key, iv, {}, data, data, tag);
+        }
+        best = std::min(best, std::chrono::steady_clock::now() - start);
+      }
+      return best;
+    };
+    // Untimed pass so neither candidate pays for first-use setup
+    measure(Aead::Aes256Gcm);
+    measure(Aead::ChaCha20Poly1305);
+    return measure(Aead::ChaCha20Poly1305) < measure(Aead::Aes256Gcm) ? Aead::ChaCha20Poly1305 : Aead::Aes256Gcm;
+  }();
+  return preferred;
+}
+
+// -----------------------------------------------------------------------------
+// KDF
+
+void hkdf(const std::string& digest, ByteSpan key, ByteSpan salt, ByteSpan info, MutableByteSpan out) {
+  EVP_KDF* kdf = fetchKdf("HKDF");
+  if (kdf == nullptr) {
+    throw std::runtime_error("Failed to fetch HKDF: " + getOpenSSLError());
+  }
+  EVP_KDF_CTX* ctx = EVP_KDF_CTX_new(kdf);
+  EVP_KDF_free(kdf);
+  if (ctx == nullptr) {
+    throw std::runtime_error("Failed to create HKDF context: " + getOpenSSLError());
+  }
+
+  OSSL_PARAM params[5];
+  size_t i = 0;
+  params[i++] = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, const_cast<char*>(digest.c_str()), 0);
+  params[i++] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_KEY, const_cast<uint8_t*>(key.data()), key.size());
+  if (!salt.empty()) {
+    params[i++] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT, const_cast<uint8_t*>(salt.data()), salt.size());
+  }
+  if (!info.empty()) {
+    params[i++] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_INFO, const_cast<uint8_t*>(info.data()), info.size());
+  }
+  params[i++] = OSSL_PARAM_construct_end();
+
+  int ret = EVP_KDF_derive(ctx, out.data(), out.size(), params);
+  EVP_KDF_CTX_free(ctx);
+  if (ret <= 0) {
+    throw std::runtime_error("HKDF derivation failed: " + getOpenSSLError());
+  }
+}
+
+void pbkdf2(const std::string& digest, ByteSpan password, ByteSpan salt, uint32_t iterations, MutableByteSpan out) {
+  if (iterations == 0) {
+    throw std::runtime_error("PBKDF2 iterations must be positive");
+  }
+#ifndef RNQC_DISABLE_PBKDF2
+  // use fastpbkdf2 when possible; it ships with the pbkdf2 subsystem
+  useFastPbkdf2Kernels();
+  if (digest == "sha1") {
+    fastpbkdf2_hmac_sha1(password.data(), password.size(), salt.data(), salt.size(), iterations, out.data(), out.size());
+  } else if (digest == "sha256") {
+    fastpbkdf2_hmac_sha256(password.data(), password.size(), salt.data(), salt.size(), iterations, out.data(), out.size());
+  } else if (digest == "sha512") {
+    fastpbkdf2_hmac_sha512(password.data(), password.size(), salt.data(), salt.size(), iterations, out.data(), out.size());
+  } else
+#endif
+  {
+    // fallback to OpenSSL
+    std::unique_ptr<EVP_MD, decltype(&EVP_MD_free)> md(fetchDigest(digest), EVP_MD_free);
+    if (md == nullptr) {
+      throw std::runtime_error("Invalid hash-algorithm: " + digest);
+    }
+    if (PKCS5_PBKDF2_HMAC(reinterpret_cast<const char*>(password.data()), toInt(password.size(), "Password"), salt.data(),
+                          toInt(salt.size(), "Salt"), static_cast<int>(iterations), md.get(), toInt(out.size(), "Key length"),
+                          out.data()) != 1) {
+      throw std::runtime_error("PBKDF2 derivation failed: " + getOpenSSLError());
+    }
+  }
+}
+
+void scrypt(ByteSpan password, ByteSpan salt, uint64_t N, uint64_t r, uint64_t p, MutableByteSpan out, uint64_t maxmem) {
+  if (EVP_PBE_scrypt(reinterpret_cast<const char*>(password.data()), password.size(), salt.data(), salt.size(), N, r, p, maxmem,
+                     out.data(), out.size()) != 1) {
+    throw std::runtime_error("Scrypt derivation failed: " + getOpenSSLError());
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Keys
+
+KeyHandle KeyHandle::fromPem(ByteSpan pem, Type type, const std::string& passphrase) {
+  BIO* bio = BIO_new_mem_buf(pem.data(), toInt(pem.size(), "PEM"));
+  if (bio == nullptr) {
+    throw std::runtime_error("Failed to create BIO: " + getOpenSSLError());
+  }
+  void* pass = passphrase.empty() ? nullptr : const_cast<char*>(passphrase.c_str());
+  EVP_PKEY* pkey = type == Type::Private ? PEM_read_bio_PrivateKey(bio, nullptr, nullptr, pass)
+                                         : PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr);
+  BIO_free(bio);
+  return KeyHandle(wrapKey(pkey, "Failed to parse PEM key"));
+}
+
+KeyHandle KeyHandle::fromDer(ByteSpan der, Type type) {
+  const unsigned char* p = der.data();
+  long len = static_cast<long>(der.size());
+  EVP_PKEY* pkey = type == Type::Private ? d2i_AutoPrivateKey(nullptr, &p, len) : d2i_PUBKEY(nullptr, &p, len);
+  return KeyHandle(wrapKey(pkey, "Failed to parse DER key"));
+}
+
+KeyHandle KeyHandle::fromRaw(const std::string& algorithm, ByteSpan raw, Type type) {
+  int id;
+  if (algorithm == "ed25519") {
+    id = EVP_PKEY_ED25519;
+  } else if (algorithm == "ed448") {
+    id = EVP_PKEY_ED448;
+  } else if (algorithm == "x25519") {
+    id = EVP_PKEY_X25519;
+  } else if (algorithm == "x448") {
+    id = EVP_PKEY_X448;
+  } else {
+    throw std::runtime_error("Unsupported raw key algorithm: " + algorithm);
+  }
+  EVP_PKEY* pkey = type == Type::Private ? EVP_PKEY_new_raw_private_key(id, nullptr, raw.data(), raw.size())
+                                         : EVP_PKEY_new_raw_public_key(id, nullptr, raw.data(), raw.size());
+  return KeyHandle(wrapKey(pkey, "Failed to import raw key"));
+}
+
+KeyHandle KeyHandle::fromEvpPkey(EVP_PKEY* pkey) {
+  if (pkey == nullptr || EVP_PKEY_up_ref(pkey) != 1) {
+    throw std::runtime_error("Invalid EVP_PKEY");
+  }
+  return KeyHandle(std::shared_ptr<EVP_PKEY>(pkey, EVP_PKEY_free));
+}
+
+bool KeyHandle::isPrivate() const {
+  if (!key_) {
+    return false;
+  }
+  // Probing for the private component works for every key type
+  EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_from_pkey(nullptr, key_.get(), nullptr);
+  bool has_private = ctx != nullptr && EVP_PKEY_private_check(ctx) == 1;
+  EVP_PKEY_CTX_free(ctx);
+  clearOpenSSLErrors();
+  return has_private;
+}
+
+std::string KeyHandle::typeName() const {
+  if (!key_) {
+    throw std::runtime_error("Empty key handle");
+  }
+  const char* name = EVP_PKEY_get0_type_name(key_.get());
+  return name != nullptr ? name : "";
+}
+
+std::vector<uint8_t> KeyHandle::exportPublicDer() const {
+  if (!key_) {
+    throw std::runtime_error("Empty key handle");
+  }
+  unsigned char* der = nullptr;
+  int len = i2d_PUBKEY(key_.get(), &der);
+  if (len <= 0) {
+    throw std::runtime_error("Failed to export public key: " + getOpenSSLError());
+  }
+  std::vector<uint8_t> out(der, der + len);
+  OPENSSL_free(der);
+  return out;
+}
+
+std::vector<uint8_t> KeyHandle::exportPublicPem() const {
+  if (!key_) {
+    throw std::runtime_error("Empty key handle");
+  }
+  BIO* bio = BIO_new(BIO_s_mem());
+  if (bio == nullptr || PEM_write_bio_PUBKEY(bio, key_.get()) != 1) {
+    BIO_free(bio);
+    throw std::runtime_error("Failed to export public key: " + getOpenSSLError());
+  }
+  return bioToVector(bio);
+}
+
+std::vector<uint8_t> KeyHandle::sign(const std::string& digest, ByteSpan data) const {
+  if (!key_) {
+    throw std::runtime_error("Empty key handle");
+  }
+  std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+  if (!ctx ||
+      EVP_DigestSignInit_ex(ctx.get(), nullptr, digest.empty() ? nullptr : digest.c_str(), nullptr, nullptr, key_.get(), nullptr) != 1) {
+    throw std::runtime_error("Failed to initialize signing: " + getOpenSSLError());
+  }
+  size_t len = 0;
+  if (EVP_DigestSign(ctx.get(), nullptr, &len, data.data(), data.size()) != 1) {
+    throw std::runtime_error("Failed to get signature length: " + getOpenSSLError());
+  }
+  std::vector<uint8_t> signature(len);
+  if (EVP_DigestSign(ctx.get(), signature.data(), &len, data.data(), data.size()) != 1) {
+    throw std::runtime_error("Failed to sign: " + getOpenSSLError());
+  }
+  signature.resize(len);
+  return signature;
+}
+
+bool KeyHandle::verify(const std::string& digest, ByteSpan data, ByteSpan signature) const {
+  if (!key_) {
+    throw std::runtime_error("Empty key handle");
+  }
+  std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+  if (!ctx ||
+      EVP_DigestVerifyInit_ex(ctx.get(), nullptr, digest.empty() ? nullptr : digest.c_str(), nullptr, nullptr, key_.get(), nullptr) !=
+          1) {
+    throw std::runtime_error("Failed to initialize verification: " + getOpenSSLError());
+  }
+  int ret = EVP_DigestVerify(ctx.get(), signature.data(), signature.size(), data.data(), data.size());
+  clearOpenSSLErrors();
+  return ret == 1;
+}
+
+std::vector<uint8_t> KeyHandle::deriveSharedSecret(const KeyHandle& peer) const {
+  if (!key_ || !peer.key_) {
+    throw std::runtime_error("Empty key handle");
+  }
+  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new_from_pkey(nullptr, key_.get(), nullptr),
+                                                                  EVP_PKEY_CTX_free);
+  if (!ctx || EVP_PKEY_derive_init(ctx.get()) != 1 || EVP_PKEY_derive_set_peer(ctx.get(), peer.key_.get()) != 1) {
+    throw std::runtime_error("Failed to initialize key agreement: " + getOpenSSLError());
+  }
+  size_t len = 0;
+  if (EVP_PKEY_derive(ctx.get(), nullptr, &len) != 1) {
+    throw std::runtime_error("Failed to get shared secret length: " + getOpenSSLError());
+  }
+  std::vector<uint8_t> secret(len);
+  if (EVP_PKEY_derive(ctx.get(), secret.data(), &len) != 1) {
+    throw std::runtime_error("Failed to derive shared secret: " + getOpenSSLError());
+  }
+  secret.resize(len);
+  return secret;
+}
+
+} // namespace margelo::nitro::crypto::api
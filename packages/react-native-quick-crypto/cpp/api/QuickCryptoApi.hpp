@@ -0,0 +1,222 @@
+#pragma once
+
+/**
+ * Public C++ API of react-native-quick-crypto.
+ *
+ * Lets other native modules (video recorders, sync engines, ...) use the same
+ * OpenSSL build and crypto engines that back the JS API, without going through
+ * JSI and without Nitro types.  Everything works on plain byte spans, so
+ * callers can pass pointers into their own buffers.
+ *
+ * The header only depends on the C++ standard library; OpenSSL types are
+ * forward declared.  All functions throw `std::runtime_error` on failure
+ * (invalid algorithm, bad key length, OpenSSL error), except `aeadOpen()` and
+ * `KeyHandle::verify()` which report authentication failure via their return
+ * value.
+ *
+ * All free functions are thread-safe.  Stateful objects (`Hash`, `Hmac`) must
+ * not be used from more than one thread at a time; `KeyHandle` is immutable
+ * and can be shared between threads.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define RNQC_API __attribute__((visibility("default")))
+
+typedef struct evp_pkey_st EVP_PKEY;
+
+namespace margelo::nitro::crypto::api {
+
+using ByteSpan = std::span<const uint8_t>;
+using MutableByteSpan = std::span<uint8_t>;
+
+// Version of this header surface; bumped on incompatible changes.
+inline constexpr int kApiVersion = 1;
+
+// -----------------------------------------------------------------------------
+// Initialization
+
+/**
+ * Does the one-time OpenSSL setup the first crypto call would otherwise pay
+ * for: library init, CPU capability probing, default provider load, DRBG
+ * seeding and fetching the common digests, ciphers, MACs and KDFs.  Blocking
+ * and idempotent; concurrent callers wait for the first one to finish.  Call
+ * it from a background thread at launch.
+ */
+RNQC_API void prewarm();
+
+// -----------------------------------------------------------------------------
+// Random
+
+/** Fills `out` with cryptographically secure random bytes. */
+RNQC_API void randomBytes(MutableByteSpan out);
+
+// -----------------------------------------------------------------------------
+// Hash
+
+/**
+ * Incremental message digest, e.g. `Hash("sha256")`.  Accepts every digest
+ * name OpenSSL knows (`sha1`, `sha256`, `sha512`, `sha3-256`, ...).
+ * `outputLength` is only used by XOFs (`shake128`, `shake256`).
+ */
+class RNQC_API Hash {
+ public:
+  explicit Hash(const std::string& algorithm, size_t outputLength = 0);
+  ~Hash();
+  Hash(Hash&&) noexcept;
+  Hash& operator=(Hash&&) noexcept;
+  Hash(const Hash&) = delete;
+  Hash& operator=(const Hash&) = delete;
+
+  /** Size in bytes of the digest `final()` produces. */
+  size_t digestSize() const;
+
+  void update(ByteSpan data);
+  /** Writes the digest into `out`, which must hold `digestSize()` bytes. Returns the bytes written. */
+  size_t final(MutableByteSpan out);
+  std::vector<uint8_t> final();
+
+  /** One-shot digest. */
+  static std::vector<uint8_t> digest(const std::string& algorithm, ByteSpan data);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+// -----------------------------------------------------------------------------
+// HMAC
+
+/** Incremental HMAC, e.g. `Hmac("sha256", key)`. */
+class RNQC_API Hmac {
+ public:
+  Hmac(const std::string& algorithm, ByteSpan key);
+  ~Hmac();
+  Hmac(Hmac&&) noexcept;
+  Hmac& operator=(Hmac&&) noexcept;
+  Hmac(const Hmac&) = delete;
+  Hmac& operator=(const Hmac&) = delete;
+
+  size_t digestSize() const;
+
+  void update(ByteSpan data);
+  /** Writes the MAC into `out`, which must hold `digestSize()` bytes. Returns the bytes written. */
+  size_t final(MutableByteSpan out);
+  std::vector<uint8_t> final();
+
+  /** One-shot HMAC. */
+  static std::vector<uint8_t> digest(const std::string& algorithm, ByteSpan key, ByteSpan data);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+// -----------------------------------------------------------------------------
+// AEAD
+
+enum class Aead {
+  Aes128Gcm,
+  Aes192Gcm,
+  Aes256Gcm,
+  ChaCha20Poly1305,
+};
+
+/** Required key length in bytes for `aead`. */
+RNQC_API size_t aeadKeyLength(Aead aead);
+
+/**
+ * Encrypts `plaintext` into `ciphertext` (same length; may alias `plaintext`)
+ * and writes the authentication tag into `tag` (4..16 bytes for GCM, 16 for
+ * ChaCha20-Poly1305).  `iv` is 12 bytes for ChaCha20-Poly1305, 1+ bytes for
+ * GCM (12 recommended).  Never reuse an IV with the same key.
+ */
+RNQC_API void aeadSeal(Aead aead, ByteSpan key, ByteSpan iv, ByteSpan aad, ByteSpan plaintext, MutableByteSpan ciphertext,
+                       MutableByteSpan tag);
+
+/**
+ * Decrypts `ciphertext` into `plaintext` (same length; may alias) and checks
+ * `tag`.  Returns false and zeroes `plaintext` if authentication fails.
+ */
+[[nodiscard]] RNQC_API bool aeadOpen(Aead aead, ByteSpan key, ByteSpan iv, ByteSpan aad, ByteSpan ciphertext, ByteSpan tag,
+                                     MutableByteSpan plaintext);
+
+/**
+ * The faster of AES-256-GCM and ChaCha20-Poly1305 on this device, measured
+ * once with a short microbenchmark (a few milliseconds) and cached for the
+ * process lifetime.  Without AES instructions ChaCha20-Poly1305 usually wins
+ * by a wide margin; with them AES-GCM does.  Thread-safe; blocks on first use.
+ */
+RNQC_API Aead preferredAead();
+
+// -----------------------------------------------------------------------------
+// KDF
+
+/** HKDF (RFC 5869) extract-and-expand; fills all of `out`. */
+RNQC_API void hkdf(const std::string& digest, ByteSpan key, ByteSpan salt, ByteSpan info, MutableByteSpan out);
+
+/** PBKDF2-HMAC; fills all of `out`.  SHA-1/256/512 use the fastpbkdf2 path. */
+RNQC_API void pbkdf2(const std::string& digest, ByteSpan password, ByteSpan salt, uint32_t iterations, MutableByteSpan out);
+
+/** scrypt (RFC 7914); fills all of `out`.  `maxmem` of 0 uses OpenSSL's default of 32MiB. */
+RNQC_API void scrypt(ByteSpan password, ByteSpan salt, uint64_t N, uint64_t r, uint64_t p, MutableByteSpan out, uint64_t maxmem = 0);
+
+// -----------------------------------------------------------------------------
+// Keys
+
+/**
+ * Reference-counted handle to an asymmetric key (RSA, EC, Ed25519, X25519,
+ * ...).  Copies share the same underlying key.
+ */
+class RNQC_API KeyHandle {
+ public:
+  enum class Type { Public, Private };
+
+  /** PEM, either SPKI/PKCS#1 public or PKCS#8/traditional private. */
+  static KeyHandle fromPem(ByteSpan pem, Type type, const std::string& passphrase = "");
+  /** DER, SPKI for public keys and PKCS#8 for private keys. */
+  static KeyHandle fromDer(ByteSpan der, Type type);
+  /** Raw keys for `ed25519`, `ed448`, `x25519` and `x448`. */
+  static KeyHandle fromRaw(const std::string& algorithm, ByteSpan raw, Type type);
+  /** Takes one reference on `pkey`; the caller keeps its own. */
+  static KeyHandle fromEvpPkey(EVP_PKEY* pkey);
+
+  KeyHandle() = default;
+  explicit operator bool() const {
+    return key_ != nullptr;
+  }
+
+  /** Borrowed pointer for callers that need OpenSSL directly; valid while the handle lives. */
+  EVP_PKEY* get() const {
+    return key_.get();
+  }
+  bool isPrivate() const;
+  /** OpenSSL key type name, e.g. `RSA`, `EC`, `ED25519`. */
+  std::string typeName() const;
+
+  std::vector<uint8_t> exportPublicDer() const;
+  std::vector<uint8_t> exportPublicPem() const;
+
+  /**
+   * Signs `data`.  `digest` is ignored for Ed25519/Ed448 (pass an empty
+   * string) and required otherwise.  EC signatures are DER encoded.
+   */
+  std::vector<uint8_t> sign(const std::string& digest, ByteSpan data) const;
+  [[nodiscard]] bool verify(const std::string& digest, ByteSpan data, ByteSpan signature) const;
+
+  /** X25519/X448/ECDH shared secret with `peer`'s public key. */
+  std::vector<uint8_t> deriveSharedSecret(const KeyHandle& peer) const;
+
+ private:
+  explicit KeyHandle(std::shared_ptr<EVP_PKEY> key) : key_(std::move(key)) {}
+
+  std::shared_ptr<EVP_PKEY> key_;
+};
+
+} // namespace margelo::nitro::crypto::api
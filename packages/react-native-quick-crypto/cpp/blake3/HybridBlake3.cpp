@@ -43,14 +43,13 @@ void HybridBlake3::initDeriveKey(const std::string& ctx) {
   initialized = true;
 }
 
-void HybridBlake3::update(const std::shared_ptr<ArrayBuffer>& data) {
+void HybridBlake3::update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                          const std::optional<double>& byteLength) {
   if (!initialized) {
     throw std::runtime_error("BLAKE3 hasher not initialized");
   }
-  if (!data) {
-    return;
-  }
-  blake3_hasher_update(&hasher, data->data(), data->size());
+  auto view = ToByteView(data, byteOffset, byteLength);
+  blake3_hasher_update(&hasher, view.data(), view.size());
 }
 
 std::shared_ptr<ArrayBuffer> HybridBlake3::digest(std::optional<double> length) {
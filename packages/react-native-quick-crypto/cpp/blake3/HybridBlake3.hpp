@@ -18,7 +18,8 @@ class HybridBlake3 : public HybridBlake3Spec {
   void initHash() override;
   void initKeyed(const std::shared_ptr<ArrayBuffer>& key) override;
   void initDeriveKey(const std::string& context) override;
-  void update(const std::shared_ptr<ArrayBuffer>& data) override;
+  void update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+              const std::optional<double>& byteLength) override;
   std::shared_ptr<ArrayBuffer> digest(std::optional<double> length) override;
   void reset() override;
   std::shared_ptr<HybridBlake3Spec> copy() override;
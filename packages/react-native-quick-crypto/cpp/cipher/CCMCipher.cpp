@@ -52,10 +52,11 @@ void CCMCipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const std::s
   }
 }
 
-std::shared_ptr<ArrayBuffer> CCMCipher::update(const std::shared_ptr<ArrayBuffer>& data) {
+std::shared_ptr<ArrayBuffer> CCMCipher::update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                                               const std::optional<double>& byteLength) {
   checkCtx();
-  auto native_data = ToNativeArrayBuffer(data);
-  size_t in_len = native_data->size();
+  auto view = ToByteView(data, byteOffset, byteLength);
+  size_t in_len = view.size();
   if (in_len < 0 || in_len > INT_MAX) {
     throw std::runtime_error("Invalid message length");
   }
@@ -75,10 +76,9 @@ std::shared_ptr<ArrayBuffer> CCMCipher::update(const std::shared_ptr<ArrayBuffer
   }
 
   auto out_buf = std::make_unique<unsigned char[]>(out_len);
-  const uint8_t* in = reinterpret_cast<const uint8_t*>(native_data->data());
 
   int actual_out_len = 0;
-  int ret = EVP_CipherUpdate(ctx, out_buf.get(), &actual_out_len, in, in_len);
+  int ret = EVP_CipherUpdate(ctx, out_buf.get(), &actual_out_len, view.data(), in_len);
 
   if (!is_cipher) {
     // Decryption: Check for tag verification failure
@@ -97,6 +97,7 @@ std::shared_ptr<ArrayBuffer> CCMCipher::update(const std::shared_ptr<ArrayBuffer
     }
   }
   // If we reached here, the operation (encryption or decryption) succeeded
+  workload.add(in_len);
 
   unsigned char* final_output = out_buf.release();
   return std::make_shared<NativeArrayBuffer>(final_output, actual_out_len, [=]() { delete[] final_output; });
@@ -107,6 +108,7 @@ std::shared_ptr<ArrayBuffer> CCMCipher::final() {
 
   // CCM decryption does not use final. Verification happens in the last update call.
   if (!is_cipher) {
+    recordWorkload();
     // Return an empty buffer, matching Node.js behavior
     unsigned char* empty_output = new unsigned char[0];
     return std::make_shared<NativeArrayBuffer>(empty_output, 0, [=]() { delete[] empty_output; });
@@ -138,6 +140,7 @@ std::shared_ptr<ArrayBuffer> CCMCipher::final() {
     throw std::runtime_error("Failed to get auth tag after finalization: " + std::string(err_buf));
   }
   auth_tag_state = kAuthTagKnown;
+  recordWorkload();
 
   unsigned char* final_output = out_buf.release();
   return std::make_shared<NativeArrayBuffer>(final_output, out_len, [=]() { delete[] final_output; });
@@ -1,5 +1,7 @@
 #include "ChaCha20Cipher.hpp"
+#include "LibraryContext.hpp"
 #include "Utils.hpp"
+#include <memory>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <stdexcept>
@@ -13,8 +15,8 @@ void ChaCha20Cipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const s
     ctx = nullptr;
   }
 
-  // Get ChaCha20 cipher implementation
-  const EVP_CIPHER* cipher = EVP_chacha20();
+  // Get ChaCha20 cipher implementation; the context takes its own reference
+  std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher(fetchCipher("ChaCha20"), EVP_CIPHER_free);
   if (!cipher) {
     throw std::runtime_error("Failed to get ChaCha20 cipher implementation");
   }
@@ -26,7 +28,7 @@ void ChaCha20Cipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const s
   }
 
   // Initialize the encryption/decryption operation
-  if (EVP_CipherInit_ex(ctx, cipher, nullptr, nullptr, nullptr, is_cipher) != 1) {
+  if (EVP_CipherInit_ex(ctx, cipher.get(), nullptr, nullptr, nullptr, is_cipher) != 1) {
     unsigned long err = ERR_get_error();
     char err_buf[256];
     ERR_error_string_n(err, err_buf, sizeof(err_buf));
@@ -62,10 +64,11 @@ void ChaCha20Cipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const s
   }
 }
 
-std::shared_ptr<ArrayBuffer> ChaCha20Cipher::update(const std::shared_ptr<ArrayBuffer>& data) {
+std::shared_ptr<ArrayBuffer> ChaCha20Cipher::update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                                                    const std::optional<double>& byteLength) {
   checkCtx();
-  auto native_data = ToNativeArrayBuffer(data);
-  size_t in_len = native_data->size();
+  auto view = ToByteView(data, byteOffset, byteLength);
+  size_t in_len = view.size();
   if (in_len > INT_MAX) {
     throw std::runtime_error("Message too long");
   }
@@ -75,13 +78,14 @@ std::shared_ptr<ArrayBuffer> ChaCha20Cipher::update(const std::shared_ptr<ArrayB
   uint8_t* out = new uint8_t[out_len];
 
   // Perform the cipher update operation
-  if (EVP_CipherUpdate(ctx, out, &out_len, native_data->data(), in_len) != 1) {
+  if (EVP_CipherUpdate(ctx, out, &out_len, view.data(), in_len) != 1) {
     delete[] out;
     unsigned long err = ERR_get_error();
     char err_buf[256];
     ERR_error_string_n(err, err_buf, sizeof(err_buf));
     throw std::runtime_error("ChaCha20Cipher: Failed to update: " + std::string(err_buf));
   }
+  workload.add(in_len);
 
   // Create and return a new buffer of exact size needed
   return std::make_shared<NativeArrayBuffer>(out, out_len, [=]() { delete[] out; });
@@ -89,6 +93,7 @@ std::shared_ptr<ArrayBuffer> ChaCha20Cipher::update(const std::shared_ptr<ArrayB
 
 std::shared_ptr<ArrayBuffer> ChaCha20Cipher::final() {
   checkCtx();
+  recordWorkload();
   // For ChaCha20, final() should return an empty buffer since it's a stream cipher
   unsigned char* empty_output = new unsigned char[0];
   return std::make_shared<NativeArrayBuffer>(empty_output, 0, [=]() { delete[] empty_output; });
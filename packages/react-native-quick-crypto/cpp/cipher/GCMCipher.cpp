@@ -1,5 +1,7 @@
 #include "GCMCipher.hpp"
+#include "LibraryContext.hpp"
 #include "Utils.hpp"
+#include <memory>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <stdexcept>
@@ -13,8 +15,8 @@ void GCMCipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const std::s
     ctx = nullptr;
   }
 
-  // 1. Get cipher implementation by name
-  const EVP_CIPHER* cipher = EVP_get_cipherbyname(cipher_type.c_str());
+  // 1. Fetch the cipher implementation by name; the context takes its own reference
+  std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher(fetchCipher(cipher_type), EVP_CIPHER_free);
   if (!cipher) {
     throw std::runtime_error("Unknown cipher " + cipher_type);
   }
@@ -26,7 +28,7 @@ void GCMCipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const std::s
   }
 
   // 3. Initialize with cipher type only (no key/IV yet)
-  if (EVP_CipherInit_ex(ctx, cipher, nullptr, nullptr, nullptr, is_cipher) != 1) {
+  if (EVP_CipherInit_ex(ctx, cipher.get(), nullptr, nullptr, nullptr, is_cipher) != 1) {
     unsigned long err = ERR_get_error();
     char err_buf[256];
     ERR_error_string_n(err, err_buf, sizeof(err_buf));
@@ -6,6 +6,9 @@
 #include <vector>
 
 #include "HybridCipher.hpp"
+#include "LibraryContext.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
 #include "Utils.hpp"
 
 #include <openssl/err.h>
@@ -24,6 +27,13 @@ void HybridCipher::checkCtx() const {
   if (!ctx) {
     throw std::runtime_error("Cipher context is not initialized or has been disposed.");
   }
+  checkNotBusy();
+}
+
+void HybridCipher::checkNotBusy() const {
+  if (job_in_flight.load(std::memory_order_acquire) && job_thread.load(std::memory_order_acquire) != std::this_thread::get_id()) {
+    throw std::runtime_error("Cipher is busy with a pending updateAsync/finalAsync");
+  }
 }
 
 bool HybridCipher::maybePassAuthTagToOpenSSL() {
@@ -48,8 +58,8 @@ void HybridCipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const std
     ctx = nullptr;
   }
 
-  // 1. Get cipher implementation by name
-  const EVP_CIPHER* cipher = EVP_get_cipherbyname(cipher_type.c_str());
+  // 1. Fetch the cipher implementation by name; the context takes its own reference
+  std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher(fetchCipher(cipher_type), EVP_CIPHER_free);
   if (!cipher) {
     throw std::runtime_error("Unknown cipher " + cipher_type);
   }
@@ -62,7 +72,7 @@ void HybridCipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const std
 
   // Initialise the encryption/decryption operation with the cipher type.
   // Key and IV will be set later by the derived class if needed.
-  if (EVP_CipherInit_ex(ctx, cipher, nullptr, nullptr, nullptr, is_cipher) != 1) {
+  if (EVP_CipherInit_ex(ctx, cipher.get(), nullptr, nullptr, nullptr, is_cipher) != 1) {
     unsigned long err = ERR_get_error();
     char err_buf[256];
     ERR_error_string_n(err, err_buf, sizeof(err_buf));
@@ -96,10 +106,11 @@ void HybridCipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const std
   }
 }
 
-std::shared_ptr<ArrayBuffer> HybridCipher::update(const std::shared_ptr<ArrayBuffer>& data) {
-  auto native_data = ToNativeArrayBuffer(data);
+std::shared_ptr<ArrayBuffer> HybridCipher::update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                                                  const std::optional<double>& byteLength) {
+  auto view = ToByteView(data, byteOffset, byteLength);
   checkCtx();
-  size_t in_len = native_data->size();
+  size_t in_len = view.size();
   if (in_len > INT_MAX) {
     throw std::runtime_error("Message too long");
   }
@@ -108,7 +119,7 @@ std::shared_ptr<ArrayBuffer> HybridCipher::update(const std::shared_ptr<ArrayBuf
   uint8_t* out = new uint8_t[out_len];
   // Perform the cipher update operation. The real size of the output is
   // returned in out_len
-  int ret = EVP_CipherUpdate(ctx, out, &out_len, native_data->data(), in_len);
+  int ret = EVP_CipherUpdate(ctx, out, &out_len, view.data(), in_len);
 
   if (!ret) {
     unsigned long err = ERR_get_error();
@@ -117,6 +128,7 @@ std::shared_ptr<ArrayBuffer> HybridCipher::update(const std::shared_ptr<ArrayBuf
     delete[] out;
     throw std::runtime_error("Cipher update failed: " + std::string(err_buf));
   }
+  workload.add(in_len);
 
   // Create and return a new buffer of exact size needed
   return std::make_shared<NativeArrayBuffer>(out, out_len, [=]() { delete[] out; });
@@ -139,6 +151,7 @@ std::shared_ptr<ArrayBuffer> HybridCipher::final() {
     // Don't free context on error here either, rely on destructor
     throw std::runtime_error("Cipher final failed: " + std::string(err_buf));
   }
+  recordWorkload();
 
   // Get raw pointer before releasing unique_ptr
   uint8_t* raw_ptr = out_buf.get();
@@ -153,6 +166,46 @@ std::shared_ptr<ArrayBuffer> HybridCipher::final() {
   return native_final_chunk;
 }
 
+void HybridCipher::recordWorkload() {
+  WorkloadRecorder::record(WorkloadRecorder::Op::Cipher, cipher_type, workload.bytes, workload.updates, is_cipher ? 1 : 0);
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridCipher::runJob(
+    std::function<std::shared_ptr<ArrayBuffer>(HybridCipher&)>&& job) {
+  // no checkCtx() here: engines without an EVP context (XSalsa20) override
+  // update/final, and the EVP ones check their context inside the job
+  if (job_in_flight.exchange(true, std::memory_order_acq_rel)) {
+    throw std::runtime_error("Cipher is busy with a pending updateAsync/finalAsync");
+  }
+  // the job holds a strong reference, so the context outlives a dropped JS object
+  auto self = strongRef(this);
+  return Promise<std::shared_ptr<ArrayBuffer>>::async([self, job = std::move(job), queued = QueueWait::stamp("cipher")]() {
+    queued.started();
+    WorkloadRecorder::AsyncJob asyncJob;
+    self->job_thread.store(std::this_thread::get_id(), std::memory_order_release);
+    struct Release {
+      HybridCipher& cipher;
+      ~Release() {
+        cipher.job_thread.store(std::thread::id(), std::memory_order_release);
+        cipher.job_in_flight.store(false, std::memory_order_release);
+      }
+    } release{*self};
+    return job(*self);
+  });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridCipher::updateAsync(const std::shared_ptr<ArrayBuffer>& data,
+                                                                                const std::optional<double>& byteOffset,
+                                                                                const std::optional<double>& byteLength) {
+  // JS-owned memory must not be read off the JS thread, so the job gets its own copy
+  std::shared_ptr<ArrayBuffer> native_data = ToNativeArrayBuffer(ToByteView(data, byteOffset, byteLength));
+  return runJob([native_data](HybridCipher& cipher) { return cipher.update(native_data, std::nullopt, std::nullopt); });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridCipher::finalAsync() {
+  return runJob([](HybridCipher& cipher) { return cipher.final(); });
+}
+
 bool HybridCipher::setAAD(const std::shared_ptr<ArrayBuffer>& data, std::optional<double> plaintextLength) {
   checkCtx();
   auto native_data = ToNativeArrayBuffer(data);
@@ -277,6 +330,9 @@ int HybridCipher::getMode() {
 }
 
 void HybridCipher::setArgs(const CipherArgs& args) {
+  if (job_in_flight.load(std::memory_order_acquire)) {
+    throw std::runtime_error("Cipher is busy with a pending updateAsync/finalAsync");
+  }
   this->is_cipher = args.isCipher;
   this->cipher_type = args.cipherType;
 
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <openssl/core_names.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/param_build.h>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "HybridCipherSpec.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -22,10 +26,17 @@ class HybridCipher : public HybridCipherSpec {
 
  public:
   // Methods
-  std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                                      const std::optional<double>& byteLength) override;
 
   std::shared_ptr<ArrayBuffer> final() override;
 
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> updateAsync(const std::shared_ptr<ArrayBuffer>& data,
+                                                                     const std::optional<double>& byteOffset,
+                                                                     const std::optional<double>& byteLength) override;
+
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> finalAsync() override;
+
   virtual void init(const std::shared_ptr<ArrayBuffer> cipher_key, const std::shared_ptr<ArrayBuffer> iv);
 
   void setArgs(const CipherArgs& args) override;
@@ -57,12 +68,22 @@ class HybridCipher : public HybridCipherSpec {
   AuthTagState auth_tag_state;
   unsigned int auth_tag_len = 0;
   int max_message_size;
+  // While an updateAsync/finalAsync job is queued or running, the context belongs to
+  // the job: only the worker in job_thread may touch it, everyone else is rejected
+  std::atomic<bool> job_in_flight = false;
+  std::atomic<std::thread::id> job_thread;
+  WorkloadRecorder::Tally workload;
 
  protected:
   // Methods
   int getMode();
   void checkCtx() const;
+  // The busy half of checkCtx(), for engines that keep their state outside ctx
+  void checkNotBusy() const;
   bool maybePassAuthTagToOpenSSL();
+  // Logs the finished operation when a workload trace is being recorded
+  void recordWorkload();
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> runJob(std::function<std::shared_ptr<ArrayBuffer>(HybridCipher&)>&& job);
 };
 
 } // namespace margelo::nitro::crypto
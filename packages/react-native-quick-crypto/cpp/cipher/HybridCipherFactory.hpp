@@ -9,6 +9,7 @@
 #include "ChaCha20Poly1305Cipher.hpp"
 #include "GCMCipher.hpp"
 #include "HybridCipherFactorySpec.hpp"
+#include "LibraryContext.hpp"
 #include "OCBCipher.hpp"
 #include "Utils.hpp"
 #include "XSalsa20Cipher.hpp"
@@ -30,7 +31,7 @@ class HybridCipherFactory : public HybridCipherFactorySpec {
 
     // OpenSSL
     // temporary cipher context to determine the mode
-    EVP_CIPHER* cipher = EVP_CIPHER_fetch(nullptr, args.cipherType.c_str(), nullptr);
+    EVP_CIPHER* cipher = fetchCipher(args.cipherType);
     if (cipher) {
       int mode = EVP_CIPHER_get_mode(cipher);
 
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <stdexcept>
+#include <string>
+
+#include "HybridKeyRotation.hpp"
+#include "LibraryContext.hpp"
+#include "ParallelFor.hpp"
+#include "QueueWait.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  using CipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+  std::shared_ptr<EVP_CIPHER_CTX> createKeyedContext(const std::string& cipherType, const std::shared_ptr<ArrayBuffer>& key,
+                                                     bool encrypt) {
+    EVP_CIPHER* cipher = fetchCipher(cipherType);
+    if (!cipher) {
+      throw std::runtime_error("Unsupported or unknown cipher type: " + cipherType);
+    }
+    std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher_guard(cipher, EVP_CIPHER_free);
+    if (EVP_CIPHER_get_mode(cipher) != EVP_CIPH_GCM_MODE && EVP_CIPHER_get_nid(cipher) != NID_chacha20_poly1305) {
+      throw std::runtime_error("KeyRotation supports AES-GCM and ChaCha20-Poly1305, got: " + cipherType);
+    }
+    if (key->size() != static_cast<size_t>(EVP_CIPHER_get_key_length(cipher))) {
+      throw std::runtime_error("Invalid key length for " + cipherType + ": expected " +
+                               std::to_string(EVP_CIPHER_get_key_length(cipher)) + " bytes");
+    }
+
+    std::shared_ptr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+    if (!ctx) {
+      throw std::runtime_error("Failed to create cipher context");
+    }
+    int enc = encrypt ? 1 : 0;
+    if (EVP_CipherInit_ex(ctx.get(), cipher, nullptr, nullptr, nullptr, enc) != 1) {
+      throw std::runtime_error("KeyRotation: Failed to initialize cipher: " + getOpenSSLError());
+    }
+    if (EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_IVLEN, 12, nullptr) != 1) {
+      throw std::runtime_error("KeyRotation: Failed to set nonce length: " + getOpenSSLError());
+    }
+    auto native_key = ToNativeArrayBuffer(key);
+    int ok = EVP_CipherInit_ex(ctx.get(), nullptr, nullptr, native_key->data(), nullptr, enc);
+    OPENSSL_cleanse(native_key->data(), native_key->size());
+    if (ok != 1) {
+      throw std::runtime_error("KeyRotation: Failed to set key: " + getOpenSSLError());
+    }
+    return ctx;
+  }
+
+  CipherCtxPtr copyContext(EVP_CIPHER_CTX* tmpl) {
+    // Copying a keyed context duplicates the expanded key, it does not redo it
+    CipherCtxPtr ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+    if (!ctx || EVP_CIPHER_CTX_copy(ctx.get(), tmpl) != 1) {
+      throw std::runtime_error("KeyRotation: Failed to copy cipher context: " + getOpenSSLError());
+    }
+    return ctx;
+  }
+
+} // namespace
+
+void HybridKeyRotation::init(const KeyRotationArgs& args) {
+  clearOpenSSLErrors();
+
+  auto config = std::make_shared<Config>();
+  config->open_ctx = createKeyedContext(args.oldCipherType.value_or(args.cipherType), args.oldKey, false);
+  config->seal_ctx = createKeyedContext(args.cipherType, args.newKey, true);
+
+  if (args.noncePrefix.has_value()) {
+    const auto& prefix = args.noncePrefix.value();
+    if (prefix->size() != config->nonce_prefix.size()) {
+      throw std::runtime_error("noncePrefix must be exactly 4 bytes");
+    }
+    std::memcpy(config->nonce_prefix.data(), prefix->data(), prefix->size());
+  } else if (RAND_bytes(config->nonce_prefix.data(), static_cast<int>(config->nonce_prefix.size())) != 1) {
+    throw std::runtime_error("KeyRotation: Failed to generate a nonce prefix: " + getOpenSSLError());
+  }
+
+  double counter = args.counter;
+  if (counter < 0 || counter != std::floor(counter) || counter > kMaxSafeInteger) {
+    throw std::runtime_error("Invalid counter: must be a non-negative integer below 2^53");
+  }
+
+  std::lock_guard<std::mutex> lock(counter_mutex_);
+  config_ = std::move(config);
+  counter_ = static_cast<uint64_t>(counter);
+}
+
+double HybridKeyRotation::getCounter() {
+  checkConfig();
+  std::lock_guard<std::mutex> lock(counter_mutex_);
+  return static_cast<double>(counter_);
+}
+
+std::shared_ptr<const HybridKeyRotation::Config> HybridKeyRotation::checkConfig() const {
+  if (!config_) {
+    throw std::runtime_error("KeyRotation not initialized. Call init() first.");
+  }
+  return config_;
+}
+
+uint64_t HybridKeyRotation::reserveCounters(size_t count) {
+  std::lock_guard<std::mutex> lock(counter_mutex_);
+  if (count > static_cast<uint64_t>(kMaxSafeInteger) - counter_) {
+    throw std::runtime_error("KeyRotation: nonce counter exhausted, rotate to a new key");
+  }
+  uint64_t first = counter_;
+  counter_ += count;
+  return first;
+}
+
+HybridKeyRotation::RecordJob HybridKeyRotation::prepareJob(const std::vector<std::shared_ptr<ArrayBuffer>>& records,
+                                                           const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad,
+                                                           bool copy) {
+  if (aad.has_value() && aad->size() != records.size()) {
+    throw std::runtime_error("aad must have one entry per record");
+  }
+  RecordJob job;
+  job.records.reserve(records.size());
+  auto view = [&](const std::shared_ptr<ArrayBuffer>& buffer) {
+    if (!copy) {
+      return ToByteView(buffer);
+    }
+    // Async jobs outlive the JS buffers, so they work on copies
+    job.owned.push_back(ToNativeArrayBuffer(buffer));
+    return ToByteView(job.owned.back());
+  };
+  for (size_t i = 0; i < records.size(); i++) {
+    size_t size = records[i]->size();
+    if (size < kOverhead || size > static_cast<size_t>(INT_MAX)) {
+      throw std::runtime_error("Invalid record " + std::to_string(i) + ": expected nonce (12) || ciphertext || tag (16), got " +
+                               std::to_string(size) + " bytes");
+    }
+    job.max_plaintext = std::max(job.max_plaintext, size - kOverhead);
+    job.records.push_back(view(records[i]));
+  }
+  if (aad.has_value()) {
+    job.aad.reserve(aad->size());
+    for (const auto& data : aad.value()) {
+      if (data->size() > static_cast<size_t>(INT_MAX)) {
+        throw std::runtime_error("aad entry too large");
+      }
+      job.aad.push_back(view(data));
+    }
+  }
+  // Spend nonces last, once nothing can be rejected up front
+  job.first_counter = reserveCounters(records.size());
+  return job;
+}
+
+bool HybridKeyRotation::reencryptRecord(const Config& config, EVP_CIPHER_CTX* open, EVP_CIPHER_CTX* seal, const RecordJob& job,
+                                        size_t index, uint8_t* scratch, std::shared_ptr<ArrayBuffer>& out) {
+  std::span<const uint8_t> record = job.records[index];
+  const size_t text_len = record.size() - kOverhead;
+  const uint8_t* ciphertext = record.data() + kNonceSize;
+  std::span<const uint8_t> aad = job.aad.empty() ? std::span<const uint8_t>() : job.aad[index];
+  int len = 0;
+
+  // Open with the old key; only the nonce changes between records
+  if (EVP_CipherInit_ex(open, nullptr, nullptr, nullptr, record.data(), -1) != 1 ||
+      EVP_CIPHER_CTX_ctrl(open, EVP_CTRL_AEAD_SET_TAG, kTagSize, const_cast<uint8_t*>(ciphertext + text_len)) != 1) {
+    throw std::runtime_error("KeyRotation: Failed to set up record " + std::to_string(index) + ": " + getOpenSSLError());
+  }
+  if ((!aad.empty() && EVP_CipherUpdate(open, nullptr, &len, aad.data(), static_cast<int>(aad.size())) != 1) ||
+      (text_len > 0 && EVP_CipherUpdate(open, scratch, &len, ciphertext, static_cast<int>(text_len)) != 1)) {
+    OPENSSL_cleanse(scratch, text_len);
+    throw std::runtime_error("KeyRotation: Failed to decrypt record " + std::to_string(index) + ": " + getOpenSSLError());
+  }
+  if (EVP_CipherFinal_ex(open, scratch + text_len, &len) != 1) {
+    // Never re-seal unauthenticated plaintext
+    clearOpenSSLErrors();
+    OPENSSL_cleanse(scratch, text_len);
+    return false;
+  }
+
+  // Seal under the new key with the next reserved counter
+  uint8_t* nonce = new uint8_t[record.size()];
+  auto sealed = std::make_shared<NativeArrayBuffer>(nonce, record.size(), [=]() { delete[] nonce; });
+  std::memcpy(nonce, config.nonce_prefix.data(), config.nonce_prefix.size());
+  storeBE64(nonce + config.nonce_prefix.size(), job.first_counter + index);
+  uint8_t* body = nonce + kNonceSize;
+  bool ok = EVP_CipherInit_ex(seal, nullptr, nullptr, nullptr, nonce, -1) == 1 &&
+            (aad.empty() || EVP_CipherUpdate(seal, nullptr, &len, aad.data(), static_cast<int>(aad.size())) == 1) &&
+            (text_len == 0 || EVP_CipherUpdate(seal, body, &len, scratch, static_cast<int>(text_len)) == 1) &&
+            EVP_CipherFinal_ex(seal, body + text_len, &len) == 1 &&
+            EVP_CIPHER_CTX_ctrl(seal, EVP_CTRL_AEAD_GET_TAG, kTagSize, body + text_len) == 1;
+  OPENSSL_cleanse(scratch, text_len);
+  if (!ok) {
+    throw std::runtime_error("KeyRotation: Failed to encrypt record " + std::to_string(index) + ": " + getOpenSSLError());
+  }
+  out = std::move(sealed);
+  return true;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridKeyRotation::run(const Config& config, const RecordJob& job, size_t parallelism) {
+  const size_t count = job.records.size();
+  std::vector<std::shared_ptr<ArrayBuffer>> out(count);
+  auto worker = [&](size_t begin, size_t end, std::vector<size_t>& failed) {
+    CipherCtxPtr open = copyContext(config.open_ctx.get());
+    CipherCtxPtr seal = copyContext(config.seal_ctx.get());
+    // Sized for the largest record up front so it never reallocates and
+    // strands plaintext in freed memory
+    std::vector<uint8_t> scratch(job.max_plaintext + 1);
+    for (size_t i = begin; i < end; i++) {
+      if (!reencryptRecord(config, open.get(), seal.get(), job, i, scratch.data(), out[i])) {
+        failed.push_back(i);
+      }
+    }
+  };
+
+  std::vector<std::vector<size_t>> failed(parallelism);
+  parallelFor(parallelism, count, [&](size_t chunk, size_t begin, size_t end) { worker(begin, end, failed[chunk]); });
+
+  std::vector<size_t> all_failed;
+  for (auto& f : failed) {
+    all_failed.insert(all_failed.end(), f.begin(), f.end());
+  }
+  if (!all_failed.empty()) {
+    std::string records;
+    for (size_t i = 0; i < all_failed.size() && i < 8; i++) {
+      records += (i ? ", " : "") + std::to_string(all_failed[i]);
+    }
+    if (all_failed.size() > 8) {
+      records += ", ...";
+    }
+    throw std::runtime_error("KeyRotation: Unable to authenticate " + std::to_string(all_failed.size()) + " record(s): " + records);
+  }
+  return out;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>>
+HybridKeyRotation::reencryptBatch(const std::vector<std::shared_ptr<ArrayBuffer>>& records,
+                                  const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad, std::optional<double> parallelism) {
+  auto config = checkConfig();
+  auto job = prepareJob(records, aad, false);
+  return run(*config, job, resolveParallelism(parallelism, records.size()));
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridKeyRotation::reencryptBatchAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& records,
+                                       const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad,
+                                       std::optional<double> parallelism) {
+  auto config = checkConfig();
+  auto job = std::make_shared<const RecordJob>(prepareJob(records, aad, true));
+  size_t threads = resolveParallelism(parallelism, records.size());
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async(
+      [config, job, threads, queued = QueueWait::stamp("reencryptBatch")]() {
+        queued.started();
+        return run(*config, *job, threads);
+      });
+}
+
+} // namespace margelo::nitro::crypto
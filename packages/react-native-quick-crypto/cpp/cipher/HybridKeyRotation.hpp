@@ -0,0 +1,90 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <openssl/evp.h>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "HybridKeyRotationSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * Re-encrypts AEAD records from an old data-encryption key to a new one.
+ *
+ * Records use one self-contained layout for both keys:
+ *
+ *   | nonce (12) | ciphertext | tag (16) |
+ *
+ * Each record is opened with the old key into a per-thread scratch buffer,
+ * sealed under the new key straight from that buffer and the scratch is
+ * wiped, so plaintext never reaches JS. Both keys are scheduled once in
+ * template contexts that workers copy.
+ *
+ * New nonces are deterministic (NIST SP 800-38D 8.2.1): a 4-byte fixed field
+ * followed by a 64-bit big-endian invocation counter. A batch reserves its
+ * counter range up front, so concurrent batches never share a nonce; the
+ * counter is spent even if the batch then fails. The caller must pass the
+ * counter it persisted for the new key. Without an explicit fixed field each
+ * rotation draws a random one, so two rotations that restart from the same
+ * counter still use different nonces.
+ */
+class HybridKeyRotation : public HybridKeyRotationSpec {
+ public:
+  HybridKeyRotation() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void init(const KeyRotationArgs& args) override;
+  double getCounter() override;
+  std::vector<std::shared_ptr<ArrayBuffer>> reencryptBatch(const std::vector<std::shared_ptr<ArrayBuffer>>& records,
+                                                           const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad,
+                                                           std::optional<double> parallelism) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  reencryptBatchAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& records,
+                      const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad, std::optional<double> parallelism) override;
+
+ private:
+  // Immutable keyed state shared with in-flight async jobs
+  struct Config {
+    std::shared_ptr<EVP_CIPHER_CTX> open_ctx;
+    std::shared_ptr<EVP_CIPHER_CTX> seal_ctx;
+    std::array<uint8_t, 4> nonce_prefix{};
+  };
+
+  struct RecordJob {
+    std::vector<std::span<const uint8_t>> records;
+    std::vector<std::span<const uint8_t>> aad;
+    // Keeps copied inputs alive for async jobs
+    std::vector<std::shared_ptr<ArrayBuffer>> owned;
+    uint64_t first_counter = 0;
+    size_t max_plaintext = 0;
+  };
+
+  std::shared_ptr<const Config> checkConfig() const;
+  RecordJob prepareJob(const std::vector<std::shared_ptr<ArrayBuffer>>& records,
+                       const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad, bool copy);
+  uint64_t reserveCounters(size_t count);
+  static std::vector<std::shared_ptr<ArrayBuffer>> run(const Config& config, const RecordJob& job, size_t parallelism);
+  static bool reencryptRecord(const Config& config, EVP_CIPHER_CTX* open, EVP_CIPHER_CTX* seal, const RecordJob& job, size_t index,
+                              uint8_t* scratch, std::shared_ptr<ArrayBuffer>& out);
+
+ private:
+  static constexpr size_t kNonceSize = 12;
+  static constexpr size_t kTagSize = 16;
+  static constexpr size_t kOverhead = kNonceSize + kTagSize;
+
+  std::shared_ptr<const Config> config_;
+  std::mutex counter_mutex_;
+  uint64_t counter_ = 0;
+};
+
+} // namespace margelo::nitro::crypto
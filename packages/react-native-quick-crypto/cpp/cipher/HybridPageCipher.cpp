@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <stdexcept>
+#include <string>
+
+#include "HybridPageCipher.hpp"
+#include "LibraryContext.hpp"
+#include "ParallelFor.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+using CipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+std::shared_ptr<EVP_CIPHER_CTX> createKeyedContext(const EVP_CIPHER* cipher, const uint8_t* key, bool is_aead, bool encrypt) {
+  std::shared_ptr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+  if (!ctx) {
+    throw std::runtime_error("Failed to create cipher context");
+  }
+  int enc = encrypt ? 1 : 0;
+  if (EVP_CipherInit_ex(ctx.get(), cipher, nullptr, nullptr, nullptr, enc) != 1) {
+    throw std::runtime_error("PageCipher: Failed to initialize cipher: " + getOpenSSLError());
+  }
+  if (is_aead && EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_IVLEN, 12, nullptr) != 1) {
+    throw std::runtime_error("PageCipher: Failed to set nonce length: " + getOpenSSLError());
+  }
+  if (EVP_CipherInit_ex(ctx.get(), nullptr, nullptr, key, nullptr, enc) != 1) {
+    throw std::runtime_error("PageCipher: Failed to set key: " + getOpenSSLError());
+  }
+  return ctx;
+}
+
+} // namespace
+
+void HybridPageCipher::init(const PageCipherArgs& args) {
+  clearOpenSSLErrors();
+
+  EVP_CIPHER* cipher = fetchCipher(args.cipherType);
+  if (!cipher) {
+    throw std::runtime_error("Unsupported or unknown cipher type: " + args.cipherType);
+  }
+  std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher_guard(cipher, EVP_CIPHER_free);
+
+  int mode = EVP_CIPHER_get_mode(cipher);
+  bool is_chacha = EVP_CIPHER_get_nid(cipher) == NID_chacha20_poly1305;
+  if (mode != EVP_CIPH_GCM_MODE && mode != EVP_CIPH_XTS_MODE && !is_chacha) {
+    throw std::runtime_error("PageCipher supports AES-GCM, AES-XTS and ChaCha20-Poly1305, got: " + args.cipherType);
+  }
+
+  auto config = std::make_shared<Config>();
+  config->is_aead = mode != EVP_CIPH_XTS_MODE;
+
+  if (args.cipherKey->size() != static_cast<size_t>(EVP_CIPHER_get_key_length(cipher))) {
+    throw std::runtime_error("Invalid key length for " + args.cipherType + ": expected " +
+                             std::to_string(EVP_CIPHER_get_key_length(cipher)) + " bytes");
+  }
+
+  if (args.pageSize <= 0 || args.pageSize != std::floor(args.pageSize) || !CheckIsUint32(args.pageSize)) {
+    throw std::runtime_error("Invalid pageSize");
+  }
+  config->page_size = static_cast<size_t>(args.pageSize);
+
+  size_t min_reserve = config->is_aead ? kTrailerSize : 0;
+  config->reserve_size = min_reserve;
+  if (args.reserveSize.has_value()) {
+    double reserve = args.reserveSize.value();
+    if (reserve < 0 || reserve != std::floor(reserve) || reserve < static_cast<double>(min_reserve) || reserve >= args.pageSize) {
+      throw std::runtime_error("Invalid reserveSize: " + args.cipherType + " needs at least " + std::to_string(min_reserve) +
+                               " bytes and less than pageSize");
+    }
+    config->reserve_size = static_cast<size_t>(reserve);
+  }
+  // XTS cannot encrypt less than one AES block
+  if (config->page_size - config->reserve_size < 16) {
+    throw std::runtime_error("pageSize too small: payload must be at least 16 bytes");
+  }
+
+  auto native_key = ToNativeArrayBuffer(args.cipherKey);
+  config->enc_ctx = createKeyedContext(cipher, native_key->data(), config->is_aead, true);
+  config->dec_ctx = createKeyedContext(cipher, native_key->data(), config->is_aead, false);
+  OPENSSL_cleanse(native_key->data(), native_key->size());
+
+  config_ = std::move(config);
+}
+
+double HybridPageCipher::getReserveSize() {
+  return static_cast<double>(checkConfig()->reserve_size);
+}
+
+std::shared_ptr<const HybridPageCipher::Config> HybridPageCipher::checkConfig() const {
+  if (!config_) {
+    throw std::runtime_error("PageCipher not initialized. Call init() first.");
+  }
+  return config_;
+}
+
+HybridPageCipher::PageJob HybridPageCipher::prepareJob(const Config& config, const std::shared_ptr<ArrayBuffer>& pages,
+                                                       const std::vector<double>& pageNumbers,
+                                                       const std::vector<double>* writeCounters) const {
+  if (pages->size() != pageNumbers.size() * config.page_size) {
+    throw std::runtime_error("pages must be exactly pageNumbers.length * pageSize bytes (" +
+                             std::to_string(pageNumbers.size() * config.page_size) + "), got " + std::to_string(pages->size()));
+  }
+  PageJob job;
+  // Grab the pointer on the calling (JS) thread; async callers pass an owned copy
+  job.data = pages->data();
+  job.count = pageNumbers.size();
+  job.page_numbers.reserve(job.count);
+  for (double n : pageNumbers) {
+    if (n < 0 || n != std::floor(n) || n > kMaxSafeInteger) {
+      throw std::runtime_error("Invalid page number: " + std::to_string(n));
+    }
+    job.page_numbers.push_back(static_cast<uint64_t>(n));
+  }
+  if (writeCounters && config.is_aead) {
+    if (writeCounters->size() != job.count) {
+      throw std::runtime_error("writeCounters must have one entry per page");
+    }
+    job.write_counters.reserve(job.count);
+    for (double c : *writeCounters) {
+      if (c != std::floor(c) || !CheckIsUint32(c)) {
+        throw std::runtime_error("Invalid write counter: " + std::to_string(c));
+      }
+      job.write_counters.push_back(static_cast<uint32_t>(c));
+    }
+  }
+  return job;
+}
+
+bool HybridPageCipher::processPage(const Config& config, EVP_CIPHER_CTX* ctx, uint8_t* page, uint64_t page_number,
+                                   uint32_t write_counter, bool encrypt) {
+  const size_t payload_len = config.page_size - config.reserve_size;
+  uint8_t* trailer = page + config.page_size - kTrailerSize;
+
+  uint8_t iv[kXtsTweakSize] = {0};
+  storeLE64(iv, page_number);
+  if (config.is_aead) {
+    if (!encrypt) {
+      write_counter = loadLE32(trailer);
+    }
+    storeLE32(iv + 8, write_counter);
+  }
+
+  // Only the IV changes per page; the key schedule stays in the context
+  if (EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, iv, -1) != 1) {
+    throw std::runtime_error("PageCipher: Failed to set page IV: " + getOpenSSLError());
+  }
+  if (config.is_aead && !encrypt) {
+    if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, kTagSize, trailer + kCounterSize) != 1) {
+      throw std::runtime_error("PageCipher: Failed to set auth tag: " + getOpenSSLError());
+    }
+  }
+
+  int out_len = 0;
+  if (EVP_CipherUpdate(ctx, page, &out_len, page, static_cast<int>(payload_len)) != 1) {
+    throw std::runtime_error("PageCipher: Failed to process page " + std::to_string(page_number) + ": " + getOpenSSLError());
+  }
+  int final_len = 0;
+  if (EVP_CipherFinal_ex(ctx, page + out_len, &final_len) != 1) {
+    if (config.is_aead && !encrypt) {
+      // Never leave unauthenticated plaintext behind in the caller's buffer
+      clearOpenSSLErrors();
+      OPENSSL_cleanse(page, payload_len);
+      return false;
+    }
+    throw std::runtime_error("PageCipher: Failed to finalize page " + std::to_string(page_number) + ": " + getOpenSSLError());
+  }
+
+  if (config.is_aead && encrypt) {
+    storeLE32(trailer, write_counter);
+    if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, kTagSize, trailer + kCounterSize) != 1) {
+      throw std::runtime_error("PageCipher: Failed to get auth tag: " + getOpenSSLError());
+    }
+  }
+  return true;
+}
+
+void HybridPageCipher::processRange(const Config& config, EVP_CIPHER_CTX* ctx, const PageJob& job, bool encrypt, size_t begin,
+                                    size_t end, std::vector<uint64_t>& failed) {
+  for (size_t i = begin; i < end; i++) {
+    uint32_t counter = job.write_counters.empty() ? 0 : job.write_counters[i];
+    if (!processPage(config, ctx, job.data + i * config.page_size, job.page_numbers[i], counter, encrypt)) {
+      failed.push_back(job.page_numbers[i]);
+    }
+  }
+}
+
+void HybridPageCipher::run(const Config& config, const PageJob& job, bool encrypt, size_t parallelism) {
+  EVP_CIPHER_CTX* tmpl = encrypt ? config.enc_ctx.get() : config.dec_ctx.get();
+  auto worker = [&](size_t begin, size_t end, std::vector<uint64_t>& failed) {
+    // Copying a keyed context duplicates the expanded key, it does not redo it
+    CipherCtxPtr ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+    if (!ctx || EVP_CIPHER_CTX_copy(ctx.get(), tmpl) != 1) {
+      throw std::runtime_error("PageCipher: Failed to copy cipher context: " + getOpenSSLError());
+    }
+    processRange(config, ctx.get(), job, encrypt, begin, end, failed);
+  };
+
+  std::vector<std::vector<uint64_t>> failed(parallelism);
+  parallelFor(parallelism, job.count, [&](size_t chunk, size_t begin, size_t end) { worker(begin, end, failed[chunk]); });
+
+  std::vector<uint64_t> all_failed;
+  for (auto& f : failed) {
+    all_failed.insert(all_failed.end(), f.begin(), f.end());
+  }
+  if (!all_failed.empty()) {
+    std::sort(all_failed.begin(), all_failed.end());
+    std::string pages;
+    for (size_t i = 0; i < all_failed.size() && i < 8; i++) {
+      pages += (i ? ", " : "") + std::to_string(all_failed[i]);
+    }
+    if (all_failed.size() > 8) {
+      pages += ", ...";
+    }
+    throw std::runtime_error("PageCipher: Unable to authenticate " + std::to_string(all_failed.size()) + " page(s): " + pages);
+  }
+}
+
+void HybridPageCipher::encryptPages(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers,
+                                    const std::vector<double>& writeCounters, std::optional<double> parallelism) {
+  auto config = checkConfig();
+  auto job = prepareJob(*config, pages, pageNumbers, &writeCounters);
+  run(*config, job, true, resolveParallelism(parallelism, job.count));
+}
+
+void HybridPageCipher::decryptPages(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers,
+                                    std::optional<double> parallelism) {
+  auto config = checkConfig();
+  auto job = prepareJob(*config, pages, pageNumbers, nullptr);
+  run(*config, job, false, resolveParallelism(parallelism, job.count));
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridPageCipher::encryptPagesAsync(const std::shared_ptr<ArrayBuffer>& pages,
+                                                                                          const std::vector<double>& pageNumbers,
+                                                                                          const std::vector<double>& writeCounters,
+                                                                                          std::optional<double> parallelism) {
+  auto config = checkConfig();
+  // Work on an owned copy; the JS buffer may be reused or collected before the worker runs
+  auto native_pages = ToNativeArrayBuffer(pages);
+  auto job = prepareJob(*config, native_pages, pageNumbers, &writeCounters);
+  size_t threads = resolveParallelism(parallelism, job.count);
+  return Promise<std::shared_ptr<ArrayBuffer>>::async(
+      [config, job = std::move(job), native_pages, threads]() -> std::shared_ptr<ArrayBuffer> {
+        run(*config, job, true, threads);
+        return native_pages;
+      });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridPageCipher::decryptPagesAsync(const std::shared_ptr<ArrayBuffer>& pages,
+                                                                                          const std::vector<double>& pageNumbers,
+                                                                                          std::optional<double> parallelism) {
+  auto config = checkConfig();
+  auto native_pages = ToNativeArrayBuffer(pages);
+  auto job = prepareJob(*config, native_pages, pageNumbers, nullptr);
+  size_t threads = resolveParallelism(parallelism, job.count);
+  return Promise<std::shared_ptr<ArrayBuffer>>::async(
+      [config, job = std::move(job), native_pages, threads]() -> std::shared_ptr<ArrayBuffer> {
+        run(*config, job, false, threads);
+        return native_pages;
+      });
+}
+
+} // namespace margelo::nitro::crypto
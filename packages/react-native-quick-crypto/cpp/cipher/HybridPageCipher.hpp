@@ -0,0 +1,89 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <memory>
+#include <openssl/evp.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "HybridPageCipherSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * Fixed-size page encryption for encrypted local databases.
+ *
+ * One cipher context holds the key schedule; every page only re-keys the IV.
+ * Pages are encrypted in place inside a contiguous buffer of `pageSize`-byte
+ * pages; the async variants work on a copy and resolve with it.  For AEAD modes the last `kTrailerSize` bytes of each page's reserved
+ * area hold the write counter and the tag:
+ *
+ *   | payload (pageSize - reserveSize) | unused reserve | counter (4, LE) | tag (16) |
+ *
+ * AEAD nonce: page number (8 bytes LE) || write counter (4 bytes LE).
+ * XTS tweak:  page number (8 bytes LE) || 8 zero bytes, no reserved area.
+ */
+class HybridPageCipher : public HybridPageCipherSpec {
+ public:
+  HybridPageCipher() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void init(const PageCipherArgs& args) override;
+  double getReserveSize() override;
+  void encryptPages(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers,
+                    const std::vector<double>& writeCounters, std::optional<double> parallelism) override;
+  void decryptPages(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers,
+                    std::optional<double> parallelism) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> encryptPagesAsync(const std::shared_ptr<ArrayBuffer>& pages,
+                                                                           const std::vector<double>& pageNumbers,
+                                                                           const std::vector<double>& writeCounters,
+                                                                           std::optional<double> parallelism) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> decryptPagesAsync(const std::shared_ptr<ArrayBuffer>& pages,
+                                                                           const std::vector<double>& pageNumbers,
+                                                                           std::optional<double> parallelism) override;
+
+ private:
+  // Immutable keyed state shared with in-flight async jobs, so init() or
+  // destruction never races a worker.
+  struct Config {
+    bool is_aead = false;
+    size_t page_size = 0;
+    size_t reserve_size = 0;
+    // Keyed template contexts; workers copy them so the key schedule is
+    // computed once per init()
+    std::shared_ptr<EVP_CIPHER_CTX> enc_ctx;
+    std::shared_ptr<EVP_CIPHER_CTX> dec_ctx;
+  };
+
+  struct PageJob {
+    uint8_t* data = nullptr;
+    size_t count = 0;
+    std::vector<uint64_t> page_numbers;
+    std::vector<uint32_t> write_counters;
+  };
+
+  std::shared_ptr<const Config> checkConfig() const;
+  PageJob prepareJob(const Config& config, const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers,
+                     const std::vector<double>* writeCounters) const;
+  static void run(const Config& config, const PageJob& job, bool encrypt, size_t parallelism);
+  static void processRange(const Config& config, EVP_CIPHER_CTX* ctx, const PageJob& job, bool encrypt, size_t begin, size_t end,
+                           std::vector<uint64_t>& failed);
+  static bool processPage(const Config& config, EVP_CIPHER_CTX* ctx, uint8_t* page, uint64_t page_number, uint32_t write_counter,
+                          bool encrypt);
+
+ private:
+  static constexpr size_t kNonceSize = 12;
+  static constexpr size_t kCounterSize = 4;
+  static constexpr size_t kTagSize = 16;
+  static constexpr size_t kTrailerSize = kCounterSize + kTagSize;
+  static constexpr size_t kXtsTweakSize = 16;
+
+  std::shared_ptr<const Config> config_;
+};
+
+} // namespace margelo::nitro::crypto
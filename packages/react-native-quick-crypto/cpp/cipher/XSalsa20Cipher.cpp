@@ -33,17 +33,20 @@ void XSalsa20Cipher::init(const std::shared_ptr<ArrayBuffer> cipher_key, const s
 /**
  * xsalsa20 call to sodium implementation
  */
-std::shared_ptr<ArrayBuffer> XSalsa20Cipher::update(const std::shared_ptr<ArrayBuffer>& data) {
+std::shared_ptr<ArrayBuffer> XSalsa20Cipher::update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                                                    const std::optional<double>& byteLength) {
 #ifndef BLSALLOC_SODIUM
   throw std::runtime_error("XSalsa20Cipher: libsodium must be enabled to use this cipher (BLSALLOC_SODIUM is not defined).");
 #else
-  auto native_data = ToNativeArrayBuffer(data);
-  auto output = new uint8_t[native_data->size()];
-  int result = crypto_stream_xor(output, native_data->data(), native_data->size(), nonce, key);
+  checkNotBusy();
+  auto view = ToByteView(data, byteOffset, byteLength);
+  auto output = new uint8_t[view.size()];
+  int result = crypto_stream_xor(output, view.data(), view.size(), nonce, key);
   if (result != 0) {
     throw std::runtime_error("XSalsa20Cipher: Failed to update");
   }
-  return std::make_shared<NativeArrayBuffer>(output, native_data->size(), [=]() { delete[] output; });
+  workload.add(view.size());
+  return std::make_shared<NativeArrayBuffer>(output, view.size(), [=]() { delete[] output; });
 #endif
 }
 
@@ -54,6 +57,8 @@ std::shared_ptr<ArrayBuffer> XSalsa20Cipher::final() {
 #ifndef BLSALLOC_SODIUM
   throw std::runtime_error("XSalsa20Cipher: libsodium must be enabled to use this cipher (BLSALLOC_SODIUM is not defined).");
 #else
+  checkNotBusy();
+  recordWorkload();
   return std::make_shared<NativeArrayBuffer>(nullptr, 0, nullptr);
 #endif
 }
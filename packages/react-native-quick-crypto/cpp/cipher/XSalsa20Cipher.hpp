@@ -22,7 +22,8 @@ class XSalsa20Cipher : public HybridCipher {
   }
 
   void init(const std::shared_ptr<ArrayBuffer> cipher_key, const std::shared_ptr<ArrayBuffer> iv) override;
-  std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                                      const std::optional<double>& byteLength) override;
   std::shared_ptr<ArrayBuffer> final() override;
 
  private:
@@ -0,0 +1,331 @@
+#include <NitroModules/ArrayBuffer.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include "HybridCompressCipher.hpp"
+#include "LibraryContext.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+// Hand a vector's storage to JS without copying it again
+std::shared_ptr<ArrayBuffer> toArrayBuffer(std::vector<uint8_t>&& bytes) {
+  auto* owned = new std::vector<uint8_t>(std::move(bytes));
+  return std::make_shared<NativeArrayBuffer>(owned->data(), owned->size(), [=]() { delete owned; });
+}
+
+bool isSupportedAead(const EVP_CIPHER* cipher) {
+  return EVP_CIPHER_get_mode(cipher) == EVP_CIPH_GCM_MODE || EVP_CIPHER_get_nid(cipher) == NID_chacha20_poly1305;
+}
+
+} // namespace
+
+HybridCompressCipher::~HybridCompressCipher() {
+  reset();
+}
+
+void HybridCompressCipher::reset() {
+  if (ctx_) {
+    EVP_CIPHER_CTX_free(ctx_);
+    ctx_ = nullptr;
+  }
+  if (zstream_init_) {
+    if (encrypt_) {
+      deflateEnd(&zstream_);
+    } else {
+      inflateEnd(&zstream_);
+    }
+    zstream_init_ = false;
+  }
+  zstream_ = z_stream{};
+  finalized_ = false;
+  stream_end_ = false;
+  auth_tag_set_ = false;
+  total_output_ = 0;
+}
+
+void HybridCompressCipher::checkInitialized() const {
+  if (!ctx_ || !zstream_init_) {
+    throw std::runtime_error("CompressCipher not initialized. Call init() first.");
+  }
+  if (finalized_) {
+    throw std::runtime_error("CompressCipher already finalized");
+  }
+}
+
+void HybridCompressCipher::init(const CompressCipherArgs& args) {
+  clearOpenSSLErrors();
+  reset();
+
+  encrypt_ = args.encrypt;
+
+  EVP_CIPHER* cipher = fetchCipher(args.cipherType);
+  if (!cipher) {
+    throw std::runtime_error("Unsupported or unknown cipher type: " + args.cipherType);
+  }
+  if (!isSupportedAead(cipher)) {
+    EVP_CIPHER_free(cipher);
+    throw std::runtime_error("CompressCipher requires an AEAD cipher (AES-GCM or ChaCha20-Poly1305), got: " + args.cipherType);
+  }
+
+  auto native_key = ToNativeArrayBuffer(args.cipherKey);
+  auto native_iv = ToNativeArrayBuffer(args.iv);
+  if (static_cast<int>(native_key->size()) != EVP_CIPHER_get_key_length(cipher)) {
+    EVP_CIPHER_free(cipher);
+    throw std::runtime_error("Invalid key length for " + args.cipherType);
+  }
+
+  ctx_ = EVP_CIPHER_CTX_new();
+  if (!ctx_) {
+    EVP_CIPHER_free(cipher);
+    throw std::runtime_error("Failed to create cipher context");
+  }
+
+  int enc = encrypt_ ? 1 : 0;
+  bool ok = EVP_CipherInit_ex(ctx_, cipher, nullptr, nullptr, nullptr, enc) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_SET_IVLEN, static_cast<int>(native_iv->size()), nullptr) == 1 &&
+            EVP_CipherInit_ex(ctx_, nullptr, nullptr, native_key->data(), native_iv->data(), enc) == 1;
+  EVP_CIPHER_free(cipher);
+  if (!ok) {
+    EVP_CIPHER_CTX_free(ctx_);
+    ctx_ = nullptr;
+    throw std::runtime_error("CompressCipher: Failed to initialize cipher: " + getOpenSSLError());
+  }
+
+  auth_tag_len_ = kMaxTagSize;
+  if (args.authTagLen.has_value()) {
+    double tag_len = args.authTagLen.value();
+    if (tag_len < 4 || tag_len > kMaxTagSize) {
+      reset();
+      throw std::runtime_error("Invalid authentication tag length: " + std::to_string(tag_len));
+    }
+    auth_tag_len_ = static_cast<int>(tag_len);
+  }
+
+  max_output_length_ = kDefaultMaxOutputLength;
+  if (args.maxOutputLength.has_value()) {
+    double max_len = args.maxOutputLength.value();
+    if (max_len < 0 || max_len > static_cast<double>(SIZE_MAX)) {
+      reset();
+      throw std::runtime_error("Invalid maxOutputLength");
+    }
+    max_output_length_ = static_cast<size_t>(max_len);
+  }
+
+  int level = Z_DEFAULT_COMPRESSION;
+  if (args.level.has_value()) {
+    level = static_cast<int>(args.level.value());
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) {
+      reset();
+      throw std::runtime_error("Invalid compression level: " + std::to_string(level));
+    }
+  }
+
+  int zret = encrypt_ ? deflateInit(&zstream_, level) : inflateInit(&zstream_);
+  if (zret != Z_OK) {
+    reset();
+    throw std::runtime_error("CompressCipher: Failed to initialize zlib stream: " + std::to_string(zret));
+  }
+  zstream_init_ = true;
+  scratch_.resize(kChunkSize);
+}
+
+void HybridCompressCipher::setAAD(const std::shared_ptr<ArrayBuffer>& data) {
+  checkInitialized();
+  int out_len = 0;
+  if (EVP_CipherUpdate(ctx_, nullptr, &out_len, data->data(), static_cast<int>(data->size())) != 1) {
+    throw std::runtime_error("CompressCipher: Failed to set AAD: " + getOpenSSLError());
+  }
+}
+
+void HybridCompressCipher::deflateChunk(const uint8_t* data, size_t len, int flush, std::vector<uint8_t>& out) {
+  zstream_.next_in = const_cast<Bytef*>(data);
+  zstream_.avail_in = static_cast<uInt>(len);
+  do {
+    zstream_.next_out = scratch_.data();
+    zstream_.avail_out = static_cast<uInt>(scratch_.size());
+    int zret = deflate(&zstream_, flush);
+    if (zret == Z_STREAM_ERROR) {
+      throw std::runtime_error("CompressCipher: deflate failed");
+    }
+    size_t produced = scratch_.size() - zstream_.avail_out;
+    if (produced > 0) {
+      // AEAD stream ciphers emit exactly as many bytes as they consume
+      size_t offset = out.size();
+      out.resize(offset + produced);
+      int out_len = 0;
+      if (EVP_CipherUpdate(ctx_, out.data() + offset, &out_len, scratch_.data(), static_cast<int>(produced)) != 1) {
+        throw std::runtime_error("CompressCipher: Failed to encrypt: " + getOpenSSLError());
+      }
+      out.resize(offset + out_len);
+    }
+    if (zret == Z_STREAM_END) {
+      stream_end_ = true;
+      break;
+    }
+  } while (zstream_.avail_out == 0 || (flush == Z_FINISH && !stream_end_));
+}
+
+void HybridCompressCipher::inflateChunk(const uint8_t* data, size_t len, std::vector<uint8_t>& out) {
+  std::vector<uint8_t> plain(kChunkSize);
+  size_t consumed = 0;
+  while (consumed < len) {
+    size_t n = std::min(kChunkSize, len - consumed);
+    int plain_len = 0;
+    if (EVP_CipherUpdate(ctx_, plain.data(), &plain_len, data + consumed, static_cast<int>(n)) != 1) {
+      throw std::runtime_error("CompressCipher: Failed to decrypt: " + getOpenSSLError());
+    }
+    consumed += n;
+    if (stream_end_) {
+      if (plain_len > 0) {
+        throw std::runtime_error("CompressCipher: Unexpected data after end of compressed stream");
+      }
+      continue;
+    }
+
+    zstream_.next_in = plain.data();
+    zstream_.avail_in = static_cast<uInt>(plain_len);
+    while (zstream_.avail_in > 0 || zstream_.avail_out == 0) {
+      zstream_.next_out = scratch_.data();
+      zstream_.avail_out = static_cast<uInt>(scratch_.size());
+      int zret = inflate(&zstream_, Z_NO_FLUSH);
+      if (zret == Z_NEED_DICT || zret == Z_DATA_ERROR || zret == Z_MEM_ERROR || zret == Z_STREAM_ERROR) {
+        throw std::runtime_error("CompressCipher: Invalid compressed data: " + std::string(zstream_.msg ? zstream_.msg : "inflate failed"));
+      }
+      size_t produced = scratch_.size() - zstream_.avail_out;
+      total_output_ += produced;
+      if (total_output_ > max_output_length_) {
+        throw std::runtime_error("CompressCipher: Decompressed size exceeds maxOutputLength (" + std::to_string(max_output_length_) +
+                                 " bytes)");
+      }
+      out.insert(out.end(), scratch_.data(), scratch_.data() + produced);
+      if (zret == Z_STREAM_END) {
+        stream_end_ = true;
+        if (zstream_.avail_in > 0) {
+          throw std::runtime_error("CompressCipher: Unexpected data after end of compressed stream");
+        }
+        break;
+      }
+      if (zret == Z_BUF_ERROR) {
+        break;
+      }
+    }
+  }
+}
+
+std::shared_ptr<ArrayBuffer> HybridCompressCipher::update(const std::shared_ptr<ArrayBuffer>& data) {
+  checkInitialized();
+  std::vector<uint8_t> out;
+  const uint8_t* in = data->data();
+  size_t in_len = data->size();
+  if (encrypt_) {
+    // zlib's avail_in is 32 bits; feed very large inputs in slices
+    size_t offset = 0;
+    do {
+      size_t n = std::min(in_len - offset, static_cast<size_t>(UINT_MAX));
+      deflateChunk(in + offset, n, Z_NO_FLUSH, out);
+      offset += n;
+    } while (offset < in_len);
+  } else {
+    inflateChunk(in, in_len, out);
+  }
+  return toArrayBuffer(std::move(out));
+}
+
+void HybridCompressCipher::finalizeCipher(std::vector<uint8_t>& out) {
+  int out_len = 0;
+  uint8_t tail[EVP_MAX_BLOCK_LENGTH];
+  if (!encrypt_) {
+    if (!auth_tag_set_) {
+      throw std::runtime_error("CompressCipher: setAuthTag() must be called before final() when decrypting");
+    }
+    if (EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_SET_TAG, auth_tag_len_, auth_tag_) != 1) {
+      throw std::runtime_error("CompressCipher: Failed to set auth tag: " + getOpenSSLError());
+    }
+  }
+  if (EVP_CipherFinal_ex(ctx_, tail, &out_len) != 1) {
+    clearOpenSSLErrors();
+    throw std::runtime_error(encrypt_ ? "CompressCipher: Failed to finalize encryption"
+                                      : "CompressCipher: Unsupported state or unable to authenticate data");
+  }
+  out.insert(out.end(), tail, tail + out_len);
+  if (encrypt_) {
+    if (EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_GET_TAG, auth_tag_len_, auth_tag_) != 1) {
+      throw std::runtime_error("CompressCipher: Failed to get auth tag: " + getOpenSSLError());
+    }
+  }
+}
+
+std::shared_ptr<ArrayBuffer> HybridCompressCipher::final() {
+  checkInitialized();
+  std::vector<uint8_t> out;
+  if (encrypt_) {
+    deflateChunk(nullptr, 0, Z_FINISH, out);
+  } else if (!stream_end_) {
+    throw std::runtime_error("CompressCipher: Compressed stream is truncated");
+  }
+  finalizeCipher(out);
+  finalized_ = true;
+  return toArrayBuffer(std::move(out));
+}
+
+std::shared_ptr<ArrayBuffer> HybridCompressCipher::process(const std::shared_ptr<ArrayBuffer>& data) {
+  checkInitialized();
+  std::vector<uint8_t> out;
+  const uint8_t* in = data->data();
+  size_t in_len = data->size();
+  if (encrypt_) {
+    // Reserve the zlib worst case so the one-shot path never reallocates
+    out.reserve(deflateBound(&zstream_, static_cast<uLong>(in_len)));
+    size_t offset = 0;
+    while (in_len - offset > UINT_MAX) {
+      deflateChunk(in + offset, UINT_MAX, Z_NO_FLUSH, out);
+      offset += UINT_MAX;
+    }
+    deflateChunk(in + offset, in_len - offset, Z_FINISH, out);
+  } else {
+    inflateChunk(in, in_len, out);
+    if (!stream_end_) {
+      throw std::runtime_error("CompressCipher: Compressed stream is truncated");
+    }
+  }
+  finalizeCipher(out);
+  finalized_ = true;
+  return toArrayBuffer(std::move(out));
+}
+
+void HybridCompressCipher::setAuthTag(const std::shared_ptr<ArrayBuffer>& tag) {
+  checkInitialized();
+  if (encrypt_) {
+    throw std::runtime_error("setAuthTag can only be called during decryption");
+  }
+  if (tag->size() != static_cast<size_t>(auth_tag_len_)) {
+    throw std::runtime_error("Invalid authentication tag length: expected " + std::to_string(auth_tag_len_) + " bytes");
+  }
+  std::memcpy(auth_tag_, tag->data(), auth_tag_len_);
+  auth_tag_set_ = true;
+}
+
+std::shared_ptr<ArrayBuffer> HybridCompressCipher::getAuthTag() {
+  if (!encrypt_) {
+    throw std::runtime_error("getAuthTag can only be called during encryption");
+  }
+  if (!finalized_) {
+    throw std::runtime_error("getAuthTag must be called after final()");
+  }
+  uint8_t* tag = new uint8_t[auth_tag_len_];
+  std::memcpy(tag, auth_tag_, auth_tag_len_);
+  return std::make_shared<NativeArrayBuffer>(tag, auth_tag_len_, [=]() { delete[] tag; });
+}
+
+} // namespace margelo::nitro::crypto
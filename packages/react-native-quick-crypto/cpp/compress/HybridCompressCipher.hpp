@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <openssl/evp.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include "HybridCompressCipherSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * Compress-then-encrypt stage.
+ *
+ * Encryption deflates the plaintext (zlib format, so the output can be
+ * inflated by pako/zlib after decryption) and seals the compressed stream
+ * with an AEAD cipher (AES-GCM or ChaCha20-Poly1305).  Decryption opens the
+ * AEAD stream and inflates it, enforcing `maxOutputLength` so a small
+ * ciphertext cannot expand into an unbounded allocation.
+ *
+ * Both directions run through fixed-size scratch buffers, so memory use is
+ * bounded by the produced output rather than by zlib's internal buffering.
+ */
+class HybridCompressCipher : public HybridCompressCipherSpec {
+ public:
+  HybridCompressCipher() : HybridObject(TAG) {}
+  ~HybridCompressCipher();
+
+ public:
+  // Methods
+  void init(const CompressCipherArgs& args) override;
+  void setAAD(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> final() override;
+  std::shared_ptr<ArrayBuffer> process(const std::shared_ptr<ArrayBuffer>& data) override;
+  void setAuthTag(const std::shared_ptr<ArrayBuffer>& tag) override;
+  std::shared_ptr<ArrayBuffer> getAuthTag() override;
+
+ private:
+  void reset();
+  void checkInitialized() const;
+  void deflateChunk(const uint8_t* data, size_t len, int flush, std::vector<uint8_t>& out);
+  void inflateChunk(const uint8_t* data, size_t len, std::vector<uint8_t>& out);
+  void finalizeCipher(std::vector<uint8_t>& out);
+
+ private:
+  // zlib/OpenSSL work in chunks of this size; keeps scratch memory constant
+  static constexpr size_t kChunkSize = 16 * 1024;
+  // Default decompression limit when the caller does not pass one
+  static constexpr size_t kDefaultMaxOutputLength = 64 * 1024 * 1024;
+  static constexpr int kMaxTagSize = 16;
+
+  bool encrypt_ = true;
+  bool finalized_ = false;
+  bool stream_end_ = false;
+  bool zstream_init_ = false;
+  EVP_CIPHER_CTX* ctx_ = nullptr;
+  z_stream zstream_{};
+  int auth_tag_len_ = kMaxTagSize;
+  uint8_t auth_tag_[kMaxTagSize]{};
+  bool auth_tag_set_ = false;
+  size_t max_output_length_ = kDefaultMaxOutputLength;
+  size_t total_output_ = 0;
+  std::vector<uint8_t> scratch_;
+};
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,399 @@
+#include <cmath>
+#include <openssl/core_names.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "HybridDiffieHellman.hpp"
+#include "LibraryContext.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  using BN_CTX_ptr = std::unique_ptr<BN_CTX, decltype(&BN_CTX_free)>;
+
+  // openssl/dh.h values, which Node exposes as crypto.constants
+  constexpr int kCheckPNotPrime = 0x01;
+  constexpr int kCheckPNotSafePrime = 0x02;
+  constexpr int kNotSuitableGenerator = 0x08;
+
+  // Same bounds as OpenSSL's DH parameter generation
+  constexpr double kMinPrimeBits = 512;
+  constexpr double kMaxPrimeBits = 10000;
+
+  enum class Source { Rfc2409, Rfc3526, Ffdhe };
+
+  struct NamedGroup {
+    const char* name;
+    Source source;
+    int bits;
+    // Exponent length OpenSSL uses for the group (crypto/ffc/ffc_dh.c); 0 for
+    // the legacy 768/1024-bit groups it does not name
+    int privateBits;
+  };
+
+  constexpr NamedGroup kNamedGroups[] = {
+      {"modp1", Source::Rfc2409, 768, 0},         {"modp2", Source::Rfc2409, 1024, 0},        {"modp5", Source::Rfc3526, 1536, 200},
+      {"modp14", Source::Rfc3526, 2048, 225},     {"modp15", Source::Rfc3526, 3072, 275},     {"modp16", Source::Rfc3526, 4096, 325},
+      {"modp17", Source::Rfc3526, 6144, 375},     {"modp18", Source::Rfc3526, 8192, 400},     {"ffdhe2048", Source::Ffdhe, 2048, 225},
+      {"ffdhe3072", Source::Ffdhe, 3072, 275},    {"ffdhe4096", Source::Ffdhe, 4096, 325},    {"ffdhe6144", Source::Ffdhe, 6144, 375},
+      {"ffdhe8192", Source::Ffdhe, 8192, 400},
+  };
+
+  BIGNUM* rfcPrime(const NamedGroup& group) {
+    switch (group.bits) {
+      case 768:
+        return BN_get_rfc2409_prime_768(nullptr);
+      case 1024:
+        return BN_get_rfc2409_prime_1024(nullptr);
+      case 1536:
+        return BN_get_rfc3526_prime_1536(nullptr);
+      case 2048:
+        return BN_get_rfc3526_prime_2048(nullptr);
+      case 3072:
+        return BN_get_rfc3526_prime_3072(nullptr);
+      case 4096:
+        return BN_get_rfc3526_prime_4096(nullptr);
+      case 6144:
+        return BN_get_rfc3526_prime_6144(nullptr);
+      case 8192:
+        return BN_get_rfc3526_prime_8192(nullptr);
+    }
+    return nullptr;
+  }
+
+  // RFC 7919 primes have no BN_get_* accessor; take them from the provider's
+  // named-group table
+  BIGNUM* ffdhePrime(const NamedGroup& group) {
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new_from_name(libraryContext(), "DH", nullptr),
+                                                                    EVP_PKEY_CTX_free);
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, const_cast<char*>(group.name), 0),
+        OSSL_PARAM_construct_end(),
+    };
+    EVP_PKEY* pkey = nullptr;
+    if (!ctx || EVP_PKEY_fromdata_init(ctx.get()) <= 0 || EVP_PKEY_fromdata(ctx.get(), &pkey, EVP_PKEY_KEY_PARAMETERS, params) <= 0) {
+      return nullptr;
+    }
+    BIGNUM* p = nullptr;
+    EVP_PKEY_get_bn_param(pkey, OSSL_PKEY_PARAM_FFC_P, &p);
+    EVP_PKEY_free(pkey);
+    return p;
+  }
+
+  BN_CTX_ptr newContext() {
+    BN_CTX_ptr ctx(BN_CTX_secure_new_ex(libraryContext()), BN_CTX_free);
+    if (!ctx) {
+      throw std::runtime_error("Failed to allocate BN_CTX");
+    }
+    return ctx;
+  }
+
+  std::shared_ptr<ArrayBuffer> toBuffer(const BIGNUM* bn, size_t size) {
+    auto buffer = ArrayBuffer::allocate(size);
+    if (BN_bn2binpad(bn, buffer->data(), static_cast<int>(size)) < 0) {
+      throw std::runtime_error("Failed to encode big number");
+    }
+    return buffer;
+  }
+
+} // namespace
+
+std::shared_ptr<const HybridDiffieHellman::Group> HybridDiffieHellman::makeGroup(BignumPtr p, BignumPtr g, int privateBits) {
+  auto ctx = newContext();
+  auto group = std::make_shared<Group>();
+  group->mont.reset(BN_MONT_CTX_new());
+  if (!group->mont || BN_MONT_CTX_set(group->mont.get(), p.get(), ctx.get()) != 1) {
+    throw std::runtime_error("Failed to set up Montgomery context: " + getOpenSSLError());
+  }
+  group->size = static_cast<size_t>(BN_num_bytes(p.get()));
+  group->privateBits = privateBits;
+  group->p = std::move(p);
+  group->g = std::move(g);
+  return group;
+}
+
+std::shared_ptr<const HybridDiffieHellman::Group> HybridDiffieHellman::namedGroup(const std::string& name) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<const Group>> cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto cached = cache.find(name);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+  for (const auto& named : kNamedGroups) {
+    if (name != named.name) {
+      continue;
+    }
+    BignumPtr p(named.source == Source::Ffdhe ? ffdhePrime(named) : rfcPrime(named), BN_clear_free);
+    BignumPtr g(BN_new(), BN_clear_free);
+    if (!p || !g || BN_set_word(g.get(), 2) != 1) {
+      throw std::runtime_error("Failed to load Diffie-Hellman group " + name + ": " + getOpenSSLError());
+    }
+    // Published safe primes with generator 2; nothing to report
+    auto group = makeGroup(std::move(p), std::move(g), named.privateBits);
+    std::call_once(group->checked, []() {});
+    return cache.emplace(name, std::move(group)).first->second;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const HybridDiffieHellman::Group> HybridDiffieHellman::generateGroup(double primeLength, double generator) {
+  if (primeLength < kMinPrimeBits || primeLength > kMaxPrimeBits || primeLength != std::floor(primeLength)) {
+    throw std::runtime_error("primeLength must be an integer between 512 and 10000");
+  }
+  if (generator < 2 || !CheckIsUint32(generator) || generator != std::floor(generator)) {
+    throw std::runtime_error("Bad generator");
+  }
+  auto g32 = static_cast<uint32_t>(generator);
+
+  // Safe prime p with p mod add == rem, so that g generates the subgroup of
+  // order (p - 1) / 2; same congruences as OpenSSL's DH_generate_parameters
+  BignumPtr add(BN_new(), BN_clear_free);
+  BignumPtr rem(BN_new(), BN_clear_free);
+  BignumPtr p(BN_new(), BN_clear_free);
+  BignumPtr g(BN_new(), BN_clear_free);
+  if (!add || !rem || !p || !g) {
+    throw std::runtime_error("Failed to allocate big numbers");
+  }
+  BN_ULONG modulus = g32 == 2 ? 24 : g32 == 5 ? 60 : 12;
+  BN_set_word(add.get(), modulus);
+  BN_set_word(rem.get(), modulus - 1);
+  BN_set_word(g.get(), g32);
+
+  auto ctx = newContext();
+  if (BN_generate_prime_ex2(p.get(), static_cast<int>(primeLength), 1, add.get(), rem.get(), nullptr, ctx.get()) != 1) {
+    throw std::runtime_error("Failed to generate prime: " + getOpenSSLError());
+  }
+  return makeGroup(std::move(p), std::move(g), 0);
+}
+
+void HybridDiffieHellman::initGroup(const std::string& name) {
+  auto group = namedGroup(name);
+  if (!group) {
+    throw std::runtime_error("Unknown DH group: " + name);
+  }
+  group_ = std::move(group);
+  privateKey_.reset();
+  publicKey_.reset();
+}
+
+void HybridDiffieHellman::init(const std::shared_ptr<ArrayBuffer>& prime, const std::shared_ptr<ArrayBuffer>& generator) {
+  auto primeBytes = ToByteView(prime);
+  auto generatorBytes = ToByteView(generator);
+  BignumPtr p(BN_bin2bn(primeBytes.data(), static_cast<int>(primeBytes.size()), nullptr), BN_clear_free);
+  BignumPtr g(BN_bin2bn(generatorBytes.data(), static_cast<int>(generatorBytes.size()), nullptr), BN_clear_free);
+  if (!p || !g) {
+    throw std::runtime_error("Failed to read Diffie-Hellman parameters");
+  }
+  if (BN_num_bits(p.get()) < 2 || !BN_is_odd(p.get())) {
+    throw std::runtime_error("Invalid prime");
+  }
+  BignumPtr pMinusOne(BN_dup(p.get()), BN_clear_free);
+  if (!pMinusOne || BN_sub_word(pMinusOne.get(), 1) != 1) {
+    throw std::runtime_error("Failed to read Diffie-Hellman parameters");
+  }
+  if (BN_is_zero(g.get()) || BN_is_one(g.get()) || BN_cmp(g.get(), pMinusOne.get()) >= 0) {
+    throw std::runtime_error("Bad generator");
+  }
+  group_ = makeGroup(std::move(p), std::move(g), 0);
+  privateKey_.reset();
+  publicKey_.reset();
+}
+
+void HybridDiffieHellman::generateParametersSync(double primeLength, double generator) {
+  group_ = generateGroup(primeLength, generator);
+  privateKey_.reset();
+  publicKey_.reset();
+}
+
+std::shared_ptr<Promise<void>> HybridDiffieHellman::generateParameters(double primeLength, double generator) {
+  // The JS wrapper hands the instance out only once this settles
+  return Promise<void>::async([self = strongRef(this), primeLength, generator, queued = QueueWait::stamp("dhGenerateParameters")]() {
+    queued.started();
+    self->generateParametersSync(primeLength, generator);
+  });
+}
+
+const HybridDiffieHellman::Group& HybridDiffieHellman::checkGroup() const {
+  if (!group_) {
+    throw std::runtime_error("Diffie-Hellman parameters are not initialized");
+  }
+  return *group_;
+}
+
+const BIGNUM* HybridDiffieHellman::checkPrivateKey() const {
+  if (!privateKey_) {
+    throw std::runtime_error("No private key - did you forget to generate one?");
+  }
+  return privateKey_.get();
+}
+
+std::shared_ptr<ArrayBuffer> HybridDiffieHellman::generateKeys() {
+  const Group& group = checkGroup();
+  auto ctx = newContext();
+
+  // Like DH_generate_key, an existing private key is kept and only the public
+  // key is (re)computed
+  if (!privateKey_) {
+    BignumPtr x(BN_secure_new(), BN_clear_free);
+    int bits = group.privateBits > 0 ? group.privateBits : BN_num_bits(group.p.get()) - 1;
+    if (!x || BN_priv_rand_ex(x.get(), bits, BN_RAND_TOP_ONE, BN_RAND_BOTTOM_ANY, 0, ctx.get()) != 1) {
+      throw std::runtime_error("Failed to generate private key: " + getOpenSSLError());
+    }
+    BN_set_flags(x.get(), BN_FLG_CONSTTIME);
+    privateKey_ = std::shared_ptr<const BIGNUM>(x.release(), BN_clear_free);
+  }
+
+  BignumPtr y(BN_new(), BN_clear_free);
+  if (!y || BN_mod_exp_mont_consttime(y.get(), group.g.get(), privateKey_.get(), group.p.get(), ctx.get(), group.mont.get()) != 1) {
+    throw std::runtime_error("Failed to compute public key: " + getOpenSSLError());
+  }
+  publicKey_ = std::move(y);
+  return toBuffer(publicKey_.get(), static_cast<size_t>(BN_num_bytes(publicKey_.get())));
+}
+
+std::shared_ptr<ArrayBuffer> HybridDiffieHellman::deriveSecret(const Group& group, const BIGNUM* privateKey,
+                                                               std::span<const uint8_t> publicKey, BN_CTX* ctx) {
+  BignumPtr y(BN_bin2bn(publicKey.data(), static_cast<int>(publicKey.size()), nullptr), BN_clear_free);
+  if (!y) {
+    throw std::runtime_error("Failed to read public key");
+  }
+  // 1 < y < p - 1, as DH_check_pub_key; rules out the degenerate secrets
+  if (BN_is_zero(y.get()) || BN_is_one(y.get())) {
+    throw std::runtime_error("Supplied key is too small");
+  }
+  BignumPtr pMinusOne(BN_dup(group.p.get()), BN_clear_free);
+  if (!pMinusOne || BN_sub_word(pMinusOne.get(), 1) != 1) {
+    throw std::runtime_error("Failed to compute secret");
+  }
+  if (BN_cmp(y.get(), pMinusOne.get()) >= 0) {
+    throw std::runtime_error("Supplied key is too large");
+  }
+
+  BignumPtr z(BN_secure_new(), BN_clear_free);
+  if (!z || BN_mod_exp_mont_consttime(z.get(), y.get(), privateKey, group.p.get(), ctx, group.mont.get()) != 1) {
+    throw std::runtime_error("Failed to compute secret: " + getOpenSSLError());
+  }
+  // Zero-padded to the size of p, like Node
+  return toBuffer(z.get(), group.size);
+}
+
+std::shared_ptr<ArrayBuffer> HybridDiffieHellman::computeSecret(const std::shared_ptr<ArrayBuffer>& publicKey) {
+  const Group& group = checkGroup();
+  const BIGNUM* privateKey = checkPrivateKey();
+  auto ctx = newContext();
+  return deriveSecret(group, privateKey, ToByteView(publicKey), ctx.get());
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridDiffieHellman::computeSecrets(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) {
+  const Group& group = checkGroup();
+  const BIGNUM* privateKey = checkPrivateKey();
+  auto ctx = newContext();
+  std::vector<std::shared_ptr<ArrayBuffer>> secrets;
+  secrets.reserve(publicKeys.size());
+  for (const auto& publicKey : publicKeys) {
+    secrets.push_back(deriveSecret(group, privateKey, ToByteView(publicKey), ctx.get()));
+  }
+  return secrets;
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridDiffieHellman::computeSecretsAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) {
+  auto group = group_;
+  checkGroup();
+  checkPrivateKey();
+  std::vector<std::shared_ptr<ArrayBuffer>> nativeKeys;
+  nativeKeys.reserve(publicKeys.size());
+  for (const auto& publicKey : publicKeys) {
+    nativeKeys.push_back(ToNativeArrayBuffer(publicKey));
+  }
+
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async(
+      [group, privateKey = privateKey_, nativeKeys = std::move(nativeKeys), queued = QueueWait::stamp("dhComputeSecrets")]() {
+        queued.started();
+        auto ctx = newContext();
+        std::vector<std::shared_ptr<ArrayBuffer>> secrets;
+        secrets.reserve(nativeKeys.size());
+        for (const auto& publicKey : nativeKeys) {
+          secrets.push_back(deriveSecret(*group, privateKey.get(), ToByteView(publicKey), ctx.get()));
+        }
+        return secrets;
+      });
+}
+
+std::shared_ptr<ArrayBuffer> HybridDiffieHellman::getPrime() {
+  const Group& group = checkGroup();
+  return toBuffer(group.p.get(), group.size);
+}
+
+std::shared_ptr<ArrayBuffer> HybridDiffieHellman::getGenerator() {
+  const Group& group = checkGroup();
+  return toBuffer(group.g.get(), static_cast<size_t>(BN_num_bytes(group.g.get())));
+}
+
+std::shared_ptr<ArrayBuffer> HybridDiffieHellman::getPublicKey() {
+  if (!publicKey_) {
+    throw std::runtime_error("No public key - did you forget to generate one?");
+  }
+  return toBuffer(publicKey_.get(), static_cast<size_t>(BN_num_bytes(publicKey_.get())));
+}
+
+std::shared_ptr<ArrayBuffer> HybridDiffieHellman::getPrivateKey() {
+  const BIGNUM* privateKey = checkPrivateKey();
+  return toBuffer(privateKey, static_cast<size_t>(BN_num_bytes(privateKey)));
+}
+
+void HybridDiffieHellman::setPublicKey(const std::shared_ptr<ArrayBuffer>& publicKey) {
+  auto bytes = ToByteView(publicKey);
+  BignumPtr y(BN_bin2bn(bytes.data(), static_cast<int>(bytes.size()), nullptr), BN_clear_free);
+  if (!y) {
+    throw std::runtime_error("Failed to read public key");
+  }
+  publicKey_ = std::move(y);
+}
+
+void HybridDiffieHellman::setPrivateKey(const std::shared_ptr<ArrayBuffer>& privateKey) {
+  auto bytes = ToByteView(privateKey);
+  BignumPtr x(BN_secure_new(), BN_clear_free);
+  if (!x || BN_bin2bn(bytes.data(), static_cast<int>(bytes.size()), x.get()) == nullptr) {
+    throw std::runtime_error("Failed to read private key");
+  }
+  BN_set_flags(x.get(), BN_FLG_CONSTTIME);
+  // Like Node, the public key is left alone until generateKeys()
+  privateKey_ = std::shared_ptr<const BIGNUM>(x.release(), BN_clear_free);
+}
+
+double HybridDiffieHellman::getVerifyError() {
+  const Group& group = checkGroup();
+  // Primality tests on p and (p - 1) / 2 take a while for large primes, so
+  // they run once per group rather than on construction
+  std::call_once(group.checked, [&group]() {
+    auto ctx = newContext();
+    BignumPtr q(BN_dup(group.p.get()), BN_clear_free);
+    BignumPtr pMinusOne(BN_dup(group.p.get()), BN_clear_free);
+    if (!q || !pMinusOne || BN_sub_word(pMinusOne.get(), 1) != 1 || BN_rshift1(q.get(), pMinusOne.get()) != 1) {
+      throw std::runtime_error("Failed to check Diffie-Hellman parameters");
+    }
+    int flags = 0;
+    if (BN_is_one(group.g.get()) || BN_cmp(group.g.get(), pMinusOne.get()) >= 0) {
+      flags |= kNotSuitableGenerator;
+    }
+    if (BN_check_prime(group.p.get(), ctx.get(), nullptr) != 1) {
+      flags |= kCheckPNotPrime;
+    } else if (BN_check_prime(q.get(), ctx.get(), nullptr) != 1) {
+      flags |= kCheckPNotSafePrime;
+    }
+    ERR_clear_error();
+    group.verifyError = flags;
+  });
+  return group.verifyError;
+}
+
+} // namespace margelo::nitro::crypto
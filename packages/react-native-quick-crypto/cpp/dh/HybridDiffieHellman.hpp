@@ -0,0 +1,86 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <memory>
+#include <mutex>
+#include <openssl/bn.h>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "HybridDiffieHellmanSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * Finite-field Diffie-Hellman (Node's DiffieHellman / DiffieHellmanGroup).
+ *
+ * A group is p, g and a Montgomery context for p, immutable once built and
+ * shared between instances and in-flight async jobs. The well-known groups
+ * (RFC 2409/3526 MODP, RFC 7919 FFDHE) are built once per process and cached
+ * by name, so getDiffieHellman('modp15') only pays for key generation.
+ *
+ * Exponentiations with the private key use BN_mod_exp_mont_consttime against
+ * the cached context. For the well-known safe-prime groups the private key is
+ * drawn with OpenSSL's exponent lengths for those groups (RFC 7919 section 5.2,
+ * e.g. 275 bits for 3072-bit groups) instead of the full width of p; custom
+ * primes use |p| - 1 bits like OpenSSL's DH_generate_key.
+ */
+class HybridDiffieHellman : public HybridDiffieHellmanSpec {
+ public:
+  HybridDiffieHellman() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void initGroup(const std::string& name) override;
+  void init(const std::shared_ptr<ArrayBuffer>& prime, const std::shared_ptr<ArrayBuffer>& generator) override;
+  void generateParametersSync(double primeLength, double generator) override;
+  std::shared_ptr<Promise<void>> generateParameters(double primeLength, double generator) override;
+  std::shared_ptr<ArrayBuffer> generateKeys() override;
+  std::shared_ptr<ArrayBuffer> computeSecret(const std::shared_ptr<ArrayBuffer>& publicKey) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> computeSecrets(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  computeSecretsAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) override;
+  std::shared_ptr<ArrayBuffer> getPrime() override;
+  std::shared_ptr<ArrayBuffer> getGenerator() override;
+  std::shared_ptr<ArrayBuffer> getPublicKey() override;
+  std::shared_ptr<ArrayBuffer> getPrivateKey() override;
+  void setPublicKey(const std::shared_ptr<ArrayBuffer>& publicKey) override;
+  void setPrivateKey(const std::shared_ptr<ArrayBuffer>& privateKey) override;
+  double getVerifyError() override;
+
+ private:
+  using BignumPtr = std::unique_ptr<BIGNUM, decltype(&BN_clear_free)>;
+
+  struct Group {
+    BignumPtr p{nullptr, BN_clear_free};
+    BignumPtr g{nullptr, BN_clear_free};
+    std::unique_ptr<BN_MONT_CTX, decltype(&BN_MONT_CTX_free)> mont{nullptr, BN_MONT_CTX_free};
+    // Private key length in bits; 0 means |p| - 1
+    int privateBits = 0;
+    // Byte length of p, the width shared secrets are padded to
+    size_t size = 0;
+    // DH_CHECK_* flags, computed on first getVerifyError()
+    mutable std::once_flag checked;
+    mutable int verifyError = 0;
+  };
+
+  // Cached well-known group, or nullptr for an unknown name
+  static std::shared_ptr<const Group> namedGroup(const std::string& name);
+  static std::shared_ptr<const Group> makeGroup(BignumPtr p, BignumPtr g, int privateBits);
+  static std::shared_ptr<const Group> generateGroup(double primeLength, double generator);
+  static std::shared_ptr<ArrayBuffer> deriveSecret(const Group& group, const BIGNUM* privateKey, std::span<const uint8_t> publicKey,
+                                                   BN_CTX* ctx);
+  const Group& checkGroup() const;
+  const BIGNUM* checkPrivateKey() const;
+
+  std::shared_ptr<const Group> group_;
+  // Shared with in-flight computeSecretsAsync jobs; replaced, never mutated
+  std::shared_ptr<const BIGNUM> privateKey_;
+  BignumPtr publicKey_{nullptr, BN_clear_free};
+};
+
+} // namespace margelo::nitro::crypto
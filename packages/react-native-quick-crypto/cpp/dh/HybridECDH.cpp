@@ -0,0 +1,303 @@
+#include <openssl/obj_mac.h>
+#include <openssl/objects.h>
+#include <stdexcept>
+
+#include "HybridECDH.hpp"
+#include "LibraryContext.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  using BN_CTX_ptr = std::unique_ptr<BN_CTX, decltype(&BN_CTX_free)>;
+  using BignumPtr = std::unique_ptr<BIGNUM, decltype(&BN_clear_free)>;
+  using OwnedPoint = std::unique_ptr<EC_POINT, decltype(&EC_POINT_clear_free)>;
+
+  // Parsed peer points kept per curve
+  constexpr size_t kPointCacheSize = 64;
+
+  BN_CTX_ptr newContext() {
+    BN_CTX_ptr ctx(BN_CTX_secure_new_ex(libraryContext()), BN_CTX_free);
+    if (!ctx) {
+      throw std::runtime_error("Failed to allocate BN_CTX");
+    }
+    return ctx;
+  }
+
+  std::shared_ptr<ArrayBuffer> toBuffer(const BIGNUM* bn, size_t size) {
+    auto buffer = ArrayBuffer::allocate(size);
+    if (BN_bn2binpad(bn, buffer->data(), static_cast<int>(size)) < 0) {
+      throw std::runtime_error("Failed to encode big number");
+    }
+    return buffer;
+  }
+
+  // Node's curve names are OpenSSL short names (prime256v1, secp384r1); the
+  // NIST names (P-256) are accepted as well
+  int curveNid(const std::string& name) {
+    int nid = OBJ_sn2nid(name.c_str());
+    if (nid == NID_undef) {
+      nid = EC_curve_nist2nid(name.c_str());
+    }
+    return nid;
+  }
+
+  std::shared_ptr<const EC_POINT> multiply(const EC_GROUP* group, const BIGNUM* scalar, const EC_POINT* point, BN_CTX* ctx) {
+    OwnedPoint result(EC_POINT_new(group), EC_POINT_clear_free);
+    // Single-scalar EC_POINT_mul runs OpenSSL's constant-time ladder (or the
+    // curve's own constant-time code for P-256/P-384/P-521)
+    int ok = point == nullptr ? EC_POINT_mul(group, result.get(), scalar, nullptr, nullptr, ctx)
+                              : EC_POINT_mul(group, result.get(), nullptr, point, scalar, ctx);
+    if (!result || ok != 1 || EC_POINT_is_at_infinity(group, result.get())) {
+      throw std::runtime_error("Failed to compute ECDH key: " + getOpenSSLError());
+    }
+    return std::shared_ptr<const EC_POINT>(result.release(), EC_POINT_clear_free);
+  }
+
+} // namespace
+
+std::shared_ptr<const HybridECDH::Curve> HybridECDH::namedCurve(const std::string& name) {
+  static std::mutex mutex;
+  static std::unordered_map<int, std::shared_ptr<const Curve>> cache;
+
+  int nid = curveNid(name);
+  if (nid == NID_undef) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  auto cached = cache.find(nid);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+  auto curve = std::make_shared<Curve>();
+  curve->group.reset(EC_GROUP_new_by_curve_name_ex(libraryContext(), nullptr, nid));
+  if (!curve->group) {
+    clearOpenSSLErrors();
+    return nullptr;
+  }
+  // Binary curves are not supported by ECDH here, as in WebCrypto
+  if (EC_GROUP_get_field_type(curve->group.get()) != NID_X9_62_prime_field) {
+    return nullptr;
+  }
+  curve->size = static_cast<size_t>((EC_GROUP_get_degree(curve->group.get()) + 7) / 8);
+  return cache.emplace(nid, std::move(curve)).first->second;
+}
+
+HybridECDH::PointPtr HybridECDH::parsePoint(const Curve& curve, std::span<const uint8_t> encoded, BN_CTX* ctx) {
+  std::string key(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+  {
+    std::lock_guard<std::mutex> lock(curve.mutex);
+    auto cached = curve.index.find(key);
+    if (cached != curve.index.end()) {
+      curve.points.splice(curve.points.begin(), curve.points, cached->second);
+      return cached->second->second;
+    }
+  }
+
+  // EC_POINT_oct2point rejects points that are not on the curve, and hybrid
+  // encodings whose prefix disagrees with y; the curves here have cofactor 1,
+  // so every point on the curve is in the prime-order group
+  const EC_GROUP* group = curve.group.get();
+  OwnedPoint point(EC_POINT_new(group), EC_POINT_clear_free);
+  if (!point || encoded.empty() || EC_POINT_oct2point(group, point.get(), encoded.data(), encoded.size(), ctx) != 1 ||
+      EC_POINT_is_at_infinity(group, point.get())) {
+    clearOpenSSLErrors();
+    throw std::runtime_error("Public key is not valid for specified curve");
+  }
+  PointPtr parsed(point.release(), EC_POINT_clear_free);
+
+  std::lock_guard<std::mutex> lock(curve.mutex);
+  auto [entry, inserted] = curve.index.try_emplace(key);
+  if (!inserted) {
+    // Parsed concurrently by another thread
+    return entry->second->second;
+  }
+  curve.points.emplace_front(std::move(key), parsed);
+  entry->second = curve.points.begin();
+  if (curve.points.size() > kPointCacheSize) {
+    curve.index.erase(curve.points.back().first);
+    curve.points.pop_back();
+  }
+  return parsed;
+}
+
+std::shared_ptr<ArrayBuffer> HybridECDH::encodePoint(const Curve& curve, const EC_POINT* point, double format, BN_CTX* ctx) {
+  // POINT_CONVERSION_* from JS constants
+  if (format != 2 && format != 4 && format != 6) {
+    throw std::runtime_error("Invalid ECDH format");
+  }
+  auto form = static_cast<point_conversion_form_t>(static_cast<int>(format));
+  const EC_GROUP* group = curve.group.get();
+  size_t length = EC_POINT_point2oct(group, point, form, nullptr, 0, ctx);
+  if (length == 0) {
+    throw std::runtime_error("Failed to encode EC point: " + getOpenSSLError());
+  }
+  auto buffer = ArrayBuffer::allocate(length);
+  if (EC_POINT_point2oct(group, point, form, buffer->data(), length, ctx) != length) {
+    throw std::runtime_error("Failed to encode EC point: " + getOpenSSLError());
+  }
+  return buffer;
+}
+
+void HybridECDH::setCurve(const std::string& name) {
+  auto curve = namedCurve(name);
+  if (!curve) {
+    throw std::runtime_error("Invalid EC curve name: " + name);
+  }
+  curve_ = std::move(curve);
+  privateKey_.reset();
+  publicKey_.reset();
+}
+
+const HybridECDH::Curve& HybridECDH::checkCurve() const {
+  if (!curve_) {
+    throw std::runtime_error("ECDH curve is not initialized");
+  }
+  return *curve_;
+}
+
+const BIGNUM* HybridECDH::checkPrivateKey() const {
+  if (!privateKey_) {
+    throw std::runtime_error("No private key - did you forget to generate one?");
+  }
+  return privateKey_.get();
+}
+
+void HybridECDH::generateKeys() {
+  const Curve& curve = checkCurve();
+  const BIGNUM* order = EC_GROUP_get0_order(curve.group.get());
+  auto ctx = newContext();
+
+  // Unlike DiffieHellman, a new private key every time, as EC_KEY_generate_key
+  BignumPtr x(BN_secure_new(), BN_clear_free);
+  do {
+    if (!x || BN_priv_rand_range_ex(x.get(), order, 0, ctx.get()) != 1) {
+      throw std::runtime_error("Failed to generate private key: " + getOpenSSLError());
+    }
+  } while (BN_is_zero(x.get()));
+  BN_set_flags(x.get(), BN_FLG_CONSTTIME);
+
+  publicKey_ = multiply(curve.group.get(), x.get(), nullptr, ctx.get());
+  privateKey_ = std::shared_ptr<const BIGNUM>(x.release(), BN_clear_free);
+}
+
+std::shared_ptr<ArrayBuffer> HybridECDH::deriveSecret(const Curve& curve, const BIGNUM* privateKey, std::span<const uint8_t> publicKey,
+                                                      BN_CTX* ctx) {
+  auto peer = parsePoint(curve, publicKey, ctx);
+  auto shared = multiply(curve.group.get(), privateKey, peer.get(), ctx);
+  BignumPtr x(BN_secure_new(), BN_clear_free);
+  if (!x || EC_POINT_get_affine_coordinates(curve.group.get(), shared.get(), x.get(), nullptr, ctx) != 1) {
+    throw std::runtime_error("Failed to compute ECDH key: " + getOpenSSLError());
+  }
+  // The x coordinate, zero-padded to the field size like ECDH_compute_key
+  return toBuffer(x.get(), curve.size);
+}
+
+std::shared_ptr<ArrayBuffer> HybridECDH::computeSecret(const std::shared_ptr<ArrayBuffer>& publicKey) {
+  const Curve& curve = checkCurve();
+  const BIGNUM* privateKey = checkPrivateKey();
+  auto ctx = newContext();
+  return deriveSecret(curve, privateKey, ToByteView(publicKey), ctx.get());
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridECDH::computeSecrets(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) {
+  const Curve& curve = checkCurve();
+  const BIGNUM* privateKey = checkPrivateKey();
+  auto ctx = newContext();
+  std::vector<std::shared_ptr<ArrayBuffer>> secrets;
+  secrets.reserve(publicKeys.size());
+  for (const auto& publicKey : publicKeys) {
+    secrets.push_back(deriveSecret(curve, privateKey, ToByteView(publicKey), ctx.get()));
+  }
+  return secrets;
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridECDH::computeSecretsAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) {
+  auto curve = curve_;
+  checkCurve();
+  checkPrivateKey();
+  std::vector<std::shared_ptr<ArrayBuffer>> nativeKeys;
+  nativeKeys.reserve(publicKeys.size());
+  for (const auto& publicKey : publicKeys) {
+    nativeKeys.push_back(ToNativeArrayBuffer(publicKey));
+  }
+
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async(
+      [curve, privateKey = privateKey_, nativeKeys = std::move(nativeKeys), queued = QueueWait::stamp("ecdhComputeSecrets")]() {
+        queued.started();
+        auto ctx = newContext();
+        std::vector<std::shared_ptr<ArrayBuffer>> secrets;
+        secrets.reserve(nativeKeys.size());
+        for (const auto& publicKey : nativeKeys) {
+          secrets.push_back(deriveSecret(*curve, privateKey.get(), ToByteView(publicKey), ctx.get()));
+        }
+        return secrets;
+      });
+}
+
+std::shared_ptr<ArrayBuffer> HybridECDH::getPublicKey(double format) {
+  const Curve& curve = checkCurve();
+  if (!publicKey_) {
+    throw std::runtime_error("Failed to get ECDH public key");
+  }
+  auto ctx = newContext();
+  return encodePoint(curve, publicKey_.get(), format, ctx.get());
+}
+
+std::shared_ptr<ArrayBuffer> HybridECDH::getPrivateKey() {
+  if (!privateKey_) {
+    throw std::runtime_error("Failed to get ECDH private key");
+  }
+  // Unpadded, like Node
+  return toBuffer(privateKey_.get(), static_cast<size_t>(BN_num_bytes(privateKey_.get())));
+}
+
+void HybridECDH::setPublicKey(const std::shared_ptr<ArrayBuffer>& publicKey) {
+  const Curve& curve = checkCurve();
+  auto ctx = newContext();
+  publicKey_ = parsePoint(curve, ToByteView(publicKey), ctx.get());
+}
+
+void HybridECDH::setPrivateKey(const std::shared_ptr<ArrayBuffer>& privateKey) {
+  const Curve& curve = checkCurve();
+  auto bytes = ToByteView(privateKey);
+  BignumPtr x(BN_secure_new(), BN_clear_free);
+  if (!x || BN_bin2bn(bytes.data(), static_cast<int>(bytes.size()), x.get()) == nullptr) {
+    throw std::runtime_error("Failed to read private key");
+  }
+  if (BN_is_zero(x.get()) || BN_cmp(x.get(), EC_GROUP_get0_order(curve.group.get())) >= 0) {
+    throw std::runtime_error("Private key is not valid for specified curve.");
+  }
+  BN_set_flags(x.get(), BN_FLG_CONSTTIME);
+
+  // Like Node, the matching public key is derived right away
+  auto ctx = newContext();
+  publicKey_ = multiply(curve.group.get(), x.get(), nullptr, ctx.get());
+  privateKey_ = std::shared_ptr<const BIGNUM>(x.release(), BN_clear_free);
+}
+
+std::shared_ptr<ArrayBuffer> HybridECDH::convertKey(const std::string& curve, const std::shared_ptr<ArrayBuffer>& key, double format) {
+  return convertKeys(curve, {key}, format).front();
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridECDH::convertKeys(const std::string& curve,
+                                                                  const std::vector<std::shared_ptr<ArrayBuffer>>& keys, double format) {
+  auto named = namedCurve(curve);
+  if (!named) {
+    throw std::runtime_error("Invalid EC curve name: " + curve);
+  }
+  auto ctx = newContext();
+  std::vector<std::shared_ptr<ArrayBuffer>> converted;
+  converted.reserve(keys.size());
+  for (const auto& key : keys) {
+    auto point = parsePoint(*named, ToByteView(key), ctx.get());
+    converted.push_back(encodePoint(*named, point.get(), format, ctx.get()));
+  }
+  return converted;
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "HybridECDHSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * Elliptic-curve Diffie-Hellman on the prime curves (Node's ECDH).
+ *
+ * Works on EC_GROUP / EC_POINT directly rather than going through EVP_PKEY,
+ * which would build and validate a key object per derivation. A curve's group
+ * is built once per process and shared between instances and in-flight async
+ * jobs.
+ *
+ * Each curve also keeps a small LRU of parsed peer points keyed by their
+ * encoding, so a peer key seen again (a reconnecting client, a server's static
+ * key) skips decoding, the on-curve check and, for compressed keys, the square
+ * root that recovers y. Parsing is the only thing cached; the scalar
+ * multiplication runs for every secret.
+ */
+class HybridECDH : public HybridECDHSpec {
+ public:
+  HybridECDH() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void setCurve(const std::string& name) override;
+  void generateKeys() override;
+  std::shared_ptr<ArrayBuffer> computeSecret(const std::shared_ptr<ArrayBuffer>& publicKey) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> computeSecrets(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  computeSecretsAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) override;
+  std::shared_ptr<ArrayBuffer> getPublicKey(double format) override;
+  std::shared_ptr<ArrayBuffer> getPrivateKey() override;
+  void setPublicKey(const std::shared_ptr<ArrayBuffer>& publicKey) override;
+  void setPrivateKey(const std::shared_ptr<ArrayBuffer>& privateKey) override;
+  std::shared_ptr<ArrayBuffer> convertKey(const std::string& curve, const std::shared_ptr<ArrayBuffer>& key, double format) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> convertKeys(const std::string& curve, const std::vector<std::shared_ptr<ArrayBuffer>>& keys,
+                                                        double format) override;
+
+ private:
+  using PointPtr = std::shared_ptr<const EC_POINT>;
+
+  struct Curve {
+    std::unique_ptr<EC_GROUP, decltype(&EC_GROUP_free)> group{nullptr, EC_GROUP_free};
+    // Byte length of a field element, the width of shared secrets
+    size_t size = 0;
+
+    // Parsed peer points, most recently used first
+    mutable std::mutex mutex;
+    mutable std::list<std::pair<std::string, PointPtr>> points;
+    mutable std::unordered_map<std::string, std::list<std::pair<std::string, PointPtr>>::iterator> index;
+  };
+
+  // Cached curve, or nullptr for an unknown or non-prime curve name
+  static std::shared_ptr<const Curve> namedCurve(const std::string& name);
+  // Decodes and validates a point in any of the three encodings; throws on
+  // invalid input
+  static PointPtr parsePoint(const Curve& curve, std::span<const uint8_t> encoded, BN_CTX* ctx);
+  static std::shared_ptr<ArrayBuffer> encodePoint(const Curve& curve, const EC_POINT* point, double format, BN_CTX* ctx);
+  static std::shared_ptr<ArrayBuffer> deriveSecret(const Curve& curve, const BIGNUM* privateKey, std::span<const uint8_t> publicKey,
+                                                   BN_CTX* ctx);
+  const Curve& checkCurve() const;
+  const BIGNUM* checkPrivateKey() const;
+
+  std::shared_ptr<const Curve> curve_;
+  // Shared with in-flight computeSecretsAsync jobs; replaced, never mutated
+  std::shared_ptr<const BIGNUM> privateKey_;
+  PointPtr publicKey_;
+};
+
+} // namespace margelo::nitro::crypto
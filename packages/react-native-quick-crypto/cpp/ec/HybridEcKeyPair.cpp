@@ -26,7 +26,7 @@
 namespace margelo::nitro::crypto {
 
 std::shared_ptr<Promise<void>> HybridEcKeyPair::generateKeyPair() {
-  return Promise<void>::async([this]() { this->generateKeyPairSync(); });
+  return executor.async<void>([self = strongRef(this)]() { self->generateKeyPairSync(); });
 }
 
 void HybridEcKeyPair::generateKeyPairSync() {
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "HybridEcKeyPairSpec.hpp"
+#include "SerialExecutor.hpp"
 #include "Utils.hpp"
 
 namespace margelo::nitro::crypto {
@@ -41,6 +42,8 @@ class HybridEcKeyPair : public HybridEcKeyPairSpec {
  private:
   std::string curve;
   EVP_PKEY* pkey = nullptr;
+  // async jobs run one at a time, in call order
+  SerialExecutor executor;
 
   static int GetCurveFromName(const char* name);
 };
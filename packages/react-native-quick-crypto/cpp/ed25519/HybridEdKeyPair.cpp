@@ -6,6 +6,8 @@
 #include <string>
 
 #include "HybridEdKeyPair.hpp"
+#include "QueueWait.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -76,8 +78,8 @@ std::shared_ptr<Promise<void>> HybridEdKeyPair::generateKeyPair(double publicFor
     nativePassphrase = ToNativeArrayBuffer(passphrase.value());
   }
 
-  return Promise<void>::async([this, publicFormat, publicType, privateFormat, privateType, cipher, nativePassphrase]() {
-    this->generateKeyPairSync(publicFormat, publicType, privateFormat, privateType, cipher, nativePassphrase);
+  return executor.async<void>([self = strongRef(this), publicFormat, publicType, privateFormat, privateType, cipher, nativePassphrase]() {
+    self->generateKeyPairSync(publicFormat, publicType, privateFormat, privateType, cipher, nativePassphrase);
   });
 }
 
@@ -137,8 +139,17 @@ std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridEdKeyPair::sign(con
     nativeKey = ToNativeArrayBuffer(key.value());
   }
 
-  return Promise<std::shared_ptr<ArrayBuffer>>::async(
-      [this, nativeMessage, nativeKey]() { return this->signSync(nativeMessage, nativeKey); });
+  auto job = [self = strongRef(this), nativeMessage, nativeKey, queued = QueueWait::stamp("ed.sign")]() {
+    queued.started();
+    WorkloadRecorder::AsyncJob asyncJob;
+    return self->signSync(nativeMessage, nativeKey);
+  };
+  // An explicit key is imported fresh by the job, so only jobs on the stored
+  // key pair need to wait for each other
+  if (nativeKey.has_value()) {
+    return Promise<std::shared_ptr<ArrayBuffer>>::async(std::move(job));
+  }
+  return executor.async<std::shared_ptr<ArrayBuffer>>(std::move(job));
 }
 
 std::shared_ptr<ArrayBuffer> HybridEdKeyPair::signSync(const std::shared_ptr<ArrayBuffer>& message,
@@ -194,6 +205,7 @@ std::shared_ptr<ArrayBuffer> HybridEdKeyPair::signSync(const std::shared_ptr<Arr
   EVP_MD_CTX_free(md_ctx);
   // Note: pkey_ctx is freed automatically by EVP_MD_CTX_free when using EVP_DigestSignInit
 
+  WorkloadRecorder::record(WorkloadRecorder::Op::EdSign, this->curve, message->size());
   return signature;
 }
 
@@ -208,8 +220,15 @@ std::shared_ptr<Promise<bool>> HybridEdKeyPair::verify(const std::shared_ptr<Arr
     nativeKey = ToNativeArrayBuffer(key.value());
   }
 
-  return Promise<bool>::async(
-      [this, nativeSignature, nativeMessage, nativeKey]() { return this->verifySync(nativeSignature, nativeMessage, nativeKey); });
+  auto job = [self = strongRef(this), nativeSignature, nativeMessage, nativeKey, queued = QueueWait::stamp("ed.verify")]() {
+    queued.started();
+    WorkloadRecorder::AsyncJob asyncJob;
+    return self->verifySync(nativeSignature, nativeMessage, nativeKey);
+  };
+  if (nativeKey.has_value()) {
+    return Promise<bool>::async(std::move(job));
+  }
+  return executor.async<bool>(std::move(job));
 }
 
 bool HybridEdKeyPair::verifySync(const std::shared_ptr<ArrayBuffer>& signature, const std::shared_ptr<ArrayBuffer>& message,
@@ -250,6 +269,7 @@ bool HybridEdKeyPair::verifySync(const std::shared_ptr<ArrayBuffer>& signature,
     EVP_MD_CTX_free(md_ctx);
     throw std::runtime_error("Failed to verify");
   }
+  WorkloadRecorder::record(WorkloadRecorder::Op::EdVerify, this->curve, message->size());
   return res == 1; // true if 1, false if 0
 }
 
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "HybridEdKeyPairSpec.hpp"
+#include "SerialExecutor.hpp"
 #include "Utils.hpp"
 
 namespace margelo::nitro::crypto {
@@ -55,6 +56,9 @@ class HybridEdKeyPair : public HybridEdKeyPairSpec {
  private:
   std::string curve;
   EVP_PKEY* pkey = nullptr;
+  // async jobs on the stored key pair run one at a time, in call order;
+  // jobs with an explicit key go straight to the pool
+  SerialExecutor executor;
 
   // Encoding configuration for key export
   // Format: -1 = default (raw), 0 = DER, 1 = PEM
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "HybridHash.hpp"
+#include "LibraryContext.hpp"
 #include "Utils.hpp"
 
 namespace margelo::nitro::crypto {
@@ -39,6 +40,7 @@ void HybridHash::createHash(const std::string& hashAlgorithmArg, const std::opti
 
   algorithm = hashAlgorithmArg;
   outputLength = outputLengthArg;
+  workload = {};
 
   // Create hash context
   ctx = EVP_MD_CTX_new();
@@ -46,8 +48,8 @@ void HybridHash::createHash(const std::string& hashAlgorithmArg, const std::opti
     throw std::runtime_error("Failed to create hash context: " + std::to_string(ERR_get_error()));
   }
 
-  // Fetch the message digest using modern provider-based API
-  md = EVP_MD_fetch(nullptr, algorithm.c_str(), nullptr);
+  // Fetch the message digest from the module's library context
+  md = fetchDigest(algorithm);
   if (!md) {
     EVP_MD_CTX_free(ctx);
     ctx = nullptr;
@@ -68,7 +70,8 @@ void HybridHash::createHash(const std::string& hashAlgorithmArg, const std::opti
   }
 }
 
-void HybridHash::update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data) {
+void HybridHash::update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset,
+                        const std::optional<double>& byteLength) {
   if (!ctx) {
     throw std::runtime_error("Hash context not initialized");
   }
@@ -78,11 +81,13 @@ void HybridHash::update(const std::variant<std::string, std::shared_ptr<ArrayBuf
     if (EVP_DigestUpdate(ctx, reinterpret_cast<const uint8_t*>(str.data()), str.length()) != 1) {
       throw std::runtime_error("Failed to update hash digest: " + std::to_string(ERR_get_error()));
     }
+    workload.add(str.length());
   } else {
-    const std::shared_ptr<ArrayBuffer>& buffer = std::get<std::shared_ptr<ArrayBuffer>>(data);
-    if (EVP_DigestUpdate(ctx, reinterpret_cast<const uint8_t*>(buffer->data()), buffer->size()) != 1) {
+    auto view = ToByteView(std::get<std::shared_ptr<ArrayBuffer>>(data), byteOffset, byteLength);
+    if (EVP_DigestUpdate(ctx, view.data(), view.size()) != 1) {
       throw std::runtime_error("Failed to update hash digest: " + std::to_string(ERR_get_error()));
     }
+    workload.add(view.size());
   }
 }
 
@@ -117,6 +122,7 @@ std::shared_ptr<ArrayBuffer> HybridHash::digest(const std::optional<std::string>
     delete[] hashBuffer;
     throw std::runtime_error("Failed to finalize hash digest: " + std::to_string(ERR_get_error()));
   }
+  WorkloadRecorder::record(WorkloadRecorder::Op::Hash, algorithm, workload.bytes, workload.updates);
 
   return std::make_shared<NativeArrayBuffer>(hashBuffer, hashLength, [=]() { delete[] hashBuffer; });
 }
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "HybridHashSpec.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -21,7 +22,8 @@ class HybridHash : public HybridHashSpec {
  public:
   // Methods
   void createHash(const std::string& algorithm, const std::optional<double> outputLength) override;
-  void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data) override;
+  void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset,
+              const std::optional<double>& byteLength) override;
   std::shared_ptr<ArrayBuffer> digest(const std::optional<std::string>& encoding = std::nullopt) override;
   std::shared_ptr<margelo::nitro::crypto::HybridHashSpec> copy(const std::optional<double> outputLength) override;
   std::vector<std::string> getSupportedHashAlgorithms() override;
@@ -38,6 +40,7 @@ class HybridHash : public HybridHashSpec {
   bool md_fetched = false;
   std::string algorithm = "";
   std::optional<double> outputLength = std::nullopt;
+  WorkloadRecorder::Tally workload;
 };
 
 } // namespace margelo::nitro::crypto
@@ -8,7 +8,11 @@
 #include <vector>
 
 #include "HybridHkdf.hpp"
+#include "QueueWait.hpp"
+#include "LibraryContext.hpp"
+#include "SerialExecutor.hpp"
 #include "Utils.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -21,15 +25,18 @@ std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridHkdf::deriveKey(con
   auto nativeSalt = ToNativeArrayBuffer(salt);
   auto nativeInfo = ToNativeArrayBuffer(info);
 
-  return Promise<std::shared_ptr<ArrayBuffer>>::async([this, algorithm, nativeKey, nativeSalt, nativeInfo, length]() {
-    return this->deriveKeySync(algorithm, nativeKey, nativeSalt, nativeInfo, length);
-  });
+  return Promise<std::shared_ptr<ArrayBuffer>>::async(
+      [self = strongRef(this), algorithm, nativeKey, nativeSalt, nativeInfo, length, queued = QueueWait::stamp("hkdf")]() {
+        queued.started();
+        WorkloadRecorder::AsyncJob asyncJob;
+        return self->deriveKeySync(algorithm, nativeKey, nativeSalt, nativeInfo, length);
+      });
 }
 
 std::shared_ptr<ArrayBuffer> HybridHkdf::deriveKeySync(const std::string& algorithm, const std::shared_ptr<ArrayBuffer>& baseKey,
                                                        const std::shared_ptr<ArrayBuffer>& salt, const std::shared_ptr<ArrayBuffer>& info,
                                                        double length) {
-  EVP_KDF* kdf = EVP_KDF_fetch(nullptr, "HKDF", nullptr);
+  EVP_KDF* kdf = fetchKdf("HKDF");
   if (kdf == nullptr) {
     throw std::runtime_error("Failed to fetch HKDF implementation: " + std::to_string(ERR_get_error()));
   }
@@ -90,6 +97,7 @@ std::shared_ptr<ArrayBuffer> HybridHkdf::deriveKeySync(const std::string& algori
 
   EVP_KDF_CTX_free(ctx);
 
+  WorkloadRecorder::record(WorkloadRecorder::Op::Hkdf, algorithm, outLen, baseKey->size());
   return std::make_shared<NativeArrayBuffer>(outBuf, outLen, [=]() { delete[] outBuf; });
 }
 
@@ -1,15 +1,69 @@
 #include <NitroModules/ArrayBuffer.hpp>
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <openssl/core_names.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "HybridHmac.hpp"
+#include "LibraryContext.hpp"
+#include "ParallelFor.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
+#include "Utils.hpp"
 
 namespace margelo::nitro::crypto {
 
+namespace {
+  // Resetting and finalizing a context costs about as much as hashing this
+  // many message bytes
+  constexpr size_t kMessageCost = 512;
+  // Batches smaller than this (in the units above) per thread are not worth
+  // starting a thread for
+  constexpr size_t kWorkPerThread = 256 * 1024;
+  constexpr size_t kMaxBatchThreads = 4;
+
+  std::span<const uint8_t> messageView(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& message) {
+    if (std::holds_alternative<std::string>(message)) {
+      const std::string& str = std::get<std::string>(message);
+      return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+    }
+    return ToByteView(std::get<std::shared_ptr<ArrayBuffer>>(message));
+  }
+
+  size_t batchThreads(const std::vector<std::span<const uint8_t>>& messages) {
+    size_t work = 0;
+    for (const auto& message : messages) {
+      work += message.size() + kMessageCost;
+    }
+    size_t limit = std::min({std::max<size_t>(1, std::thread::hardware_concurrency()), kMaxBatchThreads, messages.size()});
+    return std::clamp<size_t>(work / kWorkPerThread, 1, std::max<size_t>(1, limit));
+  }
+
+  // Tags messages [begin, end) on a context that starts out freshly keyed
+  void tagRange(EVP_MAC_CTX* ctx, const std::vector<std::span<const uint8_t>>& messages, size_t begin, size_t end, size_t tagLength,
+                uint8_t* out) {
+    uint8_t tag[EVP_MAX_MD_SIZE];
+    for (size_t i = begin; i < end; i++) {
+      // A NULL key rewinds to the keyed state, which is cheaper than
+      // duplicating the keyed context for every message
+      if (i > begin && EVP_MAC_init(ctx, nullptr, 0, nullptr) != 1) {
+        throw std::runtime_error("Failed to reset HMAC: " + getOpenSSLError());
+      }
+      size_t length = 0;
+      if (EVP_MAC_update(ctx, messages[i].data(), messages[i].size()) != 1 || EVP_MAC_final(ctx, tag, &length, sizeof(tag)) != 1) {
+        throw std::runtime_error("Failed to compute HMAC: " + getOpenSSLError());
+      }
+      std::memcpy(out + i * tagLength, tag, tagLength);
+    }
+  }
+} // namespace
+
 HybridHmac::~HybridHmac() {
   if (ctx) {
     EVP_MAC_CTX_free(ctx);
@@ -19,9 +73,10 @@ HybridHmac::~HybridHmac() {
 
 void HybridHmac::createHmac(const std::string& hmacAlgorithm, const std::shared_ptr<ArrayBuffer>& secretKey) {
   algorithm = hmacAlgorithm;
+  workload = {};
 
   // Create and use EVP_MAC locally
-  EVP_MAC* mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+  EVP_MAC* mac = fetchMac("HMAC");
   if (!mac) {
     throw std::runtime_error("Failed to fetch HMAC implementation: " + std::to_string(ERR_get_error()));
   }
@@ -34,10 +89,11 @@ void HybridHmac::createHmac(const std::string& hmacAlgorithm, const std::shared_
   }
 
   // Validate algorithm
-  const EVP_MD* md = EVP_get_digestbyname(algorithm.c_str());
+  EVP_MD* md = fetchDigest(algorithm);
   if (!md) {
     throw std::runtime_error("Unknown HMAC algorithm: " + algorithm);
   }
+  EVP_MD_free(md);
 
   // Set up parameters for HMAC
   OSSL_PARAM params[2];
@@ -60,7 +116,8 @@ void HybridHmac::createHmac(const std::string& hmacAlgorithm, const std::shared_
   }
 }
 
-void HybridHmac::update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data) {
+void HybridHmac::update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset,
+                        const std::optional<double>& byteLength) {
   if (!ctx) {
     throw std::runtime_error("HMAC context not initialized");
   }
@@ -71,12 +128,14 @@ void HybridHmac::update(const std::variant<std::string, std::shared_ptr<ArrayBuf
     if (EVP_MAC_update(ctx, reinterpret_cast<const uint8_t*>(str.data()), str.length()) != 1) {
       throw std::runtime_error("Failed to update HMAC: " + std::to_string(ERR_get_error()));
     }
+    workload.add(str.length());
   } else {
     // Handle ArrayBuffer
-    const std::shared_ptr<ArrayBuffer>& buffer = std::get<std::shared_ptr<ArrayBuffer>>(data);
-    if (EVP_MAC_update(ctx, reinterpret_cast<const uint8_t*>(buffer->data()), buffer->size()) != 1) {
+    auto view = ToByteView(std::get<std::shared_ptr<ArrayBuffer>>(data), byteOffset, byteLength);
+    if (EVP_MAC_update(ctx, view.data(), view.size()) != 1) {
       throw std::runtime_error("Failed to update HMAC: " + std::to_string(ERR_get_error()));
     }
+    workload.add(view.size());
   }
 }
 
@@ -85,9 +144,9 @@ std::shared_ptr<ArrayBuffer> HybridHmac::digest() {
     throw std::runtime_error("HMAC context not initialized");
   }
 
-  // Determine the maximum possible size of the HMAC output
-  const EVP_MD* md = EVP_get_digestbyname(algorithm.c_str());
-  const size_t hmacLength = EVP_MD_get_size(md);
+  // The context already knows its digest; a name lookup here would go through
+  // the global method store on every call
+  const size_t hmacLength = EVP_MAC_CTX_get_mac_size(ctx);
 
   // Allocate buffer with the exact required size
   uint8_t* hmacBuffer = new uint8_t[hmacLength];
@@ -97,8 +156,128 @@ std::shared_ptr<ArrayBuffer> HybridHmac::digest() {
     delete[] hmacBuffer;
     throw std::runtime_error("Failed to finalize HMAC digest: " + std::to_string(ERR_get_error()));
   }
+  WorkloadRecorder::record(WorkloadRecorder::Op::Hmac, algorithm, workload.bytes, workload.updates);
 
   return std::make_shared<NativeArrayBuffer>(hmacBuffer, hmacLength, [=]() { delete[] hmacBuffer; });
 }
 
+std::shared_ptr<ArrayBuffer> HybridHmac::hmacMany(const std::string& hmacAlgorithm, const std::shared_ptr<ArrayBuffer>& secretKey,
+                                                  const std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>& messages,
+                                                  std::optional<double> truncateTo) {
+  Batch batch = prepareBatch(hmacAlgorithm, ToByteView(secretKey), truncateTo);
+  std::vector<std::span<const uint8_t>> views;
+  views.reserve(messages.size());
+  for (const auto& message : messages) {
+    views.push_back(messageView(message));
+  }
+
+  const size_t size = messages.size() * batch.tagLength;
+  uint8_t* out = new uint8_t[size];
+  try {
+    tagBatch(batch, views, out);
+  } catch (...) {
+    delete[] out;
+    throw;
+  }
+  return std::make_shared<NativeArrayBuffer>(out, size, [=]() { delete[] out; });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+HybridHmac::hmacManyAsync(const std::string& hmacAlgorithm, const std::shared_ptr<ArrayBuffer>& secretKey,
+                          const std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>& messages,
+                          std::optional<double> truncateTo) {
+  auto batch = std::make_shared<const Batch>(prepareBatch(hmacAlgorithm, ToByteView(secretKey), truncateTo));
+  // One packed copy of the messages rather than an allocation per message
+  std::vector<uint8_t> packed;
+  std::vector<size_t> ends;
+  ends.reserve(messages.size());
+  for (const auto& message : messages) {
+    auto view = messageView(message);
+    packed.insert(packed.end(), view.begin(), view.end());
+    ends.push_back(packed.size());
+  }
+
+  return Promise<std::shared_ptr<ArrayBuffer>>::async(
+      [batch, packed = std::move(packed), ends = std::move(ends), queued = QueueWait::stamp("hmacMany")]() {
+        queued.started();
+        std::vector<std::span<const uint8_t>> views;
+        views.reserve(ends.size());
+        size_t begin = 0;
+        for (size_t end : ends) {
+          views.emplace_back(packed.data() + begin, end - begin);
+          begin = end;
+        }
+        const size_t size = views.size() * batch->tagLength;
+        uint8_t* out = new uint8_t[size];
+        try {
+          tagBatch(*batch, views, out);
+        } catch (...) {
+          delete[] out;
+          throw;
+        }
+        return std::shared_ptr<ArrayBuffer>(std::make_shared<NativeArrayBuffer>(out, size, [=]() { delete[] out; }));
+      });
+}
+
+HybridHmac::Batch HybridHmac::prepareBatch(const std::string& hmacAlgorithm, std::span<const uint8_t> key,
+                                           std::optional<double> truncateTo) {
+  EVP_MD* md = fetchDigest(hmacAlgorithm);
+  if (!md) {
+    throw std::runtime_error("Unknown HMAC algorithm: " + hmacAlgorithm);
+  }
+  const size_t digestLength = EVP_MD_get_size(md);
+  EVP_MD_free(md);
+
+  Batch batch;
+  batch.tagLength = digestLength;
+  if (truncateTo.has_value()) {
+    double length = truncateTo.value();
+    if (!(length >= 1 && length <= static_cast<double>(digestLength)) || length != static_cast<double>(static_cast<size_t>(length))) {
+      throw std::runtime_error("truncateTo must be an integer from 1 to " + std::to_string(digestLength));
+    }
+    batch.tagLength = static_cast<size_t>(length);
+  }
+
+  EVP_MAC* mac = fetchMac("HMAC");
+  if (!mac) {
+    throw std::runtime_error("Failed to fetch HMAC implementation: " + getOpenSSLError());
+  }
+  batch.keyed.reset(EVP_MAC_CTX_new(mac));
+  EVP_MAC_free(mac);
+  if (!batch.keyed) {
+    throw std::runtime_error("Failed to create HMAC context: " + getOpenSSLError());
+  }
+
+  OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>(hmacAlgorithm.c_str()), 0),
+      OSSL_PARAM_construct_end(),
+  };
+  // Same empty-key handling as createHmac
+  static const uint8_t dummyKey = 0;
+  if (key.empty()) {
+    key = std::span<const uint8_t>(&dummyKey, 1);
+  }
+  if (EVP_MAC_init(batch.keyed.get(), key.data(), key.size(), params) != 1) {
+    throw std::runtime_error("Failed to initialize HMAC: " + getOpenSSLError());
+  }
+  return batch;
+}
+
+void HybridHmac::tagBatch(const Batch& batch, const std::vector<std::span<const uint8_t>>& messages, uint8_t* out) {
+  const size_t threads = batchThreads(messages);
+  // Every chunk gets its own copy of the keyed context, made up front so the
+  // template is only ever read from this thread
+  std::vector<MacCtxPtr> contexts;
+  contexts.reserve(threads);
+  for (size_t t = 0; t < threads; t++) {
+    contexts.emplace_back(EVP_MAC_CTX_dup(batch.keyed.get()), EVP_MAC_CTX_free);
+    if (!contexts.back()) {
+      throw std::runtime_error("Failed to copy HMAC context: " + getOpenSSLError());
+    }
+  }
+  parallelFor(threads, messages.size(), [&](size_t chunk, size_t begin, size_t end) {
+    tagRange(contexts[chunk].get(), messages, begin, end, batch.tagLength, out);
+  });
+}
+
 } // namespace margelo::nitro::crypto
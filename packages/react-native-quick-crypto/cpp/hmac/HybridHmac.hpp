@@ -1,12 +1,15 @@
 #include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
 #include <memory>
 #include <openssl/evp.h>
 #include <optional>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
 
 #include "HybridHmacSpec.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -20,13 +23,35 @@ class HybridHmac : public HybridHmacSpec {
  public:
   // Methods
   void createHmac(const std::string& algorithm, const std::shared_ptr<ArrayBuffer>& key) override;
-  void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data) override;
+  void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset,
+              const std::optional<double>& byteLength) override;
   std::shared_ptr<ArrayBuffer> digest() override;
+  std::shared_ptr<ArrayBuffer> hmacMany(const std::string& algorithm, const std::shared_ptr<ArrayBuffer>& key,
+                                        const std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>& messages,
+                                        std::optional<double> truncateTo) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+  hmacManyAsync(const std::string& algorithm, const std::shared_ptr<ArrayBuffer>& key,
+                const std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>& messages,
+                std::optional<double> truncateTo) override;
 
  private:
+  using MacCtxPtr = std::unique_ptr<EVP_MAC_CTX, decltype(&EVP_MAC_CTX_free)>;
+
+  // A context keyed once for a whole batch, and its tag length after truncation
+  struct Batch {
+    MacCtxPtr keyed{nullptr, EVP_MAC_CTX_free};
+    size_t tagLength = 0;
+  };
+
+  static Batch prepareBatch(const std::string& algorithm, std::span<const uint8_t> key, std::optional<double> truncateTo);
+  // Writes messages.size() tags back to back into `out`, splitting large
+  // batches across threads
+  static void tagBatch(const Batch& batch, const std::vector<std::span<const uint8_t>>& messages, uint8_t* out);
+
   // Properties
   EVP_MAC_CTX* ctx = nullptr;
   std::string algorithm = "";
+  WorkloadRecorder::Tally workload;
 };
 
 } // namespace margelo::nitro::crypto
@@ -0,0 +1,304 @@
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <stdexcept>
+
+#include "HybridMac.hpp"
+#include "LibraryContext.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+  OSSL_PARAM octetParam(const char* key, std::span<const uint8_t> bytes) {
+    return OSSL_PARAM_construct_octet_string(key, const_cast<uint8_t*>(bytes.data()), bytes.size());
+  }
+
+  std::optional<std::span<const uint8_t>> ivAt(const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& ivs, size_t i) {
+    if (!ivs) {
+      return std::nullopt;
+    }
+    return ToByteView((*ivs)[i]);
+  }
+} // namespace
+
+void HybridMac::init(const MacArgs& args) {
+  EVP_MAC* mac = fetchMac(args.algorithm);
+  if (!mac) {
+    throw std::runtime_error("Unknown MAC algorithm: " + args.algorithm);
+  }
+  CtxPtr ctx(EVP_MAC_CTX_new(mac), EVP_MAC_CTX_free);
+  const OSSL_PARAM* settable = EVP_MAC_settable_ctx_params(mac);
+  const bool isHmac = EVP_MAC_is_a(mac, "HMAC");
+  const bool isPoly1305 = EVP_MAC_is_a(mac, "POLY1305");
+  EVP_MAC_free(mac);
+  if (!ctx) {
+    throw std::runtime_error("Failed to create " + args.algorithm + " context: " + getOpenSSLError());
+  }
+
+  auto takes = [settable](const char* key) { return OSSL_PARAM_locate_const(settable, key) != nullptr; };
+  auto check = [&](bool supplied, const char* key, const char* label) {
+    if (supplied && !takes(key)) {
+      throw std::runtime_error(args.algorithm + " does not take " + label);
+    }
+  };
+  check(args.digest.has_value(), OSSL_MAC_PARAM_DIGEST, "a digest");
+  check(args.cipher.has_value(), OSSL_MAC_PARAM_CIPHER, "a cipher");
+  check(args.iv.has_value(), OSSL_MAC_PARAM_IV, "an iv");
+  check(args.customization.has_value(), OSSL_MAC_PARAM_CUSTOM, "a customization string");
+  check(args.salt.has_value(), OSSL_MAC_PARAM_SALT, "a salt");
+  check(args.outputLength.has_value(), OSSL_MAC_PARAM_SIZE, "an output length");
+  if (takes(OSSL_MAC_PARAM_DIGEST) && !args.digest) {
+    throw std::runtime_error(args.algorithm + " needs a digest");
+  }
+  if (takes(OSSL_MAC_PARAM_CIPHER) && !args.cipher) {
+    throw std::runtime_error(args.algorithm + " needs a cipher");
+  }
+
+  std::vector<OSSL_PARAM> params;
+  if (args.digest) {
+    params.push_back(OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>(args.digest->c_str()), 0));
+  }
+  if (args.cipher) {
+    params.push_back(OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER, const_cast<char*>(args.cipher->c_str()), 0));
+  }
+  if (args.iv) {
+    params.push_back(octetParam(OSSL_MAC_PARAM_IV, ToByteView(*args.iv)));
+  }
+  if (args.customization) {
+    params.push_back(octetParam(OSSL_MAC_PARAM_CUSTOM, ToByteView(*args.customization)));
+  }
+  if (args.salt) {
+    params.push_back(octetParam(OSSL_MAC_PARAM_SALT, ToByteView(*args.salt)));
+  }
+  size_t outputLength = 0;
+  if (args.outputLength) {
+    if (!CheckIsUint32(*args.outputLength) || *args.outputLength < 1 ||
+        *args.outputLength != static_cast<double>(static_cast<uint32_t>(*args.outputLength))) {
+      throw std::runtime_error("Invalid output length for " + args.algorithm);
+    }
+    outputLength = static_cast<size_t>(*args.outputLength);
+    params.push_back(OSSL_PARAM_construct_size_t(OSSL_MAC_PARAM_SIZE, &outputLength));
+  }
+  params.push_back(OSSL_PARAM_construct_end());
+
+  auto key = ToByteView(args.key);
+  // HMAC zero-pads its key, so an empty key is the same as a single zero byte,
+  // which OpenSSL (unlike Node) accepts
+  static const uint8_t emptyHmacKey = 0;
+  if (isHmac && key.empty()) {
+    key = std::span<const uint8_t>(&emptyHmacKey, 1);
+  }
+  if (EVP_MAC_init(ctx.get(), key.data(), key.size(), params.data()) != 1) {
+    throw std::runtime_error("Failed to initialize " + args.algorithm + ": " + getOpenSSLError());
+  }
+
+  algorithm_ = args.algorithm;
+  macLength_ = EVP_MAC_CTX_get_mac_size(ctx.get());
+  oneTimeKey_ = isPoly1305;
+  needsIv_ = takes(OSSL_MAC_PARAM_IV);
+  keyUsed_ = false;
+  finalized_ = false;
+  key_ = std::move(ctx);
+  stream_.reset();
+  work_.reset();
+}
+
+void HybridMac::update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset,
+                       const std::optional<double>& byteLength) {
+  checkKey();
+  if (finalized_) {
+    throw std::runtime_error("Digest already called");
+  }
+  if (!stream_) {
+    useKey(1);
+    stream_ = duplicate(key_.get());
+  }
+
+  std::span<const uint8_t> bytes;
+  if (std::holds_alternative<std::string>(data)) {
+    const std::string& str = std::get<std::string>(data);
+    bytes = std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+  } else {
+    bytes = ToByteView(std::get<std::shared_ptr<ArrayBuffer>>(data), byteOffset, byteLength);
+  }
+  if (EVP_MAC_update(stream_.get(), bytes.data(), bytes.size()) != 1) {
+    throw std::runtime_error("Failed to update " + algorithm_ + ": " + getOpenSSLError());
+  }
+}
+
+std::shared_ptr<ArrayBuffer> HybridMac::digest() {
+  checkKey();
+  if (finalized_) {
+    throw std::runtime_error("Digest already called");
+  }
+  if (!stream_) {
+    useKey(1);
+    stream_ = duplicate(key_.get());
+  }
+  finalized_ = true;
+
+  uint8_t* out = new uint8_t[macLength_];
+  size_t outLength = 0;
+  if (EVP_MAC_final(stream_.get(), out, &outLength, macLength_) != 1) {
+    delete[] out;
+    throw std::runtime_error("Failed to finalize " + algorithm_ + ": " + getOpenSSLError());
+  }
+  stream_.reset();
+  return std::make_shared<NativeArrayBuffer>(out, outLength, [=]() { delete[] out; });
+}
+
+std::shared_ptr<HybridMacSpec> HybridMac::copy() {
+  checkKey();
+  if (finalized_) {
+    throw std::runtime_error("Digest already called");
+  }
+  if (oneTimeKey_) {
+    throw std::runtime_error("Poly1305 keys are one-time; create a new Mac for each message");
+  }
+  auto mac = std::make_shared<HybridMac>();
+  mac->algorithm_ = algorithm_;
+  mac->macLength_ = macLength_;
+  mac->needsIv_ = needsIv_;
+  mac->key_ = duplicate(key_.get());
+  if (stream_) {
+    mac->stream_ = duplicate(stream_.get());
+  }
+  return mac;
+}
+
+double HybridMac::getMacLength() {
+  checkKey();
+  return static_cast<double>(macLength_);
+}
+
+std::shared_ptr<ArrayBuffer> HybridMac::compute(const std::shared_ptr<ArrayBuffer>& data,
+                                                const std::optional<std::shared_ptr<ArrayBuffer>>& iv) {
+  checkKey();
+  checkIvs(1, iv ? std::optional<size_t>(1) : std::nullopt);
+  useKey(1);
+  if (!work_) {
+    work_ = duplicate(key_.get());
+    workFresh_ = true;
+  }
+  // A failure part-way leaves the context in an unknown state; reset it next time
+  const bool fresh = workFresh_;
+  workFresh_ = false;
+  return tag(work_.get(), fresh, ToByteView(data), iv ? std::optional(ToByteView(*iv)) : std::nullopt, macLength_);
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridMac::computeMany(const std::vector<std::shared_ptr<ArrayBuffer>>& messages,
+                                                                 const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& ivs) {
+  checkKey();
+  checkIvs(messages.size(), ivs ? std::optional(ivs->size()) : std::nullopt);
+  useKey(messages.size());
+  if (!work_) {
+    work_ = duplicate(key_.get());
+    workFresh_ = true;
+  }
+  std::vector<std::shared_ptr<ArrayBuffer>> tags;
+  tags.reserve(messages.size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    const bool fresh = workFresh_;
+    workFresh_ = false;
+    tags.push_back(tag(work_.get(), fresh, ToByteView(messages[i]), ivAt(ivs, i), macLength_));
+  }
+  return tags;
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridMac::computeManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& messages,
+                            const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& ivs) {
+  checkKey();
+  checkIvs(messages.size(), ivs ? std::optional(ivs->size()) : std::nullopt);
+  useKey(messages.size());
+  std::shared_ptr<EVP_MAC_CTX> ctx = duplicate(key_.get());
+  std::vector<std::shared_ptr<ArrayBuffer>> nativeMessages;
+  nativeMessages.reserve(messages.size());
+  for (const auto& message : messages) {
+    nativeMessages.push_back(ToNativeArrayBuffer(message));
+  }
+  std::optional<std::vector<std::shared_ptr<ArrayBuffer>>> nativeIvs;
+  if (ivs) {
+    nativeIvs.emplace();
+    nativeIvs->reserve(ivs->size());
+    for (const auto& iv : *ivs) {
+      nativeIvs->push_back(ToNativeArrayBuffer(iv));
+    }
+  }
+
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async([ctx, nativeMessages = std::move(nativeMessages),
+                                                                    nativeIvs = std::move(nativeIvs), length = macLength_,
+                                                                    queued = QueueWait::stamp("macComputeMany")]() {
+    queued.started();
+    std::vector<std::shared_ptr<ArrayBuffer>> tags;
+    tags.reserve(nativeMessages.size());
+    for (size_t i = 0; i < nativeMessages.size(); i++) {
+      tags.push_back(tag(ctx.get(), i == 0, ToByteView(nativeMessages[i]), ivAt(nativeIvs, i), length));
+    }
+    return tags;
+  });
+}
+
+std::shared_ptr<ArrayBuffer> HybridMac::tag(EVP_MAC_CTX* ctx, bool fresh, std::span<const uint8_t> data,
+                                            std::optional<std::span<const uint8_t>> iv, size_t length) {
+  OSSL_PARAM params[] = {iv ? octetParam(OSSL_MAC_PARAM_IV, *iv) : OSSL_PARAM_construct_end(), OSSL_PARAM_construct_end()};
+  if (!fresh) {
+    // A NULL key keeps the current one and rewinds to its keyed state
+    if (EVP_MAC_init(ctx, nullptr, 0, params) != 1) {
+      throw std::runtime_error("Failed to reset MAC: " + getOpenSSLError());
+    }
+  } else if (iv && EVP_MAC_CTX_set_params(ctx, params) != 1) {
+    throw std::runtime_error("Failed to set MAC iv: " + getOpenSSLError());
+  }
+
+  uint8_t* out = new uint8_t[length];
+  size_t outLength = 0;
+  if (EVP_MAC_update(ctx, data.data(), data.size()) != 1 || EVP_MAC_final(ctx, out, &outLength, length) != 1) {
+    delete[] out;
+    throw std::runtime_error("Failed to compute MAC: " + getOpenSSLError());
+  }
+  return std::make_shared<NativeArrayBuffer>(out, outLength, [=]() { delete[] out; });
+}
+
+const EVP_MAC_CTX* HybridMac::checkKey() const {
+  if (!key_) {
+    throw std::runtime_error("MAC not initialized");
+  }
+  return key_.get();
+}
+
+HybridMac::CtxPtr HybridMac::duplicate(const EVP_MAC_CTX* ctx) const {
+  CtxPtr copy(EVP_MAC_CTX_dup(ctx), EVP_MAC_CTX_free);
+  if (!copy) {
+    throw std::runtime_error("Failed to copy " + algorithm_ + " context: " + getOpenSSLError());
+  }
+  return copy;
+}
+
+void HybridMac::useKey(size_t tags) {
+  if (tags == 0) {
+    return;
+  }
+  if (oneTimeKey_ && (keyUsed_ || tags > 1)) {
+    throw std::runtime_error("Poly1305 keys are one-time; create a new Mac for each message");
+  }
+  keyUsed_ = true;
+}
+
+void HybridMac::checkIvs(size_t messages, std::optional<size_t> ivs) const {
+  if (ivs) {
+    if (!needsIv_) {
+      throw std::runtime_error(algorithm_ + " does not take an iv");
+    }
+    if (*ivs != messages) {
+      throw std::runtime_error("Expected one iv per message");
+    }
+  } else if (needsIv_ && messages > 0) {
+    // Reusing a GMAC IV under one key reveals the authentication key
+    throw std::runtime_error(algorithm_ + " needs a fresh iv for every message");
+  }
+}
+
+} // namespace margelo::nitro::crypto
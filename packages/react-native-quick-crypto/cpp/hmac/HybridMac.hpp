@@ -0,0 +1,83 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <memory>
+#include <openssl/evp.h>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "HybridMacSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * Any OpenSSL EVP_MAC behind one object: HMAC, CMAC, GMAC, KMAC-128/256,
+ * Poly1305, SipHash, BLAKE2BMAC and BLAKE2SMAC.
+ *
+ * `init` keys a template context that is never fed data. Streaming and the
+ * one-shot paths each work on their own duplicate of it, so the key schedule
+ * (HMAC's padded digest states, CMAC's subkeys, GMAC's H) is computed once per
+ * key. Between one-shot messages the working context is reset with
+ * `EVP_MAC_init(ctx, NULL, 0, ...)`, which rewinds to the keyed state without
+ * allocating.
+ *
+ * Poly1305 keys must authenticate a single message, and OpenSSL cannot reset
+ * them, so a Poly1305 Mac produces exactly one tag. GMAC must never repeat an
+ * IV under one key; the one-shot paths therefore take an IV per message.
+ */
+class HybridMac : public HybridMacSpec {
+ public:
+  HybridMac() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void init(const MacArgs& args) override;
+  void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset,
+              const std::optional<double>& byteLength) override;
+  std::shared_ptr<ArrayBuffer> digest() override;
+  std::shared_ptr<HybridMacSpec> copy() override;
+  double getMacLength() override;
+  std::shared_ptr<ArrayBuffer> compute(const std::shared_ptr<ArrayBuffer>& data,
+                                       const std::optional<std::shared_ptr<ArrayBuffer>>& iv) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> computeMany(const std::vector<std::shared_ptr<ArrayBuffer>>& messages,
+                                                        const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& ivs) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  computeManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& messages,
+                   const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& ivs) override;
+
+ private:
+  using CtxPtr = std::unique_ptr<EVP_MAC_CTX, decltype(&EVP_MAC_CTX_free)>;
+
+  // Tags one message on `ctx`. A `fresh` context is still in its keyed state;
+  // any other one is reset first
+  static std::shared_ptr<ArrayBuffer> tag(EVP_MAC_CTX* ctx, bool fresh, std::span<const uint8_t> data,
+                                          std::optional<std::span<const uint8_t>> iv, size_t length);
+  const EVP_MAC_CTX* checkKey() const;
+  CtxPtr duplicate(const EVP_MAC_CTX* ctx) const;
+  // Claims the key for one more tag; throws for a second Poly1305 tag
+  void useKey(size_t tags);
+  // One IV per message exactly when the algorithm takes IVs
+  void checkIvs(size_t messages, std::optional<size_t> ivs) const;
+
+  std::string algorithm_;
+  size_t macLength_ = 0;
+  bool oneTimeKey_ = false;
+  bool needsIv_ = false;
+  bool keyUsed_ = false;
+  bool finalized_ = false;
+  // Keyed and never updated
+  CtxPtr key_{nullptr, EVP_MAC_CTX_free};
+  // update / digest; duplicated from key_ on first use
+  CtxPtr stream_{nullptr, EVP_MAC_CTX_free};
+  // compute / computeMany; reset between messages
+  CtxPtr work_{nullptr, EVP_MAC_CTX_free};
+  bool workFresh_ = false;
+};
+
+} // namespace margelo::nitro::crypto
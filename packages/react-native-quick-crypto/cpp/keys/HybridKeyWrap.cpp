@@ -0,0 +1,408 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <openssl/crypto.h>
+#include <stdexcept>
+
+#include "HybridKeyObjectHandle.hpp"
+#include "HybridKeyWrap.hpp"
+#include "LibraryContext.hpp"
+#include "QueueWait.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  using CipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+  // Key bytes that are wiped when the last reference goes away
+  std::shared_ptr<ArrayBuffer> secretBytes(const uint8_t* data, size_t size) {
+    uint8_t* bytes = new uint8_t[size];
+    std::memcpy(bytes, data, size);
+    return std::make_shared<NativeArrayBuffer>(bytes, size, [=]() {
+      OPENSSL_cleanse(bytes, size);
+      delete[] bytes;
+    });
+  }
+
+  std::string wrappedKey(const std::shared_ptr<ArrayBuffer>& wrapped) {
+    return std::string(reinterpret_cast<const char*>(wrapped->data()), wrapped->size());
+  }
+
+  // RFC 3394 section 2.2.3.1 and RFC 5649 section 3 initial values
+  constexpr uint8_t kDefaultIv[8] = {0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6};
+  constexpr uint8_t kPaddedIvPrefix[4] = {0xA6, 0x59, 0x59, 0xA6};
+  constexpr size_t kAesBlock = 16;
+  // Keys stepped together; bounds the block buffer of one ECB call
+  constexpr size_t kLanes = 128;
+
+  std::string ecbCipherName(size_t kek_size) {
+    if (kek_size != 16 && kek_size != 24 && kek_size != 32) {
+      throw std::runtime_error("Invalid KEK length: expected 16, 24 or 32 bytes, got " + std::to_string(kek_size));
+    }
+    return "AES-" + std::to_string(kek_size * 8) + "-ECB";
+  }
+
+  std::shared_ptr<EVP_CIPHER_CTX> createKeyedContext(const EVP_CIPHER* cipher, const std::shared_ptr<ArrayBuffer>& kek, bool encrypt) {
+    std::shared_ptr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+    if (!ctx) {
+      throw std::runtime_error("Failed to create cipher context");
+    }
+    if (EVP_CipherInit_ex(ctx.get(), cipher, nullptr, kek->data(), nullptr, encrypt ? 1 : 0) != 1 ||
+        EVP_CIPHER_CTX_set_padding(ctx.get(), 0) != 1) {
+      throw std::runtime_error("KeyWrap: Failed to set KEK: " + getOpenSSLError());
+    }
+    return ctx;
+  }
+
+  CipherCtxPtr copyContext(EVP_CIPHER_CTX* tmpl) {
+    // Copying a keyed context duplicates the expanded key, it does not redo it
+    CipherCtxPtr ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+    if (!ctx || EVP_CIPHER_CTX_copy(ctx.get(), tmpl) != 1) {
+      throw std::runtime_error("KeyWrap: Failed to copy cipher context: " + getOpenSSLError());
+    }
+    return ctx;
+  }
+
+  void xorCounter(uint8_t* a, uint64_t t) {
+    for (size_t i = 0; i < 8; i++) {
+      a[7 - i] ^= static_cast<uint8_t>(t >> (8 * i));
+    }
+  }
+
+  void ecbInPlace(EVP_CIPHER_CTX* ctx, uint8_t* blocks, size_t size) {
+    int out_len = 0;
+    if (EVP_CipherUpdate(ctx, blocks, &out_len, blocks, static_cast<int>(size)) != 1 || out_len != static_cast<int>(size)) {
+      throw std::runtime_error("KeyWrap: AES failed: " + getOpenSSLError());
+    }
+  }
+
+  // Runs the RFC 3394 wrapping function W (or its inverse) over keys of n
+  // semiblocks each. Every state is A || R[1] .. R[n] and is updated in place.
+  // Step t of all keys goes through AES in one call. RFC 5649 wraps a single
+  // semiblock as one AES block instead.
+  void stepKeys(EVP_CIPHER_CTX* ctx, bool encrypt, const std::vector<uint8_t*>& states, size_t n, std::vector<uint8_t>& blocks) {
+    size_t count = states.size();
+    blocks.resize(count * kAesBlock);
+    uint8_t* b = blocks.data();
+    if (n == 1) {
+      for (size_t k = 0; k < count; k++) {
+        std::memcpy(b + k * kAesBlock, states[k], kAesBlock);
+      }
+      ecbInPlace(ctx, b, count * kAesBlock);
+      for (size_t k = 0; k < count; k++) {
+        std::memcpy(states[k], b + k * kAesBlock, kAesBlock);
+      }
+      return;
+    }
+    for (size_t step = 0; step < 6 * n; step++) {
+      // Wrapping runs t = 1 .. 6n, unwrapping runs it backwards
+      uint64_t t = encrypt ? step + 1 : 6 * n - step;
+      size_t i = (t - 1) % n + 1;
+      for (size_t k = 0; k < count; k++) {
+        std::memcpy(b + k * kAesBlock, states[k], 8);
+        if (!encrypt) {
+          xorCounter(b + k * kAesBlock, t);
+        }
+        std::memcpy(b + k * kAesBlock + 8, states[k] + 8 * i, 8);
+      }
+      ecbInPlace(ctx, b, count * kAesBlock);
+      for (size_t k = 0; k < count; k++) {
+        std::memcpy(states[k], b + k * kAesBlock, 8);
+        if (encrypt) {
+          xorCounter(states[k], t);
+        }
+        std::memcpy(states[k] + 8 * i, b + k * kAesBlock + 8, 8);
+      }
+    }
+  }
+
+  // Runs stepKeys over every group of equally long keys, kLanes at a time
+  void stepAll(EVP_CIPHER_CTX* ctx, bool encrypt, const std::vector<uint8_t*>& states, const std::vector<size_t>& semiblocks) {
+    std::map<size_t, std::vector<size_t>> groups;
+    for (size_t k = 0; k < states.size(); k++) {
+      groups[semiblocks[k]].push_back(k);
+    }
+    std::vector<uint8_t> blocks;
+    std::vector<uint8_t*> lanes;
+    for (const auto& [n, members] : groups) {
+      for (size_t first = 0; first < members.size(); first += kLanes) {
+        size_t last = std::min(first + kLanes, members.size());
+        lanes.clear();
+        for (size_t k = first; k < last; k++) {
+          lanes.push_back(states[members[k]]);
+        }
+        stepKeys(ctx, encrypt, lanes, n, blocks);
+      }
+    }
+    OPENSSL_cleanse(blocks.data(), blocks.size());
+  }
+
+  // Checks the recovered A of an unwrapped state, returning the key length or
+  // -1 if the integrity check fails
+  int checkUnwrapped(const uint8_t* state, size_t n, bool padded) {
+    if (!padded) {
+      return CRYPTO_memcmp(state, kDefaultIv, 8) == 0 ? static_cast<int>(8 * n) : -1;
+    }
+    uint32_t mli = (static_cast<uint32_t>(state[4]) << 24) | (static_cast<uint32_t>(state[5]) << 16) |
+                   (static_cast<uint32_t>(state[6]) << 8) | static_cast<uint32_t>(state[7]);
+    if (CRYPTO_memcmp(state, kPaddedIvPrefix, 4) != 0 || mli <= 8 * (n - 1) || mli > 8 * n) {
+      return -1;
+    }
+    uint8_t padding = 0;
+    for (size_t i = 8 + mli; i < 8 * (n + 1); i++) {
+      padding |= state[i];
+    }
+    return padding == 0 ? static_cast<int>(mli) : -1;
+  }
+
+} // namespace
+
+std::shared_ptr<ArrayBuffer> HybridKeyWrap::Cache::find(const std::string& wrapped) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto cached = index.find(wrapped);
+  if (cached == index.end()) {
+    return nullptr;
+  }
+  keys.splice(keys.begin(), keys, cached->second);
+  return cached->second->second;
+}
+
+void HybridKeyWrap::Cache::insert(std::string wrapped, const std::shared_ptr<ArrayBuffer>& key) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (capacity == 0 || index.count(wrapped) != 0) {
+    return;
+  }
+  keys.emplace_front(std::move(wrapped), key);
+  index.emplace(keys.front().first, keys.begin());
+  if (keys.size() > capacity) {
+    index.erase(keys.back().first);
+    keys.pop_back();
+  }
+}
+
+void HybridKeyWrap::Cache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  index.clear();
+  keys.clear();
+}
+
+void HybridKeyWrap::init(const std::shared_ptr<HybridKeyObjectHandleSpec>& kek, bool padded, double cacheSize) {
+  clearOpenSSLErrors();
+
+  if (cacheSize < 0 || cacheSize != std::floor(cacheSize) || !CheckIsUint32(cacheSize)) {
+    throw std::runtime_error("Invalid cacheSize");
+  }
+  const auto& data = std::static_pointer_cast<HybridKeyObjectHandle>(kek)->getKeyObjectData();
+  if (!data || data.GetKeyType() != KeyType::SECRET) {
+    throw std::runtime_error("KeyWrap: KEK must be a secret key");
+  }
+  auto kek_bytes = data.GetSymmetricKey();
+  std::string cipher_name = ecbCipherName(kek_bytes->size());
+  EVP_CIPHER* cipher = fetchCipher(cipher_name);
+  if (!cipher) {
+    throw std::runtime_error("KeyWrap: " + cipher_name + " is not available");
+  }
+  std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher_guard(cipher, EVP_CIPHER_free);
+
+  auto config = std::make_shared<Kek>();
+  config->padded = padded;
+  config->enc_ctx = createKeyedContext(cipher, kek_bytes, true);
+  config->dec_ctx = createKeyedContext(cipher, kek_bytes, false);
+
+  // Cached keys belong to the previous KEK; in-flight jobs keep the old cache
+  auto cache = std::make_shared<Cache>();
+  cache->capacity = static_cast<size_t>(cacheSize);
+
+  kek_ = std::move(config);
+  cache_ = std::move(cache);
+}
+
+std::shared_ptr<const HybridKeyWrap::Kek> HybridKeyWrap::checkKek() const {
+  if (!kek_) {
+    throw std::runtime_error("KeyWrap not initialized. Call init() first.");
+  }
+  return kek_;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridKeyWrap::keyBytes(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys,
+                                                                  bool padded) {
+  std::vector<std::shared_ptr<ArrayBuffer>> bytes;
+  bytes.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    const auto& data = std::static_pointer_cast<HybridKeyObjectHandle>(keys[i])->getKeyObjectData();
+    if (!data || data.GetKeyType() != KeyType::SECRET) {
+      throw std::runtime_error("KeyWrap: key " + std::to_string(i) + " is not a secret key");
+    }
+    // Handles own native copies of their key bytes, so workers may read them
+    auto key = data.GetSymmetricKey();
+    size_t size = key->size();
+    if (padded ? size == 0 || size > static_cast<size_t>(INT_MAX) - 2 * kSemiblock
+               : size < 2 * kSemiblock || size % kSemiblock != 0 || size > static_cast<size_t>(INT_MAX) - kSemiblock) {
+      throw std::runtime_error("KeyWrap: key " + std::to_string(i) + " has an invalid length of " + std::to_string(size) +
+                               (padded ? " bytes" : " bytes; RFC 3394 needs a multiple of 8, at least 16"));
+    }
+    bytes.push_back(std::move(key));
+  }
+  return bytes;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridKeyWrap::wrapAll(const Kek& kek, Cache& cache,
+                                                                 const std::vector<std::shared_ptr<ArrayBuffer>>& keys) {
+  std::vector<std::shared_ptr<ArrayBuffer>> wrapped;
+  std::vector<uint8_t*> states;
+  std::vector<size_t> semiblocks;
+  wrapped.reserve(keys.size());
+  states.reserve(keys.size());
+  semiblocks.reserve(keys.size());
+  for (const auto& key : keys) {
+    size_t size = key->size();
+    // Padded input is zero-filled to whole semiblocks; A adds one more
+    size_t n = (size + kSemiblock - 1) / kSemiblock;
+    size_t out_size = (n + 1) * kSemiblock;
+    uint8_t* out = new uint8_t[out_size];
+    wrapped.push_back(std::make_shared<NativeArrayBuffer>(out, out_size, [=]() { delete[] out; }));
+    if (kek.padded) {
+      std::memcpy(out, kPaddedIvPrefix, 4);
+      for (size_t i = 0; i < 4; i++) {
+        out[7 - i] = static_cast<uint8_t>(size >> (8 * i));
+      }
+    } else {
+      std::memcpy(out, kDefaultIv, kSemiblock);
+    }
+    std::memcpy(out + kSemiblock, key->data(), size);
+    std::memset(out + kSemiblock + size, 0, out_size - kSemiblock - size);
+    states.push_back(out);
+    semiblocks.push_back(n);
+  }
+
+  CipherCtxPtr ctx = copyContext(kek.enc_ctx.get());
+  stepAll(ctx.get(), true, states, semiblocks);
+  for (size_t i = 0; i < keys.size(); i++) {
+    cache.insert(wrappedKey(wrapped[i]), secretBytes(keys[i]->data(), keys[i]->size()));
+  }
+  return wrapped;
+}
+
+std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>> HybridKeyWrap::unwrapAll(const Kek& kek, Cache& cache,
+                                                                                 const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped) {
+  std::vector<std::shared_ptr<ArrayBuffer>> keys(wrapped.size());
+  std::vector<size_t> misses;
+  size_t scratch_size = 0;
+  for (size_t i = 0; i < wrapped.size(); i++) {
+    keys[i] = cache.find(wrappedKey(wrapped[i]));
+    if (keys[i]) {
+      continue;
+    }
+    size_t size = wrapped[i]->size();
+    if (size % kSemiblock != 0 || size < (kek.padded ? 2 : 3) * kSemiblock || size > static_cast<size_t>(INT_MAX)) {
+      throw std::runtime_error("KeyWrap: wrapped key " + std::to_string(i) + " has an invalid length of " + std::to_string(size) +
+                               " bytes");
+    }
+    misses.push_back(i);
+    scratch_size += size;
+  }
+
+  if (!misses.empty()) {
+    // Unwrapped in place in one scratch buffer, wiped before returning
+    std::vector<uint8_t> scratch(scratch_size);
+    std::vector<uint8_t*> states;
+    std::vector<size_t> semiblocks;
+    uint8_t* next = scratch.data();
+    for (size_t i : misses) {
+      size_t size = wrapped[i]->size();
+      std::memcpy(next, wrapped[i]->data(), size);
+      states.push_back(next);
+      semiblocks.push_back(size / kSemiblock - 1);
+      next += size;
+    }
+
+    std::string failed;
+    size_t failures = 0;
+    try {
+      CipherCtxPtr ctx = copyContext(kek.dec_ctx.get());
+      stepAll(ctx.get(), false, states, semiblocks);
+      for (size_t m = 0; m < misses.size(); m++) {
+        int length = checkUnwrapped(states[m], semiblocks[m], kek.padded);
+        if (length < 0) {
+          failed += (failures++ == 0 ? "" : ", ") + std::to_string(misses[m]);
+          continue;
+        }
+        keys[misses[m]] = secretBytes(states[m] + kSemiblock, static_cast<size_t>(length));
+      }
+    } catch (...) {
+      OPENSSL_cleanse(scratch.data(), scratch.size());
+      throw;
+    }
+    OPENSSL_cleanse(scratch.data(), scratch.size());
+    if (failures != 0) {
+      throw std::runtime_error("KeyWrap: Unable to unwrap " + std::to_string(failures) + " key(s): " + failed +
+                               "; integrity check failed");
+    }
+    for (size_t i : misses) {
+      cache.insert(wrappedKey(wrapped[i]), keys[i]);
+    }
+  }
+
+  std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>> handles;
+  handles.reserve(wrapped.size());
+  for (const auto& key : keys) {
+    // A private copy per handle: exported key bytes are writable from JS
+    auto handle = std::make_shared<HybridKeyObjectHandle>();
+    handle->getKeyObjectData() = KeyObjectData::CreateSecret(secretBytes(key->data(), key->size()));
+    handles.push_back(std::move(handle));
+  }
+  return handles;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridKeyWrap::wrapKeys(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys) {
+  auto kek = checkKek();
+  return wrapAll(*kek, *cache_, keyBytes(keys, kek->padded));
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridKeyWrap::wrapKeysAsync(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys) {
+  auto kek = checkKek();
+  auto bytes = keyBytes(keys, kek->padded);
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async(
+      [kek, cache = cache_, bytes = std::move(bytes), queued = QueueWait::stamp("wrapKeys")]() {
+        queued.started();
+        return wrapAll(*kek, *cache, bytes);
+      });
+}
+
+std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>
+HybridKeyWrap::unwrapKeys(const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped) {
+  auto kek = checkKek();
+  return unwrapAll(*kek, *cache_, wrapped);
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>>>
+HybridKeyWrap::unwrapKeysAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped) {
+  auto kek = checkKek();
+  // Async jobs outlive the JS buffers, so they work on copies
+  std::vector<std::shared_ptr<ArrayBuffer>> native;
+  native.reserve(wrapped.size());
+  for (const auto& buffer : wrapped) {
+    native.push_back(ToNativeArrayBuffer(buffer));
+  }
+  return Promise<std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>>::async(
+      [kek, cache = cache_, native = std::move(native), queued = QueueWait::stamp("unwrapKeys")]() {
+        queued.started();
+        return unwrapAll(*kek, *cache, native);
+      });
+}
+
+double HybridKeyWrap::getCachedCount() {
+  std::lock_guard<std::mutex> lock(cache_->mutex);
+  return static_cast<double>(cache_->keys.size());
+}
+
+void HybridKeyWrap::clearCache() {
+  cache_->clear();
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <openssl/evp.h>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HybridKeyWrapSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * AES key wrap (RFC 3394, or RFC 5649 with padding) of many data keys under
+ * one key-encryption key.
+ *
+ * OpenSSL 3.0's `-wrap` ciphers step through the key one block at a time on
+ * the portable AES code, even where AES instructions exist. Key wrap is only
+ * AES on 16-byte blocks, so it is done here over a KEK scheduled once into
+ * AES-ECB contexts. All keys of a batch that have the same length advance in
+ * lockstep, and each of the 6n wrap steps becomes one multi-block ECB call.
+ *
+ * Unwrapped keys are remembered in an LRU keyed by the wrapped bytes. Keys
+ * wrapped here are added to it too, so opening the same envelope again skips
+ * the unwrap. Every handle gets its own copy of the key bytes. Cached and
+ * returned copies are cleansed when freed.
+ */
+class HybridKeyWrap : public HybridKeyWrapSpec {
+ public:
+  HybridKeyWrap() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void init(const std::shared_ptr<HybridKeyObjectHandleSpec>& kek, bool padded, double cacheSize) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> wrapKeys(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  wrapKeysAsync(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys) override;
+  std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>> unwrapKeys(const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>>>
+  unwrapKeysAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped) override;
+  double getCachedCount() override;
+  void clearCache() override;
+
+ private:
+  // Immutable keyed state shared with in-flight async jobs
+  struct Kek {
+    bool padded = false;
+    // AES-ECB without padding, keyed with the KEK
+    std::shared_ptr<EVP_CIPHER_CTX> enc_ctx;
+    std::shared_ptr<EVP_CIPHER_CTX> dec_ctx;
+  };
+
+  // Unwrapped keys by wrapped bytes, most recently used first
+  struct Cache {
+    std::mutex mutex;
+    size_t capacity = 0;
+    std::list<std::pair<std::string, std::shared_ptr<ArrayBuffer>>> keys;
+    std::unordered_map<std::string, std::list<std::pair<std::string, std::shared_ptr<ArrayBuffer>>>::iterator> index;
+
+    std::shared_ptr<ArrayBuffer> find(const std::string& wrapped);
+    void insert(std::string wrapped, const std::shared_ptr<ArrayBuffer>& key);
+    void clear();
+  };
+
+  std::shared_ptr<const Kek> checkKek() const;
+  static std::vector<std::shared_ptr<ArrayBuffer>> keyBytes(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys,
+                                                            bool padded);
+  static std::vector<std::shared_ptr<ArrayBuffer>> wrapAll(const Kek& kek, Cache& cache,
+                                                           const std::vector<std::shared_ptr<ArrayBuffer>>& keys);
+  static std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>> unwrapAll(const Kek& kek, Cache& cache,
+                                                                           const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped);
+
+ private:
+  // RFC 3394 works on 64-bit semiblocks
+  static constexpr size_t kSemiblock = 8;
+
+  std::shared_ptr<const Kek> kek_;
+  std::shared_ptr<Cache> cache_ = std::make_shared<Cache>();
+};
+
+} // namespace margelo::nitro::crypto
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "HybridMlDsaKeyPairSpec.hpp"
+#include "SerialExecutor.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -34,6 +35,8 @@ class HybridMlDsaKeyPair : public HybridMlDsaKeyPairSpec {
  private:
   std::string variant_;
   EVP_PKEY* pkey_ = nullptr;
+  // async jobs run one at a time, in call order
+  SerialExecutor executor_;
 
   int publicFormat_ = -1;
   int publicType_ = -1;
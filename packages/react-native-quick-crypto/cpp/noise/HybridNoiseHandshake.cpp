@@ -0,0 +1,250 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "HybridNoiseHandshake.hpp"
+#include "HybridNoiseTransport.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  std::shared_ptr<ArrayBuffer> toBuffer(std::span<const uint8_t> bytes) {
+    return ToNativeArrayBuffer(bytes);
+  }
+
+  bool writesStatic(const NoiseProtocol& protocol, bool initiator) {
+    if (initiator ? protocol.initiator_pre_s : protocol.responder_pre_s) {
+      return true;
+    }
+    for (size_t i = initiator ? 0 : 1; i < protocol.messages.size(); i += 2) {
+      for (NoiseToken token : protocol.messages[i]) {
+        if (token == NoiseToken::S) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Length of a handshake message before it is written, so an oversized
+  // payload is rejected without touching the handshake state
+  size_t messageLength(const NoiseProtocol& protocol, const std::vector<NoiseToken>& tokens, bool has_key, size_t payload) {
+    size_t length = 0;
+    for (NoiseToken token : tokens) {
+      if (token == NoiseToken::E) {
+        length += protocol.dh_len;
+      } else if (token == NoiseToken::S) {
+        length += protocol.dh_len + (has_key ? kNoiseTagSize : 0);
+      } else {
+        has_key = true;
+      }
+    }
+    return length + payload + (has_key ? kNoiseTagSize : 0);
+  }
+
+} // namespace
+
+void HybridNoiseHandshake::init(const NoiseHandshakeArgs& args) {
+  clearOpenSSLErrors();
+  auto protocol = NoiseProtocol::named(args.protocolName);
+  bool initiator = args.initiator;
+  const char* role = initiator ? "initiator" : "responder";
+
+  std::optional<NoiseKeyPair> s;
+  if (args.staticPrivateKey.has_value()) {
+    s = NoiseKeyPair::fromPrivateKey(*protocol, ToByteView(args.staticPrivateKey.value()));
+  }
+  if (writesStatic(*protocol, initiator) && !s) {
+    throw std::runtime_error("Noise: The " + std::string(role) + " of " + protocol->name + " needs a static private key");
+  }
+  bool knows_remote = initiator ? protocol->responder_pre_s : protocol->initiator_pre_s;
+  if (knows_remote != args.remoteStaticPublicKey.has_value()) {
+    throw std::runtime_error("Noise: The " + std::string(role) + " of " + protocol->name +
+                             (knows_remote ? " needs" : " does not take") + " the remote static public key");
+  }
+  std::vector<uint8_t> rs;
+  if (knows_remote) {
+    auto key = ToByteView(args.remoteStaticPublicKey.value());
+    if (key.size() != protocol->dh_len) {
+      throw std::runtime_error("Noise: Invalid remote static public key length: expected " + std::to_string(protocol->dh_len) + " bytes");
+    }
+    rs.assign(key.begin(), key.end());
+  }
+  std::optional<NoiseKeyPair> e;
+  if (args.ephemeralPrivateKey.has_value()) {
+    e = NoiseKeyPair::fromPrivateKey(*protocol, ToByteView(args.ephemeralPrivateKey.value()));
+  }
+
+  auto symmetric = std::make_unique<NoiseSymmetricState>(protocol);
+  symmetric->mixHash(args.prologue.has_value() ? ToByteView(args.prologue.value()) : std::span<const uint8_t>());
+  if (protocol->initiator_pre_s) {
+    symmetric->mixHash(initiator ? std::span<const uint8_t>(s->publicKey()) : std::span<const uint8_t>(rs));
+  }
+  if (protocol->responder_pre_s) {
+    symmetric->mixHash(initiator ? std::span<const uint8_t>(rs) : std::span<const uint8_t>(s->publicKey()));
+  }
+
+  protocol_ = std::move(protocol);
+  initiator_ = initiator;
+  symmetric_ = std::move(symmetric);
+  s_ = std::move(s);
+  e_ = std::move(e);
+  rs_ = std::move(rs);
+  re_.clear();
+  message_ = 0;
+  failed_ = false;
+  split_ = false;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridNoiseHandshake::generateKeyPair(const std::string& dh) {
+  if (dh != "25519" && dh != "448") {
+    throw std::runtime_error("Noise: Unsupported DH function: " + dh + "; expected 25519 or 448");
+  }
+  auto pair = NoiseKeyPair::generate(dh == "25519" ? "X25519" : "X448");
+  auto private_key = pair.privateKey();
+  auto result = std::vector<std::shared_ptr<ArrayBuffer>>{toBuffer(private_key), toBuffer(pair.publicKey())};
+  OPENSSL_cleanse(private_key.data(), private_key.size());
+  return result;
+}
+
+bool HybridNoiseHandshake::isWriteTurn() const {
+  return (message_ % 2 == 0) == initiator_;
+}
+
+std::string HybridNoiseHandshake::getAction() {
+  if (!symmetric_) {
+    throw std::runtime_error("NoiseHandshake not initialized. Call init() first.");
+  }
+  if (failed_ || split_) {
+    return "done";
+  }
+  if (message_ == protocol_->messages.size()) {
+    return "split";
+  }
+  return isWriteTurn() ? "write" : "read";
+}
+
+void HybridNoiseHandshake::checkTurn(bool write) {
+  std::string action = getAction();
+  if (failed_) {
+    throw std::runtime_error("Noise: The handshake failed; start a new one");
+  }
+  if (action != (write ? "write" : "read")) {
+    throw std::runtime_error(std::string("Noise: Cannot ") + (write ? "write" : "read") + " a message now; the next action is " +
+                             action);
+  }
+}
+
+void HybridNoiseHandshake::mixDh(NoiseToken token) {
+  // es is DH(e, rs) for the initiator and DH(s, re) for the responder; se
+  // mirrors it
+  bool local_ephemeral = token == NoiseToken::EE || (token == NoiseToken::ES && initiator_) || (token == NoiseToken::SE && !initiator_);
+  bool remote_ephemeral = token == NoiseToken::EE || (token == NoiseToken::ES && !initiator_) || (token == NoiseToken::SE && initiator_);
+  const NoiseKeyPair& local = local_ephemeral ? *e_ : *s_;
+  std::vector<uint8_t> shared = local.dh(*protocol_, remote_ephemeral ? re_ : rs_);
+  symmetric_->mixKey(shared);
+  OPENSSL_cleanse(shared.data(), shared.size());
+}
+
+std::shared_ptr<ArrayBuffer> HybridNoiseHandshake::writeMessage(const std::shared_ptr<ArrayBuffer>& payload) {
+  checkTurn(true);
+  clearOpenSSLErrors();
+  auto body = ToByteView(payload);
+  if (messageLength(*protocol_, protocol_->messages[message_], symmetric_->hasKey(), body.size()) > kNoiseMaxMessage) {
+    throw std::runtime_error("Noise: Handshake messages are limited to 65535 bytes");
+  }
+  // Any failure past this point leaves the symmetric state half-updated
+  failed_ = true;
+  std::vector<uint8_t> out;
+  for (NoiseToken token : protocol_->messages[message_]) {
+    if (token == NoiseToken::E) {
+      if (!e_) {
+        e_ = NoiseKeyPair::generate(protocol_->dh_name);
+      }
+      out.insert(out.end(), e_->publicKey().begin(), e_->publicKey().end());
+      symmetric_->mixHash(e_->publicKey());
+    } else if (token == NoiseToken::S) {
+      auto sealed = symmetric_->encryptAndHash(s_->publicKey());
+      out.insert(out.end(), sealed.begin(), sealed.end());
+    } else {
+      mixDh(token);
+    }
+  }
+  auto sealed = symmetric_->encryptAndHash(body);
+  out.insert(out.end(), sealed.begin(), sealed.end());
+  failed_ = false;
+  message_++;
+  return toBuffer(out);
+}
+
+std::shared_ptr<ArrayBuffer> HybridNoiseHandshake::readMessage(const std::shared_ptr<ArrayBuffer>& message) {
+  checkTurn(false);
+  clearOpenSSLErrors();
+  auto bytes = ToByteView(message);
+  if (bytes.size() > kNoiseMaxMessage) {
+    throw std::runtime_error("Noise: Handshake messages are limited to 65535 bytes");
+  }
+  // Any failure past this point leaves the symmetric state half-updated
+  failed_ = true;
+  size_t offset = 0;
+  auto take = [&](size_t length) {
+    if (bytes.size() - offset < length) {
+      throw std::runtime_error("Noise: Handshake message is too short");
+    }
+    auto part = bytes.subspan(offset, length);
+    offset += length;
+    return part;
+  };
+  for (NoiseToken token : protocol_->messages[message_]) {
+    if (token == NoiseToken::E) {
+      auto key = take(protocol_->dh_len);
+      re_.assign(key.begin(), key.end());
+      symmetric_->mixHash(re_);
+    } else if (token == NoiseToken::S) {
+      rs_ = symmetric_->decryptAndHash(take(protocol_->dh_len + (symmetric_->hasKey() ? kNoiseTagSize : 0)));
+    } else {
+      mixDh(token);
+    }
+  }
+  auto payload = symmetric_->decryptAndHash(bytes.subspan(offset));
+  failed_ = false;
+  message_++;
+  return toBuffer(payload);
+}
+
+std::shared_ptr<ArrayBuffer> HybridNoiseHandshake::getHandshakeHash() {
+  if (!symmetric_) {
+    throw std::runtime_error("NoiseHandshake not initialized. Call init() first.");
+  }
+  return toBuffer(symmetric_->handshakeHash());
+}
+
+std::optional<std::shared_ptr<ArrayBuffer>> HybridNoiseHandshake::getRemoteStaticPublicKey() {
+  if (rs_.empty()) {
+    return std::nullopt;
+  }
+  return toBuffer(rs_);
+}
+
+std::shared_ptr<HybridNoiseTransportSpec> HybridNoiseHandshake::split() {
+  std::string action = getAction();
+  if (action != "split") {
+    throw std::runtime_error("Noise: Cannot split now; the next action is " + action);
+  }
+  auto [initiator_to_responder, responder_to_initiator] = symmetric_->split();
+  split_ = true;
+  // The handshake keys are no longer needed; the hash stays for channel binding
+  s_.reset();
+  e_.reset();
+  if (protocol_->one_way) {
+    // Only the initiator sends in a one-way pattern
+    responder_to_initiator.reset();
+  }
+  if (initiator_) {
+    return std::make_shared<HybridNoiseTransport>(protocol_, std::move(initiator_to_responder), std::move(responder_to_initiator));
+  }
+  return std::make_shared<HybridNoiseTransport>(protocol_, std::move(responder_to_initiator), std::move(initiator_to_responder));
+}
+
+} // namespace margelo::nitro::crypto
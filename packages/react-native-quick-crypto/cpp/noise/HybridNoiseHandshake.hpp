@@ -0,0 +1,59 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "HybridNoiseHandshakeSpec.hpp"
+#include "NoiseState.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * HandshakeState of the Noise Protocol Framework (revision 34) for the
+ * fundamental patterns with 25519/448, ChaChaPoly/AESGCM and
+ * SHA256/SHA512/BLAKE2s/BLAKE2b. One call writes or reads a whole handshake
+ * message: every token's DH, MixKey and MixHash runs natively, and the
+ * ephemeral, static and chaining keys never cross the bridge.
+ *
+ * `split` hands the two transport CipherStates to a NoiseTransport, already
+ * keyed. A handshake that fails to write or read a message cannot be resumed.
+ */
+class HybridNoiseHandshake : public HybridNoiseHandshakeSpec {
+ public:
+  HybridNoiseHandshake() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void init(const NoiseHandshakeArgs& args) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> generateKeyPair(const std::string& dh) override;
+  std::string getAction() override;
+  std::shared_ptr<ArrayBuffer> writeMessage(const std::shared_ptr<ArrayBuffer>& payload) override;
+  std::shared_ptr<ArrayBuffer> readMessage(const std::shared_ptr<ArrayBuffer>& message) override;
+  std::shared_ptr<ArrayBuffer> getHandshakeHash() override;
+  std::optional<std::shared_ptr<ArrayBuffer>> getRemoteStaticPublicKey() override;
+  std::shared_ptr<HybridNoiseTransportSpec> split() override;
+
+ private:
+  // The pattern's messages in order; even ones are the initiator's
+  bool isWriteTurn() const;
+  void checkTurn(bool write);
+  void mixDh(NoiseToken token);
+
+  std::shared_ptr<const NoiseProtocol> protocol_;
+  bool initiator_ = false;
+  std::unique_ptr<NoiseSymmetricState> symmetric_;
+  std::optional<NoiseKeyPair> s_;
+  std::optional<NoiseKeyPair> e_;
+  std::vector<uint8_t> rs_;
+  std::vector<uint8_t> re_;
+  size_t message_ = 0;
+  bool failed_ = false;
+  bool split_ = false;
+};
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,183 @@
+#include <stdexcept>
+#include <string>
+
+#include "HybridNoiseTransport.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  std::span<const uint8_t> optionalView(const std::optional<std::shared_ptr<ArrayBuffer>>& buffer) {
+    return buffer.has_value() ? ToByteView(buffer.value()) : std::span<const uint8_t>();
+  }
+
+  void checkPlaintext(size_t size) {
+    if (size > kNoiseMaxMessage - kNoiseTagSize) {
+      throw std::runtime_error("Noise: Transport messages are limited to 65535 bytes, so plaintexts to 65519");
+    }
+  }
+
+  void checkCiphertext(size_t size) {
+    if (size > kNoiseMaxMessage) {
+      throw std::runtime_error("Noise: Transport messages are limited to 65535 bytes");
+    }
+    if (size < kNoiseTagSize) {
+      throw std::runtime_error("Noise: Decryption failed");
+    }
+  }
+
+  std::shared_ptr<ArrayBuffer> allocate(size_t size) {
+    uint8_t* out = new uint8_t[size];
+    return std::make_shared<NativeArrayBuffer>(out, size, [=]() { delete[] out; });
+  }
+
+} // namespace
+
+NoiseCipherState& HybridNoiseTransport::sending() {
+  if (!send_) {
+    throw std::runtime_error("Noise: " + protocol_->name + " is one-way; only the initiator sends");
+  }
+  return *send_;
+}
+
+NoiseCipherState& HybridNoiseTransport::receiving() {
+  if (!receive_) {
+    throw std::runtime_error("Noise: " + protocol_->name + " is one-way; only the responder receives");
+  }
+  if (decrypt_in_flight_.load(std::memory_order_acquire)) {
+    throw std::runtime_error("Noise: Transport is busy with a pending decryptManyAsync");
+  }
+  return *receive_;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNoiseTransport::encrypt(const std::shared_ptr<ArrayBuffer>& plaintext,
+                                                           const std::optional<std::shared_ptr<ArrayBuffer>>& ad) {
+  auto bytes = ToByteView(plaintext);
+  checkPlaintext(bytes.size());
+  auto out = allocate(bytes.size() + kNoiseTagSize);
+  sending().encryptWithAd(optionalView(ad), bytes, out->data());
+  return out;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNoiseTransport::decrypt(const std::shared_ptr<ArrayBuffer>& ciphertext,
+                                                           const std::optional<std::shared_ptr<ArrayBuffer>>& ad) {
+  auto bytes = ToByteView(ciphertext);
+  checkCiphertext(bytes.size());
+  auto out = allocate(bytes.size() - kNoiseTagSize);
+  receiving().decryptWithAd(optionalView(ad), bytes, out->data());
+  return out;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridNoiseTransport::sealAll(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx,
+                                                                        uint64_t nonce,
+                                                                        const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts) {
+  std::vector<std::shared_ptr<ArrayBuffer>> out;
+  out.reserve(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    auto bytes = ToByteView(plaintexts[i]);
+    auto sealed = allocate(bytes.size() + kNoiseTagSize);
+    NoiseCipherState::seal(protocol, ctx, nonce + i, {}, bytes, sealed->data());
+    out.push_back(sealed);
+  }
+  return out;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridNoiseTransport::openAll(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx,
+                                                                        uint64_t nonce,
+                                                                        const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts) {
+  std::vector<std::shared_ptr<ArrayBuffer>> out;
+  out.reserve(ciphertexts.size());
+  for (size_t i = 0; i < ciphertexts.size(); i++) {
+    auto bytes = ToByteView(ciphertexts[i]);
+    auto opened = allocate(bytes.size() - kNoiseTagSize);
+    if (!NoiseCipherState::open(protocol, ctx, nonce + i, {}, bytes, opened->data())) {
+      throw std::runtime_error("Noise: Decryption failed for message " + std::to_string(i));
+    }
+    out.push_back(opened);
+  }
+  return out;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridNoiseTransport::encryptMany(const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts) {
+  for (const auto& plaintext : plaintexts) {
+    checkPlaintext(plaintext->size());
+  }
+  NoiseCipherState& state = sending();
+  std::shared_ptr<EVP_CIPHER_CTX> ctx = state.duplicateContext(true);
+  uint64_t nonce = state.reserveNonces(plaintexts.size());
+  return sealAll(*protocol_, ctx.get(), nonce, plaintexts);
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridNoiseTransport::encryptManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts) {
+  std::vector<std::shared_ptr<ArrayBuffer>> nativePlaintexts;
+  nativePlaintexts.reserve(plaintexts.size());
+  for (const auto& plaintext : plaintexts) {
+    checkPlaintext(plaintext->size());
+    nativePlaintexts.push_back(ToNativeArrayBuffer(plaintext));
+  }
+  NoiseCipherState& state = sending();
+  std::shared_ptr<EVP_CIPHER_CTX> ctx = state.duplicateContext(true);
+  uint64_t nonce = state.reserveNonces(plaintexts.size());
+
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async([protocol = protocol_, ctx, nonce,
+                                                                    nativePlaintexts = std::move(nativePlaintexts),
+                                                                    queued = QueueWait::stamp("noiseEncryptMany")]() {
+    queued.started();
+    return sealAll(*protocol, ctx.get(), nonce, nativePlaintexts);
+  });
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridNoiseTransport::decryptMany(const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts) {
+  for (const auto& ciphertext : ciphertexts) {
+    checkCiphertext(ciphertext->size());
+  }
+  NoiseCipherState& state = receiving();
+  std::shared_ptr<EVP_CIPHER_CTX> ctx = state.duplicateContext(false);
+  auto plaintexts = openAll(*protocol_, ctx.get(), state.peekNonces(ciphertexts.size()), ciphertexts);
+  state.advanceNonces(ciphertexts.size());
+  return plaintexts;
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridNoiseTransport::decryptManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts) {
+  std::vector<std::shared_ptr<ArrayBuffer>> nativeCiphertexts;
+  nativeCiphertexts.reserve(ciphertexts.size());
+  for (const auto& ciphertext : ciphertexts) {
+    checkCiphertext(ciphertext->size());
+    nativeCiphertexts.push_back(ToNativeArrayBuffer(ciphertext));
+  }
+  NoiseCipherState& state = receiving();
+  std::shared_ptr<EVP_CIPHER_CTX> ctx = state.duplicateContext(false);
+  uint64_t nonce = state.peekNonces(ciphertexts.size());
+  decrypt_in_flight_.store(true, std::memory_order_release);
+
+  // the job advances the receive nonce, so it keeps the transport alive
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async([self = strongRef(this), ctx, nonce,
+                                                                    nativeCiphertexts = std::move(nativeCiphertexts),
+                                                                    queued = QueueWait::stamp("noiseDecryptMany")]() {
+    queued.started();
+    struct Release {
+      std::atomic<bool>& in_flight;
+      ~Release() {
+        in_flight.store(false, std::memory_order_release);
+      }
+    } release{self->decrypt_in_flight_};
+    auto plaintexts = openAll(*self->protocol_, ctx.get(), nonce, nativeCiphertexts);
+    self->receive_->advanceNonces(nativeCiphertexts.size());
+    return plaintexts;
+  });
+}
+
+void HybridNoiseTransport::rekeySend() {
+  sending().rekey();
+}
+
+void HybridNoiseTransport::rekeyReceive() {
+  receiving().rekey();
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "HybridNoiseTransportSpec.hpp"
+#include "NoiseState.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+/**
+ * The two transport CipherStates a Noise handshake splits into, one per
+ * direction. Each keeps a keyed cipher context for the whole session, so a
+ * message costs one nonce change and one AEAD pass.
+ *
+ * Batches run on a copy of the keyed context. Encryption batches reserve their
+ * nonces when called, in call order. Decryption, single or batched, advances
+ * the nonce only once every message authenticated, so a forged message never
+ * desynchronizes the channel. While a decryptManyAsync is pending, the other
+ * receive calls throw. Created only by NoiseHandshake.split().
+ */
+class HybridNoiseTransport : public HybridNoiseTransportSpec {
+ public:
+  HybridNoiseTransport(std::shared_ptr<const NoiseProtocol> protocol, std::unique_ptr<NoiseCipherState> send,
+                       std::unique_ptr<NoiseCipherState> receive)
+      : HybridObject(TAG), protocol_(std::move(protocol)), send_(std::move(send)), receive_(std::move(receive)) {}
+
+ public:
+  // Methods
+  std::shared_ptr<ArrayBuffer> encrypt(const std::shared_ptr<ArrayBuffer>& plaintext,
+                                       const std::optional<std::shared_ptr<ArrayBuffer>>& ad) override;
+  std::shared_ptr<ArrayBuffer> decrypt(const std::shared_ptr<ArrayBuffer>& ciphertext,
+                                       const std::optional<std::shared_ptr<ArrayBuffer>>& ad) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> encryptMany(const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  encryptManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> decryptMany(const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  decryptManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts) override;
+  void rekeySend() override;
+  void rekeyReceive() override;
+
+ private:
+  NoiseCipherState& sending();
+  NoiseCipherState& receiving();
+
+  static std::vector<std::shared_ptr<ArrayBuffer>> sealAll(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx, uint64_t nonce,
+                                                           const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts);
+  static std::vector<std::shared_ptr<ArrayBuffer>> openAll(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx, uint64_t nonce,
+                                                           const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts);
+
+  std::shared_ptr<const NoiseProtocol> protocol_;
+  std::unique_ptr<NoiseCipherState> send_;
+  std::unique_ptr<NoiseCipherState> receive_;
+  // Set while a decryptManyAsync job owns the receive nonce
+  std::atomic<bool> decrypt_in_flight_{false};
+};
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,491 @@
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+#include <openssl/params.h>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "LibraryContext.hpp"
+#include "NoiseState.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  using Bytes = std::vector<uint8_t>;
+
+  // The fundamental patterns of section 7.4 (one-way) and 7.5 (interactive).
+  // Every pre-message here is a single static key
+  struct PatternSpec {
+    const char* name;
+    bool initiator_pre_s;
+    bool responder_pre_s;
+    std::vector<const char*> messages;
+  };
+
+  const PatternSpec kPatterns[] = {
+      {"N", false, true, {"e es"}},
+      {"K", true, true, {"e es ss"}},
+      {"X", false, true, {"e es s ss"}},
+      {"NN", false, false, {"e", "e ee"}},
+      {"NK", false, true, {"e es", "e ee"}},
+      {"NX", false, false, {"e", "e ee s es"}},
+      {"KN", true, false, {"e", "e ee se"}},
+      {"KK", true, true, {"e es ss", "e ee se"}},
+      {"KX", true, false, {"e", "e ee se s es"}},
+      {"XN", false, false, {"e", "e ee", "s se"}},
+      {"XK", false, true, {"e es", "e ee", "s se"}},
+      {"XX", false, false, {"e", "e ee s es", "s se"}},
+      {"IN", false, false, {"e s", "e ee se"}},
+      {"IK", false, true, {"e es s ss", "e ee se"}},
+      {"IX", false, false, {"e s", "e ee se s es"}},
+  };
+
+  std::vector<NoiseToken> parseTokens(std::string_view message) {
+    std::vector<NoiseToken> tokens;
+    size_t start = 0;
+    while (start < message.size()) {
+      size_t end = message.find(' ', start);
+      std::string_view token = message.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+      if (token == "e") {
+        tokens.push_back(NoiseToken::E);
+      } else if (token == "s") {
+        tokens.push_back(NoiseToken::S);
+      } else if (token == "ee") {
+        tokens.push_back(NoiseToken::EE);
+      } else if (token == "es") {
+        tokens.push_back(NoiseToken::ES);
+      } else if (token == "se") {
+        tokens.push_back(NoiseToken::SE);
+      } else {
+        tokens.push_back(NoiseToken::SS);
+      }
+      start = end == std::string_view::npos ? message.size() : end + 1;
+    }
+    return tokens;
+  }
+
+  std::vector<std::string> splitName(const std::string& name) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    for (size_t end = name.find('_'); end != std::string::npos; end = name.find('_', start)) {
+      parts.push_back(name.substr(start, end - start));
+      start = end + 1;
+    }
+    parts.push_back(name.substr(start));
+    return parts;
+  }
+
+  std::shared_ptr<const NoiseProtocol> buildProtocol(const std::string& name) {
+    auto parts = splitName(name);
+    if (parts.size() != 5 || parts[0] != "Noise") {
+      throw std::runtime_error("Noise: Invalid protocol name: " + name + "; expected Noise_<pattern>_<dh>_<cipher>_<hash>");
+    }
+    auto protocol = std::make_shared<NoiseProtocol>();
+    protocol->name = name;
+
+    const PatternSpec* pattern = nullptr;
+    for (const auto& candidate : kPatterns) {
+      if (parts[1] == candidate.name) {
+        pattern = &candidate;
+      }
+    }
+    if (pattern == nullptr) {
+      throw std::runtime_error("Noise: Unsupported handshake pattern: " + parts[1] +
+                               "; expected one of the fundamental patterns, without modifiers");
+    }
+    protocol->initiator_pre_s = pattern->initiator_pre_s;
+    protocol->responder_pre_s = pattern->responder_pre_s;
+    for (const char* message : pattern->messages) {
+      protocol->messages.push_back(parseTokens(message));
+    }
+    protocol->one_way = protocol->messages.size() == 1;
+
+    if (parts[2] == "25519") {
+      protocol->dh_name = "X25519";
+      protocol->dh_len = 32;
+    } else if (parts[2] == "448") {
+      protocol->dh_name = "X448";
+      protocol->dh_len = 56;
+    } else {
+      throw std::runtime_error("Noise: Unsupported DH function: " + parts[2] + "; expected 25519 or 448");
+    }
+
+    if (parts[3] == "ChaChaPoly") {
+      protocol->cipher.reset(fetchCipher("ChaCha20-Poly1305"));
+    } else if (parts[3] == "AESGCM") {
+      protocol->cipher.reset(fetchCipher("AES-256-GCM"));
+      protocol->big_endian_nonce = true;
+    } else {
+      throw std::runtime_error("Noise: Unsupported cipher: " + parts[3] + "; expected ChaChaPoly or AESGCM");
+    }
+
+    if (parts[4] == "SHA256") {
+      protocol->digest_name = "SHA256";
+    } else if (parts[4] == "SHA512") {
+      protocol->digest_name = "SHA512";
+    } else if (parts[4] == "BLAKE2s") {
+      protocol->digest_name = "BLAKE2S-256";
+    } else if (parts[4] == "BLAKE2b") {
+      protocol->digest_name = "BLAKE2B-512";
+    } else {
+      throw std::runtime_error("Noise: Unsupported hash: " + parts[4] + "; expected SHA256, SHA512, BLAKE2s or BLAKE2b");
+    }
+    protocol->md.reset(fetchDigest(protocol->digest_name));
+    protocol->hmac.reset(fetchMac("HMAC"));
+    if (!protocol->cipher || !protocol->md || !protocol->hmac) {
+      throw std::runtime_error("Noise: " + name + " is not available: " + getOpenSSLError());
+    }
+    protocol->hash_len = static_cast<size_t>(EVP_MD_get_size(protocol->md.get()));
+    return protocol;
+  }
+
+  Bytes computeHmac(const NoiseProtocol& protocol, std::span<const uint8_t> key, std::initializer_list<std::span<const uint8_t>> parts) {
+    std::unique_ptr<EVP_MAC_CTX, decltype(&EVP_MAC_CTX_free)> ctx(EVP_MAC_CTX_new(protocol.hmac.get()), EVP_MAC_CTX_free);
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>(protocol.digest_name.c_str()), 0),
+        OSSL_PARAM_construct_end(),
+    };
+    Bytes out(protocol.hash_len);
+    size_t length = 0;
+    bool ok = ctx && EVP_MAC_init(ctx.get(), key.data(), key.size(), params) == 1;
+    for (const auto& part : parts) {
+      ok = ok && EVP_MAC_update(ctx.get(), part.data(), part.size()) == 1;
+    }
+    if (!ok || EVP_MAC_final(ctx.get(), out.data(), &length, out.size()) != 1) {
+      throw std::runtime_error("Noise: HMAC failed: " + getOpenSSLError());
+    }
+    return out;
+  }
+
+  void storeNonce(uint8_t* iv, uint64_t nonce, bool big_endian) {
+    std::memset(iv, 0, 4);
+    for (size_t i = 0; i < 8; i++) {
+      iv[4 + (big_endian ? 7 - i : i)] = static_cast<uint8_t>(nonce >> (8 * i));
+    }
+  }
+
+} // namespace
+
+std::shared_ptr<const NoiseProtocol> NoiseProtocol::named(const std::string& name) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<const NoiseProtocol>> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto cached = cache.find(name);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+  return cache.emplace(name, buildProtocol(name)).first->second;
+}
+
+std::vector<uint8_t> NoiseProtocol::hash(std::initializer_list<std::span<const uint8_t>> parts) const {
+  std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+  Bytes out(hash_len);
+  bool ok = ctx && EVP_DigestInit_ex2(ctx.get(), md.get(), nullptr) == 1;
+  for (const auto& part : parts) {
+    ok = ok && EVP_DigestUpdate(ctx.get(), part.data(), part.size()) == 1;
+  }
+  if (!ok || EVP_DigestFinal_ex(ctx.get(), out.data(), nullptr) != 1) {
+    throw std::runtime_error("Noise: HASH failed: " + getOpenSSLError());
+  }
+  return out;
+}
+
+std::vector<std::vector<uint8_t>> NoiseProtocol::hkdf(std::span<const uint8_t> chaining_key, std::span<const uint8_t> ikm,
+                                                       size_t outputs) const {
+  Bytes temp_key = computeHmac(*this, chaining_key, {ikm});
+  std::vector<Bytes> out;
+  for (size_t i = 1; i <= outputs; i++) {
+    const uint8_t counter = static_cast<uint8_t>(i);
+    std::span<const uint8_t> previous = out.empty() ? std::span<const uint8_t>() : std::span<const uint8_t>(out.back());
+    out.push_back(computeHmac(*this, temp_key, {previous, std::span<const uint8_t>(&counter, 1)}));
+  }
+  OPENSSL_cleanse(temp_key.data(), temp_key.size());
+  return out;
+}
+
+NoiseKeyPair::NoiseKeyPair(EVP_PKEY* pkey) : pkey_(pkey, EVP_PKEY_free) {
+  size_t length = 0;
+  if (EVP_PKEY_get_raw_public_key(pkey, nullptr, &length) != 1) {
+    throw std::runtime_error("Noise: Failed to read public key: " + getOpenSSLError());
+  }
+  public_key_.resize(length);
+  if (EVP_PKEY_get_raw_public_key(pkey, public_key_.data(), &length) != 1) {
+    throw std::runtime_error("Noise: Failed to read public key: " + getOpenSSLError());
+  }
+}
+
+NoiseKeyPair NoiseKeyPair::generate(const std::string& dh_name) {
+  EVP_PKEY* pkey = EVP_PKEY_Q_keygen(libraryContext(), nullptr, dh_name.c_str());
+  if (pkey == nullptr) {
+    throw std::runtime_error("Noise: Failed to generate " + dh_name + " key: " + getOpenSSLError());
+  }
+  return NoiseKeyPair(pkey);
+}
+
+NoiseKeyPair NoiseKeyPair::fromPrivateKey(const NoiseProtocol& protocol, std::span<const uint8_t> private_key) {
+  if (private_key.size() != protocol.dh_len) {
+    throw std::runtime_error("Noise: Invalid private key length: expected " + std::to_string(protocol.dh_len) + " bytes, got " +
+                             std::to_string(private_key.size()));
+  }
+  EVP_PKEY* pkey =
+      EVP_PKEY_new_raw_private_key_ex(libraryContext(), protocol.dh_name.c_str(), nullptr, private_key.data(), private_key.size());
+  if (pkey == nullptr) {
+    throw std::runtime_error("Noise: Invalid private key: " + getOpenSSLError());
+  }
+  return NoiseKeyPair(pkey);
+}
+
+std::vector<uint8_t> NoiseKeyPair::privateKey() const {
+  size_t length = 0;
+  Bytes out;
+  if (EVP_PKEY_get_raw_private_key(pkey_.get(), nullptr, &length) == 1) {
+    out.resize(length);
+    if (EVP_PKEY_get_raw_private_key(pkey_.get(), out.data(), &length) == 1) {
+      return out;
+    }
+  }
+  throw std::runtime_error("Noise: Failed to read private key: " + getOpenSSLError());
+}
+
+std::vector<uint8_t> NoiseKeyPair::dh(const NoiseProtocol& protocol, std::span<const uint8_t> remote_public_key) const {
+  if (remote_public_key.size() != protocol.dh_len) {
+    throw std::runtime_error("Noise: Invalid public key length: expected " + std::to_string(protocol.dh_len) + " bytes, got " +
+                             std::to_string(remote_public_key.size()));
+  }
+  std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> peer(
+      EVP_PKEY_new_raw_public_key_ex(libraryContext(), protocol.dh_name.c_str(), nullptr, remote_public_key.data(),
+                                     remote_public_key.size()),
+      EVP_PKEY_free);
+  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new_from_pkey(libraryContext(), pkey_.get(), nullptr),
+                                                                   EVP_PKEY_CTX_free);
+  Bytes out(protocol.dh_len);
+  size_t length = out.size();
+  // OpenSSL refuses an all-zero shared secret, i.e. a low-order remote key
+  if (!peer || !ctx || EVP_PKEY_derive_init(ctx.get()) != 1 || EVP_PKEY_derive_set_peer(ctx.get(), peer.get()) != 1 ||
+      EVP_PKEY_derive(ctx.get(), out.data(), &length) != 1) {
+    throw std::runtime_error("Noise: DH failed, the remote public key is invalid: " + getOpenSSLError());
+  }
+  return out;
+}
+
+NoiseCipherState::~NoiseCipherState() {
+  OPENSSL_cleanse(key_.data(), key_.size());
+}
+
+void NoiseCipherState::initializeKey(std::span<const uint8_t> key) {
+  enc_ctx_.reset();
+  dec_ctx_.reset();
+  nonce_ = 0;
+  has_key_ = !key.empty();
+  if (!has_key_) {
+    OPENSSL_cleanse(key_.data(), key_.size());
+    return;
+  }
+  if (key.size() != kNoiseKeySize) {
+    throw std::runtime_error("Noise: cipher keys are 32 bytes");
+  }
+  std::memcpy(key_.data(), key.data(), key_.size());
+}
+
+EVP_CIPHER_CTX* NoiseCipherState::context(bool encrypt) {
+  CipherCtxPtr& ctx = encrypt ? enc_ctx_ : dec_ctx_;
+  if (ctx) {
+    return ctx.get();
+  }
+  CipherCtxPtr fresh(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+  int enc = encrypt ? 1 : 0;
+  if (!fresh || EVP_CipherInit_ex(fresh.get(), protocol_->cipher.get(), nullptr, nullptr, nullptr, enc) != 1 ||
+      EVP_CipherInit_ex(fresh.get(), nullptr, nullptr, key_.data(), nullptr, enc) != 1) {
+    throw std::runtime_error("Noise: Failed to set up cipher: " + getOpenSSLError());
+  }
+  ctx = std::move(fresh);
+  return ctx.get();
+}
+
+void NoiseCipherState::checkKey() const {
+  // 2^64 - 1 is reserved for rekey()
+  if (nonce_ == std::numeric_limits<uint64_t>::max()) {
+    throw std::runtime_error("Noise: nonces exhausted; start a new handshake");
+  }
+}
+
+void NoiseCipherState::seal(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx, uint64_t nonce, std::span<const uint8_t> ad,
+                            std::span<const uint8_t> plaintext, uint8_t* out) {
+  uint8_t iv[12];
+  storeNonce(iv, nonce, protocol.big_endian_nonce);
+  int length = 0;
+  bool ok = EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, iv, -1) == 1 &&
+            (ad.empty() || EVP_CipherUpdate(ctx, nullptr, &length, ad.data(), static_cast<int>(ad.size())) == 1) &&
+            (plaintext.empty() || EVP_CipherUpdate(ctx, out, &length, plaintext.data(), static_cast<int>(plaintext.size())) == 1) &&
+            EVP_CipherFinal_ex(ctx, out + plaintext.size(), &length) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, kNoiseTagSize, out + plaintext.size()) == 1;
+  if (!ok) {
+    throw std::runtime_error("Noise: Encryption failed: " + getOpenSSLError());
+  }
+}
+
+bool NoiseCipherState::open(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx, uint64_t nonce, std::span<const uint8_t> ad,
+                            std::span<const uint8_t> ciphertext, uint8_t* out) {
+  if (ciphertext.size() < kNoiseTagSize) {
+    return false;
+  }
+  size_t size = ciphertext.size() - kNoiseTagSize;
+  uint8_t iv[12];
+  storeNonce(iv, nonce, protocol.big_endian_nonce);
+  int length = 0;
+  bool ok =
+      EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, iv, -1) == 1 &&
+      EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, kNoiseTagSize, const_cast<uint8_t*>(ciphertext.data() + size)) == 1 &&
+      (ad.empty() || EVP_CipherUpdate(ctx, nullptr, &length, ad.data(), static_cast<int>(ad.size())) == 1) &&
+      (size == 0 || EVP_CipherUpdate(ctx, out, &length, ciphertext.data(), static_cast<int>(size)) == 1) &&
+      EVP_CipherFinal_ex(ctx, out + size, &length) == 1;
+  if (!ok) {
+    ERR_clear_error();
+    OPENSSL_cleanse(out, size);
+  }
+  return ok;
+}
+
+void NoiseCipherState::encryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> plaintext, uint8_t* out) {
+  if (!has_key_) {
+    if (!plaintext.empty()) {
+      std::memcpy(out, plaintext.data(), plaintext.size());
+    }
+    return;
+  }
+  checkKey();
+  seal(*protocol_, context(true), nonce_, ad, plaintext, out);
+  nonce_++;
+}
+
+void NoiseCipherState::decryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> ciphertext, uint8_t* out) {
+  if (!has_key_) {
+    if (!ciphertext.empty()) {
+      std::memcpy(out, ciphertext.data(), ciphertext.size());
+    }
+    return;
+  }
+  checkKey();
+  if (!open(*protocol_, context(false), nonce_, ad, ciphertext, out)) {
+    throw std::runtime_error("Noise: Decryption failed");
+  }
+  nonce_++;
+}
+
+std::vector<uint8_t> NoiseCipherState::encryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> plaintext) {
+  Bytes out(plaintext.size() + (has_key_ ? kNoiseTagSize : 0));
+  encryptWithAd(ad, plaintext, out.data());
+  return out;
+}
+
+std::vector<uint8_t> NoiseCipherState::decryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> ciphertext) {
+  if (has_key_ && ciphertext.size() < kNoiseTagSize) {
+    throw std::runtime_error("Noise: Decryption failed");
+  }
+  Bytes out(ciphertext.size() - (has_key_ ? kNoiseTagSize : 0));
+  decryptWithAd(ad, ciphertext, out.data());
+  return out;
+}
+
+void NoiseCipherState::rekey() {
+  // REKEY(k) = ENCRYPT(k, 2^64 - 1, empty, zeros) truncated to 32 bytes
+  uint8_t zeros[kNoiseKeySize] = {};
+  uint8_t sealed[kNoiseKeySize + kNoiseTagSize];
+  seal(*protocol_, context(true), std::numeric_limits<uint64_t>::max(), {}, zeros, sealed);
+  std::memcpy(key_.data(), sealed, key_.size());
+  OPENSSL_cleanse(sealed, sizeof(sealed));
+  enc_ctx_.reset();
+  dec_ctx_.reset();
+}
+
+uint64_t NoiseCipherState::reserveNonces(size_t count) {
+  uint64_t first = peekNonces(count);
+  advanceNonces(count);
+  return first;
+}
+
+uint64_t NoiseCipherState::peekNonces(size_t count) const {
+  if (count > std::numeric_limits<uint64_t>::max() - nonce_) {
+    throw std::runtime_error("Noise: nonces exhausted; start a new handshake");
+  }
+  return nonce_;
+}
+
+void NoiseCipherState::advanceNonces(size_t count) {
+  peekNonces(count);
+  nonce_ += count;
+}
+
+std::shared_ptr<EVP_CIPHER_CTX> NoiseCipherState::duplicateContext(bool encrypt) {
+  EVP_CIPHER_CTX* keyed = context(encrypt);
+  std::shared_ptr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free);
+  if (!ctx || EVP_CIPHER_CTX_copy(ctx.get(), keyed) != 1) {
+    throw std::runtime_error("Noise: Failed to copy cipher context: " + getOpenSSLError());
+  }
+  return ctx;
+}
+
+NoiseSymmetricState::NoiseSymmetricState(std::shared_ptr<const NoiseProtocol> protocol)
+    : protocol_(std::move(protocol)), cipher_(protocol_) {
+  const auto* name = reinterpret_cast<const uint8_t*>(protocol_->name.data());
+  if (protocol_->name.size() <= protocol_->hash_len) {
+    h_.assign(name, name + protocol_->name.size());
+    h_.resize(protocol_->hash_len, 0);
+  } else {
+    h_ = protocol_->hash({std::span<const uint8_t>(name, protocol_->name.size())});
+  }
+  ck_ = h_;
+}
+
+NoiseSymmetricState::~NoiseSymmetricState() {
+  OPENSSL_cleanse(ck_.data(), ck_.size());
+}
+
+void NoiseSymmetricState::mixKey(std::span<const uint8_t> ikm) {
+  auto out = protocol_->hkdf(ck_, ikm, 2);
+  ck_ = out[0];
+  // HASHLEN 64 hashes truncate the key to 32 bytes
+  cipher_.initializeKey(std::span<const uint8_t>(out[1]).first(kNoiseKeySize));
+  for (auto& key : out) {
+    OPENSSL_cleanse(key.data(), key.size());
+  }
+}
+
+void NoiseSymmetricState::mixHash(std::span<const uint8_t> data) {
+  h_ = protocol_->hash({h_, data});
+}
+
+std::vector<uint8_t> NoiseSymmetricState::encryptAndHash(std::span<const uint8_t> plaintext) {
+  Bytes ciphertext = cipher_.encryptWithAd(h_, plaintext);
+  mixHash(ciphertext);
+  return ciphertext;
+}
+
+std::vector<uint8_t> NoiseSymmetricState::decryptAndHash(std::span<const uint8_t> ciphertext) {
+  Bytes plaintext = cipher_.decryptWithAd(h_, ciphertext);
+  mixHash(ciphertext);
+  return plaintext;
+}
+
+std::pair<std::unique_ptr<NoiseCipherState>, std::unique_ptr<NoiseCipherState>> NoiseSymmetricState::split() {
+  auto out = protocol_->hkdf(ck_, {}, 2);
+  auto first = std::make_unique<NoiseCipherState>(protocol_);
+  auto second = std::make_unique<NoiseCipherState>(protocol_);
+  first->initializeKey(std::span<const uint8_t>(out[0]).first(kNoiseKeySize));
+  second->initializeKey(std::span<const uint8_t>(out[1]).first(kNoiseKeySize));
+  for (auto& key : out) {
+    OPENSSL_cleanse(key.data(), key.size());
+  }
+  // Only the handshake hash outlives the handshake
+  OPENSSL_cleanse(ck_.data(), ck_.size());
+  cipher_.initializeKey({});
+  return {std::move(first), std::move(second)};
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <openssl/evp.h>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::crypto {
+
+// Noise caps every handshake and transport message at 65535 bytes
+constexpr size_t kNoiseMaxMessage = 65535;
+constexpr size_t kNoiseKeySize = 32;
+constexpr size_t kNoiseTagSize = 16;
+
+enum class NoiseToken { E, S, EE, ES, SE, SS };
+
+/**
+ * Everything a protocol name such as Noise_XX_25519_ChaChaPoly_BLAKE2s
+ * selects: the handshake pattern and the DH, cipher and hash functions of
+ * the Noise Protocol Framework (revision 34). Parsed once per name and
+ * shared by every handshake and transport that uses it.
+ */
+struct NoiseProtocol {
+  std::string name;
+  // Pre-messages: the initiator's and the responder's static keys are known
+  // to the other side before the handshake starts
+  bool initiator_pre_s = false;
+  bool responder_pre_s = false;
+  std::vector<std::vector<NoiseToken>> messages;
+  bool one_way = false;
+
+  std::string dh_name; // OpenSSL key type, X25519 or X448
+  size_t dh_len = 0;
+  std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher{nullptr, EVP_CIPHER_free};
+  // ChaChaPoly encodes the nonce little-endian, AESGCM big-endian
+  bool big_endian_nonce = false;
+  std::string digest_name;
+  std::unique_ptr<EVP_MD, decltype(&EVP_MD_free)> md{nullptr, EVP_MD_free};
+  std::unique_ptr<EVP_MAC, decltype(&EVP_MAC_free)> hmac{nullptr, EVP_MAC_free};
+  size_t hash_len = 0;
+
+  static std::shared_ptr<const NoiseProtocol> named(const std::string& name);
+
+  std::vector<uint8_t> hash(std::initializer_list<std::span<const uint8_t>> parts) const;
+  // HKDF(chaining_key, input_key_material, num_outputs) of section 4.3
+  std::vector<std::vector<uint8_t>> hkdf(std::span<const uint8_t> chaining_key, std::span<const uint8_t> ikm, size_t outputs) const;
+};
+
+// A DH key pair of the protocol's curve; the private key never leaves OpenSSL
+class NoiseKeyPair {
+ public:
+  static NoiseKeyPair generate(const std::string& dh_name);
+  static NoiseKeyPair fromPrivateKey(const NoiseProtocol& protocol, std::span<const uint8_t> private_key);
+
+  const std::vector<uint8_t>& publicKey() const {
+    return public_key_;
+  }
+  std::vector<uint8_t> privateKey() const;
+  std::vector<uint8_t> dh(const NoiseProtocol& protocol, std::span<const uint8_t> remote_public_key) const;
+
+ private:
+  explicit NoiseKeyPair(EVP_PKEY* pkey);
+
+  std::shared_ptr<EVP_PKEY> pkey_;
+  std::vector<uint8_t> public_key_;
+};
+
+/**
+ * CipherState: a key and a 64-bit nonce. The key schedule runs once per key;
+ * every message then only sets its nonce on an already keyed context.
+ */
+class NoiseCipherState {
+ public:
+  explicit NoiseCipherState(std::shared_ptr<const NoiseProtocol> protocol) : protocol_(std::move(protocol)) {}
+  ~NoiseCipherState();
+  NoiseCipherState(const NoiseCipherState&) = delete;
+  NoiseCipherState& operator=(const NoiseCipherState&) = delete;
+
+  // An empty key clears it, and without a key messages pass through unchanged
+  void initializeKey(std::span<const uint8_t> key);
+  bool hasKey() const {
+    return has_key_;
+  }
+
+  // EncryptWithAd / DecryptWithAd into `out`, which holds the ciphertext
+  // (plaintext + tag) or plaintext length. A failed decryption throws and
+  // leaves the nonce where it was
+  void encryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> plaintext, uint8_t* out);
+  void decryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> ciphertext, uint8_t* out);
+  std::vector<uint8_t> encryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> plaintext);
+  std::vector<uint8_t> decryptWithAd(std::span<const uint8_t> ad, std::span<const uint8_t> ciphertext);
+  void rekey();
+
+  // Batches seal or open on a duplicate of the keyed context. Encryption
+  // takes its `count` consecutive nonces up front; decryption looks up the
+  // first one and advances past them only once every message authenticated
+  uint64_t reserveNonces(size_t count);
+  uint64_t peekNonces(size_t count) const;
+  void advanceNonces(size_t count);
+  std::shared_ptr<EVP_CIPHER_CTX> duplicateContext(bool encrypt);
+  static void seal(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx, uint64_t nonce, std::span<const uint8_t> ad,
+                   std::span<const uint8_t> plaintext, uint8_t* out);
+  static bool open(const NoiseProtocol& protocol, EVP_CIPHER_CTX* ctx, uint64_t nonce, std::span<const uint8_t> ad,
+                   std::span<const uint8_t> ciphertext, uint8_t* out);
+
+ private:
+  using CipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+  EVP_CIPHER_CTX* context(bool encrypt);
+  void checkKey() const;
+
+  std::shared_ptr<const NoiseProtocol> protocol_;
+  std::array<uint8_t, kNoiseKeySize> key_{};
+  bool has_key_ = false;
+  uint64_t nonce_ = 0;
+  CipherCtxPtr enc_ctx_{nullptr, EVP_CIPHER_CTX_free};
+  CipherCtxPtr dec_ctx_{nullptr, EVP_CIPHER_CTX_free};
+};
+
+// SymmetricState: the chaining key, the handshake hash and the CipherState
+// that encrypts handshake payloads
+class NoiseSymmetricState {
+ public:
+  explicit NoiseSymmetricState(std::shared_ptr<const NoiseProtocol> protocol);
+  ~NoiseSymmetricState();
+
+  void mixKey(std::span<const uint8_t> ikm);
+  void mixHash(std::span<const uint8_t> data);
+  std::vector<uint8_t> encryptAndHash(std::span<const uint8_t> plaintext);
+  std::vector<uint8_t> decryptAndHash(std::span<const uint8_t> ciphertext);
+  bool hasKey() const {
+    return cipher_.hasKey();
+  }
+  const std::vector<uint8_t>& handshakeHash() const {
+    return h_;
+  }
+  std::pair<std::unique_ptr<NoiseCipherState>, std::unique_ptr<NoiseCipherState>> split();
+
+ private:
+  std::shared_ptr<const NoiseProtocol> protocol_;
+  std::vector<uint8_t> ck_;
+  std::vector<uint8_t> h_;
+  NoiseCipherState cipher_;
+};
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,795 @@
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "HybridOprf.hpp"
+#include "LibraryContext.hpp"
+#include "QueueWait.hpp"
+#include "Utils.hpp"
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  using BN_CTX_ptr = std::unique_ptr<BN_CTX, decltype(&BN_CTX_free)>;
+  using BignumPtr = std::unique_ptr<BIGNUM, decltype(&BN_clear_free)>;
+  using OwnedPoint = std::unique_ptr<EC_POINT, decltype(&EC_POINT_clear_free)>;
+  using Bytes = std::vector<uint8_t>;
+
+  BN_CTX_ptr newContext() {
+    BN_CTX_ptr ctx(BN_CTX_secure_new_ex(libraryContext()), BN_CTX_free);
+    if (!ctx) {
+      throw std::runtime_error("Failed to allocate BN_CTX");
+    }
+    return ctx;
+  }
+
+  BignumPtr newBignum() {
+    BignumPtr bn(BN_secure_new(), BN_clear_free);
+    if (!bn) {
+      throw std::runtime_error("Failed to allocate big number");
+    }
+    return bn;
+  }
+
+} // namespace
+
+struct OprfSuite {
+  std::string identifier;
+  std::unique_ptr<EC_GROUP, decltype(&EC_GROUP_free)> group{nullptr, EC_GROUP_free};
+  std::unique_ptr<EVP_MD, decltype(&EVP_MD_free)> md{nullptr, EVP_MD_free};
+  size_t hash_size = 0;    // Nh
+  size_t scalar_size = 0;  // Ns
+  size_t element_size = 0; // Ne, a compressed SEC1 point
+  size_t expand_size = 0;  // L, bytes hashed per field element
+  // y^2 = x^3 + A * x + B over GF(p), and Z of the simplified SWU map
+  BignumPtr p{nullptr, BN_clear_free};
+  BignumPtr a{nullptr, BN_clear_free};
+  BignumPtr b{nullptr, BN_clear_free};
+  BignumPtr z{nullptr, BN_clear_free};
+  // sqrt_ratio for p = 3 mod 4 (RFC 9380 appendix F.2.1.2): (p - 3) / 4 and
+  // sqrt(-Z). order - 2 inverts scalars by Fermat's little theorem
+  BignumPtr sqrt_ratio_exp{nullptr, BN_clear_free};
+  BignumPtr sqrt_neg_z{nullptr, BN_clear_free};
+  BignumPtr order_inv_exp{nullptr, BN_clear_free};
+
+  const BIGNUM* order() const {
+    return EC_GROUP_get0_order(group.get());
+  }
+};
+
+namespace {
+
+  // RFC 9497 section 4: each suite's HashToGroup is the RFC 9380 suite of the
+  // same curve and hash, with the given SSWU Z and hash_to_field length L
+  struct SuiteParams {
+    const char* identifier;
+    int nid;
+    const char* digest;
+    int z;
+    size_t expand_size;
+  };
+
+  constexpr SuiteParams kSuites[] = {
+      {"P256-SHA256", NID_X9_62_prime256v1, "SHA256", -10, 48},
+      {"P384-SHA384", NID_secp384r1, "SHA384", -12, 72},
+      {"P521-SHA512", NID_secp521r1, "SHA512", -4, 98},
+  };
+
+  // Batches are indexed with two-byte counters in the proof transcripts
+  constexpr size_t kMaxBatch = 65535;
+
+  std::shared_ptr<const OprfSuite> buildSuite(const SuiteParams& params) {
+    auto suite = std::make_shared<OprfSuite>();
+    suite->identifier = params.identifier;
+    suite->group.reset(EC_GROUP_new_by_curve_name_ex(libraryContext(), nullptr, params.nid));
+    suite->md.reset(fetchDigest(params.digest));
+    if (!suite->group || !suite->md) {
+      throw std::runtime_error(std::string("OPRF: ") + params.identifier + " is not available: " + getOpenSSLError());
+    }
+    auto ctx = newContext();
+    suite->p = newBignum();
+    suite->a = newBignum();
+    suite->b = newBignum();
+    suite->z = newBignum();
+    suite->sqrt_ratio_exp = newBignum();
+    suite->sqrt_neg_z = newBignum();
+    suite->order_inv_exp = newBignum();
+    BignumPtr t = newBignum();
+
+    const BIGNUM* p = suite->p.get();
+    bool ok = EC_GROUP_get_curve(suite->group.get(), suite->p.get(), suite->a.get(), suite->b.get(), ctx.get()) == 1 &&
+              BN_set_word(t.get(), static_cast<BN_ULONG>(-params.z)) == 1 && BN_sub(suite->z.get(), p, t.get()) == 1 &&
+              // sqrt(-Z) = (-Z)^((p + 1) / 4)
+              BN_copy(suite->sqrt_ratio_exp.get(), p) != nullptr && BN_add_word(suite->sqrt_ratio_exp.get(), 1) == 1 &&
+              BN_rshift(suite->sqrt_ratio_exp.get(), suite->sqrt_ratio_exp.get(), 2) == 1 &&
+              BN_mod_exp(suite->sqrt_neg_z.get(), t.get(), suite->sqrt_ratio_exp.get(), p, ctx.get()) == 1 &&
+              BN_copy(suite->sqrt_ratio_exp.get(), p) != nullptr && BN_sub_word(suite->sqrt_ratio_exp.get(), 3) == 1 &&
+              BN_rshift(suite->sqrt_ratio_exp.get(), suite->sqrt_ratio_exp.get(), 2) == 1 &&
+              BN_copy(suite->order_inv_exp.get(), suite->order()) != nullptr && BN_sub_word(suite->order_inv_exp.get(), 2) == 1;
+    if (!ok) {
+      throw std::runtime_error(std::string("OPRF: Failed to set up ") + params.identifier + ": " + getOpenSSLError());
+    }
+    suite->hash_size = static_cast<size_t>(EVP_MD_get_size(suite->md.get()));
+    suite->scalar_size = static_cast<size_t>(BN_num_bytes(suite->order()));
+    suite->element_size = static_cast<size_t>(BN_num_bytes(p)) + 1;
+    suite->expand_size = params.expand_size;
+    return suite;
+  }
+
+  std::shared_ptr<const OprfSuite> namedSuite(const std::string& identifier) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const OprfSuite>> cache;
+
+    for (const auto& params : kSuites) {
+      if (identifier != params.identifier) {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      auto cached = cache.find(identifier);
+      if (cached != cache.end()) {
+        return cached->second;
+      }
+      return cache.emplace(identifier, buildSuite(params)).first->second;
+    }
+    return nullptr;
+  }
+
+  std::span<const uint8_t> asBytes(std::string_view text) {
+    return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+  }
+
+  // I2OSP(len(data), 2) || data, the framing of every RFC 9497 transcript
+  void appendFramed(Bytes& out, std::span<const uint8_t> data) {
+    if (data.size() > 65535) {
+      throw std::runtime_error("OPRF: inputs are limited to 65535 bytes");
+    }
+    out.push_back(static_cast<uint8_t>(data.size() >> 8));
+    out.push_back(static_cast<uint8_t>(data.size()));
+    out.insert(out.end(), data.begin(), data.end());
+  }
+
+  void appendRaw(Bytes& out, std::span<const uint8_t> data) {
+    out.insert(out.end(), data.begin(), data.end());
+  }
+
+  Bytes digest(const OprfSuite& suite, std::initializer_list<std::span<const uint8_t>> parts) {
+    std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+    Bytes out(suite.hash_size);
+    unsigned int length = 0;
+    bool ok = ctx && EVP_DigestInit_ex2(ctx.get(), suite.md.get(), nullptr) == 1;
+    for (const auto& part : parts) {
+      ok = ok && EVP_DigestUpdate(ctx.get(), part.data(), part.size()) == 1;
+    }
+    if (!ok || EVP_DigestFinal_ex(ctx.get(), out.data(), &length) != 1) {
+      throw std::runtime_error("OPRF: digest failed: " + getOpenSSLError());
+    }
+    return out;
+  }
+
+  // RFC 9380 section 5.3.1
+  Bytes expandMessageXmd(const OprfSuite& suite, std::span<const uint8_t> msg, std::span<const uint8_t> dst, size_t length) {
+    size_t b_len = suite.hash_size;
+    size_t ell = (length + b_len - 1) / b_len;
+    if (ell > 255 || length > 65535 || dst.size() > 255) {
+      throw std::runtime_error("OPRF: expand_message_xmd arguments out of range");
+    }
+    Bytes dst_prime(dst.begin(), dst.end());
+    dst_prime.push_back(static_cast<uint8_t>(dst.size()));
+    Bytes z_pad(static_cast<size_t>(EVP_MD_get_block_size(suite.md.get())), 0);
+    const uint8_t lib_str[3] = {static_cast<uint8_t>(length >> 8), static_cast<uint8_t>(length), 0};
+
+    Bytes b0 = digest(suite, {z_pad, msg, lib_str, dst_prime});
+    Bytes out;
+    out.reserve(ell * b_len);
+    Bytes chain(b_len, 0);
+    for (size_t i = 1; i <= ell; i++) {
+      // b_1 hashes b_0 itself; later blocks hash b_0 XOR b_(i - 1)
+      for (size_t j = 0; j < b_len; j++) {
+        chain[j] ^= b0[j];
+      }
+      const uint8_t counter = static_cast<uint8_t>(i);
+      chain = digest(suite, {chain, std::span<const uint8_t>(&counter, 1), dst_prime});
+      appendRaw(out, chain);
+    }
+    OPENSSL_cleanse(b0.data(), b0.size());
+    out.resize(length);
+    return out;
+  }
+
+  // RFC 9380 section 5.2 with m = 1: count elements of GF(modulus)
+  std::vector<BignumPtr> hashToField(const OprfSuite& suite, std::span<const uint8_t> msg, std::span<const uint8_t> dst,
+                                     const BIGNUM* modulus, size_t count, BN_CTX* ctx) {
+    Bytes uniform = expandMessageXmd(suite, msg, dst, count * suite.expand_size);
+    std::vector<BignumPtr> elements;
+    for (size_t i = 0; i < count; i++) {
+      BignumPtr e = newBignum();
+      if (BN_bin2bn(uniform.data() + i * suite.expand_size, static_cast<int>(suite.expand_size), e.get()) == nullptr ||
+          BN_nnmod(e.get(), e.get(), modulus, ctx) != 1) {
+        OPENSSL_cleanse(uniform.data(), uniform.size());
+        throw std::runtime_error("OPRF: hash_to_field failed");
+      }
+      elements.push_back(std::move(e));
+    }
+    OPENSSL_cleanse(uniform.data(), uniform.size());
+    return elements;
+  }
+
+  // RFC 9380 appendix F.2, the straight-line simplified SWU map for A * B != 0
+  // with sqrt_ratio for p = 3 mod 4. One exponentiation yields both the
+  // square-root test and the root, and x stays a fraction: the point is set in
+  // Jacobian coordinates with Z = x's denominator, so nothing is inverted
+  OwnedPoint mapToCurve(const OprfSuite& suite, const BIGNUM* u, BN_CTX* ctx) {
+    const BIGNUM* p = suite.p.get();
+    const BIGNUM* a = suite.a.get();
+    const BIGNUM* b = suite.b.get();
+    BignumPtr tv1 = newBignum();
+    BignumPtr tv2 = newBignum();
+    BignumPtr tv3 = newBignum();
+    BignumPtr tv4 = newBignum();
+    BignumPtr tv5 = newBignum();
+    BignumPtr tv6 = newBignum();
+    BignumPtr x = newBignum();
+    BignumPtr y = newBignum();
+    BignumPtr y1 = newBignum();
+    BN_set_flags(y1.get(), BN_FLG_CONSTTIME);
+
+    // tv1 = Z * u^2, tv2 = tv1^2 + tv1, tv3 = B * (tv2 + 1), tv4 = A * (tv2 ? -tv2 : Z)
+    bool ok = BN_mod_sqr(tv1.get(), u, p, ctx) == 1 && BN_mod_mul(tv1.get(), tv1.get(), suite.z.get(), p, ctx) == 1 &&
+              BN_mod_sqr(tv2.get(), tv1.get(), p, ctx) == 1 && BN_mod_add(tv2.get(), tv2.get(), tv1.get(), p, ctx) == 1 &&
+              BN_copy(tv3.get(), tv2.get()) != nullptr && BN_add_word(tv3.get(), 1) == 1 &&
+              BN_mod_mul(tv3.get(), tv3.get(), b, p, ctx) == 1 &&
+              (BN_is_zero(tv2.get()) ? BN_copy(tv4.get(), suite.z.get()) != nullptr : BN_sub(tv4.get(), p, tv2.get()) == 1) &&
+              BN_mod_mul(tv4.get(), tv4.get(), a, p, ctx) == 1 &&
+              // gx1 = tv2 / tv6 = (tv3^3 + A * tv3 * tv4^2 + B * tv4^3) / tv4^3
+              BN_mod_sqr(tv2.get(), tv3.get(), p, ctx) == 1 && BN_mod_sqr(tv6.get(), tv4.get(), p, ctx) == 1 &&
+              BN_mod_mul(tv5.get(), a, tv6.get(), p, ctx) == 1 && BN_mod_add(tv2.get(), tv2.get(), tv5.get(), p, ctx) == 1 &&
+              BN_mod_mul(tv2.get(), tv2.get(), tv3.get(), p, ctx) == 1 && BN_mod_mul(tv6.get(), tv6.get(), tv4.get(), p, ctx) == 1 &&
+              BN_mod_mul(tv5.get(), b, tv6.get(), p, ctx) == 1 && BN_mod_add(tv2.get(), tv2.get(), tv5.get(), p, ctx) == 1 &&
+              // sqrt_ratio(tv2, tv6): y1 = (tv2 * tv6^3)^((p - 3) / 4) * tv2 * tv6
+              BN_mod_mul(tv5.get(), tv2.get(), tv6.get(), p, ctx) == 1 && BN_mod_sqr(y1.get(), tv6.get(), p, ctx) == 1 &&
+              BN_mod_mul(y1.get(), y1.get(), tv5.get(), p, ctx) == 1 &&
+              BN_mod_exp_mont_consttime(y1.get(), y1.get(), suite.sqrt_ratio_exp.get(), p, ctx, nullptr) == 1 &&
+              BN_mod_mul(y1.get(), y1.get(), tv5.get(), p, ctx) == 1 && BN_mod_sqr(tv5.get(), y1.get(), p, ctx) == 1 &&
+              BN_mod_mul(tv5.get(), tv5.get(), tv6.get(), p, ctx) == 1;
+    if (!ok) {
+      throw std::runtime_error("OPRF: map_to_curve failed: " + getOpenSSLError());
+    }
+    // Square gx1: (x, y) = (tv3, y1). Otherwise gx2 = Z^3 u^6 gx1 is square with
+    // (x, y) = (tv1 * tv3, tv1 * u * y1 * sqrt(-Z))
+    if (BN_cmp(tv5.get(), tv2.get()) == 0) {
+      ok = BN_copy(x.get(), tv3.get()) != nullptr && BN_copy(y.get(), y1.get()) != nullptr;
+    } else {
+      ok = BN_mod_mul(x.get(), tv1.get(), tv3.get(), p, ctx) == 1 && BN_mod_mul(y.get(), tv1.get(), u, p, ctx) == 1 &&
+           BN_mod_mul(y.get(), y.get(), y1.get(), p, ctx) == 1 && BN_mod_mul(y.get(), y.get(), suite.sqrt_neg_z.get(), p, ctx) == 1;
+    }
+    // sgn0(y) must match sgn0(u)
+    if (ok && BN_is_odd(u) != BN_is_odd(y.get()) && !BN_is_zero(y.get())) {
+      ok = BN_sub(y.get(), p, y.get()) == 1;
+    }
+    // Jacobian (x * tv4, y * tv4^3, tv4) is the affine (x / tv4, y)
+    ok = ok && BN_mod_mul(x.get(), x.get(), tv4.get(), p, ctx) == 1 && BN_mod_mul(y.get(), y.get(), tv6.get(), p, ctx) == 1;
+
+    OwnedPoint point(EC_POINT_new(suite.group.get()), EC_POINT_clear_free);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    // Deprecated in OpenSSL 3.0; the affine setter would cost an inversion
+    ok = ok && point && EC_POINT_set_Jprojective_coordinates_GFp(suite.group.get(), point.get(), x.get(), y.get(), tv4.get(), ctx) == 1;
+#pragma GCC diagnostic pop
+    if (!ok) {
+      throw std::runtime_error("OPRF: map_to_curve failed: " + getOpenSSLError());
+    }
+    return point;
+  }
+
+  // RFC 9380 hash_to_curve, random-oracle variant; every curve here has cofactor 1
+  OwnedPoint hashToCurve(const OprfSuite& suite, std::span<const uint8_t> msg, std::span<const uint8_t> dst, BN_CTX* ctx) {
+    auto u = hashToField(suite, msg, dst, suite.p.get(), 2, ctx);
+    OwnedPoint q0 = mapToCurve(suite, u[0].get(), ctx);
+    OwnedPoint q1 = mapToCurve(suite, u[1].get(), ctx);
+    if (EC_POINT_add(suite.group.get(), q0.get(), q0.get(), q1.get(), ctx) != 1) {
+      throw std::runtime_error("OPRF: hash_to_curve failed: " + getOpenSSLError());
+    }
+    return q0;
+  }
+
+  BignumPtr hashToScalar(const OprfSuite& suite, std::span<const uint8_t> msg, std::string_view dst, BN_CTX* ctx) {
+    auto scalars = hashToField(suite, msg, asBytes(dst), suite.order(), 1, ctx);
+    return std::move(scalars[0]);
+  }
+
+  OwnedPoint newPoint(const OprfSuite& suite) {
+    OwnedPoint point(EC_POINT_new(suite.group.get()), EC_POINT_clear_free);
+    if (!point) {
+      throw std::runtime_error("OPRF: Failed to allocate EC point");
+    }
+    return point;
+  }
+
+  // scalar * point, or scalar * G without a point, on the constant-time path
+  OwnedPoint multiply(const OprfSuite& suite, const BIGNUM* scalar, const EC_POINT* point, BN_CTX* ctx) {
+    OwnedPoint result = newPoint(suite);
+    int ok = point == nullptr ? EC_POINT_mul(suite.group.get(), result.get(), scalar, nullptr, nullptr, ctx)
+                              : EC_POINT_mul(suite.group.get(), result.get(), nullptr, point, scalar, ctx);
+    if (ok != 1) {
+      throw std::runtime_error("OPRF: scalar multiplication failed: " + getOpenSSLError());
+    }
+    return result;
+  }
+
+  // sum(scalars[i] * points[i]) in one pass with shared doublings. Variable
+  // time, so only used on public values (proof composites and checks)
+  OwnedPoint multiScalarMultiply(const OprfSuite& suite, const std::vector<const EC_POINT*>& points,
+                                 const std::vector<const BIGNUM*>& scalars, BN_CTX* ctx) {
+    OwnedPoint result = newPoint(suite);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    // Deprecated in OpenSSL 3.0 without a replacement for more than one point
+    int ok = EC_POINTs_mul(suite.group.get(), result.get(), nullptr, points.size(), const_cast<const EC_POINT**>(points.data()),
+                           const_cast<const BIGNUM**>(scalars.data()), ctx);
+#pragma GCC diagnostic pop
+    if (ok != 1) {
+      throw std::runtime_error("OPRF: multi-scalar multiplication failed: " + getOpenSSLError());
+    }
+    return result;
+  }
+
+  // SerializeElement: compressed SEC1; the identity has no encoding
+  Bytes encodeElement(const OprfSuite& suite, const EC_POINT* point, BN_CTX* ctx) {
+    if (EC_POINT_is_at_infinity(suite.group.get(), point)) {
+      throw std::runtime_error("OPRF: the identity element cannot be serialized");
+    }
+    Bytes out(suite.element_size);
+    if (EC_POINT_point2oct(suite.group.get(), point, POINT_CONVERSION_COMPRESSED, out.data(), out.size(), ctx) != out.size()) {
+      throw std::runtime_error("OPRF: Failed to encode element: " + getOpenSSLError());
+    }
+    return out;
+  }
+
+  // DeserializeElement: any valid SEC1 point except the identity
+  OwnedPoint decodeElement(const OprfSuite& suite, std::span<const uint8_t> bytes, const std::string& what, BN_CTX* ctx) {
+    OwnedPoint point = newPoint(suite);
+    if (bytes.empty() || EC_POINT_oct2point(suite.group.get(), point.get(), bytes.data(), bytes.size(), ctx) != 1 ||
+        EC_POINT_is_at_infinity(suite.group.get(), point.get())) {
+      clearOpenSSLErrors();
+      throw std::runtime_error("OPRF: invalid " + what);
+    }
+    return point;
+  }
+
+  BignumPtr decodeScalar(const OprfSuite& suite, std::span<const uint8_t> bytes, const std::string& what) {
+    BignumPtr scalar = newBignum();
+    if (bytes.size() != suite.scalar_size || BN_bin2bn(bytes.data(), static_cast<int>(bytes.size()), scalar.get()) == nullptr ||
+        BN_is_zero(scalar.get()) || BN_cmp(scalar.get(), suite.order()) >= 0) {
+      throw std::runtime_error("OPRF: invalid " + what + "; expected a nonzero " + std::to_string(suite.scalar_size) +
+                               "-byte scalar below the group order");
+    }
+    BN_set_flags(scalar.get(), BN_FLG_CONSTTIME);
+    return scalar;
+  }
+
+  Bytes encodeScalar(const OprfSuite& suite, const BIGNUM* scalar) {
+    Bytes out(suite.scalar_size);
+    if (BN_bn2binpad(scalar, out.data(), static_cast<int>(out.size())) < 0) {
+      throw std::runtime_error("OPRF: Failed to encode scalar");
+    }
+    return out;
+  }
+
+  BignumPtr randomScalar(const OprfSuite& suite, BN_CTX* ctx) {
+    BignumPtr scalar = newBignum();
+    do {
+      if (BN_priv_rand_range_ex(scalar.get(), suite.order(), 0, ctx) != 1) {
+        throw std::runtime_error("OPRF: Failed to generate scalar: " + getOpenSSLError());
+      }
+    } while (BN_is_zero(scalar.get()));
+    BN_set_flags(scalar.get(), BN_FLG_CONSTTIME);
+    return scalar;
+  }
+
+  std::shared_ptr<ArrayBuffer> toBuffer(const Bytes& bytes) {
+    return ArrayBuffer::copy(bytes);
+  }
+
+  std::vector<std::shared_ptr<ArrayBuffer>> copyAll(const std::vector<std::shared_ptr<ArrayBuffer>>& buffers) {
+    std::vector<std::shared_ptr<ArrayBuffer>> copies;
+    copies.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+      copies.push_back(ToNativeArrayBuffer(buffer));
+    }
+    return copies;
+  }
+
+  void checkBatch(size_t count, size_t other, const char* what) {
+    if (count != other) {
+      throw std::runtime_error(std::string("OPRF: expected one ") + what + " per input, got " + std::to_string(other) + " for " +
+                               std::to_string(count));
+    }
+    if (count > kMaxBatch) {
+      throw std::runtime_error("OPRF: batches are limited to 65535 elements");
+    }
+  }
+
+  std::vector<std::shared_ptr<ArrayBuffer>> blindAll(const OprfSuite& suite, const std::string& context,
+                                                     const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                     const std::vector<std::shared_ptr<ArrayBuffer>>& blinds) {
+    checkBatch(inputs.size(), blinds.size(), "blind");
+    auto ctx = newContext();
+    std::string dst = "HashToGroup-" + context;
+    std::vector<std::shared_ptr<ArrayBuffer>> blinded;
+    blinded.reserve(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+      BignumPtr blind = decodeScalar(suite, ToByteView(blinds[i]), "blind " + std::to_string(i));
+      OwnedPoint element = hashToCurve(suite, ToByteView(inputs[i]), asBytes(dst), ctx.get());
+      if (EC_POINT_is_at_infinity(suite.group.get(), element.get())) {
+        throw std::runtime_error("OPRF: input " + std::to_string(i) + " hashes to the identity element");
+      }
+      OwnedPoint result = multiply(suite, blind.get(), element.get(), ctx.get());
+      blinded.push_back(toBuffer(encodeElement(suite, result.get(), ctx.get())));
+    }
+    return blinded;
+  }
+
+  std::vector<std::shared_ptr<ArrayBuffer>> finalizeAll(const OprfSuite& suite, const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                        const std::vector<std::shared_ptr<ArrayBuffer>>& blinds,
+                                                        const std::vector<std::shared_ptr<ArrayBuffer>>& evaluated) {
+    checkBatch(inputs.size(), blinds.size(), "blind");
+    checkBatch(inputs.size(), evaluated.size(), "evaluated element");
+    size_t count = inputs.size();
+    if (count == 0) {
+      return {};
+    }
+    auto ctx = newContext();
+    const BIGNUM* order = suite.order();
+
+    // Montgomery's trick: prefix[i] = blind[0] * .. * blind[i], one inversion
+    // of the full product, then each inverse is peeled off walking back
+    std::vector<BignumPtr> scalars;
+    std::vector<BignumPtr> prefix;
+    for (size_t i = 0; i < count; i++) {
+      scalars.push_back(decodeScalar(suite, ToByteView(blinds[i]), "blind " + std::to_string(i)));
+      prefix.push_back(newBignum());
+      bool ok = i == 0 ? BN_copy(prefix[i].get(), scalars[i].get()) != nullptr
+                       : BN_mod_mul(prefix[i].get(), prefix[i - 1].get(), scalars[i].get(), order, ctx.get()) == 1;
+      if (!ok) {
+        throw std::runtime_error("OPRF: Failed to invert blinds");
+      }
+    }
+    BignumPtr inverse = newBignum();
+    BN_set_flags(prefix[count - 1].get(), BN_FLG_CONSTTIME);
+    if (BN_mod_exp_mont_consttime(inverse.get(), prefix[count - 1].get(), suite.order_inv_exp.get(), order, ctx.get(), nullptr) != 1) {
+      throw std::runtime_error("OPRF: Failed to invert blinds");
+    }
+    for (size_t i = count; i-- > 1;) {
+      // inverse = 1 / (blind[0] * .. * blind[i]); store 1 / blind[i] in scalars[i]
+      BignumPtr single = newBignum();
+      if (BN_mod_mul(single.get(), inverse.get(), prefix[i - 1].get(), order, ctx.get()) != 1 ||
+          BN_mod_mul(inverse.get(), inverse.get(), scalars[i].get(), order, ctx.get()) != 1) {
+        throw std::runtime_error("OPRF: Failed to invert blinds");
+      }
+      scalars[i] = std::move(single);
+    }
+    scalars[0] = std::move(inverse);
+
+    std::vector<std::shared_ptr<ArrayBuffer>> outputs;
+    outputs.reserve(count);
+    static constexpr std::string_view kFinalize = "Finalize";
+    for (size_t i = 0; i < count; i++) {
+      OwnedPoint element = decodeElement(suite, ToByteView(evaluated[i]), "evaluated element " + std::to_string(i), ctx.get());
+      OwnedPoint unblinded = multiply(suite, scalars[i].get(), element.get(), ctx.get());
+      Bytes transcript;
+      appendFramed(transcript, ToByteView(inputs[i]));
+      appendFramed(transcript, encodeElement(suite, unblinded.get(), ctx.get()));
+      appendRaw(transcript, asBytes(kFinalize));
+      outputs.push_back(toBuffer(digest(suite, {transcript})));
+    }
+    return outputs;
+  }
+
+  struct Composites {
+    OwnedPoint m;
+    OwnedPoint z;
+  };
+
+  // RFC 9497 section 2.2.1. The prover passes its key and gets Z = k * M
+  // (ComputeCompositesFast); the verifier sums the evaluated elements instead
+  Composites computeComposites(const OprfSuite& suite, const std::string& context, std::span<const uint8_t> public_key,
+                               const std::vector<OwnedPoint>& blinded, const std::vector<OwnedPoint>& evaluated, const BIGNUM* key,
+                               BN_CTX* ctx) {
+    std::string seed_dst = "Seed-" + context;
+    Bytes seed_transcript;
+    appendFramed(seed_transcript, public_key);
+    appendFramed(seed_transcript, asBytes(seed_dst));
+    Bytes seed = digest(suite, {seed_transcript});
+
+    std::string scalar_dst = "HashToScalar-" + context;
+    static constexpr std::string_view kComposite = "Composite";
+    std::vector<BignumPtr> weights;
+    for (size_t i = 0; i < blinded.size(); i++) {
+      Bytes transcript;
+      appendFramed(transcript, seed);
+      transcript.push_back(static_cast<uint8_t>(i >> 8));
+      transcript.push_back(static_cast<uint8_t>(i));
+      appendFramed(transcript, encodeElement(suite, blinded[i].get(), ctx));
+      appendFramed(transcript, encodeElement(suite, evaluated[i].get(), ctx));
+      appendRaw(transcript, asBytes(kComposite));
+      weights.push_back(hashToScalar(suite, transcript, scalar_dst, ctx));
+    }
+
+    std::vector<const BIGNUM*> scalars;
+    std::vector<const EC_POINT*> points;
+    for (size_t i = 0; i < blinded.size(); i++) {
+      scalars.push_back(weights[i].get());
+      points.push_back(blinded[i].get());
+    }
+    Composites composites{multiScalarMultiply(suite, points, scalars, ctx), OwnedPoint(nullptr, EC_POINT_clear_free)};
+    if (key != nullptr) {
+      composites.z = multiply(suite, key, composites.m.get(), ctx);
+    } else {
+      for (size_t i = 0; i < evaluated.size(); i++) {
+        points[i] = evaluated[i].get();
+      }
+      composites.z = multiScalarMultiply(suite, points, scalars, ctx);
+    }
+    return composites;
+  }
+
+  BignumPtr challenge(const OprfSuite& suite, const std::string& context, std::span<const uint8_t> public_key, const Composites& composites,
+                      const EC_POINT* t2, const EC_POINT* t3, BN_CTX* ctx) {
+    static constexpr std::string_view kChallenge = "Challenge";
+    Bytes transcript;
+    appendFramed(transcript, public_key);
+    appendFramed(transcript, encodeElement(suite, composites.m.get(), ctx));
+    appendFramed(transcript, encodeElement(suite, composites.z.get(), ctx));
+    appendFramed(transcript, encodeElement(suite, t2, ctx));
+    appendFramed(transcript, encodeElement(suite, t3, ctx));
+    appendRaw(transcript, asBytes(kChallenge));
+    return hashToScalar(suite, transcript, "HashToScalar-" + context, ctx);
+  }
+
+  std::vector<OwnedPoint> decodeElements(const OprfSuite& suite, const std::vector<std::shared_ptr<ArrayBuffer>>& buffers, const char* what,
+                                         BN_CTX* ctx) {
+    std::vector<OwnedPoint> elements;
+    elements.reserve(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++) {
+      elements.push_back(decodeElement(suite, ToByteView(buffers[i]), what + std::string(" ") + std::to_string(i), ctx));
+    }
+    return elements;
+  }
+
+  bool verifyAll(const OprfSuite& suite, const std::string& context, const std::shared_ptr<ArrayBuffer>& public_key,
+                 const std::vector<std::shared_ptr<ArrayBuffer>>& blinded, const std::vector<std::shared_ptr<ArrayBuffer>>& evaluated,
+                 const std::shared_ptr<ArrayBuffer>& proof) {
+    checkBatch(blinded.size(), evaluated.size(), "evaluated element");
+    if (blinded.empty()) {
+      throw std::runtime_error("OPRF: cannot verify a proof over an empty batch");
+    }
+    auto ctx = newContext();
+    OwnedPoint key = decodeElement(suite, ToByteView(public_key), "public key", ctx.get());
+    Bytes key_bytes = encodeElement(suite, key.get(), ctx.get());
+    auto blinded_elements = decodeElements(suite, blinded, "blinded element", ctx.get());
+    auto evaluated_elements = decodeElements(suite, evaluated, "evaluated element", ctx.get());
+
+    // proof = SerializeScalar(c) || SerializeScalar(s)
+    auto proof_bytes = ToByteView(proof);
+    if (proof_bytes.size() != 2 * suite.scalar_size) {
+      return false;
+    }
+    BignumPtr c = newBignum();
+    BignumPtr s = newBignum();
+    if (BN_bin2bn(proof_bytes.data(), static_cast<int>(suite.scalar_size), c.get()) == nullptr ||
+        BN_bin2bn(proof_bytes.data() + suite.scalar_size, static_cast<int>(suite.scalar_size), s.get()) == nullptr) {
+      throw std::runtime_error("OPRF: Failed to read proof");
+    }
+    if (BN_cmp(c.get(), suite.order()) >= 0 || BN_cmp(s.get(), suite.order()) >= 0) {
+      return false;
+    }
+
+    Composites composites = computeComposites(suite, context, key_bytes, blinded_elements, evaluated_elements, nullptr, ctx.get());
+    // t2 = s * G + c * pkS, t3 = s * M + c * Z
+    OwnedPoint t2 = newPoint(suite);
+    if (EC_POINT_mul(suite.group.get(), t2.get(), s.get(), key.get(), c.get(), ctx.get()) != 1) {
+      throw std::runtime_error("OPRF: proof verification failed: " + getOpenSSLError());
+    }
+    OwnedPoint t3 = multiScalarMultiply(suite, {composites.m.get(), composites.z.get()}, {s.get(), c.get()}, ctx.get());
+    if (EC_POINT_is_at_infinity(suite.group.get(), t2.get()) || EC_POINT_is_at_infinity(suite.group.get(), t3.get())) {
+      return false;
+    }
+    BignumPtr expected = challenge(suite, context, key_bytes, composites, t2.get(), t3.get(), ctx.get());
+    return BN_cmp(expected.get(), c.get()) == 0;
+  }
+
+} // namespace
+
+void HybridOprf::init(const std::string& suite, bool verifiable) {
+  auto named = namedSuite(suite);
+  if (!named) {
+    throw std::runtime_error("Unsupported OPRF suite: " + suite + "; expected P256-SHA256, P384-SHA384 or P521-SHA512");
+  }
+  suite_ = std::move(named);
+  verifiable_ = verifiable;
+  // RFC 9497 section 3.1: modeOPRF = 0x00, modeVOPRF = 0x01
+  context_ = std::string("OPRFV1-") + (verifiable ? '\x01' : '\x00') + "-" + suite_->identifier;
+}
+
+const OprfSuite& HybridOprf::checkSuite() const {
+  if (!suite_) {
+    throw std::runtime_error("OPRF not initialized. Call init() first.");
+  }
+  return *suite_;
+}
+
+void HybridOprf::checkVerifiable() const {
+  checkSuite();
+  if (!verifiable_) {
+    throw std::runtime_error("OPRF: proofs are only used in the VOPRF mode");
+  }
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridOprf::randomScalars(double count) {
+  const OprfSuite& suite = checkSuite();
+  if (!CheckIsUint32(count) || count != std::floor(count) || count > kMaxBatch) {
+    throw std::runtime_error("OPRF: invalid scalar count");
+  }
+  auto ctx = newContext();
+  std::vector<std::shared_ptr<ArrayBuffer>> scalars;
+  for (size_t i = 0; i < static_cast<size_t>(count); i++) {
+    BignumPtr scalar = randomScalar(suite, ctx.get());
+    scalars.push_back(toBuffer(encodeScalar(suite, scalar.get())));
+  }
+  return scalars;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridOprf::deriveKeyPair(const std::shared_ptr<ArrayBuffer>& seed,
+                                                                    const std::shared_ptr<ArrayBuffer>& info) {
+  const OprfSuite& suite = checkSuite();
+  auto ctx = newContext();
+  // RFC 9497 section 3.2.1
+  Bytes derive_input;
+  appendRaw(derive_input, ToByteView(seed));
+  appendFramed(derive_input, ToByteView(info));
+  derive_input.push_back(0);
+  std::string dst = "DeriveKeyPair" + context_;
+  BignumPtr key(nullptr, BN_clear_free);
+  for (int counter = 0; !key || BN_is_zero(key.get()); counter++) {
+    if (counter > 255) {
+      OPENSSL_cleanse(derive_input.data(), derive_input.size());
+      throw std::runtime_error("OPRF: DeriveKeyPair found no valid key");
+    }
+    derive_input.back() = static_cast<uint8_t>(counter);
+    key = hashToScalar(suite, derive_input, dst, ctx.get());
+  }
+  OPENSSL_cleanse(derive_input.data(), derive_input.size());
+  BN_set_flags(key.get(), BN_FLG_CONSTTIME);
+  OwnedPoint public_key = multiply(suite, key.get(), nullptr, ctx.get());
+  return {toBuffer(encodeScalar(suite, key.get())), toBuffer(encodeElement(suite, public_key.get(), ctx.get()))};
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridOprf::hashToGroup(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                                  const std::optional<std::shared_ptr<ArrayBuffer>>& dst) {
+  const OprfSuite& suite = checkSuite();
+  auto ctx = newContext();
+  std::string default_dst = "HashToGroup-" + context_;
+  std::span<const uint8_t> tag = dst.has_value() ? ToByteView(*dst) : asBytes(default_dst);
+  std::vector<std::shared_ptr<ArrayBuffer>> elements;
+  elements.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    OwnedPoint element = hashToCurve(suite, ToByteView(input), tag, ctx.get());
+    elements.push_back(toBuffer(encodeElement(suite, element.get(), ctx.get())));
+  }
+  return elements;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridOprf::blind(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                            const std::vector<std::shared_ptr<ArrayBuffer>>& blinds) {
+  return blindAll(checkSuite(), context_, inputs, blinds);
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridOprf::blindAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds) {
+  checkSuite();
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async(
+      [suite = suite_, context = context_, inputs = copyAll(inputs), blinds = copyAll(blinds), queued = QueueWait::stamp("oprfBlind")]() {
+        queued.started();
+        return blindAll(*suite, context, inputs, blinds);
+      });
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridOprf::finalize(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                               const std::vector<std::shared_ptr<ArrayBuffer>>& blinds,
+                                                               const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements) {
+  return finalizeAll(checkSuite(), inputs, blinds, evaluatedElements);
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridOprf::finalizeAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds,
+                          const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements) {
+  checkSuite();
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async([suite = suite_, inputs = copyAll(inputs), blinds = copyAll(blinds),
+                                                                     evaluated = copyAll(evaluatedElements),
+                                                                     queued = QueueWait::stamp("oprfFinalize")]() {
+    queued.started();
+    return finalizeAll(*suite, inputs, blinds, evaluated);
+  });
+}
+
+bool HybridOprf::verifyProof(const std::shared_ptr<ArrayBuffer>& publicKey,
+                             const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements,
+                             const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements,
+                             const std::shared_ptr<ArrayBuffer>& proof) {
+  checkVerifiable();
+  return verifyAll(*suite_, context_, publicKey, blindedElements, evaluatedElements, proof);
+}
+
+std::shared_ptr<Promise<bool>> HybridOprf::verifyProofAsync(const std::shared_ptr<ArrayBuffer>& publicKey,
+                                                            const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements,
+                                                            const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements,
+                                                            const std::shared_ptr<ArrayBuffer>& proof) {
+  checkVerifiable();
+  return Promise<bool>::async([suite = suite_, context = context_, publicKey = ToNativeArrayBuffer(publicKey),
+                               blinded = copyAll(blindedElements), evaluated = copyAll(evaluatedElements),
+                               proof = ToNativeArrayBuffer(proof), queued = QueueWait::stamp("oprfVerifyProof")]() {
+    queued.started();
+    return verifyAll(*suite, context, publicKey, blinded, evaluated, proof);
+  });
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridOprf::blindEvaluate(const std::shared_ptr<ArrayBuffer>& privateKey,
+                                                                    const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements) {
+  const OprfSuite& suite = checkSuite();
+  BignumPtr key = decodeScalar(suite, ToByteView(privateKey), "private key");
+  auto ctx = newContext();
+  std::vector<std::shared_ptr<ArrayBuffer>> evaluated;
+  evaluated.reserve(blindedElements.size());
+  for (size_t i = 0; i < blindedElements.size(); i++) {
+    OwnedPoint element = decodeElement(suite, ToByteView(blindedElements[i]), "blinded element " + std::to_string(i), ctx.get());
+    OwnedPoint result = multiply(suite, key.get(), element.get(), ctx.get());
+    evaluated.push_back(toBuffer(encodeElement(suite, result.get(), ctx.get())));
+  }
+  return evaluated;
+}
+
+std::shared_ptr<ArrayBuffer> HybridOprf::generateProof(const std::shared_ptr<ArrayBuffer>& privateKey,
+                                                       const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements,
+                                                       const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements,
+                                                       const std::optional<std::shared_ptr<ArrayBuffer>>& proofScalar) {
+  checkVerifiable();
+  const OprfSuite& suite = *suite_;
+  checkBatch(blindedElements.size(), evaluatedElements.size(), "evaluated element");
+  if (blindedElements.empty()) {
+    throw std::runtime_error("OPRF: cannot prove an empty batch");
+  }
+  auto ctx = newContext();
+  BignumPtr key = decodeScalar(suite, ToByteView(privateKey), "private key");
+  OwnedPoint public_key = multiply(suite, key.get(), nullptr, ctx.get());
+  Bytes key_bytes = encodeElement(suite, public_key.get(), ctx.get());
+  auto blinded = decodeElements(suite, blindedElements, "blinded element", ctx.get());
+  auto evaluated = decodeElements(suite, evaluatedElements, "evaluated element", ctx.get());
+
+  // RFC 9497 section 2.2.1 GenerateProof
+  BignumPtr r = proofScalar.has_value() ? decodeScalar(suite, ToByteView(*proofScalar), "proof scalar") : randomScalar(suite, ctx.get());
+  Composites composites = computeComposites(suite, context_, key_bytes, blinded, evaluated, key.get(), ctx.get());
+  OwnedPoint t2 = multiply(suite, r.get(), nullptr, ctx.get());
+  OwnedPoint t3 = multiply(suite, r.get(), composites.m.get(), ctx.get());
+  BignumPtr c = challenge(suite, context_, key_bytes, composites, t2.get(), t3.get(), ctx.get());
+  BignumPtr s = newBignum();
+  if (BN_mod_mul(s.get(), c.get(), key.get(), suite.order(), ctx.get()) != 1 ||
+      BN_mod_sub(s.get(), r.get(), s.get(), suite.order(), ctx.get()) != 1) {
+    throw std::runtime_error("OPRF: Failed to generate proof: " + getOpenSSLError());
+  }
+  Bytes proof = encodeScalar(suite, c.get());
+  appendRaw(proof, encodeScalar(suite, s.get()));
+  return toBuffer(proof);
+}
+
+} // namespace margelo::nitro::crypto
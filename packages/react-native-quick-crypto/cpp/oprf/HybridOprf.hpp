@@ -0,0 +1,78 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "HybridOprfSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+using namespace facebook;
+
+// Group, digest and hash-to-curve constants of one ciphersuite; defined in
+// HybridOprf.cpp and built once per process
+struct OprfSuite;
+
+/**
+ * Oblivious pseudorandom functions (RFC 9497) in the OPRF and VOPRF modes,
+ * for the P256-SHA256, P384-SHA384 and P521-SHA512 ciphersuites. HashToGroup
+ * is the RFC 9380 simplified SWU encoding of those suites.
+ *
+ * Every operation takes a whole batch and runs it on one BN_CTX against the
+ * suite's shared group. Finalize inverts all blinds with a single modular
+ * exponentiation. VOPRF proofs are the batched DLEQ proofs of RFC 9497: one
+ * proof covers the batch, and its composite elements are multi-scalar
+ * multiplications over every blinded and evaluated element.
+ *
+ * ristretto255 is not offered because OpenSSL has no ristretto255 group.
+ */
+class HybridOprf : public HybridOprfSpec {
+ public:
+  HybridOprf() : HybridObject(TAG) {}
+
+ public:
+  // Methods
+  void init(const std::string& suite, bool verifiable) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> randomScalars(double count) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> deriveKeyPair(const std::shared_ptr<ArrayBuffer>& seed,
+                                                          const std::shared_ptr<ArrayBuffer>& info) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> hashToGroup(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                        const std::optional<std::shared_ptr<ArrayBuffer>>& dst) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> blind(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                  const std::vector<std::shared_ptr<ArrayBuffer>>& blinds) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  blindAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> finalize(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs,
+                                                     const std::vector<std::shared_ptr<ArrayBuffer>>& blinds,
+                                                     const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  finalizeAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds,
+                const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements) override;
+  bool verifyProof(const std::shared_ptr<ArrayBuffer>& publicKey, const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements,
+                   const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements, const std::shared_ptr<ArrayBuffer>& proof) override;
+  std::shared_ptr<Promise<bool>> verifyProofAsync(const std::shared_ptr<ArrayBuffer>& publicKey,
+                                                  const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements,
+                                                  const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements,
+                                                  const std::shared_ptr<ArrayBuffer>& proof) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> blindEvaluate(const std::shared_ptr<ArrayBuffer>& privateKey,
+                                                          const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements) override;
+  std::shared_ptr<ArrayBuffer> generateProof(const std::shared_ptr<ArrayBuffer>& privateKey,
+                                             const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements,
+                                             const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements,
+                                             const std::optional<std::shared_ptr<ArrayBuffer>>& proofScalar) override;
+
+ private:
+  const OprfSuite& checkSuite() const;
+  void checkVerifiable() const;
+
+  std::shared_ptr<const OprfSuite> suite_;
+  bool verifiable_ = false;
+  // "OPRFV1-" || mode || "-" || suite, the domain separator of every hash
+  std::string context_;
+};
+
+} // namespace margelo::nitro::crypto
@@ -1,5 +1,8 @@
 #include "HybridPbkdf2.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
 #include "Utils.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -10,9 +13,12 @@ std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridPbkdf2::pbkdf2(cons
   auto nativePassword = ToNativeArrayBuffer(password);
   auto nativeSalt = ToNativeArrayBuffer(salt);
 
-  return Promise<std::shared_ptr<ArrayBuffer>>::async([this, nativePassword, nativeSalt, iterations, keylen, digest]() {
-    return this->pbkdf2Sync(nativePassword, nativeSalt, iterations, keylen, digest);
-  });
+  return Promise<std::shared_ptr<ArrayBuffer>>::async(
+      [self = strongRef(this), nativePassword, nativeSalt, iterations, keylen, digest, queued = QueueWait::stamp("pbkdf2")]() {
+        queued.started();
+        WorkloadRecorder::AsyncJob asyncJob;
+        return self->pbkdf2Sync(nativePassword, nativeSalt, iterations, keylen, digest);
+      });
 }
 
 std::shared_ptr<ArrayBuffer> HybridPbkdf2::pbkdf2Sync(const std::shared_ptr<ArrayBuffer>& password,
@@ -23,6 +29,7 @@ std::shared_ptr<ArrayBuffer> HybridPbkdf2::pbkdf2Sync(const std::shared_ptr<Arra
   auto result = std::make_shared<NativeArrayBuffer>(data, bufferSize, [=]() { delete[] data; });
 
   // use fastpbkdf2 when possible
+  useFastPbkdf2Kernels();
   if (digest == "sha1") {
     fastpbkdf2_hmac_sha1(password.get()->data(), password.get()->size(), salt.get()->data(), salt.get()->size(),
                          static_cast<uint32_t>(iterations), result.get()->data(), result.get()->size());
@@ -45,6 +52,7 @@ std::shared_ptr<ArrayBuffer> HybridPbkdf2::pbkdf2Sync(const std::shared_ptr<Arra
                       result.get()->size(), resultAsCharA);
   }
 
+  WorkloadRecorder::record(WorkloadRecorder::Op::Pbkdf2, digest, bufferSize, static_cast<uint64_t>(iterations));
   return result;
 }
 
@@ -1,6 +1,7 @@
 #include <openssl/evp.h>
 
 #include "HybridPbkdf2Spec.hpp"
+#include "Pbkdf2Kernels.hpp"
 #include "fastpbkdf2.h"
 
 namespace margelo::nitro::crypto {
@@ -0,0 +1,27 @@
+#include "Pbkdf2Kernels.hpp"
+
+#include "CpuCapabilities.hpp"
+#include "fastpbkdf2.h"
+
+namespace margelo::nitro::crypto {
+
+void useFastPbkdf2Kernels() {
+  static const bool enabled = [] {
+    const auto& caps = cpuCapabilities();
+    unsigned features = 0;
+    if (caps.sha1) {
+      features |= FASTPBKDF2_HW_SHA1;
+    }
+    if (caps.sha2) {
+      features |= FASTPBKDF2_HW_SHA256;
+    }
+    if (caps.sha512) {
+      features |= FASTPBKDF2_HW_SHA512;
+    }
+    fastpbkdf2_hw_enable(features);
+    return true;
+  }();
+  (void)enabled;
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace margelo::nitro::crypto {
+
+// Enables fastpbkdf2's hardware SHA kernels (deps/fastpbkdf2/fastpbkdf2_hw.c)
+// for the features this CPU reports. Call before any fastpbkdf2_hmac_*; only
+// the first call does any work.
+void useFastPbkdf2Kernels();
+
+} // namespace margelo::nitro::crypto
@@ -2,7 +2,10 @@
 #include <openssl/rand.h>
 
 #include "HybridRandom.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
 #include "Utils.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -16,12 +19,14 @@ size_t checkSize(double size) {
   return static_cast<size_t>(size);
 }
 
-size_t checkOffset(double size, double offset) {
+// offset and size are relative to the whole ArrayBuffer, which may be the
+// backing store of a smaller view
+size_t checkOffset(size_t bufferSize, double offset, size_t size) {
   if (!CheckIsUint32(offset)) {
     throw std::runtime_error("offset must be uint32");
   }
-  if (offset > size) {
-    throw std::runtime_error("offset must be less than size");
+  if (offset > bufferSize || size > bufferSize - static_cast<size_t>(offset)) {
+    throw std::runtime_error("offset + size must be within the buffer");
   }
   return static_cast<size_t>(offset);
 }
@@ -32,16 +37,21 @@ std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridRandom::randomFill(
   auto nativeBuffer = ToNativeArrayBuffer(buffer);
 
   return Promise<std::shared_ptr<ArrayBuffer>>::async(
-      [this, nativeBuffer, dOffset, dSize]() { return this->randomFillSync(nativeBuffer, dOffset, dSize); });
+      [self = strongRef(this), nativeBuffer, dOffset, dSize, queued = QueueWait::stamp("randomFill")]() {
+        queued.started();
+        WorkloadRecorder::AsyncJob asyncJob;
+        return self->randomFillSync(nativeBuffer, dOffset, dSize);
+      });
 };
 
 std::shared_ptr<ArrayBuffer> HybridRandom::randomFillSync(const std::shared_ptr<ArrayBuffer>& buffer, double dOffset, double dSize) {
   size_t size = checkSize(dSize);
-  size_t offset = checkOffset(dSize, dOffset);
+  size_t offset = checkOffset(buffer->size(), dOffset, size);
   uint8_t* data = buffer.get()->data();
   if (RAND_bytes(data + offset, (int)size) != 1) {
     throw std::runtime_error("error calling RAND_bytes: " + std::to_string(ERR_get_error()));
   }
+  WorkloadRecorder::record(WorkloadRecorder::Op::RandomFill, "", size);
   return buffer;
 };
 
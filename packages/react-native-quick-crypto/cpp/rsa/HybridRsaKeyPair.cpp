@@ -1,6 +1,9 @@
 #include <NitroModules/ArrayBuffer.hpp>
 #include <NitroModules/Promise.hpp>
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <openssl/bio.h>
 #include <openssl/buffer.h>
 #include <openssl/err.h>
@@ -9,14 +12,26 @@
 #include <openssl/rsa.h>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "HybridRsaKeyPair.hpp"
 #include "Utils.hpp"
 
 namespace margelo::nitro::crypto {
 
+namespace {
+
+  // Keygen progress callback: returning 0 makes OpenSSL abandon the search
+  int keygenProgress(EVP_PKEY_CTX* ctx) {
+    auto* done = static_cast<std::atomic<bool>*>(EVP_PKEY_CTX_get_app_data(ctx));
+    return done->load(std::memory_order_relaxed) ? 0 : 1;
+  }
+
+} // namespace
+
 std::shared_ptr<Promise<void>> HybridRsaKeyPair::generateKeyPair() {
-  return Promise<void>::async([this]() { this->generateKeyPairSync(); });
+  return executor.async<void>([self = strongRef(this)]() { self->generateKeyPairSync(); });
 }
 
 void HybridRsaKeyPair::generateKeyPairSync() {
@@ -26,6 +41,65 @@ void HybridRsaKeyPair::generateKeyPairSync() {
     this->pkey = nullptr;
   }
 
+  int workers = keygenWorkers();
+  if (workers == 1) {
+    auto ctx = keygenContext();
+    EVP_PKEY* raw_pkey = nullptr;
+    if (EVP_PKEY_keygen(ctx.get(), &raw_pkey) <= 0) {
+      throw std::runtime_error("Failed to generate RSA key pair");
+    }
+    this->pkey = raw_pkey;
+    return;
+  }
+
+  // Opt-in: most of keygen is the search for primes, and how many candidates
+  // that takes varies a lot. Run independent generations side by side and
+  // keep the first key; the others stop at their next progress callback.
+  // Every worker is OpenSSL's unchanged generator, so the kept key passes the
+  // same checks, but which one is kept depends on timing. Contexts are set up
+  // here so bad parameters throw.
+  std::vector<std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)>> contexts;
+  for (int i = 0; i < workers; i++) {
+    contexts.push_back(keygenContext());
+  }
+
+  std::atomic<bool> done{false};
+  std::mutex mutex;
+  EVP_PKEY* winner = nullptr;
+  auto search = [&](EVP_PKEY_CTX* ctx) {
+    EVP_PKEY_CTX_set_app_data(ctx, &done);
+    EVP_PKEY_CTX_set_cb(ctx, keygenProgress);
+    EVP_PKEY* candidate = nullptr;
+    if (EVP_PKEY_keygen(ctx, &candidate) <= 0 || candidate == nullptr) {
+      return;
+    }
+    std::unique_lock lock(mutex);
+    if (winner == nullptr) {
+      winner = candidate;
+      done.store(true, std::memory_order_relaxed);
+    } else {
+      EVP_PKEY_free(candidate);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < workers; i++) {
+    threads.emplace_back(search, contexts[i].get());
+  }
+  search(contexts[0].get());
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // Cancelled searches leave their errors behind
+  ERR_clear_error();
+
+  if (winner == nullptr) {
+    throw std::runtime_error("Failed to generate RSA key pair");
+  }
+  this->pkey = winner;
+}
+
+std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> HybridRsaKeyPair::keygenContext() {
   // Create key generation context
   std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr), EVP_PKEY_CTX_free);
 
@@ -63,13 +137,24 @@ void HybridRsaKeyPair::generateKeyPairSync() {
     throw std::runtime_error("Failed to set RSA public exponent");
   }
 
-  // Generate the key pair
-  EVP_PKEY* raw_pkey = nullptr;
-  if (EVP_PKEY_keygen(ctx.get(), &raw_pkey) <= 0) {
-    throw std::runtime_error("Failed to generate RSA key pair");
+  if (this->primes != 2) {
+    // OpenSSL's limit: smaller moduli get too weak with more factors
+    int maxPrimes = this->modulusLength < 1024 ? 2 : this->modulusLength < 4096 ? 3 : this->modulusLength < 8192 ? 4 : 5;
+    if (this->primes > maxPrimes) {
+      throw std::runtime_error("A " + std::to_string(this->modulusLength) + "-bit RSA key supports at most " + std::to_string(maxPrimes) +
+                               " primes");
+    }
+    if (EVP_PKEY_CTX_set_rsa_keygen_primes(ctx.get(), this->primes) <= 0) {
+      throw std::runtime_error("Failed to set RSA prime count");
+    }
   }
 
-  this->pkey = raw_pkey;
+  return ctx;
+}
+
+int HybridRsaKeyPair::keygenWorkers() const {
+  // More searches than cores only slow each other down
+  return std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, this->parallelism);
 }
 
 void HybridRsaKeyPair::setModulusLength(double modulusLength) {
@@ -87,6 +172,20 @@ void HybridRsaKeyPair::setHashAlgorithm(const std::string& hashAlgorithm) {
   this->hashAlgorithm = hashAlgorithm;
 }
 
+void HybridRsaKeyPair::setPrimes(double primes) {
+  if (primes < 2 || primes > 5 || primes != static_cast<int>(primes)) {
+    throw std::runtime_error("RSA prime count must be an integer from 2 to 5");
+  }
+  this->primes = static_cast<int>(primes);
+}
+
+void HybridRsaKeyPair::setParallelism(double parallelism) {
+  if (parallelism < 1 || parallelism > 64 || parallelism != static_cast<int>(parallelism)) {
+    throw std::runtime_error("RSA keygen parallelism must be an integer from 1 to 64");
+  }
+  this->parallelism = static_cast<int>(parallelism);
+}
+
 std::shared_ptr<ArrayBuffer> HybridRsaKeyPair::getPublicKey() {
   this->checkKeyPair();
 
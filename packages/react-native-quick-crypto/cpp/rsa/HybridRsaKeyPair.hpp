@@ -1,6 +1,7 @@
 #pragma once
 
 #include "HybridRsaKeyPairSpec.hpp"
+#include "SerialExecutor.hpp"
 #include <NitroModules/ArrayBuffer.hpp>
 #include <NitroModules/Promise.hpp>
 #include <memory>
@@ -25,6 +26,8 @@ class HybridRsaKeyPair : public HybridRsaKeyPairSpec {
   void setModulusLength(double modulusLength) override;
   void setPublicExponent(const std::shared_ptr<ArrayBuffer>& publicExponent) override;
   void setHashAlgorithm(const std::string& hashAlgorithm) override;
+  void setPrimes(double primes) override;
+  void setParallelism(double parallelism) override;
   std::shared_ptr<ArrayBuffer> getPublicKey() override;
   std::shared_ptr<ArrayBuffer> getPrivateKey() override;
   KeyObject importKey(const std::string& format, const std::shared_ptr<ArrayBuffer>& keyData, const std::string& algorithm,
@@ -36,8 +39,14 @@ class HybridRsaKeyPair : public HybridRsaKeyPairSpec {
   int modulusLength;
   std::vector<unsigned char> publicExponent;
   std::string hashAlgorithm;
+  int primes = 2;
+  int parallelism = 1; // concurrent key searches, opt-in
+  // async jobs run one at a time, in call order
+  SerialExecutor executor;
 
   void checkKeyPair();
+  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> keygenContext();
+  int keygenWorkers() const;
 };
 
 } // namespace margelo::nitro::crypto
@@ -6,7 +6,10 @@
 #include <vector>
 
 #include "HybridScrypt.hpp"
+#include "QueueWait.hpp"
+#include "SerialExecutor.hpp"
 #include "Utils.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -17,9 +20,12 @@ std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridScrypt::deriveKey(c
   auto nativePassword = ToNativeArrayBuffer(password);
   auto nativeSalt = ToNativeArrayBuffer(salt);
 
-  return Promise<std::shared_ptr<ArrayBuffer>>::async([this, nativePassword, nativeSalt, N, r, p, maxmem, keylen]() {
-    return this->deriveKeySync(nativePassword, nativeSalt, N, r, p, maxmem, keylen);
-  });
+  return Promise<std::shared_ptr<ArrayBuffer>>::async(
+      [self = strongRef(this), nativePassword, nativeSalt, N, r, p, maxmem, keylen, queued = QueueWait::stamp("scrypt")]() {
+        queued.started();
+        WorkloadRecorder::AsyncJob asyncJob;
+        return self->deriveKeySync(nativePassword, nativeSalt, N, r, p, maxmem, keylen);
+      });
 }
 
 std::shared_ptr<ArrayBuffer> HybridScrypt::deriveKeySync(const std::shared_ptr<ArrayBuffer>& password,
@@ -56,6 +62,7 @@ std::shared_ptr<ArrayBuffer> HybridScrypt::deriveKeySync(const std::shared_ptr<A
     throw std::runtime_error("SCRYPT derivation failed: " + getOpenSSLError());
   }
 
+  WorkloadRecorder::record(WorkloadRecorder::Op::Scrypt, "", outLen, n_val, r_val, p_val);
   return std::make_shared<NativeArrayBuffer>(outBuf, outLen, [=]() { delete[] outBuf; });
 }
 
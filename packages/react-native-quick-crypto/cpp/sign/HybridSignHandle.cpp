@@ -53,20 +53,20 @@ void HybridSignHandle::init(const std::string& algorithm) {
   }
 }
 
-void HybridSignHandle::update(const std::shared_ptr<ArrayBuffer>& data) {
+void HybridSignHandle::update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+                              const std::optional<double>& byteLength) {
   if (!md_ctx) {
     throw std::runtime_error("Sign not initialized");
   }
 
-  auto native_data = ToNativeArrayBuffer(data);
+  auto view = ToByteView(data, byteOffset, byteLength);
 
   // Accumulate raw data for potential one-shot signing (Ed25519/Ed448/ML-DSA)
-  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(native_data->data());
-  data_buffer.insert(data_buffer.end(), ptr, ptr + native_data->size());
+  data_buffer.insert(data_buffer.end(), view.begin(), view.end());
 
   // Only update digest if we have one (not needed for pure signature schemes)
   if (md != nullptr) {
-    if (EVP_DigestUpdate(md_ctx, native_data->data(), native_data->size()) <= 0) {
+    if (EVP_DigestUpdate(md_ctx, view.data(), view.size()) <= 0) {
       unsigned long err = ERR_get_error();
       char err_buf[256];
       ERR_error_string_n(err, err_buf, sizeof(err_buf));
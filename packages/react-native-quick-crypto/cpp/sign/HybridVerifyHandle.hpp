@@ -21,7 +21,8 @@ class HybridVerifyHandle : public HybridVerifyHandleSpec {
 
  public:
   void init(const std::string& algorithm) override;
-  void update(const std::shared_ptr<ArrayBuffer>& data) override;
+  void update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset,
+              const std::optional<double>& byteLength) override;
   bool verify(const std::shared_ptr<HybridKeyObjectHandleSpec>& keyHandle, const std::shared_ptr<ArrayBuffer>& signature,
               std::optional<double> padding, std::optional<double> saltLength, std::optional<double> dsaEncoding) override;
 
@@ -0,0 +1,115 @@
+#include "CpuCapabilities.hpp"
+
+#include <cstdint>
+#include <openssl/crypto.h>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+#include <sys/auxv.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+#if defined(__APPLE__)
+  // Missing keys (older OS releases) fall back to `fallback`
+  bool sysctlFlag(const char* name, bool fallback) {
+    int value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, nullptr, 0) != 0) {
+      return fallback;
+    }
+    return value != 0;
+  }
+#endif
+
+  CpuCapabilities detect() {
+    CpuCapabilities caps;
+#if defined(__APPLE__) && defined(__aarch64__)
+    // Every Apple arm64 core (A7 onwards) has the ARMv8 crypto extensions
+    caps.neon = true;
+    caps.aes = sysctlFlag("hw.optional.arm.FEAT_AES", true);
+    caps.pmull = sysctlFlag("hw.optional.arm.FEAT_PMULL", true);
+    caps.sha1 = sysctlFlag("hw.optional.arm.FEAT_SHA1", true);
+    caps.sha2 = sysctlFlag("hw.optional.arm.FEAT_SHA256", true);
+    caps.sha512 = sysctlFlag("hw.optional.arm.FEAT_SHA512", false);
+    caps.sha3 = sysctlFlag("hw.optional.arm.FEAT_SHA3", false);
+#elif defined(__linux__) && defined(__aarch64__)
+    // Bits from <asm/hwcap.h>, spelled out for older NDK headers
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    caps.neon = hwcap & (1UL << 1);
+    caps.aes = hwcap & (1UL << 3);
+    caps.pmull = hwcap & (1UL << 4);
+    caps.sha1 = hwcap & (1UL << 5);
+    caps.sha2 = hwcap & (1UL << 6);
+    caps.sha3 = hwcap & (1UL << 17);
+    caps.sha512 = hwcap & (1UL << 21);
+#elif defined(__linux__) && defined(__arm__)
+    // ARMv7 userspace on an ARMv8 core reports crypto in AT_HWCAP2
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    caps.neon = hwcap & (1UL << 12);
+    caps.aes = hwcap2 & (1UL << 0);
+    caps.pmull = hwcap2 & (1UL << 1);
+    caps.sha1 = hwcap2 & (1UL << 2);
+    caps.sha2 = hwcap2 & (1UL << 3);
+#elif defined(__x86_64__) || defined(__i386__)
+    // x86 covers simulators, emulators and the host build
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      caps.aes = ecx & (1U << 25);
+      caps.pmull = ecx & (1U << 1);
+    }
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+      caps.avx2 = ebx & (1U << 5);
+      caps.sha1 = caps.sha2 = ebx & (1U << 29);
+    }
+#endif
+    return caps;
+  }
+
+} // namespace
+
+std::unordered_map<std::string, bool> CpuCapabilities::toMap() const {
+  return {
+      {"aes", aes}, {"pmull", pmull}, {"sha1", sha1}, {"sha2", sha2},
+      {"sha512", sha512}, {"sha3", sha3}, {"neon", neon}, {"avx2", avx2},
+  };
+}
+
+const CpuCapabilities& cpuCapabilities() {
+  static const CpuCapabilities caps = detect();
+  return caps;
+}
+
+std::unordered_map<std::string, std::string> cryptoImplementations() {
+  const auto& caps = cpuCapabilities();
+#if defined(__x86_64__) || defined(__i386__)
+  constexpr bool simd = true; // SSSE3 paths (vpaes, ChaCha20) on any 64-bit-era x86
+#else
+  const bool simd = caps.neon;
+#endif
+
+  // Mirrors OpenSSL's own dispatch on the capability mask it reports in
+  // OPENSSL_CPU_INFO; OPENSSL_armcap / OPENSSL_ia32cap can mask features off
+  std::unordered_map<std::string, std::string> impls = {
+      {"openssl", OpenSSL_version(OPENSSL_VERSION)},
+      {"cpuinfo", OpenSSL_version(OPENSSL_CPU_INFO)},
+      {"aes", caps.aes ? "hardware" : simd ? "vector-permute (constant-time SIMD)" : "portable C"},
+      {"ghash", caps.pmull ? "hardware" : simd ? "SIMD" : "portable C"},
+      {"chacha20", caps.avx2 ? "AVX2" : simd ? "SIMD" : "portable C"},
+      {"sha1", caps.sha1 ? "hardware" : "software"},
+      {"sha256", caps.sha2 ? "hardware" : "software"},
+      {"sha512", caps.sha512 ? "hardware" : "software"},
+      {"sha3", caps.sha3 ? "hardware" : "software"},
+  };
+  return impls;
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::crypto {
+
+// Crypto-relevant CPU features, as reported by the OS (getauxval on
+// Linux/Android, sysctl on Apple, cpuid on x86). Detected once, cached.
+struct CpuCapabilities {
+  bool aes = false;    // ARMv8 AES / x86 AES-NI
+  bool pmull = false;  // ARMv8 PMULL / x86 PCLMULQDQ, used by GHASH (GCM)
+  bool sha1 = false;   // ARMv8 SHA1 / x86 SHA-NI
+  bool sha2 = false;   // ARMv8 SHA256 / x86 SHA-NI
+  bool sha512 = false; // ARMv8.2 SHA512
+  bool sha3 = false;   // ARMv8.2 SHA3
+  bool neon = false;   // ARM Advanced SIMD
+  bool avx2 = false;   // x86 AVX2
+
+  std::unordered_map<std::string, bool> toMap() const;
+};
+
+const CpuCapabilities& cpuCapabilities();
+
+// OpenSSL's own view: version, the capability mask it selected
+// (OPENSSL_CPU_INFO), and the implementation each hot primitive ends up on.
+std::unordered_map<std::string, std::string> cryptoImplementations();
+
+} // namespace margelo::nitro::crypto
@@ -1,7 +1,15 @@
 #include "HybridUtils.hpp"
 
+#include <chrono>
+#include <functional>
 #include <openssl/crypto.h>
 #include <stdexcept>
+#include <vector>
+
+#include "CpuCapabilities.hpp"
+#include "QueueWait.hpp"
+#include "QuickCryptoApi.hpp"
+#include "WorkloadRecorder.hpp"
 
 namespace margelo::nitro::crypto {
 
@@ -16,4 +24,91 @@ bool HybridUtils::timingSafeEqual(const std::shared_ptr<ArrayBuffer>& a, const s
   return CRYPTO_memcmp(a->data(), b->data(), aLen) == 0;
 }
 
+void HybridUtils::benchmarkNoop(const std::shared_ptr<ArrayBuffer>& /* data */) {}
+
+std::shared_ptr<ArrayBuffer> HybridUtils::benchmarkNative(const std::string& operation, const std::shared_ptr<ArrayBuffer>& data,
+                                                          double iterations) {
+  if (iterations < 1) {
+    throw std::runtime_error("iterations must be at least 1");
+  }
+  size_t count = static_cast<size_t>(iterations);
+  api::ByteSpan input(data->data(), data->size());
+  std::vector<uint8_t> key(32, 0x42);
+  std::vector<uint8_t> iv(12, 0x24);
+  std::vector<uint8_t> output;
+
+  // Mirrors what the JS-facing Hybrid methods do, minus the JSI crossing
+  std::function<void()> op;
+  if (operation == "noop") {
+    op = []() {};
+  } else if (operation == "sha256") {
+    op = [&]() { api::Hash::digest("sha256", input); };
+  } else if (operation == "hmac-sha256") {
+    op = [&]() { api::Hmac::digest("sha256", key, input); };
+  } else if (operation == "aes-256-gcm") {
+    output.resize(input.size());
+    op = [&]() {
+      uint8_t tag[16];
+      api::aeadSeal(api::Aead::Aes256Gcm, key, iv, {}, input, output, tag);
+    };
+  } else if (operation == "randomFill") {
+    output.resize(input.size());
+    op = [&]() { api::randomBytes(output); };
+  } else {
+    throw std::runtime_error("Unknown benchmark operation: " + operation);
+  }
+
+  auto* samples = new double[count];
+  for (size_t i = 0; i < count; i++) {
+    auto start = std::chrono::steady_clock::now();
+    op();
+    auto end = std::chrono::steady_clock::now();
+    samples[i] = std::chrono::duration<double, std::milli>(end - start).count();
+  }
+  return std::make_shared<NativeArrayBuffer>(reinterpret_cast<uint8_t*>(samples), count * sizeof(double),
+                                             [=]() { delete[] samples; });
+}
+
+std::shared_ptr<Promise<void>> HybridUtils::prewarm() {
+  return Promise<void>::async([]() { api::prewarm(); });
+}
+
+std::unordered_map<std::string, bool> HybridUtils::getCpuCapabilities() {
+  return cpuCapabilities().toMap();
+}
+
+std::unordered_map<std::string, std::string> HybridUtils::getCryptoImplementations() {
+  return cryptoImplementations();
+}
+
+std::shared_ptr<Promise<std::string>> HybridUtils::preferredAead() {
+  return Promise<std::string>::async([]() -> std::string {
+    return api::preferredAead() == api::Aead::ChaCha20Poly1305 ? "chacha20-poly1305" : "aes-256-gcm";
+  });
+}
+
+void HybridUtils::setQueueWaitTracking(bool enabled) {
+  QueueWait::setEnabled(enabled);
+}
+
+std::unordered_map<std::string, std::vector<double>> HybridUtils::takeQueueWaits() {
+  return QueueWait::take();
+}
+
+void HybridUtils::startWorkloadRecording(std::optional<double> maxBytes) {
+  if (!maxBytes.has_value()) {
+    WorkloadRecorder::start();
+    return;
+  }
+  if (*maxBytes < 16) {
+    throw std::runtime_error("maxBytes must be at least 16");
+  }
+  WorkloadRecorder::start(static_cast<size_t>(*maxBytes));
+}
+
+std::shared_ptr<ArrayBuffer> HybridUtils::stopWorkloadRecording() {
+  std::vector<uint8_t> trace = WorkloadRecorder::stop();
+  return ArrayBuffer::copy(trace);
+}
+
 } // namespace margelo::nitro::crypto
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "HybridUtilsSpec.hpp"
 
 namespace margelo::nitro::crypto {
@@ -10,6 +15,29 @@ class HybridUtils : public HybridUtilsSpec {
 
  public:
   bool timingSafeEqual(const std::shared_ptr<ArrayBuffer>& a, const std::shared_ptr<ArrayBuffer>& b) override;
+
+  // Benchmark baselines: a call that does nothing once it crosses JSI, and
+  // the same crypto work timed purely in C++ (per-iteration ms, Float64).
+  void benchmarkNoop(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> benchmarkNative(const std::string& operation, const std::shared_ptr<ArrayBuffer>& data,
+                                               double iterations) override;
+
+  // Runs api::prewarm() on the thread pool so launch code can await it
+  // without blocking the JS thread.
+  std::shared_ptr<Promise<void>> prewarm() override;
+
+  std::unordered_map<std::string, bool> getCpuCapabilities() override;
+  std::unordered_map<std::string, std::string> getCryptoImplementations() override;
+  // api::preferredAead() on the thread pool; the measurement runs once
+  std::shared_ptr<Promise<std::string>> preferredAead() override;
+
+  // QueueWait tracking for the concurrency benchmarks
+  void setQueueWaitTracking(bool enabled) override;
+  std::unordered_map<std::string, std::vector<double>> takeQueueWaits() override;
+
+  // WorkloadRecorder traces for replay in the host benchmarks
+  void startWorkloadRecording(std::optional<double> maxBytes) override;
+  std::shared_ptr<ArrayBuffer> stopWorkloadRecording() override;
 };
 
 } // namespace margelo::nitro::crypto
@@ -0,0 +1,70 @@
+#include "LibraryContext.hpp"
+
+#include <openssl/err.h>
+#include <openssl/provider.h>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  OSSL_LIB_CTX* createLibraryContext() {
+    OSSL_LIB_CTX* ctx = OSSL_LIB_CTX_new();
+    if (ctx == nullptr) {
+      throw std::runtime_error("Failed to create OpenSSL library context");
+    }
+    if (OSSL_PROVIDER_load(ctx, "default") == nullptr) {
+      OSSL_LIB_CTX_free(ctx);
+      throw std::runtime_error("Failed to load the default provider");
+    }
+    return ctx;
+  }
+
+  // Entries hold one reference each for the thread's lifetime. They are not
+  // released when the thread exits: the methods belong to libraryContext(),
+  // which is never freed, and releasing them could race OpenSSL's own atexit
+  // cleanup on threads that outlive main().
+  template <typename T, T* (*Fetch)(OSSL_LIB_CTX*, const char*, const char*), int (*UpRef)(T*)>
+  T* cachedFetch(const std::string& name) {
+    thread_local std::unordered_map<std::string, T*> cache;
+    auto it = cache.find(name);
+    if (it == cache.end()) {
+      T* method = Fetch(libraryContext(), name.c_str(), nullptr);
+      if (method == nullptr) {
+        // Drop the miss in our context; a miss in the default one is reported
+        ERR_clear_error();
+        method = Fetch(nullptr, name.c_str(), nullptr);
+      }
+      if (method == nullptr) {
+        return nullptr;
+      }
+      it = cache.emplace(name, method).first;
+    }
+    return UpRef(it->second) == 1 ? it->second : nullptr;
+  }
+
+} // namespace
+
+OSSL_LIB_CTX* libraryContext() {
+  static OSSL_LIB_CTX* const ctx = createLibraryContext();
+  return ctx;
+}
+
+EVP_MD* fetchDigest(const std::string& name) {
+  return cachedFetch<EVP_MD, EVP_MD_fetch, EVP_MD_up_ref>(name);
+}
+
+EVP_CIPHER* fetchCipher(const std::string& name) {
+  return cachedFetch<EVP_CIPHER, EVP_CIPHER_fetch, EVP_CIPHER_up_ref>(name);
+}
+
+EVP_MAC* fetchMac(const std::string& name) {
+  return cachedFetch<EVP_MAC, EVP_MAC_fetch, EVP_MAC_up_ref>(name);
+}
+
+EVP_KDF* fetchKdf(const std::string& name) {
+  return cachedFetch<EVP_KDF, EVP_KDF_fetch, EVP_KDF_up_ref>(name);
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <string>
+
+namespace margelo::nitro::crypto {
+
+// The module's own OpenSSL library context, with the default provider loaded
+// once. Keeps our method store apart from the process-wide default context
+// other libraries in the app share. Lives for the process.
+OSSL_LIB_CTX* libraryContext();
+
+// Algorithm fetches through a per-thread cache: after a thread's first fetch
+// of a name, later ones are a map lookup and an up-ref on the cached method
+// instead of a method-store query. Each returns a new reference (free it as
+// usual) or nullptr if the name is unknown. Names missing from our context
+// fall back to the default one, so providers an app loaded there (e.g. legacy)
+// keep working.
+EVP_MD* fetchDigest(const std::string& name);
+EVP_CIPHER* fetchCipher(const std::string& name);
+EVP_MAC* fetchMac(const std::string& name);
+EVP_KDF* fetchKdf(const std::string& name);
+
+} // namespace margelo::nitro::crypto
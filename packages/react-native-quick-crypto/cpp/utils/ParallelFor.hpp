@@ -0,0 +1,105 @@
+#pragma once
+
+#include <NitroModules/ThreadPool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace margelo::nitro::crypto {
+
+// Turns a JS `parallelism` option into a chunk count: 1 unless asked for more,
+// and never more than the cores available or the `count` items to split.
+inline size_t resolveParallelism(std::optional<double> parallelism, size_t count) {
+  if (!parallelism.has_value() || parallelism.value() <= 1) {
+    return 1;
+  }
+  size_t hw = std::max<size_t>(1, std::thread::hardware_concurrency());
+  size_t requested = static_cast<size_t>(std::min(parallelism.value(), static_cast<double>(hw)));
+  return std::max<size_t>(1, std::min(requested, count));
+}
+
+// Splits [0, count) into `chunks` contiguous ranges and calls
+// fn(chunk, begin, end) once per range. The calling thread works through the
+// ranges itself; up to `chunks - 1` helpers are posted to Nitro's shared pool
+// and pick up whatever is left when they get to run. The caller never waits for
+// a helper that has not started, so this is safe to call from a pool worker
+// (e.g. inside Promise::async) even when every other worker is busy.
+//
+// Once a range throws, ranges not yet started are skipped and the first error
+// is rethrown after every running range has finished.
+inline void parallelFor(size_t chunks, size_t count, const std::function<void(size_t chunk, size_t begin, size_t end)>& fn) {
+  if (chunks <= 1) {
+    fn(0, 0, count);
+    return;
+  }
+
+  struct State {
+    const std::function<void(size_t, size_t, size_t)>* fn = nullptr;
+    size_t chunks = 0;
+    size_t count = 0;
+    size_t per_chunk = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::condition_variable idle;
+    // Set by the caller once it is done; helpers that start later do nothing
+    bool closed = false;
+    size_t active = 0;
+    std::exception_ptr error;
+
+    void drain() {
+      for (size_t chunk = next++; chunk < chunks && !failed; chunk = next++) {
+        size_t begin = std::min(count, chunk * per_chunk);
+        size_t end = std::min(count, begin + per_chunk);
+        try {
+          (*fn)(chunk, begin, end);
+        } catch (...) {
+          std::lock_guard lock(mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          failed = true;
+        }
+      }
+    }
+  };
+
+  auto state = std::make_shared<State>();
+  state->fn = &fn;
+  state->chunks = chunks;
+  state->count = count;
+  state->per_chunk = (count + chunks - 1) / chunks;
+
+  for (size_t i = 1; i < chunks; i++) {
+    ThreadPool::shared().run([state]() {
+      {
+        std::lock_guard lock(state->mutex);
+        if (state->closed) {
+          return;
+        }
+        state->active++;
+      }
+      state->drain();
+      std::lock_guard lock(state->mutex);
+      if (--state->active == 0) {
+        state->idle.notify_all();
+      }
+    });
+  }
+
+  state->drain();
+  std::unique_lock lock(state->mutex);
+  state->closed = true;
+  state->idle.wait(lock, [&]() { return state->active == 0; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+} // namespace margelo::nitro::crypto
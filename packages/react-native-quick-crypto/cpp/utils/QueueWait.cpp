@@ -0,0 +1,46 @@
+#include "QueueWait.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  std::atomic<bool> enabled{false};
+
+  // Only touched while tracking is on, so the lock never sits on a
+  // production path
+  std::mutex mutex;
+  std::unordered_map<std::string, std::vector<double>> waits;
+
+} // namespace
+
+QueueWait::Stamp QueueWait::stamp(const char* api) {
+  if (!enabled.load(std::memory_order_relaxed)) {
+    return {};
+  }
+  return {api, Clock::now()};
+}
+
+void QueueWait::Stamp::started() const {
+  if (api == nullptr) {
+    return;
+  }
+  double ms = std::chrono::duration<double, std::milli>(Clock::now() - queued).count();
+  std::unique_lock lock(mutex);
+  waits[api].push_back(ms);
+}
+
+void QueueWait::setEnabled(bool value) {
+  enabled.store(value, std::memory_order_relaxed);
+}
+
+std::unordered_map<std::string, std::vector<double>> QueueWait::take() {
+  std::unique_lock lock(mutex);
+  std::unordered_map<std::string, std::vector<double>> result;
+  result.swap(waits);
+  return result;
+}
+
+} // namespace margelo::nitro::crypto
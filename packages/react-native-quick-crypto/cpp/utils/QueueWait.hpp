@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::crypto {
+
+// How long async jobs sit in the worker pool's queue before a thread picks
+// them up, per API. Off by default; the concurrency benchmarks switch it on to
+// tell oversubscription (long waits) apart from contention inside the job.
+//
+//   Promise<T>::async([..., queued = QueueWait::stamp("pbkdf2")]() {
+//     queued.started();
+//     ...
+//   });
+class QueueWait {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stamp {
+    const char* api = nullptr; // nullptr while tracking is off
+    Clock::time_point queued;
+
+    void started() const;
+  };
+
+  static Stamp stamp(const char* api);
+
+  static void setEnabled(bool enabled);
+  // Waits in milliseconds recorded since the last call, keyed by API
+  static std::unordered_map<std::string, std::vector<double>> take();
+};
+
+} // namespace margelo::nitro::crypto
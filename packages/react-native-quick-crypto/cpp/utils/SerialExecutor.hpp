@@ -0,0 +1,94 @@
+#pragma once
+
+#include <NitroModules/Promise.hpp>
+#include <NitroModules/ThreadPool.hpp>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace margelo::nitro::crypto {
+
+// Runs jobs on Nitro's shared thread pool one at a time, in submission order.
+// Stateful HybridObjects (key pairs) own one, so a single long-lived object can
+// serve many concurrent promises without two jobs touching its state at once,
+// e.g. sign() queued behind generateKeyPair() sees the generated key.
+//
+// The queue lives in a shared State so a drain already scheduled on the pool
+// stays valid even if the owning object is released mid-flight; callers should
+// still capture a strong reference to the object itself in `run` (see strongRef).
+class SerialExecutor {
+ public:
+  template <typename T, typename Run>
+  std::shared_ptr<Promise<T>> async(Run&& run) {
+    auto promise = Promise<T>::create();
+    post([promise, run = std::forward<Run>(run)]() mutable {
+      try {
+        if constexpr (std::is_void_v<T>) {
+          run();
+          promise->resolve();
+        } else {
+          promise->resolve(run());
+        }
+      } catch (...) {
+        promise->reject(std::current_exception());
+      }
+    });
+    return promise;
+  }
+
+ private:
+  struct State {
+    std::mutex mutex;
+    std::deque<std::function<void()>> queue;
+    bool draining = false;
+  };
+
+  void post(std::function<void()>&& job) {
+    {
+      std::unique_lock lock(state->mutex);
+      state->queue.push_back(std::move(job));
+      if (state->draining) {
+        return;
+      }
+      state->draining = true;
+    }
+    ThreadPool::shared().run([state = state]() { drain(state); });
+  }
+
+  static void drain(const std::shared_ptr<State>& state) {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock lock(state->mutex);
+        if (state->queue.empty()) {
+          state->draining = false;
+          return;
+        }
+        job = std::move(state->queue.front());
+        state->queue.pop_front();
+      }
+      job();
+    }
+  }
+
+  std::shared_ptr<State> state = std::make_shared<State>();
+};
+
+// A strong reference to a HybridObject for capture in async jobs, so JS can drop
+// the object while a job is still running. HybridObject is a virtual base, hence
+// the dynamic cast.
+template <typename T>
+std::shared_ptr<T> strongRef(T* self) {
+  auto ref = std::dynamic_pointer_cast<T>(self->shared());
+  if (ref == nullptr) {
+    throw std::runtime_error("HybridObject is not owned by a shared_ptr");
+  }
+  return ref;
+}
+
+} // namespace margelo::nitro::crypto
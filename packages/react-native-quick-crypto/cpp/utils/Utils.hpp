@@ -4,6 +4,9 @@
 #include <cctype>
 #include <limits>
 #include <openssl/err.h>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
 
 #include "Macros.hpp"
@@ -37,6 +40,15 @@ inline std::shared_ptr<margelo::nitro::NativeArrayBuffer> ToNativeArrayBuffer(co
   return std::make_shared<margelo::nitro::NativeArrayBuffer>(data, bufferSize, [=]() { delete[] data; });
 }
 
+inline std::shared_ptr<margelo::nitro::NativeArrayBuffer> ToNativeArrayBuffer(std::span<const uint8_t> bytes) {
+  size_t size = bytes.size();
+  uint8_t* data = new uint8_t[size];
+  if (size > 0) {
+    memcpy(data, bytes.data(), size);
+  }
+  return std::make_shared<margelo::nitro::NativeArrayBuffer>(data, size, [=]() { delete[] data; });
+}
+
 inline std::shared_ptr<margelo::nitro::NativeArrayBuffer> ToNativeArrayBuffer(std::string str) {
   size_t size = str.size();
   uint8_t* data = new uint8_t[size];
@@ -52,6 +64,60 @@ inline bool CheckIsInt32(double value) {
   return (value >= std::numeric_limits<int32_t>::lowest() && value <= std::numeric_limits<int32_t>::max());
 }
 
+// 2^53: largest integer a JS number represents exactly
+constexpr double kMaxSafeInteger = 9007199254740992.0;
+
+// fixed-width integers in nonces, tweaks and page trailers
+inline void storeLE32(uint8_t* out, uint32_t value) {
+  for (size_t i = 0; i < 4; i++) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+inline void storeLE64(uint8_t* out, uint64_t value) {
+  for (size_t i = 0; i < 8; i++) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+inline void storeBE64(uint8_t* out, uint64_t value) {
+  for (size_t i = 0; i < 8; i++) {
+    out[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+  }
+}
+
+inline uint32_t loadLE32(const uint8_t* in) {
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) | (static_cast<uint32_t>(in[2]) << 16) |
+         (static_cast<uint32_t>(in[3]) << 24);
+}
+
+// read [byteOffset, byteOffset + byteLength) of a JSArrayBuffer in place. Only valid
+// for the duration of the synchronous call the buffer was passed to, so anything that
+// outlives it (async work, stored state) must still go through ToNativeArrayBuffer
+inline std::span<const uint8_t> ToByteView(const std::shared_ptr<margelo::nitro::ArrayBuffer>& buffer,
+                                           const std::optional<double>& byteOffset = std::nullopt,
+                                           const std::optional<double>& byteLength = std::nullopt) {
+  if (!buffer) {
+    return {};
+  }
+  size_t size = buffer->size();
+  size_t offset = 0;
+  if (byteOffset.has_value()) {
+    if (!CheckIsUint32(*byteOffset) || *byteOffset != static_cast<double>(static_cast<uint32_t>(*byteOffset)) || *byteOffset > size) {
+      throw std::runtime_error("byteOffset is out of range");
+    }
+    offset = static_cast<size_t>(*byteOffset);
+  }
+  size_t length = size - offset;
+  if (byteLength.has_value()) {
+    if (!CheckIsUint32(*byteLength) || *byteLength != static_cast<double>(static_cast<uint32_t>(*byteLength)) || *byteLength > length) {
+      throw std::runtime_error("byteLength is out of range");
+    }
+    length = static_cast<size_t>(*byteLength);
+  }
+  return {buffer->data() + offset, length};
+}
+
 // Function to convert a string to lowercase
 inline std::string toLower(std::string s) {
   std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
@@ -0,0 +1,221 @@
+#include "WorkloadRecorder.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace margelo::nitro::crypto {
+
+namespace {
+
+  constexpr uint8_t kMagic[] = {'R', 'Q', 'W', 'L'};
+  constexpr uint8_t kVersion = 1;
+  constexpr uint8_t kStringTag = 0x00;
+  constexpr uint8_t kAsyncFlag = 0x01;
+
+  using Clock = std::chrono::steady_clock;
+
+  std::atomic<bool> recording{false};
+  thread_local int asyncDepth = 0;
+
+  // Everything below is guarded by `mutex` and only touched while recording
+  std::mutex mutex;
+  std::vector<uint8_t> trace;
+  std::unordered_map<std::string, uint64_t> strings;
+  size_t maxTraceBytes = 0;
+  Clock::time_point last;
+
+  void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+  }
+
+  class Reader {
+   public:
+    Reader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    bool done() const {
+      return pos_ == size_;
+    }
+
+    uint8_t byte() {
+      if (pos_ >= size_) {
+        throw std::runtime_error("Workload trace is truncated");
+      }
+      return data_[pos_++];
+    }
+
+    uint64_t varint() {
+      uint64_t value = 0;
+      for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b = byte();
+        value |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+          return value;
+        }
+      }
+      throw std::runtime_error("Workload trace has an invalid varint");
+    }
+
+    std::string string(size_t length) {
+      if (size_ - pos_ < length) {
+        throw std::runtime_error("Workload trace is truncated");
+      }
+      std::string value(reinterpret_cast<const char*>(data_ + pos_), length);
+      pos_ += length;
+      return value;
+    }
+
+   private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+  };
+
+} // namespace
+
+WorkloadRecorder::AsyncJob::AsyncJob() {
+  asyncDepth++;
+}
+
+WorkloadRecorder::AsyncJob::~AsyncJob() {
+  asyncDepth--;
+}
+
+bool WorkloadRecorder::enabled() {
+  return recording.load(std::memory_order_relaxed);
+}
+
+void WorkloadRecorder::start(size_t maxBytes) {
+  std::unique_lock lock(mutex);
+  trace.assign(std::begin(kMagic), std::end(kMagic));
+  trace.push_back(kVersion);
+  strings.clear();
+  maxTraceBytes = maxBytes;
+  last = Clock::now();
+  recording.store(true, std::memory_order_relaxed);
+}
+
+std::vector<uint8_t> WorkloadRecorder::stop() {
+  std::unique_lock lock(mutex);
+  recording.store(false, std::memory_order_relaxed);
+  strings.clear();
+  std::vector<uint8_t> result;
+  result.swap(trace);
+  return result;
+}
+
+void WorkloadRecorder::record(Op op, const std::string& algorithm, uint64_t size, uint64_t p1, uint64_t p2, uint64_t p3) {
+  if (!enabled()) {
+    return;
+  }
+  bool async = asyncDepth > 0;
+  auto now = Clock::now();
+
+  std::unique_lock lock(mutex);
+  // stop() may have run since the check above
+  if (!enabled()) {
+    return;
+  }
+  std::vector<uint8_t> entry;
+  auto it = strings.find(algorithm);
+  if (it == strings.end()) {
+    // Names are algorithm identifiers, so 255 bytes is plenty
+    std::string name = algorithm.substr(0, 255);
+    entry.push_back(kStringTag);
+    entry.push_back(static_cast<uint8_t>(name.size()));
+    entry.insert(entry.end(), name.begin(), name.end());
+  }
+  uint64_t id = it != strings.end() ? it->second : strings.size();
+  uint64_t delta = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+
+  entry.push_back(static_cast<uint8_t>(op));
+  entry.push_back(async ? kAsyncFlag : 0);
+  putVarint(entry, id);
+  putVarint(entry, size);
+  putVarint(entry, p1);
+  putVarint(entry, p2);
+  putVarint(entry, p3);
+  putVarint(entry, now > last ? delta : 0);
+
+  if (trace.size() + entry.size() > maxTraceBytes) {
+    recording.store(false, std::memory_order_relaxed);
+    return;
+  }
+  if (it == strings.end()) {
+    strings.emplace(algorithm, id);
+  }
+  last = now;
+  trace.insert(trace.end(), entry.begin(), entry.end());
+}
+
+std::vector<WorkloadRecorder::Entry> WorkloadRecorder::decode(const uint8_t* data, size_t size) {
+  Reader reader(data, size);
+  for (uint8_t expected : kMagic) {
+    if (reader.byte() != expected) {
+      throw std::runtime_error("Not a workload trace");
+    }
+  }
+  if (reader.byte() != kVersion) {
+    throw std::runtime_error("Unsupported workload trace version");
+  }
+
+  std::vector<std::string> names;
+  std::vector<Entry> entries;
+  while (!reader.done()) {
+    uint8_t tag = reader.byte();
+    if (tag == kStringTag) {
+      names.push_back(reader.string(reader.byte()));
+      continue;
+    }
+    if (tag < static_cast<uint8_t>(Op::Hash) || tag > static_cast<uint8_t>(Op::EdVerify)) {
+      throw std::runtime_error("Unknown operation in workload trace: " + std::to_string(tag));
+    }
+    Entry entry;
+    entry.op = static_cast<Op>(tag);
+    entry.async = (reader.byte() & kAsyncFlag) != 0;
+    uint64_t id = reader.varint();
+    if (id >= names.size()) {
+      throw std::runtime_error("Workload trace references an undefined string");
+    }
+    entry.algorithm = names[id];
+    entry.size = reader.varint();
+    entry.p1 = reader.varint();
+    entry.p2 = reader.varint();
+    entry.p3 = reader.varint();
+    entry.deltaMicros = reader.varint();
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+const char* WorkloadRecorder::opName(Op op) {
+  switch (op) {
+    case Op::Hash:
+      return "hash";
+    case Op::Hmac:
+      return "hmac";
+    case Op::Cipher:
+      return "cipher";
+    case Op::Pbkdf2:
+      return "pbkdf2";
+    case Op::Scrypt:
+      return "scrypt";
+    case Op::Hkdf:
+      return "hkdf";
+    case Op::RandomFill:
+      return "randomFill";
+    case Op::EdSign:
+      return "ed.sign";
+    case Op::EdVerify:
+      return "ed.verify";
+  }
+  return "unknown";
+}
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::crypto {
+
+// Opt-in log of the crypto operations an app performs, for replaying a
+// production mix in the host benchmarks (quickcrypto_replay). Only metadata is
+// recorded: operation, algorithm name, sizes, cost parameters, sync/async and
+// the time since the previous operation. Never inputs, outputs or keys.
+//
+// Trace format (little-endian varints, LEB128):
+//   "RQWL" u8 version
+//   then entries, each starting with a tag byte:
+//     0x00                 string: u8 length, bytes; ids count up from 0
+//     Op                   u8 flags (bit 0: async), varint algorithm id,
+//                          varint size, varint p1, p2, p3, varint delta us
+class WorkloadRecorder {
+ public:
+  enum class Op : uint8_t {
+    Hash = 1,       // size: bytes hashed, p1: update calls
+    Hmac = 2,       // size: bytes, p1: update calls
+    Cipher = 3,     // size: bytes, p1: update calls, p2: 1 encrypt / 0 decrypt
+    Pbkdf2 = 4,     // algorithm: digest, size: key length, p1: iterations
+    Scrypt = 5,     // size: key length, p1: N, p2: r, p3: p
+    Hkdf = 6,       // algorithm: digest, size: key length, p1: input key length
+    RandomFill = 7, // size: bytes
+    EdSign = 8,     // algorithm: curve, size: message length
+    EdVerify = 9,   // algorithm: curve, size: message length
+  };
+
+  struct Entry {
+    Op op;
+    bool async = false;
+    std::string algorithm;
+    uint64_t size = 0;
+    uint64_t p1 = 0;
+    uint64_t p2 = 0;
+    uint64_t p3 = 0;
+    uint64_t deltaMicros = 0;
+  };
+
+  // Bytes and update calls of a streaming operation (Hash, Hmac, Cipher)
+  struct Tally {
+    uint64_t bytes = 0;
+    uint64_t updates = 0;
+
+    void add(size_t size) {
+      bytes += size;
+      updates++;
+    }
+  };
+
+  // Marks the current thread as running an async job, so operations it
+  // records are tagged async; set by the async wrappers around *Sync methods
+  class AsyncJob {
+   public:
+    AsyncJob();
+    ~AsyncJob();
+    AsyncJob(const AsyncJob&) = delete;
+    AsyncJob& operator=(const AsyncJob&) = delete;
+  };
+
+  static bool enabled();
+  // Starts a new trace, discarding any previous one. Recording stops by
+  // itself once the trace would exceed maxBytes.
+  static void start(size_t maxBytes = 8 * 1024 * 1024);
+  // Stops recording and hands over the trace
+  static std::vector<uint8_t> stop();
+
+  static void record(Op op, const std::string& algorithm, uint64_t size, uint64_t p1 = 0, uint64_t p2 = 0, uint64_t p3 = 0);
+
+  // Parses a trace; throws std::runtime_error if it is malformed
+  static std::vector<Entry> decode(const uint8_t* data, size_t size);
+  static const char* opName(Op op);
+};
+
+} // namespace margelo::nitro::crypto
@@ -13,6 +13,7 @@
  */
 
 #include "fastpbkdf2.h"
+#include "fastpbkdf2_hw.h"
 
 #include <assert.h>
 #include <string.h>
@@ -105,11 +106,13 @@ static inline void md_pad(uint8_t *block, size_t blocksz, size_t used,
  *    args: args (_ctx *restrict c, uint8_t *restrict out)
  * _xxor hash context xor function (only need xor hash state)
  *    args: (_ctx *restrict out, const _ctx *restrict in)
+ * _hwloop hardware iteration loop, see fastpbkdf2_hw.h; returns 0 if unused
+ *    args: (const _ctx *inner, const _ctx *outer, _ctx *result, uint32_t n)
  *
  * The resulting function is named PBKDF2(_name).
  */
 #define DECL_PBKDF2(_name, _blocksz, _hashsz, _ctx, _init, _update, _xform,    \
-                    _final, _xcpy, _xtract, _xxor)                             \
+                    _final, _xcpy, _xtract, _xxor, _hwloop)                    \
   typedef struct {                                                             \
     _ctx inner;                                                                \
     _ctx outer;                                                                \
@@ -186,6 +189,12 @@ static inline void md_pad(uint8_t *block, size_t blocksz, size_t used,
     HMAC_FINAL(_name)(&ctx, Ublock);                                           \
     _ctx result = ctx.outer;                                                   \
                                                                                \
+    /* A hardware kernel runs all the remaining iterations if it can. */       \
+    if (iterations > 1 && _hwloop(&startctx->inner, &startctx->outer,          \
+                                  &result, iterations - 1)) {                  \
+      iterations = 1;                                                          \
+    }                                                                          \
+                                                                               \
     /* Subsequent iterations: \
      *   U_c = PRF(P, U_{c-1}) \
      */                                                                        \
@@ -253,9 +262,27 @@ static inline void sha1_xor(SHA_CTX *restrict out, const SHA_CTX *restrict in) {
   out->h4 ^= in->h4;
 }
 
+static inline int sha1_hwloop(const SHA_CTX *inner, const SHA_CTX *outer,
+                              SHA_CTX *result, uint32_t n) {
+  const uint32_t in[5] = {inner->h0, inner->h1, inner->h2, inner->h3,
+                          inner->h4};
+  const uint32_t out[5] = {outer->h0, outer->h1, outer->h2, outer->h3,
+                           outer->h4};
+  uint32_t u[5] = {result->h0, result->h1, result->h2, result->h3,
+                   result->h4};
+  if (!fastpbkdf2_sha1_hw(in, out, u, n))
+    return 0;
+  result->h0 = u[0];
+  result->h1 = u[1];
+  result->h2 = u[2];
+  result->h3 = u[3];
+  result->h4 = u[4];
+  return 1;
+}
+
 DECL_PBKDF2(sha1, SHA_CBLOCK, SHA_DIGEST_LENGTH, SHA_CTX, SHA1_Init,
             SHA1_Update, SHA1_Transform, SHA1_Final, sha1_cpy, sha1_extract,
-            sha1_xor)
+            sha1_xor, sha1_hwloop)
 
 static inline void sha256_extract(SHA256_CTX *restrict ctx,
                                   uint8_t *restrict out) {
@@ -293,9 +320,25 @@ static inline void sha256_xor(SHA256_CTX *restrict out,
   out->h[7] ^= in->h[7];
 }
 
+static inline int sha256_hwloop(const SHA256_CTX *inner,
+                                const SHA256_CTX *outer, SHA256_CTX *result,
+                                uint32_t n) {
+  uint32_t in[8], out[8], u[8];
+  for (int i = 0; i < 8; i++) {
+    in[i] = inner->h[i];
+    out[i] = outer->h[i];
+    u[i] = result->h[i];
+  }
+  if (!fastpbkdf2_sha256_hw(in, out, u, n))
+    return 0;
+  for (int i = 0; i < 8; i++)
+    result->h[i] = u[i];
+  return 1;
+}
+
 DECL_PBKDF2(sha256, SHA256_CBLOCK, SHA256_DIGEST_LENGTH, SHA256_CTX,
             SHA256_Init, SHA256_Update, SHA256_Transform, SHA256_Final,
-            sha256_cpy, sha256_extract, sha256_xor)
+            sha256_cpy, sha256_extract, sha256_xor, sha256_hwloop)
 
 static inline void sha512_extract(SHA512_CTX *restrict ctx,
                                   uint8_t *restrict out) {
@@ -333,9 +376,25 @@ static inline void sha512_xor(SHA512_CTX *restrict out,
   out->h[7] ^= in->h[7];
 }
 
+static inline int sha512_hwloop(const SHA512_CTX *inner,
+                                const SHA512_CTX *outer, SHA512_CTX *result,
+                                uint32_t n) {
+  uint64_t in[8], out[8], u[8];
+  for (int i = 0; i < 8; i++) {
+    in[i] = inner->h[i];
+    out[i] = outer->h[i];
+    u[i] = result->h[i];
+  }
+  if (!fastpbkdf2_sha512_hw(in, out, u, n))
+    return 0;
+  for (int i = 0; i < 8; i++)
+    result->h[i] = u[i];
+  return 1;
+}
+
 DECL_PBKDF2(sha512, SHA512_CBLOCK, SHA512_DIGEST_LENGTH, SHA512_CTX,
             SHA512_Init, SHA512_Update, SHA512_Transform, SHA512_Final,
-            sha512_cpy, sha512_extract, sha512_xor)
+            sha512_cpy, sha512_extract, sha512_xor, sha512_hwloop)
 
 void fastpbkdf2_hmac_sha1(const uint8_t *pw, size_t npw, const uint8_t *salt,
                           size_t nsalt, uint32_t iterations, uint8_t *out,
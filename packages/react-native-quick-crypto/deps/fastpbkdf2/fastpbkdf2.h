@@ -61,6 +61,25 @@ void fastpbkdf2_hmac_sha512(const uint8_t *pw, size_t npw, const uint8_t *salt,
                             size_t nsalt, uint32_t iterations, uint8_t *out,
                             size_t nout);
 
+/* Hardware SHA kernels for the iteration loop (fastpbkdf2_hw.c). */
+#define FASTPBKDF2_HW_SHA1 1u
+#define FASTPBKDF2_HW_SHA256 2u
+#define FASTPBKDF2_HW_SHA512 4u
+
+/** Returns the FASTPBKDF2_HW_* kernels compiled in for this target. */
+unsigned fastpbkdf2_hw_compiled(void);
+
+/** Selects the kernels to use; bits that are not compiled in are ignored.
+ *
+ *  The caller must only pass features the running CPU has.  Nothing is
+ *  enabled by default, so every hash uses the portable loop until this is
+ *  called.  Safe to call from any thread.
+ */
+void fastpbkdf2_hw_enable(unsigned features);
+
+/** Returns the FASTPBKDF2_HW_* kernels currently in use. */
+unsigned fastpbkdf2_hw_enabled(void);
+
 #ifdef __cplusplus
 }
 #endif
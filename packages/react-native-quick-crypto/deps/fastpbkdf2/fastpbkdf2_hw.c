@@ -0,0 +1,503 @@
+/*
+ * Hardware SHA kernels for the fastpbkdf2 iteration loop.
+ *
+ * After U_1, every PBKDF2 iteration hashes one block twice: the previous U
+ * plus constant padding, first from the inner and then from the outer HMAC
+ * start state. The kernels below keep U, both start states and the running
+ * XOR in vector registers for the whole loop and build each block directly
+ * from the previous state words, instead of going through SHAx_Transform
+ * and a byte buffer per block.
+ *
+ *   x86 / x86_64  SHA-1, SHA-256   SHA-NI, via function target attributes
+ *   AArch64       SHA-1, SHA-256   ARMv8 Crypto (__ARM_FEATURE_SHA2)
+ *                 SHA-512          ARMv8.2 SHA512, fastpbkdf2_hw_sha512.c
+ *
+ * The AArch64 kernels are only compiled when the target enables the
+ * extension; a kernel is only used once fastpbkdf2_hw_enable() selects it.
+ */
+
+#include "fastpbkdf2.h"
+#include "fastpbkdf2_hw.h"
+
+#include <stdatomic.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define FASTPBKDF2_X86_SHANI 1
+#include <immintrin.h>
+#define SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+
+#if defined(__aarch64__) &&                                                    \
+  (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define FASTPBKDF2_ARM_SHA2 1
+#include <arm_neon.h>
+#endif
+
+static atomic_uint enabled_features;
+
+unsigned fastpbkdf2_hw_compiled(void) {
+  unsigned features = 0;
+#if defined(FASTPBKDF2_X86_SHANI) || defined(FASTPBKDF2_ARM_SHA2)
+  features |= FASTPBKDF2_HW_SHA1 | FASTPBKDF2_HW_SHA256;
+#endif
+  return features | fastpbkdf2_hw_sha512_compiled();
+}
+
+void fastpbkdf2_hw_enable(unsigned features) {
+  atomic_store_explicit(&enabled_features, features & fastpbkdf2_hw_compiled(),
+                        memory_order_relaxed);
+}
+
+unsigned fastpbkdf2_hw_enabled(void) {
+  return atomic_load_explicit(&enabled_features, memory_order_relaxed);
+}
+
+#if defined(FASTPBKDF2_X86_SHANI) || defined(FASTPBKDF2_ARM_SHA2)
+static const uint32_t sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+  0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+  0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+  0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+  0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+  0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+#endif
+
+/* The block hashed by iterations 2..c is the previous U followed by SHA
+ * padding for a 64 + 20 or 64 + 32 byte message: a single 1 bit right after
+ * U and the bit length in the last word. */
+#define SHA1_PAD_BITS ((64 + 20) * 8)
+#define SHA256_PAD_BITS ((64 + 32) * 8)
+
+/* --- x86 SHA-NI --- */
+#if defined(FASTPBKDF2_X86_SHANI)
+
+/* SHA-1 state: abcd with a in the top lane, e in the top lane of its own
+ * vector. Message words are in the same order, w0 in the top lane. */
+#define SHA1_X86_ROUNDS(ec, en, w, f)                                          \
+  ec = _mm_sha1nexte_epu32(ec, w);                                             \
+  en = abcd;                                                                   \
+  abcd = _mm_sha1rnds4_epu32(abcd, ec, f)
+
+/* Schedule after the rounds on w: msg2 finishes the next group, msg1 starts
+ * the one three ahead and the xor feeds the one two ahead. */
+#define SHA1_X86_SCHEDULE(w, next, ahead2, ahead3)                             \
+  next = _mm_sha1msg2_epu32(next, w);                                          \
+  ahead3 = _mm_sha1msg1_epu32(ahead3, w);                                      \
+  ahead2 = _mm_xor_si128(ahead2, w)
+
+SHANI_TARGET static inline void sha1_x86_block(__m128i *state_abcd,
+                                               __m128i *state_e, __m128i m0,
+                                               __m128i m1, __m128i m2,
+                                               __m128i m3) {
+  __m128i abcd = *state_abcd, e0 = *state_e, e1;
+
+  e0 = _mm_add_epi32(e0, m0);
+  e1 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+  SHA1_X86_ROUNDS(e1, e0, m1, 0);
+  m0 = _mm_sha1msg1_epu32(m0, m1);
+  SHA1_X86_ROUNDS(e0, e1, m2, 0);
+  m1 = _mm_sha1msg1_epu32(m1, m2);
+  m0 = _mm_xor_si128(m0, m2);
+  SHA1_X86_ROUNDS(e1, e0, m3, 0);
+  SHA1_X86_SCHEDULE(m3, m0, m1, m2);
+  SHA1_X86_ROUNDS(e0, e1, m0, 0);
+  SHA1_X86_SCHEDULE(m0, m1, m2, m3);
+  SHA1_X86_ROUNDS(e1, e0, m1, 1);
+  SHA1_X86_SCHEDULE(m1, m2, m3, m0);
+  SHA1_X86_ROUNDS(e0, e1, m2, 1);
+  SHA1_X86_SCHEDULE(m2, m3, m0, m1);
+  SHA1_X86_ROUNDS(e1, e0, m3, 1);
+  SHA1_X86_SCHEDULE(m3, m0, m1, m2);
+  SHA1_X86_ROUNDS(e0, e1, m0, 1);
+  SHA1_X86_SCHEDULE(m0, m1, m2, m3);
+  SHA1_X86_ROUNDS(e1, e0, m1, 1);
+  SHA1_X86_SCHEDULE(m1, m2, m3, m0);
+  SHA1_X86_ROUNDS(e0, e1, m2, 2);
+  SHA1_X86_SCHEDULE(m2, m3, m0, m1);
+  SHA1_X86_ROUNDS(e1, e0, m3, 2);
+  SHA1_X86_SCHEDULE(m3, m0, m1, m2);
+  SHA1_X86_ROUNDS(e0, e1, m0, 2);
+  SHA1_X86_SCHEDULE(m0, m1, m2, m3);
+  SHA1_X86_ROUNDS(e1, e0, m1, 2);
+  SHA1_X86_SCHEDULE(m1, m2, m3, m0);
+  SHA1_X86_ROUNDS(e0, e1, m2, 2);
+  SHA1_X86_SCHEDULE(m2, m3, m0, m1);
+  SHA1_X86_ROUNDS(e1, e0, m3, 3);
+  SHA1_X86_SCHEDULE(m3, m0, m1, m2);
+  SHA1_X86_ROUNDS(e0, e1, m0, 3);
+  SHA1_X86_SCHEDULE(m0, m1, m2, m3);
+  SHA1_X86_ROUNDS(e1, e0, m1, 3);
+  m2 = _mm_sha1msg2_epu32(m2, m1);
+  m3 = _mm_xor_si128(m3, m1);
+  SHA1_X86_ROUNDS(e0, e1, m2, 3);
+  m3 = _mm_sha1msg2_epu32(m3, m2);
+  SHA1_X86_ROUNDS(e1, e0, m3, 3);
+
+  *state_e = _mm_sha1nexte_epu32(e0, *state_e);
+  *state_abcd = _mm_add_epi32(abcd, *state_abcd);
+}
+
+SHANI_TARGET static void sha1_x86_iterate(const uint32_t inner[5],
+                                          const uint32_t outer[5],
+                                          uint32_t u[5], uint32_t n) {
+  const __m128i inner_abcd =
+    _mm_set_epi32((int)inner[0], (int)inner[1], (int)inner[2], (int)inner[3]);
+  const __m128i inner_e = _mm_set_epi32((int)inner[4], 0, 0, 0);
+  const __m128i outer_abcd =
+    _mm_set_epi32((int)outer[0], (int)outer[1], (int)outer[2], (int)outer[3]);
+  const __m128i outer_e = _mm_set_epi32((int)outer[4], 0, 0, 0);
+  const __m128i pad1 = _mm_set_epi32(0, (int)0x80000000, 0, 0);
+  const __m128i pad2 = _mm_setzero_si128();
+  const __m128i pad3 = _mm_set_epi32(0, 0, 0, SHA1_PAD_BITS);
+
+  __m128i abcd = _mm_set_epi32((int)u[0], (int)u[1], (int)u[2], (int)u[3]);
+  __m128i e = _mm_set_epi32((int)u[4], 0, 0, 0);
+  __m128i acc_abcd = abcd, acc_e = e;
+
+  for (uint32_t i = 0; i < n; i++) {
+    __m128i s_abcd = inner_abcd, s_e = inner_e;
+    sha1_x86_block(&s_abcd, &s_e, abcd, _mm_or_si128(e, pad1), pad2, pad3);
+    abcd = outer_abcd;
+    e = outer_e;
+    sha1_x86_block(&abcd, &e, s_abcd, _mm_or_si128(s_e, pad1), pad2, pad3);
+    acc_abcd = _mm_xor_si128(acc_abcd, abcd);
+    acc_e = _mm_xor_si128(acc_e, e);
+  }
+
+  u[0] = (uint32_t)_mm_extract_epi32(acc_abcd, 3);
+  u[1] = (uint32_t)_mm_extract_epi32(acc_abcd, 2);
+  u[2] = (uint32_t)_mm_extract_epi32(acc_abcd, 1);
+  u[3] = (uint32_t)_mm_extract_epi32(acc_abcd, 0);
+  u[4] = (uint32_t)_mm_extract_epi32(acc_e, 3);
+}
+
+/* SHA-256 state is kept the way sha256rnds2 wants it, abef / cdgh; message
+ * vectors and U are plain abcd / efgh with w0 in lane 0. */
+#define SHA256_X86_ROUNDS(w, k)                                                \
+  msg = _mm_add_epi32(w, _mm_loadu_si128((const __m128i *)&sha256_k[k]));      \
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);                               \
+  msg = _mm_shuffle_epi32(msg, 0x0E);                                          \
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, msg)
+
+/* next = msg2(next + (w:prev >> 32), w), i.e. finish the following group */
+#define SHA256_X86_MSG2(next, w, prev)                                         \
+  next = _mm_sha256msg2_epu32(                                                 \
+    _mm_add_epi32(next, _mm_alignr_epi8(w, prev, 4)), w)
+
+SHANI_TARGET static inline void sha256_x86_block(__m128i *state_abef,
+                                                 __m128i *state_cdgh,
+                                                 __m128i m0, __m128i m1,
+                                                 __m128i m2, __m128i m3) {
+  __m128i abef = *state_abef, cdgh = *state_cdgh, msg;
+
+  SHA256_X86_ROUNDS(m0, 0);
+  SHA256_X86_ROUNDS(m1, 4);
+  m0 = _mm_sha256msg1_epu32(m0, m1);
+  SHA256_X86_ROUNDS(m2, 8);
+  m1 = _mm_sha256msg1_epu32(m1, m2);
+  SHA256_X86_ROUNDS(m3, 12);
+  SHA256_X86_MSG2(m0, m3, m2);
+  m2 = _mm_sha256msg1_epu32(m2, m3);
+  SHA256_X86_ROUNDS(m0, 16);
+  SHA256_X86_MSG2(m1, m0, m3);
+  m3 = _mm_sha256msg1_epu32(m3, m0);
+  SHA256_X86_ROUNDS(m1, 20);
+  SHA256_X86_MSG2(m2, m1, m0);
+  m0 = _mm_sha256msg1_epu32(m0, m1);
+  SHA256_X86_ROUNDS(m2, 24);
+  SHA256_X86_MSG2(m3, m2, m1);
+  m1 = _mm_sha256msg1_epu32(m1, m2);
+  SHA256_X86_ROUNDS(m3, 28);
+  SHA256_X86_MSG2(m0, m3, m2);
+  m2 = _mm_sha256msg1_epu32(m2, m3);
+  SHA256_X86_ROUNDS(m0, 32);
+  SHA256_X86_MSG2(m1, m0, m3);
+  m3 = _mm_sha256msg1_epu32(m3, m0);
+  SHA256_X86_ROUNDS(m1, 36);
+  SHA256_X86_MSG2(m2, m1, m0);
+  m0 = _mm_sha256msg1_epu32(m0, m1);
+  SHA256_X86_ROUNDS(m2, 40);
+  SHA256_X86_MSG2(m3, m2, m1);
+  m1 = _mm_sha256msg1_epu32(m1, m2);
+  SHA256_X86_ROUNDS(m3, 44);
+  SHA256_X86_MSG2(m0, m3, m2);
+  m2 = _mm_sha256msg1_epu32(m2, m3);
+  SHA256_X86_ROUNDS(m0, 48);
+  SHA256_X86_MSG2(m1, m0, m3);
+  m3 = _mm_sha256msg1_epu32(m3, m0);
+  SHA256_X86_ROUNDS(m1, 52);
+  SHA256_X86_MSG2(m2, m1, m0);
+  SHA256_X86_ROUNDS(m2, 56);
+  SHA256_X86_MSG2(m3, m2, m1);
+  SHA256_X86_ROUNDS(m3, 60);
+
+  *state_abef = _mm_add_epi32(abef, *state_abef);
+  *state_cdgh = _mm_add_epi32(cdgh, *state_cdgh);
+}
+
+SHANI_TARGET static inline void sha256_x86_to_abef(__m128i abcd, __m128i efgh,
+                                                   __m128i *abef,
+                                                   __m128i *cdgh) {
+  abcd = _mm_shuffle_epi32(abcd, 0xB1);
+  efgh = _mm_shuffle_epi32(efgh, 0x1B);
+  *abef = _mm_alignr_epi8(abcd, efgh, 8);
+  *cdgh = _mm_blend_epi16(efgh, abcd, 0xF0);
+}
+
+SHANI_TARGET static inline void sha256_x86_to_abcd(__m128i abef, __m128i cdgh,
+                                                   __m128i *abcd,
+                                                   __m128i *efgh) {
+  abef = _mm_shuffle_epi32(abef, 0x1B);
+  cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+  *abcd = _mm_blend_epi16(abef, cdgh, 0xF0);
+  *efgh = _mm_alignr_epi8(cdgh, abef, 8);
+}
+
+SHANI_TARGET static void sha256_x86_iterate(const uint32_t inner[8],
+                                            const uint32_t outer[8],
+                                            uint32_t u[8], uint32_t n) {
+  __m128i inner_abef, inner_cdgh, outer_abef, outer_cdgh;
+  sha256_x86_to_abef(_mm_loadu_si128((const __m128i *)inner),
+                     _mm_loadu_si128((const __m128i *)(inner + 4)),
+                     &inner_abef, &inner_cdgh);
+  sha256_x86_to_abef(_mm_loadu_si128((const __m128i *)outer),
+                     _mm_loadu_si128((const __m128i *)(outer + 4)),
+                     &outer_abef, &outer_cdgh);
+  const __m128i pad2 = _mm_set_epi32(0, 0, 0, (int)0x80000000);
+  const __m128i pad3 = _mm_set_epi32(SHA256_PAD_BITS, 0, 0, 0);
+
+  __m128i abcd = _mm_loadu_si128((const __m128i *)u);
+  __m128i efgh = _mm_loadu_si128((const __m128i *)(u + 4));
+  __m128i acc_abcd = abcd, acc_efgh = efgh;
+
+  for (uint32_t i = 0; i < n; i++) {
+    __m128i abef = inner_abef, cdgh = inner_cdgh;
+    sha256_x86_block(&abef, &cdgh, abcd, efgh, pad2, pad3);
+    sha256_x86_to_abcd(abef, cdgh, &abcd, &efgh);
+    abef = outer_abef;
+    cdgh = outer_cdgh;
+    sha256_x86_block(&abef, &cdgh, abcd, efgh, pad2, pad3);
+    sha256_x86_to_abcd(abef, cdgh, &abcd, &efgh);
+    acc_abcd = _mm_xor_si128(acc_abcd, abcd);
+    acc_efgh = _mm_xor_si128(acc_efgh, efgh);
+  }
+
+  _mm_storeu_si128((__m128i *)u, acc_abcd);
+  _mm_storeu_si128((__m128i *)(u + 4), acc_efgh);
+}
+
+#endif /* FASTPBKDF2_X86_SHANI */
+
+/* --- AArch64 SHA1 / SHA256 --- */
+#if defined(FASTPBKDF2_ARM_SHA2)
+
+/* State and message vectors are in natural order, a / w0 in lane 0. */
+#define SHA1_ARM_ROUNDS(op, ec, en, w, k)                                      \
+  en = vsha1h_u32(vgetq_lane_u32(abcd, 0));                                    \
+  abcd = op(abcd, ec, vaddq_u32(w, k))
+
+#define SHA1_ARM_SCHEDULE(w, w1, w2, w3)                                       \
+  w = vsha1su1q_u32(vsha1su0q_u32(w, w1, w2), w3)
+
+static inline void sha1_arm_block(uint32x4_t *state_abcd, uint32_t *state_e,
+                                  uint32x4_t m0, uint32x4_t m1, uint32x4_t m2,
+                                  uint32x4_t m3) {
+  const uint32x4_t k0 = vdupq_n_u32(0x5a827999);
+  const uint32x4_t k1 = vdupq_n_u32(0x6ed9eba1);
+  const uint32x4_t k2 = vdupq_n_u32(0x8f1bbcdc);
+  const uint32x4_t k3 = vdupq_n_u32(0xca62c1d6);
+  uint32x4_t abcd = *state_abcd;
+  uint32_t e0 = *state_e, e1;
+
+  SHA1_ARM_ROUNDS(vsha1cq_u32, e0, e1, m0, k0);
+  SHA1_ARM_ROUNDS(vsha1cq_u32, e1, e0, m1, k0);
+  SHA1_ARM_ROUNDS(vsha1cq_u32, e0, e1, m2, k0);
+  SHA1_ARM_ROUNDS(vsha1cq_u32, e1, e0, m3, k0);
+  SHA1_ARM_SCHEDULE(m0, m1, m2, m3);
+  SHA1_ARM_ROUNDS(vsha1cq_u32, e0, e1, m0, k0);
+  SHA1_ARM_SCHEDULE(m1, m2, m3, m0);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e1, e0, m1, k1);
+  SHA1_ARM_SCHEDULE(m2, m3, m0, m1);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e0, e1, m2, k1);
+  SHA1_ARM_SCHEDULE(m3, m0, m1, m2);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e1, e0, m3, k1);
+  SHA1_ARM_SCHEDULE(m0, m1, m2, m3);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e0, e1, m0, k1);
+  SHA1_ARM_SCHEDULE(m1, m2, m3, m0);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e1, e0, m1, k1);
+  SHA1_ARM_SCHEDULE(m2, m3, m0, m1);
+  SHA1_ARM_ROUNDS(vsha1mq_u32, e0, e1, m2, k2);
+  SHA1_ARM_SCHEDULE(m3, m0, m1, m2);
+  SHA1_ARM_ROUNDS(vsha1mq_u32, e1, e0, m3, k2);
+  SHA1_ARM_SCHEDULE(m0, m1, m2, m3);
+  SHA1_ARM_ROUNDS(vsha1mq_u32, e0, e1, m0, k2);
+  SHA1_ARM_SCHEDULE(m1, m2, m3, m0);
+  SHA1_ARM_ROUNDS(vsha1mq_u32, e1, e0, m1, k2);
+  SHA1_ARM_SCHEDULE(m2, m3, m0, m1);
+  SHA1_ARM_ROUNDS(vsha1mq_u32, e0, e1, m2, k2);
+  SHA1_ARM_SCHEDULE(m3, m0, m1, m2);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e1, e0, m3, k3);
+  SHA1_ARM_SCHEDULE(m0, m1, m2, m3);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e0, e1, m0, k3);
+  SHA1_ARM_SCHEDULE(m1, m2, m3, m0);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e1, e0, m1, k3);
+  SHA1_ARM_SCHEDULE(m2, m3, m0, m1);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e0, e1, m2, k3);
+  SHA1_ARM_SCHEDULE(m3, m0, m1, m2);
+  SHA1_ARM_ROUNDS(vsha1pq_u32, e1, e0, m3, k3);
+
+  *state_abcd = vaddq_u32(abcd, *state_abcd);
+  *state_e += e0;
+}
+
+static void sha1_arm_iterate(const uint32_t inner[5], const uint32_t outer[5],
+                             uint32_t u[5], uint32_t n) {
+  static const uint32_t pad1_words[4] = {0, 0x80000000, 0, 0};
+  static const uint32_t pad3_words[4] = {0, 0, 0, SHA1_PAD_BITS};
+  const uint32x4_t inner_abcd = vld1q_u32(inner);
+  const uint32x4_t outer_abcd = vld1q_u32(outer);
+  const uint32x4_t pad1 = vld1q_u32(pad1_words);
+  const uint32x4_t pad2 = vdupq_n_u32(0);
+  const uint32x4_t pad3 = vld1q_u32(pad3_words);
+
+  uint32x4_t abcd = vld1q_u32(u);
+  uint32_t e = u[4];
+  uint32x4_t acc_abcd = abcd;
+  uint32_t acc_e = e;
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint32x4_t s_abcd = inner_abcd;
+    uint32_t s_e = inner[4];
+    sha1_arm_block(&s_abcd, &s_e, abcd, vsetq_lane_u32(e, pad1, 0), pad2,
+                   pad3);
+    abcd = outer_abcd;
+    e = outer[4];
+    sha1_arm_block(&abcd, &e, s_abcd, vsetq_lane_u32(s_e, pad1, 0), pad2,
+                   pad3);
+    acc_abcd = veorq_u32(acc_abcd, abcd);
+    acc_e ^= e;
+  }
+
+  vst1q_u32(u, acc_abcd);
+  u[4] = acc_e;
+}
+
+#define SHA256_ARM_ROUNDS(w, k)                                                \
+  wk = vaddq_u32(w, vld1q_u32(&sha256_k[k]));                                  \
+  abcd_prev = abcd;                                                            \
+  abcd = vsha256hq_u32(abcd, efgh, wk);                                        \
+  efgh = vsha256h2q_u32(efgh, abcd_prev, wk)
+
+#define SHA256_ARM_SCHEDULE(w, w1, w2, w3)                                     \
+  w = vsha256su1q_u32(vsha256su0q_u32(w, w1), w2, w3)
+
+static inline void sha256_arm_block(uint32x4_t *state_abcd,
+                                    uint32x4_t *state_efgh, uint32x4_t m0,
+                                    uint32x4_t m1, uint32x4_t m2,
+                                    uint32x4_t m3) {
+  uint32x4_t abcd = *state_abcd, efgh = *state_efgh, abcd_prev, wk;
+
+  SHA256_ARM_ROUNDS(m0, 0);
+  SHA256_ARM_SCHEDULE(m0, m1, m2, m3);
+  SHA256_ARM_ROUNDS(m1, 4);
+  SHA256_ARM_SCHEDULE(m1, m2, m3, m0);
+  SHA256_ARM_ROUNDS(m2, 8);
+  SHA256_ARM_SCHEDULE(m2, m3, m0, m1);
+  SHA256_ARM_ROUNDS(m3, 12);
+  SHA256_ARM_SCHEDULE(m3, m0, m1, m2);
+  SHA256_ARM_ROUNDS(m0, 16);
+  SHA256_ARM_SCHEDULE(m0, m1, m2, m3);
+  SHA256_ARM_ROUNDS(m1, 20);
+  SHA256_ARM_SCHEDULE(m1, m2, m3, m0);
+  SHA256_ARM_ROUNDS(m2, 24);
+  SHA256_ARM_SCHEDULE(m2, m3, m0, m1);
+  SHA256_ARM_ROUNDS(m3, 28);
+  SHA256_ARM_SCHEDULE(m3, m0, m1, m2);
+  SHA256_ARM_ROUNDS(m0, 32);
+  SHA256_ARM_SCHEDULE(m0, m1, m2, m3);
+  SHA256_ARM_ROUNDS(m1, 36);
+  SHA256_ARM_SCHEDULE(m1, m2, m3, m0);
+  SHA256_ARM_ROUNDS(m2, 40);
+  SHA256_ARM_SCHEDULE(m2, m3, m0, m1);
+  SHA256_ARM_ROUNDS(m3, 44);
+  SHA256_ARM_SCHEDULE(m3, m0, m1, m2);
+  SHA256_ARM_ROUNDS(m0, 48);
+  SHA256_ARM_ROUNDS(m1, 52);
+  SHA256_ARM_ROUNDS(m2, 56);
+  SHA256_ARM_ROUNDS(m3, 60);
+
+  *state_abcd = vaddq_u32(abcd, *state_abcd);
+  *state_efgh = vaddq_u32(efgh, *state_efgh);
+}
+
+static void sha256_arm_iterate(const uint32_t inner[8],
+                               const uint32_t outer[8], uint32_t u[8],
+                               uint32_t n) {
+  static const uint32_t pad2_words[4] = {0x80000000, 0, 0, 0};
+  static const uint32_t pad3_words[4] = {0, 0, 0, SHA256_PAD_BITS};
+  const uint32x4_t inner_abcd = vld1q_u32(inner);
+  const uint32x4_t inner_efgh = vld1q_u32(inner + 4);
+  const uint32x4_t outer_abcd = vld1q_u32(outer);
+  const uint32x4_t outer_efgh = vld1q_u32(outer + 4);
+  const uint32x4_t pad2 = vld1q_u32(pad2_words);
+  const uint32x4_t pad3 = vld1q_u32(pad3_words);
+
+  uint32x4_t abcd = vld1q_u32(u);
+  uint32x4_t efgh = vld1q_u32(u + 4);
+  uint32x4_t acc_abcd = abcd, acc_efgh = efgh;
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint32x4_t s_abcd = inner_abcd, s_efgh = inner_efgh;
+    sha256_arm_block(&s_abcd, &s_efgh, abcd, efgh, pad2, pad3);
+    abcd = outer_abcd;
+    efgh = outer_efgh;
+    sha256_arm_block(&abcd, &efgh, s_abcd, s_efgh, pad2, pad3);
+    acc_abcd = veorq_u32(acc_abcd, abcd);
+    acc_efgh = veorq_u32(acc_efgh, efgh);
+  }
+
+  vst1q_u32(u, acc_abcd);
+  vst1q_u32(u + 4, acc_efgh);
+}
+
+#endif /* FASTPBKDF2_ARM_SHA2 */
+
+
+/* --- Dispatch --- */
+int fastpbkdf2_sha1_hw(const uint32_t inner[5], const uint32_t outer[5],
+                       uint32_t u[5], uint32_t n) {
+  if (!(fastpbkdf2_hw_enabled() & FASTPBKDF2_HW_SHA1))
+    return 0;
+#if defined(FASTPBKDF2_X86_SHANI)
+  sha1_x86_iterate(inner, outer, u, n);
+  return 1;
+#elif defined(FASTPBKDF2_ARM_SHA2)
+  sha1_arm_iterate(inner, outer, u, n);
+  return 1;
+#else
+  (void)inner, (void)outer, (void)u, (void)n;
+  return 0;
+#endif
+}
+
+int fastpbkdf2_sha256_hw(const uint32_t inner[8], const uint32_t outer[8],
+                         uint32_t u[8], uint32_t n) {
+  if (!(fastpbkdf2_hw_enabled() & FASTPBKDF2_HW_SHA256))
+    return 0;
+#if defined(FASTPBKDF2_X86_SHANI)
+  sha256_x86_iterate(inner, outer, u, n);
+  return 1;
+#elif defined(FASTPBKDF2_ARM_SHA2)
+  sha256_arm_iterate(inner, outer, u, n);
+  return 1;
+#else
+  (void)inner, (void)outer, (void)u, (void)n;
+  return 0;
+#endif
+}
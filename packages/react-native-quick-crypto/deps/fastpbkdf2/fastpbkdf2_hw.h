@@ -0,0 +1,28 @@
+/*
+ * Hardware SHA kernels for the fastpbkdf2 iteration loop, see
+ * fastpbkdf2_hw.c and fastpbkdf2_hw_sha512.c. Internal to fastpbkdf2.
+ */
+
+#ifndef FASTPBKDF2_HW_H
+#define FASTPBKDF2_HW_H
+
+#include <stdint.h>
+
+/* Each kernel runs PBKDF2 iterations 2..n+1 of one output block.
+ *
+ * @p inner and @p outer are the HMAC start states (after the key block),
+ * @p u holds U_1 on entry and U_1 ^ U_2 ^ ... ^ U_{n+1} on return.
+ *
+ * Returns 0, leaving @p u untouched, when no kernel for the hash is compiled
+ * in or it has not been enabled with fastpbkdf2_hw_enable(). */
+int fastpbkdf2_sha1_hw(const uint32_t inner[5], const uint32_t outer[5],
+                       uint32_t u[5], uint32_t n);
+int fastpbkdf2_sha256_hw(const uint32_t inner[8], const uint32_t outer[8],
+                         uint32_t u[8], uint32_t n);
+int fastpbkdf2_sha512_hw(const uint64_t inner[8], const uint64_t outer[8],
+                         uint64_t u[8], uint32_t n);
+
+/* FASTPBKDF2_HW_SHA512 if fastpbkdf2_hw_sha512.c was built with SHA512. */
+unsigned fastpbkdf2_hw_sha512_compiled(void);
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * ARMv8.2 SHA512 kernel for the fastpbkdf2 iteration loop, see
+ * fastpbkdf2_hw.c.
+ *
+ * Kept apart from the other kernels because most toolchains only expose the
+ * SHA512 instructions when the whole file is built for them (e.g.
+ * -march=armv8.2-a+sha3, set for arm64-v8a in android/CMakeLists.txt).
+ * Nothing else lives here, so that flag cannot leak ARMv8.2 instructions
+ * into code that runs on older cores: the kernel only runs once
+ * fastpbkdf2_hw_enable() has seen the CPU report SHA512. Without the flag
+ * this file builds to a stub.
+ */
+
+#include "fastpbkdf2.h"
+#include "fastpbkdf2_hw.h"
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_SHA512)
+#define FASTPBKDF2_ARM_SHA512 1
+#include <arm_neon.h>
+#endif
+
+unsigned fastpbkdf2_hw_sha512_compiled(void) {
+#if defined(FASTPBKDF2_ARM_SHA512)
+  return FASTPBKDF2_HW_SHA512;
+#else
+  return 0;
+#endif
+}
+
+#if defined(FASTPBKDF2_ARM_SHA512)
+
+/* The block hashed by iterations 2..c is the previous U followed by SHA
+ * padding for a 128 + 64 byte message, see fastpbkdf2_hw.c. */
+#define SHA512_PAD_BITS ((128 + 64) * 8)
+
+static const uint64_t sha512_k[80] = {
+  0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
+  0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
+  0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
+  0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+  0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+  0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
+  0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
+  0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+  0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
+  0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+  0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
+  0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+  0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
+  0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
+  0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+  0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+  0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
+  0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
+  0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
+  0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+  0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
+  0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
+  0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
+  0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+  0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+  0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
+  0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
+
+/* Two rounds on state pairs ab, cd, ef, gh (i0..i3, lane 0 first); i4
+ * receives the new ef. The caller rotates the five registers, so after
+ * every five calls the state is back in s0..s3. Message pairs m0..m7 are
+ * rescheduled in place for the first 32 double rounds. */
+#define SHA512_DROUND(i0, i1, i2, i3, i4, j, w, w1, w7, w4, w5)                \
+  do {                                                                         \
+    uint64x2_t kw = vaddq_u64(w, vld1q_u64(&sha512_k[2 * (j)]));               \
+    uint64x2_t fg = vextq_u64(i2, i3, 1);                                      \
+    uint64x2_t de = vextq_u64(i1, i2, 1);                                      \
+    i3 = vaddq_u64(i3, vextq_u64(kw, kw, 1));                                  \
+    if ((j) < 32)                                                              \
+      w = vsha512su1q_u64(vsha512su0q_u64(w, w1), w7, vextq_u64(w4, w5, 1));   \
+    i3 = vsha512hq_u64(i3, fg, de);                                            \
+    i4 = vaddq_u64(i1, i3);                                                    \
+    i3 = vsha512h2q_u64(i3, i1, i0);                                           \
+  } while (0)
+
+static inline void sha512_arm_block(uint64x2_t state[4], uint64x2_t m0,
+                                    uint64x2_t m1, uint64x2_t m2,
+                                    uint64x2_t m3, uint64x2_t m4,
+                                    uint64x2_t m5, uint64x2_t m6,
+                                    uint64x2_t m7) {
+  uint64x2_t s0 = state[0], s1 = state[1], s2 = state[2], s3 = state[3], s4;
+
+  SHA512_DROUND(s0, s1, s2, s3, s4, 0, m0, m1, m7, m4, m5);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 1, m1, m2, m0, m5, m6);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 2, m2, m3, m1, m6, m7);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 3, m3, m4, m2, m7, m0);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 4, m4, m5, m3, m0, m1);
+  SHA512_DROUND(s0, s1, s2, s3, s4, 5, m5, m6, m4, m1, m2);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 6, m6, m7, m5, m2, m3);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 7, m7, m0, m6, m3, m4);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 8, m0, m1, m7, m4, m5);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 9, m1, m2, m0, m5, m6);
+  SHA512_DROUND(s0, s1, s2, s3, s4, 10, m2, m3, m1, m6, m7);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 11, m3, m4, m2, m7, m0);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 12, m4, m5, m3, m0, m1);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 13, m5, m6, m4, m1, m2);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 14, m6, m7, m5, m2, m3);
+  SHA512_DROUND(s0, s1, s2, s3, s4, 15, m7, m0, m6, m3, m4);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 16, m0, m1, m7, m4, m5);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 17, m1, m2, m0, m5, m6);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 18, m2, m3, m1, m6, m7);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 19, m3, m4, m2, m7, m0);
+  SHA512_DROUND(s0, s1, s2, s3, s4, 20, m4, m5, m3, m0, m1);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 21, m5, m6, m4, m1, m2);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 22, m6, m7, m5, m2, m3);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 23, m7, m0, m6, m3, m4);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 24, m0, m1, m7, m4, m5);
+  SHA512_DROUND(s0, s1, s2, s3, s4, 25, m1, m2, m0, m5, m6);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 26, m2, m3, m1, m6, m7);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 27, m3, m4, m2, m7, m0);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 28, m4, m5, m3, m0, m1);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 29, m5, m6, m4, m1, m2);
+  SHA512_DROUND(s0, s1, s2, s3, s4, 30, m6, m7, m5, m2, m3);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 31, m7, m0, m6, m3, m4);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 32, m0, m1, m7, m4, m5);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 33, m1, m2, m0, m5, m6);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 34, m2, m3, m1, m6, m7);
+  SHA512_DROUND(s0, s1, s2, s3, s4, 35, m3, m4, m2, m7, m0);
+  SHA512_DROUND(s3, s0, s4, s2, s1, 36, m4, m5, m3, m0, m1);
+  SHA512_DROUND(s2, s3, s1, s4, s0, 37, m5, m6, m4, m1, m2);
+  SHA512_DROUND(s4, s2, s0, s1, s3, 38, m6, m7, m5, m2, m3);
+  SHA512_DROUND(s1, s4, s3, s0, s2, 39, m7, m0, m6, m3, m4);
+
+  state[0] = vaddq_u64(s0, state[0]);
+  state[1] = vaddq_u64(s1, state[1]);
+  state[2] = vaddq_u64(s2, state[2]);
+  state[3] = vaddq_u64(s3, state[3]);
+}
+
+static void sha512_arm_iterate(const uint64_t inner[8],
+                               const uint64_t outer[8], uint64_t u[8],
+                               uint32_t n) {
+  static const uint64_t pad4_words[2] = {UINT64_C(1) << 63, 0};
+  static const uint64_t pad7_words[2] = {0, SHA512_PAD_BITS};
+  const uint64x2_t pad4 = vld1q_u64(pad4_words);
+  const uint64x2_t zero = vdupq_n_u64(0);
+  const uint64x2_t pad7 = vld1q_u64(pad7_words);
+  uint64x2_t inner_state[4], outer_state[4], state[4], s[4], acc[4];
+
+  for (int i = 0; i < 4; i++) {
+    inner_state[i] = vld1q_u64(inner + 2 * i);
+    outer_state[i] = vld1q_u64(outer + 2 * i);
+    state[i] = acc[i] = vld1q_u64(u + 2 * i);
+  }
+
+  for (uint32_t i = 0; i < n; i++) {
+    s[0] = inner_state[0];
+    s[1] = inner_state[1];
+    s[2] = inner_state[2];
+    s[3] = inner_state[3];
+    sha512_arm_block(s, state[0], state[1], state[2], state[3], pad4, zero,
+                     zero, pad7);
+    state[0] = outer_state[0];
+    state[1] = outer_state[1];
+    state[2] = outer_state[2];
+    state[3] = outer_state[3];
+    sha512_arm_block(state, s[0], s[1], s[2], s[3], pad4, zero, zero, pad7);
+    acc[0] = veorq_u64(acc[0], state[0]);
+    acc[1] = veorq_u64(acc[1], state[1]);
+    acc[2] = veorq_u64(acc[2], state[2]);
+    acc[3] = veorq_u64(acc[3], state[3]);
+  }
+
+  for (int i = 0; i < 4; i++) {
+    vst1q_u64(u + 2 * i, acc[i]);
+  }
+}
+
+#endif /* FASTPBKDF2_ARM_SHA512 */
+
+int fastpbkdf2_sha512_hw(const uint64_t inner[8], const uint64_t outer[8],
+                         uint64_t u[8], uint32_t n) {
+  if (!(fastpbkdf2_hw_enabled() & FASTPBKDF2_HW_SHA512))
+    return 0;
+#if defined(FASTPBKDF2_ARM_SHA512)
+  sha512_arm_iterate(inner, outer, u, n);
+  return 1;
+#else
+  (void)inner, (void)outer, (void)u, (void)n;
+  return 0;
+#endif
+}
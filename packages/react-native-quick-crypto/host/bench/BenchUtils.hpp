@@ -0,0 +1,33 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <openssl/rand.h>
+#include <stdexcept>
+
+namespace margelo::nitro::crypto::bench {
+
+using margelo::nitro::ArrayBuffer;
+
+inline std::shared_ptr<ArrayBuffer> randomBuffer(size_t size) {
+  auto buffer = ArrayBuffer::allocate(size);
+  if (size > 0 && RAND_bytes(buffer->data(), static_cast<int>(size)) != 1) {
+    throw std::runtime_error("RAND_bytes failed");
+  }
+  return buffer;
+}
+
+// Payload sizes for throughput benchmarks: 64B, 1KB, 16KB, 256KB, 1MB
+inline void payloadSizes(benchmark::internal::Benchmark* b) {
+  for (int64_t size : {64, 1024, 16 * 1024, 256 * 1024, 1024 * 1024}) {
+    b->Arg(size);
+  }
+}
+
+inline void setThroughput(benchmark::State& state) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+} // namespace margelo::nitro::crypto::bench
@@ -0,0 +1,85 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridCipherFactory.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+struct CipherCase {
+  const char* name;
+  size_t key_length;
+  size_t iv_length;
+  bool aead;
+  bool ccm;
+};
+
+// Every mode HybridCipherFactory dispatches on
+static constexpr CipherCase kCiphers[] = {
+    {"aes-256-ecb", 32, 0, false, false},      {"aes-256-cbc", 32, 16, false, false},
+    {"aes-256-ctr", 32, 16, false, false},     {"aes-256-cfb", 32, 16, false, false},
+    {"aes-256-ofb", 32, 16, false, false},     {"aes-256-xts", 64, 16, false, false},
+    {"aes-128-gcm", 16, 12, true, false},      {"aes-256-gcm", 32, 12, true, false},
+    {"aes-256-ccm", 32, 12, true, true},       {"aes-256-ocb", 32, 12, true, false},
+    {"chacha20", 32, 16, false, false},        {"chacha20-poly1305", 32, 12, true, false},
+#ifdef BLSALLOC_SODIUM
+    {"xsalsa20", 32, 24, false, false},
+#endif
+};
+
+static std::shared_ptr<HybridCipherSpec> createCipher(const CipherCase& c, bool encrypt, const std::shared_ptr<ArrayBuffer>& key,
+                                                      const std::shared_ptr<ArrayBuffer>& iv) {
+  HybridCipherFactory factory;
+  std::optional<double> tagLength = c.aead ? std::optional<double>(16) : std::nullopt;
+  return factory.createCipher(CipherArgs(encrypt, c.name, key, iv, tagLength));
+}
+
+static void BM_Cipher(benchmark::State& state, const CipherCase& c, bool encrypt) {
+  auto key = randomBuffer(c.key_length);
+  auto iv = randomBuffer(c.iv_length);
+  auto aad = randomBuffer(0);
+  auto input = randomBuffer(state.range(0));
+
+  std::shared_ptr<ArrayBuffer> tag;
+  if (!encrypt) {
+    // Decrypt real ciphertext so AEAD modes authenticate successfully
+    auto cipher = createCipher(c, true, key, iv);
+    if (c.ccm) {
+      cipher->setAAD(aad, static_cast<double>(input->size()));
+    }
+    auto head = cipher->update(input, std::nullopt, std::nullopt);
+    auto tail = cipher->final();
+    std::vector<uint8_t> ciphertext(head->data(), head->data() + head->size());
+    ciphertext.insert(ciphertext.end(), tail->data(), tail->data() + tail->size());
+    input = ArrayBuffer::copy(ciphertext);
+    if (c.aead) {
+      tag = cipher->getAuthTag();
+    }
+  }
+
+  for (auto _ : state) {
+    auto cipher = createCipher(c, encrypt, key, iv);
+    if (tag) {
+      cipher->setAuthTag(tag);
+    }
+    if (c.ccm) {
+      cipher->setAAD(aad, static_cast<double>(input->size()));
+    }
+    benchmark::DoNotOptimize(cipher->update(input, std::nullopt, std::nullopt));
+    benchmark::DoNotOptimize(cipher->final());
+  }
+  setThroughput(state);
+}
+
+static const bool registered = [] {
+  for (const auto& c : kCiphers) {
+    for (bool encrypt : {true, false}) {
+      std::string name = std::string("BM_Cipher/") + c.name + (encrypt ? "/encrypt" : "/decrypt");
+      benchmark::RegisterBenchmark(name.c_str(), BM_Cipher, c, encrypt)->Apply(payloadSizes);
+    }
+  }
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
@@ -0,0 +1,115 @@
+// Finite-field Diffie-Hellman lives in the optional `dh` subsystem
+#ifndef RNQC_DISABLE_DH
+
+#include <cstring>
+#include <memory>
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <string>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridDiffieHellman.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+static constexpr const char* kGroups[] = {"modp14", "modp15", "modp16", "ffdhe3072"};
+
+static std::shared_ptr<HybridDiffieHellman> party(const std::string& group) {
+  auto dh = std::make_shared<HybridDiffieHellman>();
+  dh->initGroup(group);
+  dh->generateKeys();
+  return dh;
+}
+
+static void BM_DhGenerateKeys(benchmark::State& state, std::string group) {
+  for (auto _ : state) {
+    auto dh = std::make_shared<HybridDiffieHellman>();
+    dh->initGroup(group);
+    benchmark::DoNotOptimize(dh->generateKeys());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void BM_DhComputeSecret(benchmark::State& state, std::string group) {
+  auto alice = party(group);
+  auto bob = party(group);
+  auto peer = bob->getPublicKey();
+  auto secret = alice->computeSecret(peer);
+  auto expected = bob->computeSecret(alice->getPublicKey());
+  if (secret->size() != expected->size() || std::memcmp(secret->data(), expected->data(), secret->size()) != 0) {
+    state.SkipWithError("shared secrets differ");
+    return;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(alice->computeSecret(peer));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// One call for `range(0)` peers; items are secrets
+static void BM_DhComputeSecrets(benchmark::State& state, std::string group) {
+  auto alice = party(group);
+  std::vector<std::shared_ptr<ArrayBuffer>> peers;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    peers.push_back(party(group)->getPublicKey());
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(alice->computeSecrets(peers));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Baseline: OpenSSL's EVP_PKEY_derive on a named-group key. It checks the
+// peer key with a full y^q exponentiation, which for safe primes adds nothing
+// over the 1 < y < p - 1 range check, and sets up p's Montgomery context
+// again on every derivation
+static void BM_DhEvpDerive(benchmark::State& state, std::string group) {
+  // OpenSSL spells the RFC 3526 groups by size
+  std::string name = group == "modp14" ? "modp_2048" : group == "modp15" ? "modp_3072" : group == "modp16" ? "modp_4096" : group;
+  auto generate = [&name]() {
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new_from_name(nullptr, "DH", nullptr),
+                                                                    EVP_PKEY_CTX_free);
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, name.data(), 0),
+        OSSL_PARAM_construct_end(),
+    };
+    EVP_PKEY* pkey = nullptr;
+    if (EVP_PKEY_keygen_init(ctx.get()) == 1 && EVP_PKEY_CTX_set_params(ctx.get(), params) == 1) {
+      EVP_PKEY_generate(ctx.get(), &pkey);
+    }
+    return std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>(pkey, EVP_PKEY_free);
+  };
+  auto alice = generate();
+  auto bob = generate();
+  if (!alice || !bob) {
+    state.SkipWithError("keygen failed");
+    return;
+  }
+  std::vector<unsigned char> secret(EVP_PKEY_get_size(alice.get()));
+  for (auto _ : state) {
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new(alice.get(), nullptr), EVP_PKEY_CTX_free);
+    size_t length = secret.size();
+    if (EVP_PKEY_derive_init(ctx.get()) != 1 || EVP_PKEY_derive_set_peer(ctx.get(), bob.get()) != 1 ||
+        EVP_PKEY_derive(ctx.get(), secret.data(), &length) != 1) {
+      state.SkipWithError("derive failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static const bool registered = [] {
+  for (const char* group : kGroups) {
+    std::string name = group;
+    benchmark::RegisterBenchmark(("BM_DhGenerateKeys/" + name).c_str(), BM_DhGenerateKeys, name);
+    benchmark::RegisterBenchmark(("BM_DhComputeSecret/" + name).c_str(), BM_DhComputeSecret, name);
+    benchmark::RegisterBenchmark(("BM_DhComputeSecrets/" + name).c_str(), BM_DhComputeSecrets, name)->Arg(16);
+    benchmark::RegisterBenchmark(("BM_DhEvpDerive/" + name).c_str(), BM_DhEvpDerive, name);
+  }
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
+
+#endif // RNQC_DISABLE_DH
@@ -0,0 +1,144 @@
+// ECDH lives in the optional `dh` subsystem
+#ifndef RNQC_DISABLE_DH
+
+#include <cstring>
+#include <memory>
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <string>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridECDH.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+static constexpr const char* kCurves[] = {"prime256v1", "secp384r1", "secp521r1"};
+
+// POINT_CONVERSION_COMPRESSED / POINT_CONVERSION_UNCOMPRESSED
+static constexpr double kCompressed = 2;
+static constexpr double kUncompressed = 4;
+
+// More distinct peers than the per-curve point cache holds, so every parse misses
+static constexpr int kColdPeers = 256;
+
+static std::shared_ptr<HybridECDH> party(const std::string& curve) {
+  auto ecdh = std::make_shared<HybridECDH>();
+  ecdh->setCurve(curve);
+  ecdh->generateKeys();
+  return ecdh;
+}
+
+static void BM_EcdhGenerateKeys(benchmark::State& state, std::string curve) {
+  auto ecdh = std::make_shared<HybridECDH>();
+  ecdh->setCurve(curve);
+  for (auto _ : state) {
+    ecdh->generateKeys();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// range(0): peer key format; range(1): distinct peers cycled through
+static void BM_EcdhComputeSecret(benchmark::State& state, std::string curve) {
+  auto alice = party(curve);
+  std::vector<std::shared_ptr<ArrayBuffer>> peers;
+  for (int64_t i = 0; i < state.range(1); i++) {
+    auto bob = party(curve);
+    peers.push_back(bob->getPublicKey(static_cast<double>(state.range(0))));
+    if (i == 0) {
+      auto secret = alice->computeSecret(peers[0]);
+      auto expected = bob->computeSecret(alice->getPublicKey(kUncompressed));
+      if (secret->size() != expected->size() || std::memcmp(secret->data(), expected->data(), secret->size()) != 0) {
+        state.SkipWithError("shared secrets differ");
+        return;
+      }
+    }
+  }
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(alice->computeSecret(peers[next]));
+    next = (next + 1) % peers.size();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// One call for `range(0)` peers; items are secrets
+static void BM_EcdhComputeSecrets(benchmark::State& state, std::string curve) {
+  auto alice = party(curve);
+  std::vector<std::shared_ptr<ArrayBuffer>> peers;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    peers.push_back(party(curve)->getPublicKey(kUncompressed));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(alice->computeSecrets(peers));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Decompression of `range(0)` distinct compressed keys per call; items are keys
+static void BM_EcdhConvertKeys(benchmark::State& state, std::string curve) {
+  auto ecdh = std::make_shared<HybridECDH>();
+  std::vector<std::shared_ptr<ArrayBuffer>> keys;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    keys.push_back(party(curve)->getPublicKey(kCompressed));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ecdh->convertKeys(curve, keys, kUncompressed));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Baseline: what a generic path does per secret, importing the peer's raw
+// point into an EVP_PKEY and deriving through an EVP_PKEY_CTX
+static void BM_EcdhEvpDerive(benchmark::State& state, std::string curve) {
+  std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> alice(EVP_EC_gen(curve.c_str()), EVP_PKEY_free);
+  auto peer = party(curve)->getPublicKey(kUncompressed);
+  if (!alice) {
+    state.SkipWithError("keygen failed");
+    return;
+  }
+  std::vector<unsigned char> secret(EVP_PKEY_get_size(alice.get()));
+  for (auto _ : state) {
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, curve.data(), 0),
+        OSSL_PARAM_construct_octet_string(OSSL_PKEY_PARAM_PUB_KEY, peer->data(), peer->size()),
+        OSSL_PARAM_construct_end(),
+    };
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> import(EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr),
+                                                                       EVP_PKEY_CTX_free);
+    EVP_PKEY* raw = nullptr;
+    if (EVP_PKEY_fromdata_init(import.get()) != 1 || EVP_PKEY_fromdata(import.get(), &raw, EVP_PKEY_PUBLIC_KEY, params) != 1) {
+      state.SkipWithError("import failed");
+      break;
+    }
+    std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> bob(raw, EVP_PKEY_free);
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new(alice.get(), nullptr), EVP_PKEY_CTX_free);
+    size_t length = secret.size();
+    if (EVP_PKEY_derive_init(ctx.get()) != 1 || EVP_PKEY_derive_set_peer(ctx.get(), bob.get()) != 1 ||
+        EVP_PKEY_derive(ctx.get(), secret.data(), &length) != 1) {
+      state.SkipWithError("derive failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static const bool registered = [] {
+  for (const char* curve : kCurves) {
+    std::string name = curve;
+    benchmark::RegisterBenchmark(("BM_EcdhGenerateKeys/" + name).c_str(), BM_EcdhGenerateKeys, name);
+    benchmark::RegisterBenchmark(("BM_EcdhComputeSecret/" + name).c_str(), BM_EcdhComputeSecret, name)
+        ->ArgNames({"format", "peers"})
+        ->Args({static_cast<int64_t>(kUncompressed), 1})
+        ->Args({static_cast<int64_t>(kCompressed), 1})
+        ->Args({static_cast<int64_t>(kCompressed), kColdPeers});
+    benchmark::RegisterBenchmark(("BM_EcdhComputeSecrets/" + name).c_str(), BM_EcdhComputeSecrets, name)->Arg(16);
+    benchmark::RegisterBenchmark(("BM_EcdhConvertKeys/" + name).c_str(), BM_EcdhConvertKeys, name)->Arg(kColdPeers);
+    benchmark::RegisterBenchmark(("BM_EcdhEvpDerive/" + name).c_str(), BM_EcdhEvpDerive, name);
+  }
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
+
+#endif // RNQC_DISABLE_DH
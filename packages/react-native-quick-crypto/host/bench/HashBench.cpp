@@ -0,0 +1,60 @@
+#include <memory>
+#include <string>
+
+#include "BenchUtils.hpp"
+#ifndef RNQC_DISABLE_BLAKE3
+#include "HybridBlake3.hpp"
+#endif
+#include "HybridHash.hpp"
+#include "HybridHmac.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+static void BM_Hash(benchmark::State& state, const std::string& algorithm) {
+  auto data = randomBuffer(state.range(0));
+  for (auto _ : state) {
+    auto hash = std::make_shared<HybridHash>();
+    hash->createHash(algorithm, std::nullopt);
+    hash->update(data, std::nullopt, std::nullopt);
+    benchmark::DoNotOptimize(hash->digest());
+  }
+  setThroughput(state);
+}
+
+#ifndef RNQC_DISABLE_BLAKE3
+static void BM_Blake3(benchmark::State& state) {
+  auto data = randomBuffer(state.range(0));
+  for (auto _ : state) {
+    auto hash = std::make_shared<HybridBlake3>();
+    hash->initHash();
+    hash->update(data, std::nullopt, std::nullopt);
+    benchmark::DoNotOptimize(hash->digest(std::nullopt));
+  }
+  setThroughput(state);
+}
+BENCHMARK(BM_Blake3)->Apply(payloadSizes);
+#endif
+
+static void BM_Hmac(benchmark::State& state, const std::string& algorithm) {
+  auto key = randomBuffer(32);
+  auto data = randomBuffer(state.range(0));
+  for (auto _ : state) {
+    auto hmac = std::make_shared<HybridHmac>();
+    hmac->createHmac(algorithm, key);
+    hmac->update(data, std::nullopt, std::nullopt);
+    benchmark::DoNotOptimize(hmac->digest());
+  }
+  setThroughput(state);
+}
+
+static const bool registered = [] {
+  for (const char* algorithm : {"md5", "sha1", "sha256", "sha512", "sha3-256"}) {
+    benchmark::RegisterBenchmark((std::string("BM_Hash/") + algorithm).c_str(), BM_Hash, algorithm)->Apply(payloadSizes);
+  }
+  for (const char* algorithm : {"sha1", "sha256", "sha512"}) {
+    benchmark::RegisterBenchmark((std::string("BM_Hmac/") + algorithm).c_str(), BM_Hmac, algorithm)->Apply(payloadSizes);
+  }
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
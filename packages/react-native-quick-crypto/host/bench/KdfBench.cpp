@@ -0,0 +1,107 @@
+#include <memory>
+#include <string>
+
+#include "BenchUtils.hpp"
+#ifndef RNQC_DISABLE_HKDF
+#include "HybridHkdf.hpp"
+#endif
+#ifndef RNQC_DISABLE_PBKDF2
+#include "HybridPbkdf2.hpp"
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
+#include "HybridScrypt.hpp"
+#endif
+
+namespace margelo::nitro::crypto::bench {
+
+#ifndef RNQC_DISABLE_PBKDF2
+// range(0) is the iteration count
+static void BM_Pbkdf2(benchmark::State& state, const std::string& digest) {
+  auto password = randomBuffer(16);
+  auto salt = randomBuffer(16);
+  auto pbkdf2 = std::make_shared<HybridPbkdf2>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pbkdf2->pbkdf2Sync(password, salt, static_cast<double>(state.range(0)), 32, digest));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+  // which fastpbkdf2 loop ran; other digests go through OpenSSL
+  unsigned kernel = digest == "sha1" ? FASTPBKDF2_HW_SHA1 : digest == "sha256" ? FASTPBKDF2_HW_SHA256 : FASTPBKDF2_HW_SHA512;
+  if (digest == "sha1" || digest == "sha256" || digest == "sha512") {
+    state.SetLabel(fastpbkdf2_hw_enabled() & kernel ? "hardware" : "portable");
+  }
+}
+
+// BM_Pbkdf2 with fastpbkdf2's hardware kernels switched off: the
+// SHAx_Transform loop every CPU without the extensions runs
+static void BM_Pbkdf2Portable(benchmark::State& state, const std::string& digest) {
+  useFastPbkdf2Kernels();
+  unsigned selected = fastpbkdf2_hw_enabled();
+  fastpbkdf2_hw_enable(0);
+  BM_Pbkdf2(state, digest);
+  fastpbkdf2_hw_enable(selected);
+}
+
+// Same work through Promise::async and the worker pool
+static void BM_Pbkdf2Async(benchmark::State& state) {
+  auto password = randomBuffer(16);
+  auto salt = randomBuffer(16);
+  auto pbkdf2 = std::make_shared<HybridPbkdf2>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pbkdf2->pbkdf2(password, salt, static_cast<double>(state.range(0)), 32, "sha256")->await().get());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Pbkdf2Async)->Arg(1000)->Arg(100000)->UseRealTime();
+#endif
+
+#ifndef RNQC_DISABLE_HKDF
+// range(0) is the output length
+static void BM_Hkdf(benchmark::State& state, const std::string& digest) {
+  auto key = randomBuffer(32);
+  auto salt = randomBuffer(16);
+  auto info = randomBuffer(16);
+  auto hkdf = std::make_shared<HybridHkdf>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hkdf->deriveKeySync(digest, key, salt, info, static_cast<double>(state.range(0))));
+  }
+  setThroughput(state);
+}
+#endif
+
+#ifndef RNQC_DISABLE_SCRYPT
+// range(0) is N, with r = 8, p = 1
+static void BM_Scrypt(benchmark::State& state) {
+  auto password = randomBuffer(16);
+  auto salt = randomBuffer(16);
+  auto scrypt = std::make_shared<HybridScrypt>();
+  double N = static_cast<double>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scrypt->deriveKeySync(password, salt, N, 8, 1, 256.0 * 1024 * 1024, 64));
+  }
+}
+BENCHMARK(BM_Scrypt)->Arg(1 << 10)->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+#endif
+
+static const bool registered = [] {
+#ifndef RNQC_DISABLE_PBKDF2
+  for (const char* digest : {"sha1", "sha256", "sha512", "sha3-256"}) {
+    benchmark::RegisterBenchmark((std::string("BM_Pbkdf2/") + digest).c_str(), BM_Pbkdf2, digest)
+        ->Arg(1000)
+        ->Arg(100000)
+        ->Unit(benchmark::kMillisecond);
+  }
+  for (const char* digest : {"sha1", "sha256", "sha512"}) {
+    benchmark::RegisterBenchmark((std::string("BM_Pbkdf2Portable/") + digest).c_str(), BM_Pbkdf2Portable, digest)
+        ->Arg(100000)
+        ->Unit(benchmark::kMillisecond);
+  }
+#endif
+#ifndef RNQC_DISABLE_HKDF
+  for (const char* digest : {"sha256", "sha512"}) {
+    benchmark::RegisterBenchmark((std::string("BM_Hkdf/") + digest).c_str(), BM_Hkdf, digest)->Arg(32)->Arg(1024)->Arg(8160);
+  }
+#endif
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
@@ -0,0 +1,94 @@
+// KeyRotation lives in the optional `pagecipher` subsystem
+#ifndef RNQC_DISABLE_PAGECIPHER
+
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridCipherFactory.hpp"
+#include "HybridKeyRotation.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+static constexpr size_t kNonceSize = 12;
+static constexpr size_t kTagSize = 16;
+
+static std::shared_ptr<HybridCipherSpec> createGcm(bool encrypt, const std::shared_ptr<ArrayBuffer>& key,
+                                                   const std::shared_ptr<ArrayBuffer>& nonce) {
+  HybridCipherFactory factory;
+  return factory.createCipher(CipherArgs(encrypt, "aes-256-gcm", key, nonce, 16));
+}
+
+// nonce || ciphertext || tag, as stored by the caller
+static std::shared_ptr<ArrayBuffer> seal(const std::shared_ptr<ArrayBuffer>& key, size_t size) {
+  auto nonce = randomBuffer(kNonceSize);
+  auto cipher = createGcm(true, key, nonce);
+  auto body = cipher->update(randomBuffer(size), std::nullopt, std::nullopt);
+  cipher->final();
+  auto tag = cipher->getAuthTag();
+  std::vector<uint8_t> record(nonce->data(), nonce->data() + kNonceSize);
+  record.insert(record.end(), body->data(), body->data() + body->size());
+  record.insert(record.end(), tag->data(), tag->data() + tag->size());
+  return ArrayBuffer::copy(record);
+}
+
+static std::vector<std::shared_ptr<ArrayBuffer>> records(const std::shared_ptr<ArrayBuffer>& key, int64_t count, int64_t size) {
+  std::vector<std::shared_ptr<ArrayBuffer>> out;
+  for (int64_t i = 0; i < count; i++) {
+    out.push_back(seal(key, static_cast<size_t>(size)));
+  }
+  return out;
+}
+
+static std::shared_ptr<ArrayBuffer> slice(const std::shared_ptr<ArrayBuffer>& buffer, size_t offset, size_t length) {
+  return ArrayBuffer::copy(buffer->data() + offset, length);
+}
+
+// Baseline: decipher + cipher objects per record, plaintext handed back to the caller in between.
+// range(0): records, range(1): record payload size
+static void BM_ReencryptPerRecord(benchmark::State& state) {
+  auto oldKey = randomBuffer(32);
+  auto newKey = randomBuffer(32);
+  auto batch = records(oldKey, state.range(0), state.range(1));
+  for (auto _ : state) {
+    for (const auto& record : batch) {
+      size_t size = record->size() - kNonceSize - kTagSize;
+      auto decipher = createGcm(false, oldKey, slice(record, 0, kNonceSize));
+      decipher->setAuthTag(slice(record, kNonceSize + size, kTagSize));
+      auto plaintext = decipher->update(slice(record, kNonceSize, size), std::nullopt, std::nullopt);
+      decipher->final();
+      auto cipher = createGcm(true, newKey, randomBuffer(kNonceSize));
+      benchmark::DoNotOptimize(cipher->update(plaintext, std::nullopt, std::nullopt));
+      cipher->final();
+      benchmark::DoNotOptimize(cipher->getAuthTag());
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(1));
+}
+
+// range(2): parallelism
+static void BM_ReencryptBatch(benchmark::State& state) {
+  auto oldKey = randomBuffer(32);
+  auto batch = records(oldKey, state.range(0), state.range(1));
+  auto rotation = std::make_shared<HybridKeyRotation>();
+  rotation->init(KeyRotationArgs("aes-256-gcm", std::nullopt, oldKey, randomBuffer(32), std::nullopt, 0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation->reencryptBatch(batch, std::nullopt, static_cast<double>(state.range(2))));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(1));
+}
+
+static const bool registered = [] {
+  benchmark::RegisterBenchmark("BM_ReencryptPerRecord", BM_ReencryptPerRecord)->Args({1000, 256});
+  benchmark::RegisterBenchmark("BM_ReencryptBatch", BM_ReencryptBatch)->Args({1000, 256, 1})->Args({1000, 256, 4})->UseRealTime();
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
+
+#endif // RNQC_DISABLE_PAGECIPHER
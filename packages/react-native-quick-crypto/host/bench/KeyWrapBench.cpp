@@ -0,0 +1,90 @@
+// KeyWrap lives in the optional `keys` subsystem
+#ifndef RNQC_DISABLE_KEYS
+
+#include <memory>
+#include <openssl/evp.h>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridKeyObjectHandle.hpp"
+#include "HybridKeyWrap.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+static std::shared_ptr<HybridKeyObjectHandleSpec> secretKey(size_t size) {
+  auto handle = std::make_shared<HybridKeyObjectHandle>();
+  handle->init(KeyType::SECRET, randomBuffer(size), std::nullopt, std::nullopt, std::nullopt);
+  return handle;
+}
+
+static std::vector<std::shared_ptr<ArrayBuffer>> wrappedDeks(const std::shared_ptr<HybridKeyObjectHandleSpec>& kek, int64_t count) {
+  std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>> deks;
+  for (int64_t i = 0; i < count; i++) {
+    deks.push_back(secretKey(32));
+  }
+  auto wrap = std::make_shared<HybridKeyWrap>();
+  wrap->init(kek, false, 0);
+  return wrap->wrapKeys(deks);
+}
+
+// Baseline: an AES-256-WRAP context set up per key, as a cipher object per DEK would.
+// range(0): wrapped 32-byte DEKs
+static void BM_UnwrapFreshContext(benchmark::State& state) {
+  auto kek = randomBuffer(32);
+  auto kekHandle = std::make_shared<HybridKeyObjectHandle>();
+  kekHandle->init(KeyType::SECRET, kek, std::nullopt, std::nullopt, std::nullopt);
+  auto wrapped = wrappedDeks(kekHandle, state.range(0));
+  EVP_CIPHER* cipher = EVP_CIPHER_fetch(nullptr, "AES-256-WRAP", nullptr);
+  uint8_t out[40];
+  for (auto _ : state) {
+    for (const auto& key : wrapped) {
+      EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+      EVP_CIPHER_CTX_set_flags(ctx, EVP_CIPHER_CTX_FLAG_WRAP_ALLOW);
+      EVP_DecryptInit_ex(ctx, cipher, nullptr, kek->data(), nullptr);
+      int len = 0;
+      int final_len = 0;
+      EVP_DecryptUpdate(ctx, out, &len, key->data(), static_cast<int>(key->size()));
+      EVP_DecryptFinal_ex(ctx, out + len, &final_len);
+      benchmark::DoNotOptimize(out);
+      EVP_CIPHER_CTX_free(ctx);
+    }
+  }
+  EVP_CIPHER_free(cipher);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// range(1): cache size; 0 unwraps every time, otherwise every key after the first pass is a hit
+static void BM_UnwrapBatch(benchmark::State& state) {
+  auto kek = secretKey(32);
+  auto wrapped = wrappedDeks(kek, state.range(0));
+  auto wrap = std::make_shared<HybridKeyWrap>();
+  wrap->init(kek, false, static_cast<double>(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(wrap->unwrapKeys(wrapped));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_WrapBatch(benchmark::State& state) {
+  auto wrap = std::make_shared<HybridKeyWrap>();
+  wrap->init(secretKey(32), false, 0);
+  std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>> deks;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    deks.push_back(secretKey(32));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(wrap->wrapKeys(deks));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static const bool registered = [] {
+  benchmark::RegisterBenchmark("BM_UnwrapFreshContext", BM_UnwrapFreshContext)->Arg(500);
+  benchmark::RegisterBenchmark("BM_UnwrapBatch", BM_UnwrapBatch)->Args({500, 0})->Args({500, 1000});
+  benchmark::RegisterBenchmark("BM_WrapBatch", BM_WrapBatch)->Arg(500);
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
+
+#endif // RNQC_DISABLE_KEYS
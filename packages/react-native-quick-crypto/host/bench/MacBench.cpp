@@ -0,0 +1,121 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridHmac.hpp"
+#include "HybridMac.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+struct MacCase {
+  const char* name;
+  const char* algorithm;
+  size_t keyLength;
+  std::optional<std::string> digest;
+  std::optional<std::string> cipher;
+  std::optional<double> outputLength;
+};
+
+// Poly1305 is left out: its keys are one-time, so there is nothing to reuse
+static const MacCase kCases[] = {
+    {"HMAC-SHA256", "HMAC", 32, "SHA256", std::nullopt, std::nullopt},
+    {"CMAC-AES128", "CMAC", 16, std::nullopt, "AES-128-CBC", std::nullopt},
+    {"KMAC-256", "KMAC-256", 32, std::nullopt, std::nullopt, 32},
+    {"SIPHASH", "SIPHASH", 16, std::nullopt, std::nullopt, 8},
+    {"BLAKE2BMAC", "BLAKE2BMAC", 32, std::nullopt, std::nullopt, 32},
+};
+
+static MacArgs macArgs(const MacCase& c) {
+  return MacArgs(c.algorithm, randomBuffer(c.keyLength), c.digest, c.cipher, std::nullopt, std::nullopt, std::nullopt,
+                 c.outputLength);
+}
+
+// range(0): message size. One tag per iteration on a Mac keyed once
+static void BM_MacCompute(benchmark::State& state, MacCase c) {
+  auto mac = std::make_shared<HybridMac>();
+  mac->init(macArgs(c));
+  auto message = randomBuffer(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mac->compute(message, std::nullopt));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Baseline: a new Mac per message, as with createHmac() per packet
+static void BM_MacFreshKey(benchmark::State& state, MacCase c) {
+  auto args = macArgs(c);
+  auto message = randomBuffer(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto mac = std::make_shared<HybridMac>();
+    mac->init(args);
+    mac->update(message, std::nullopt, std::nullopt);
+    benchmark::DoNotOptimize(mac->digest());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// 16 messages of range(0) bytes per call; items are tags
+static void BM_MacComputeMany(benchmark::State& state, MacCase c) {
+  auto mac = std::make_shared<HybridMac>();
+  mac->init(macArgs(c));
+  std::vector<std::shared_ptr<ArrayBuffer>> messages(16, randomBuffer(static_cast<size_t>(state.range(0))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mac->computeMany(messages, std::nullopt));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 16);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * 16 * state.range(0));
+}
+
+// Blind-index shaped work: range(0) short field values, HMAC-SHA256
+// truncated to 16 bytes. Items are tags
+static std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>> fieldValues(int64_t count) {
+  std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>> values;
+  for (int64_t i = 0; i < count; i++) {
+    values.emplace_back("user-" + std::to_string(i) + "@example.com");
+  }
+  return values;
+}
+
+// Baseline: one Hmac object per value, as createHmac() in a loop
+static void BM_HmacPerMessage(benchmark::State& state) {
+  auto key = randomBuffer(32);
+  auto values = fieldValues(state.range(0));
+  for (auto _ : state) {
+    for (const auto& value : values) {
+      auto hmac = std::make_shared<HybridHmac>();
+      hmac->createHmac("SHA256", key);
+      hmac->update(value, std::nullopt, std::nullopt);
+      benchmark::DoNotOptimize(hmac->digest());
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_HmacMany(benchmark::State& state) {
+  auto hmac = std::make_shared<HybridHmac>();
+  auto key = randomBuffer(32);
+  auto values = fieldValues(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hmac->hmacMany("SHA256", key, values, 16));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static const bool registered = [] {
+  benchmark::RegisterBenchmark("BM_HmacPerMessage", BM_HmacPerMessage)->Arg(1000);
+  benchmark::RegisterBenchmark("BM_HmacMany", BM_HmacMany)->Arg(16)->Arg(1000)->Arg(10000)->UseRealTime();
+  for (const MacCase& c : kCases) {
+    std::string name = c.name;
+    benchmark::RegisterBenchmark(("BM_MacCompute/" + name).c_str(), BM_MacCompute, c)->Arg(64)->Arg(1024);
+    benchmark::RegisterBenchmark(("BM_MacFreshKey/" + name).c_str(), BM_MacFreshKey, c)->Arg(64)->Arg(1024);
+    benchmark::RegisterBenchmark(("BM_MacComputeMany/" + name).c_str(), BM_MacComputeMany, c)->Arg(64);
+  }
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
@@ -0,0 +1,107 @@
+// NoiseHandshake lives in the optional `noise` subsystem
+#ifndef RNQC_DISABLE_NOISE
+
+#include <memory>
+#include <openssl/evp.h>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridNoiseHandshake.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+static void handshakeXX(std::shared_ptr<HybridNoiseHandshake>& initiator, std::shared_ptr<HybridNoiseHandshake>& responder) {
+  static const std::string name = "Noise_XX_25519_ChaChaPoly_BLAKE2s";
+  auto initiatorKeys = initiator->generateKeyPair("25519");
+  auto responderKeys = responder->generateKeyPair("25519");
+  initiator->init(NoiseHandshakeArgs(name, true, std::nullopt, initiatorKeys[0], std::nullopt, std::nullopt));
+  responder->init(NoiseHandshakeArgs(name, false, std::nullopt, responderKeys[0], std::nullopt, std::nullopt));
+  auto empty = ArrayBuffer::allocate(0);
+  responder->readMessage(initiator->writeMessage(empty));
+  initiator->readMessage(responder->writeMessage(empty));
+  responder->readMessage(initiator->writeMessage(empty));
+}
+
+static std::shared_ptr<HybridNoiseTransportSpec> sendingTransport() {
+  auto initiator = std::make_shared<HybridNoiseHandshake>();
+  auto responder = std::make_shared<HybridNoiseHandshake>();
+  handshakeXX(initiator, responder);
+  return initiator->split();
+}
+
+static std::vector<std::shared_ptr<ArrayBuffer>> messages(int64_t count, size_t size) {
+  std::vector<std::shared_ptr<ArrayBuffer>> out;
+  for (int64_t i = 0; i < count; i++) {
+    out.push_back(randomBuffer(size));
+  }
+  return out;
+}
+
+static void BM_NoiseHandshakeXX(benchmark::State& state) {
+  for (auto _ : state) {
+    auto initiator = std::make_shared<HybridNoiseHandshake>();
+    auto responder = std::make_shared<HybridNoiseHandshake>();
+    handshakeXX(initiator, responder);
+    benchmark::DoNotOptimize(initiator->split());
+  }
+}
+
+// Baseline: a cipher context created and keyed for every message, as a
+// transport built on createCipheriv would do.
+// range(0): messages, range(1): message size
+static void BM_NoiseTransportFreshCipher(benchmark::State& state) {
+  auto key = randomBuffer(32);
+  auto inputs = messages(state.range(0), static_cast<size_t>(state.range(1)));
+  uint64_t nonce = 0;
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      uint8_t iv[12] = {};
+      for (size_t i = 0; i < 8; i++) {
+        iv[4 + i] = static_cast<uint8_t>(nonce >> (8 * i));
+      }
+      nonce++;
+      auto out = std::make_unique<uint8_t[]>(input->size() + 16);
+      EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+      int length = 0;
+      EVP_EncryptInit_ex(ctx, EVP_chacha20_poly1305(), nullptr, key->data(), iv);
+      EVP_EncryptUpdate(ctx, out.get(), &length, input->data(), static_cast<int>(input->size()));
+      EVP_EncryptFinal_ex(ctx, out.get() + length, &length);
+      EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, out.get() + input->size());
+      EVP_CIPHER_CTX_free(ctx);
+      benchmark::DoNotOptimize(out.get());
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_NoiseTransportEncrypt(benchmark::State& state) {
+  auto transport = sendingTransport();
+  auto inputs = messages(state.range(0), static_cast<size_t>(state.range(1)));
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(transport->encrypt(input, std::nullopt));
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_NoiseTransportEncryptMany(benchmark::State& state) {
+  auto transport = sendingTransport();
+  auto inputs = messages(state.range(0), static_cast<size_t>(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(transport->encryptMany(inputs));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static const bool registered = [] {
+  benchmark::RegisterBenchmark("BM_NoiseHandshakeXX", BM_NoiseHandshakeXX);
+  benchmark::RegisterBenchmark("BM_NoiseTransportFreshCipher", BM_NoiseTransportFreshCipher)->Args({256, 64})->Args({256, 1024});
+  benchmark::RegisterBenchmark("BM_NoiseTransportEncrypt", BM_NoiseTransportEncrypt)->Args({256, 64})->Args({256, 1024});
+  benchmark::RegisterBenchmark("BM_NoiseTransportEncryptMany", BM_NoiseTransportEncryptMany)->Args({256, 64})->Args({256, 1024});
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
+
+#endif // RNQC_DISABLE_NOISE
@@ -0,0 +1,101 @@
+// Oprf lives in the optional `oprf` subsystem
+#ifndef RNQC_DISABLE_OPRF
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchUtils.hpp"
+#include "HybridOprf.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+static std::vector<std::shared_ptr<ArrayBuffer>> contacts(int64_t count) {
+  std::vector<std::shared_ptr<ArrayBuffer>> inputs;
+  for (int64_t i = 0; i < count; i++) {
+    std::string number = "+1555" + std::to_string(1000000 + i);
+    inputs.push_back(ArrayBuffer::copy(reinterpret_cast<const uint8_t*>(number.data()), number.size()));
+  }
+  return inputs;
+}
+
+static std::shared_ptr<HybridOprf> createOprf(bool verifiable) {
+  auto oprf = std::make_shared<HybridOprf>();
+  oprf->init("P256-SHA256", verifiable);
+  return oprf;
+}
+
+// One native call per contact for each step, as a per-element API would. Both
+// forms do the same curve work per contact, so this and BM_OprfClientBatch
+// land within run-to-run noise of each other; batching only saves calls.
+// range(0): contacts
+static void BM_OprfClientPerContact(benchmark::State& state) {
+  auto oprf = createOprf(false);
+  auto key = oprf->randomScalars(1).front();
+  auto inputs = contacts(state.range(0));
+  auto blinds = oprf->randomScalars(static_cast<double>(inputs.size()));
+  auto evaluated = oprf->blindEvaluate(key, oprf->blind(inputs, blinds));
+  for (auto _ : state) {
+    for (size_t i = 0; i < inputs.size(); i++) {
+      benchmark::DoNotOptimize(oprf->blind({inputs[i]}, {blinds[i]}));
+      benchmark::DoNotOptimize(oprf->finalize({inputs[i]}, {blinds[i]}, {evaluated[i]}));
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_OprfClientBatch(benchmark::State& state) {
+  auto oprf = createOprf(false);
+  auto key = oprf->randomScalars(1).front();
+  auto inputs = contacts(state.range(0));
+  auto blinds = oprf->randomScalars(static_cast<double>(inputs.size()));
+  auto evaluated = oprf->blindEvaluate(key, oprf->blind(inputs, blinds));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(oprf->blind(inputs, blinds));
+    benchmark::DoNotOptimize(oprf->finalize(inputs, blinds, evaluated));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Baseline: a DLEQ proof per element, checked one by one
+static void BM_VoprfVerifyPerElement(benchmark::State& state) {
+  auto oprf = createOprf(true);
+  auto keys = oprf->deriveKeyPair(randomBuffer(32), randomBuffer(8));
+  auto blinded = oprf->blind(contacts(state.range(0)), oprf->randomScalars(static_cast<double>(state.range(0))));
+  auto evaluated = oprf->blindEvaluate(keys[0], blinded);
+  std::vector<std::shared_ptr<ArrayBuffer>> proofs;
+  for (size_t i = 0; i < blinded.size(); i++) {
+    proofs.push_back(oprf->generateProof(keys[0], {blinded[i]}, {evaluated[i]}, std::nullopt));
+  }
+  for (auto _ : state) {
+    for (size_t i = 0; i < blinded.size(); i++) {
+      benchmark::DoNotOptimize(oprf->verifyProof(keys[1], {blinded[i]}, {evaluated[i]}, proofs[i]));
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// One batched proof; its composites are multi-scalar multiplications
+static void BM_VoprfVerifyBatch(benchmark::State& state) {
+  auto oprf = createOprf(true);
+  auto keys = oprf->deriveKeyPair(randomBuffer(32), randomBuffer(8));
+  auto blinded = oprf->blind(contacts(state.range(0)), oprf->randomScalars(static_cast<double>(state.range(0))));
+  auto evaluated = oprf->blindEvaluate(keys[0], blinded);
+  auto proof = oprf->generateProof(keys[0], blinded, evaluated, std::nullopt);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(oprf->verifyProof(keys[1], blinded, evaluated, proof));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static const bool registered = [] {
+  benchmark::RegisterBenchmark("BM_OprfClientPerContact", BM_OprfClientPerContact)->Arg(200);
+  benchmark::RegisterBenchmark("BM_OprfClientBatch", BM_OprfClientBatch)->Arg(200);
+  benchmark::RegisterBenchmark("BM_VoprfVerifyPerElement", BM_VoprfVerifyPerElement)->Arg(200);
+  benchmark::RegisterBenchmark("BM_VoprfVerifyBatch", BM_VoprfVerifyBatch)->Arg(200);
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
+
+#endif // RNQC_DISABLE_OPRF
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "BenchUtils.hpp"
+#include "HybridCipherFactory.hpp"
+#include "HybridHash.hpp"
+#ifndef RNQC_DISABLE_HKDF
+#include "HybridHkdf.hpp"
+#endif
+#include "HybridHmac.hpp"
+
+// Many small operations on 1..N threads at once, as concurrent async jobs on
+// the worker pool would run them. Per-operation setup (algorithm fetch,
+// context creation) dominates at this size. The 1-thread rows measure that
+// per-op cost; how it behaves across thread counts can only be read off a
+// multi-core host. On one core the threads just take turns, so flat items/s
+// across thread counts is the expected result there.
+//
+//   quickcrypto_bench --benchmark_filter=BM_Parallel
+namespace margelo::nitro::crypto::bench {
+
+static constexpr int64_t kMessageSize = 64;
+
+static void threadCounts(benchmark::internal::Benchmark* b) {
+  int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  b->ThreadRange(1, std::max(cores, 4))->UseRealTime();
+}
+
+static void BM_ParallelHash(benchmark::State& state) {
+  auto data = randomBuffer(kMessageSize);
+  for (auto _ : state) {
+    auto hash = std::make_shared<HybridHash>();
+    hash->createHash("sha256", std::nullopt);
+    hash->update(data, std::nullopt, std::nullopt);
+    benchmark::DoNotOptimize(hash->digest());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParallelHash)->Apply(threadCounts);
+
+static void BM_ParallelHmac(benchmark::State& state) {
+  auto key = randomBuffer(32);
+  auto data = randomBuffer(kMessageSize);
+  for (auto _ : state) {
+    auto hmac = std::make_shared<HybridHmac>();
+    hmac->createHmac("sha256", key);
+    hmac->update(data, std::nullopt, std::nullopt);
+    benchmark::DoNotOptimize(hmac->digest());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParallelHmac)->Apply(threadCounts);
+
+static void BM_ParallelCipher(benchmark::State& state) {
+  auto key = randomBuffer(32);
+  auto iv = randomBuffer(12);
+  auto data = randomBuffer(kMessageSize);
+  HybridCipherFactory factory;
+  for (auto _ : state) {
+    auto cipher = factory.createCipher(CipherArgs(true, "aes-256-gcm", key, iv, 16.0));
+    benchmark::DoNotOptimize(cipher->update(data, std::nullopt, std::nullopt));
+    benchmark::DoNotOptimize(cipher->final());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParallelCipher)->Apply(threadCounts);
+
+#ifndef RNQC_DISABLE_HKDF
+static void BM_ParallelHkdf(benchmark::State& state) {
+  auto key = randomBuffer(32);
+  auto salt = randomBuffer(16);
+  auto info = randomBuffer(16);
+  auto hkdf = std::make_shared<HybridHkdf>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hkdf->deriveKeySync("sha256", key, salt, info, 32));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParallelHkdf)->Apply(threadCounts);
+#endif
+
+} // namespace margelo::nitro::crypto::bench
@@ -0,0 +1,143 @@
+// Key import/export and sign/verify live in the optional `keys` subsystem
+#ifndef RNQC_DISABLE_KEYS
+
+#include <map>
+#include <memory>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <string>
+
+#include "BenchUtils.hpp"
+#include "HybridKeyObjectHandle.hpp"
+#include "HybridSignHandle.hpp"
+#include "HybridVerifyHandle.hpp"
+
+namespace margelo::nitro::crypto::bench {
+
+struct KeyCase {
+  const char* name;
+  const char* type;
+  const char* param; // RSA bits or curve name
+  const char* digest;
+};
+
+static constexpr KeyCase kKeys[] = {
+    {"rsa-2048", "RSA", "2048", "sha256"}, {"rsa-4096", "RSA", "4096", "sha256"}, {"ec-p256", "EC", "P-256", "sha256"},
+    {"ec-p384", "EC", "P-384", "sha384"},  {"ed25519", "ED25519", nullptr, ""},   {"ed448", "ED448", nullptr, ""},
+};
+
+static EVP_PKEY* generate(const KeyCase& k) {
+  EVP_PKEY* pkey = nullptr;
+  if (std::string(k.type) == "RSA") {
+    pkey = EVP_PKEY_Q_keygen(nullptr, nullptr, "RSA", static_cast<size_t>(std::stoul(k.param)));
+  } else if (k.param != nullptr) {
+    pkey = EVP_PKEY_Q_keygen(nullptr, nullptr, k.type, k.param);
+  } else {
+    pkey = EVP_PKEY_Q_keygen(nullptr, nullptr, k.type);
+  }
+  if (pkey == nullptr) {
+    throw std::runtime_error(std::string("Failed to generate ") + k.name);
+  }
+  return pkey;
+}
+
+struct KeyPem {
+  std::string private_pem;
+  std::string public_pem;
+};
+
+// Key generation is slow (RSA-4096); do it once per key type
+static const KeyPem& pemFor(const KeyCase& k) {
+  static std::map<std::string, KeyPem> cache;
+  auto it = cache.find(k.name);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  EVP_PKEY* pkey = generate(k);
+  KeyPem pem;
+  BIO* bio = BIO_new(BIO_s_mem());
+  PEM_write_bio_PrivateKey(bio, pkey, nullptr, nullptr, 0, nullptr, nullptr);
+  char* data = nullptr;
+  long len = BIO_get_mem_data(bio, &data);
+  pem.private_pem.assign(data, len);
+  BIO_free(bio);
+  bio = BIO_new(BIO_s_mem());
+  PEM_write_bio_PUBKEY(bio, pkey);
+  len = BIO_get_mem_data(bio, &data);
+  pem.public_pem.assign(data, len);
+  BIO_free(bio);
+  EVP_PKEY_free(pkey);
+  return cache.emplace(k.name, std::move(pem)).first->second;
+}
+
+static std::shared_ptr<HybridKeyObjectHandle> importKey(const std::string& pem, KeyType type) {
+  auto handle = std::make_shared<HybridKeyObjectHandle>();
+  auto encoding = type == KeyType::PRIVATE ? KeyEncoding::PKCS8 : KeyEncoding::SPKI;
+  handle->init(type, pem, KFormatType::PEM, encoding, std::nullopt);
+  return handle;
+}
+
+static void BM_Sign(benchmark::State& state, const KeyCase& k) {
+  auto key = importKey(pemFor(k).private_pem, KeyType::PRIVATE);
+  auto data = randomBuffer(state.range(0));
+  for (auto _ : state) {
+    auto sign = std::make_shared<HybridSignHandle>();
+    sign->init(k.digest);
+    sign->update(data, std::nullopt, std::nullopt);
+    benchmark::DoNotOptimize(sign->sign(key, std::nullopt, std::nullopt, std::nullopt));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void BM_Verify(benchmark::State& state, const KeyCase& k) {
+  auto privateKey = importKey(pemFor(k).private_pem, KeyType::PRIVATE);
+  auto publicKey = importKey(pemFor(k).public_pem, KeyType::PUBLIC);
+  auto data = randomBuffer(state.range(0));
+
+  auto sign = std::make_shared<HybridSignHandle>();
+  sign->init(k.digest);
+  sign->update(data, std::nullopt, std::nullopt);
+  auto signature = sign->sign(privateKey, std::nullopt, std::nullopt, std::nullopt);
+
+  for (auto _ : state) {
+    auto verify = std::make_shared<HybridVerifyHandle>();
+    verify->init(k.digest);
+    verify->update(data, std::nullopt, std::nullopt);
+    if (!verify->verify(publicKey, signature, std::nullopt, std::nullopt, std::nullopt)) {
+      state.SkipWithError("signature did not verify");
+      break;
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void BM_ImportKey(benchmark::State& state, const KeyCase& k, KeyType type) {
+  const std::string& pem = type == KeyType::PRIVATE ? pemFor(k).private_pem : pemFor(k).public_pem;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(importKey(pem, type));
+  }
+}
+
+static void BM_ExportKey(benchmark::State& state, const KeyCase& k, KFormatType format) {
+  auto key = importKey(pemFor(k).private_pem, KeyType::PRIVATE);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key->exportKey(format, KeyEncoding::PKCS8, std::nullopt, std::nullopt));
+  }
+}
+
+static const bool registered = [] {
+  for (const auto& k : kKeys) {
+    std::string name = k.name;
+    benchmark::RegisterBenchmark(("BM_Sign/" + name).c_str(), BM_Sign, k)->Arg(64)->Arg(16 * 1024);
+    benchmark::RegisterBenchmark(("BM_Verify/" + name).c_str(), BM_Verify, k)->Arg(64)->Arg(16 * 1024);
+    benchmark::RegisterBenchmark(("BM_ImportKey/" + name + "/pkcs8-pem").c_str(), BM_ImportKey, k, KeyType::PRIVATE);
+    benchmark::RegisterBenchmark(("BM_ImportKey/" + name + "/spki-pem").c_str(), BM_ImportKey, k, KeyType::PUBLIC);
+    benchmark::RegisterBenchmark(("BM_ExportKey/" + name + "/pkcs8-pem").c_str(), BM_ExportKey, k, KFormatType::PEM);
+    benchmark::RegisterBenchmark(("BM_ExportKey/" + name + "/pkcs8-der").c_str(), BM_ExportKey, k, KFormatType::DER);
+  }
+  return true;
+}();
+
+} // namespace margelo::nitro::crypto::bench
+
+#endif // RNQC_DISABLE_KEYS
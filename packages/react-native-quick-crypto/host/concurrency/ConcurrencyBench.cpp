@@ -0,0 +1,196 @@
+// Concurrency scaling of the async APIs: N operations submitted at once, as an
+// app firing N promises would, for N = 1, 2, 4 ... max. Per API and N it
+// reports aggregate throughput, per-operation latency (submit to resolve) and
+// the time each job waited in the worker queue (QueueWait).
+//
+// Throughput that stops growing while queue wait stays flat points at
+// contention inside the jobs; queue wait growing with N is oversubscription.
+// Ed25519 runs on one shared key pair, as sharedEd() does in JS.
+//
+//   host/build/quickcrypto_concurrency [operations-per-level] [max-concurrency]
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef RNQC_DISABLE_ED25519
+#include "HybridEdKeyPair.hpp"
+#endif
+#ifndef RNQC_DISABLE_HKDF
+#include "HybridHkdf.hpp"
+#endif
+#ifndef RNQC_DISABLE_PBKDF2
+#include "HybridPbkdf2.hpp"
+#endif
+#include "HybridRandom.hpp"
+#ifndef RNQC_DISABLE_SCRYPT
+#include "HybridScrypt.hpp"
+#endif
+#include "QueueWait.hpp"
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::crypto;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::shared_ptr<ArrayBuffer> filled(size_t size) {
+  auto buffer = ArrayBuffer::allocate(size);
+  std::memset(buffer->data(), 0x61, size);
+  return buffer;
+}
+
+// Counts outstanding operations of one batch
+class Latch {
+ public:
+  explicit Latch(size_t count) : count_(count) {}
+
+  void countDown() {
+    std::unique_lock lock(mutex_);
+    if (--count_ == 0) {
+      condition_.notify_all();
+    }
+  }
+
+  void wait() {
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this]() { return count_ == 0; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  size_t count_;
+};
+
+// Submits one operation; `done` must be called exactly once when it settles
+using Submit = std::function<void(std::function<void()> done)>;
+
+template <typename T>
+void settle(const std::shared_ptr<Promise<T>>& promise, std::function<void()> done) {
+  if constexpr (std::is_void_v<T>) {
+    promise->addOnResolvedListener([done]() { done(); });
+  } else {
+    promise->addOnResolvedListener([done](const T&) { done(); });
+  }
+  promise->addOnRejectedListener([](const std::exception_ptr&) {
+    std::fprintf(stderr, "operation failed\n");
+    std::abort();
+  });
+}
+
+struct Api {
+  const char* name;      // as reported by the benchmark
+  const char* queueName; // QueueWait key
+  Submit submit;
+};
+
+std::vector<Api> apis() {
+  std::vector<Api> result;
+#ifndef RNQC_DISABLE_PBKDF2
+  auto pbkdf2 = std::make_shared<HybridPbkdf2>();
+  result.push_back({"pbkdf2 sha256 1000x", "pbkdf2", [pbkdf2, password = filled(16), salt = filled(16)](auto done) {
+                      settle(pbkdf2->pbkdf2(password, salt, 1000, 32, "sha256"), done);
+                    }});
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
+  auto scrypt = std::make_shared<HybridScrypt>();
+  result.push_back({"scrypt N=1024 r=8", "scrypt", [scrypt, password = filled(16), salt = filled(16)](auto done) {
+                      settle(scrypt->deriveKey(password, salt, 1024, 8, 1, 32 * 1024 * 1024, 32), done);
+                    }});
+#endif
+#ifndef RNQC_DISABLE_HKDF
+  auto hkdf = std::make_shared<HybridHkdf>();
+  result.push_back({"hkdf sha256", "hkdf", [hkdf, key = filled(32), salt = filled(16), info = filled(16)](auto done) {
+                      settle(hkdf->deriveKey("sha256", key, salt, info, 32), done);
+                    }});
+#endif
+  auto random = std::make_shared<HybridRandom>();
+  result.push_back({"randomFill 4KB", "randomFill", [random](auto done) {
+                      settle(random->randomFill(filled(4096), 0, 4096), done);
+                    }});
+#ifndef RNQC_DISABLE_ED25519
+  std::shared_ptr<HybridEdKeyPairSpec> ed = std::make_shared<HybridEdKeyPair>();
+  ed->setCurve("ed25519");
+  ed->generateKeyPairSync(-1, -1, -1, -1, std::nullopt, std::nullopt);
+  auto message = filled(64);
+  auto signature = ed->signSync(message, std::nullopt);
+  result.push_back({"ed25519 sign", "ed.sign", [ed, message](auto done) { settle(ed->sign(message, std::nullopt), done); }});
+  result.push_back({"ed25519 verify", "ed.verify", [ed, message, signature](auto done) {
+                      settle(ed->verify(signature, message, std::nullopt), done);
+                    }});
+#endif
+  return result;
+}
+
+double percentile(std::vector<double> samples, double p) {
+  if (samples.empty()) {
+    return 0;
+  }
+  std::sort(samples.begin(), samples.end());
+  size_t index = std::min(samples.size() - 1, static_cast<size_t>(samples.size() * p));
+  return samples[index];
+}
+
+void run(const Api& api, size_t concurrency, size_t operations, bool report = true) {
+  size_t batches = std::max<size_t>(1, operations / concurrency);
+  std::vector<double> latencies(batches * concurrency);
+
+  QueueWait::take();
+  auto start = Clock::now();
+  for (size_t batch = 0; batch < batches; batch++) {
+    Latch latch(concurrency);
+    for (size_t i = 0; i < concurrency; i++) {
+      double* latency = &latencies[batch * concurrency + i];
+      auto submitted = Clock::now();
+      api.submit([&latch, latency, submitted]() {
+        *latency = std::chrono::duration<double, std::milli>(Clock::now() - submitted).count();
+        latch.countDown();
+      });
+    }
+    latch.wait();
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  auto waits = QueueWait::take()[api.queueName];
+  if (!report) {
+    return;
+  }
+
+  std::printf("%-20s %5zu %12.0f %9.3f %9.3f %9.3f %9.3f %9.3f\n", api.name, concurrency, latencies.size() / seconds,
+              percentile(latencies, 0.5), percentile(latencies, 0.9), percentile(latencies, 0.99), percentile(waits, 0.5),
+              percentile(waits, 0.99));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t operations = argc >= 2 ? std::max(1, std::atoi(argv[1])) : 256;
+  size_t maxConcurrency = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 64;
+
+  QueueWait::setEnabled(true);
+  std::printf("%zu operations per level, %u cores; latency and queue wait in ms\n", operations,
+              std::thread::hardware_concurrency());
+  std::printf("%-20s %5s %12s %9s %9s %9s %9s %9s\n", "api", "N", "ops/s", "lat p50", "lat p90", "lat p99", "wait p50",
+              "wait p99");
+  for (const auto& api : apis()) {
+    // Warm up the pool and OpenSSL's per-algorithm state
+    run(api, 1, 1, false);
+    for (size_t concurrency = 1; concurrency <= maxConcurrency; concurrency *= 2) {
+      run(api, concurrency, std::max(operations, concurrency));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include "AllocationShim.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <openssl/crypto.h>
+
+namespace allocation {
+
+namespace {
+
+  // Every block carries its size in front, so frees can be accounted without
+  // relying on malloc_usable_size(). Keeps malloc's 16-byte alignment.
+  constexpr size_t kHeader = alignof(std::max_align_t);
+
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<int64_t> live{0};
+  std::atomic<int64_t> peak{0};
+
+  void added(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    int64_t now = live.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+    int64_t high = peak.load(std::memory_order_relaxed);
+    while (now > high && !peak.compare_exchange_weak(high, now, std::memory_order_relaxed)) {
+    }
+  }
+
+  void* allocate(size_t size) {
+    auto* base = static_cast<unsigned char*>(std::malloc(size + kHeader));
+    if (base == nullptr) {
+      return nullptr;
+    }
+    *reinterpret_cast<size_t*>(base) = size;
+    added(size);
+    return base + kHeader;
+  }
+
+  void release(void* ptr) {
+    if (ptr == nullptr) {
+      return;
+    }
+    auto* base = static_cast<unsigned char*>(ptr) - kHeader;
+    live.fetch_sub(static_cast<int64_t>(*reinterpret_cast<size_t*>(base)), std::memory_order_relaxed);
+    std::free(base);
+  }
+
+  void* reallocate(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+      return allocate(size);
+    }
+    auto* base = static_cast<unsigned char*>(ptr) - kHeader;
+    size_t old = *reinterpret_cast<size_t*>(base);
+    auto* moved = static_cast<unsigned char*>(std::realloc(base, size + kHeader));
+    if (moved == nullptr) {
+      return nullptr;
+    }
+    *reinterpret_cast<size_t*>(moved) = size;
+    live.fetch_sub(static_cast<int64_t>(old), std::memory_order_relaxed);
+    added(size);
+    return moved + kHeader;
+  }
+
+  void* opensslMalloc(size_t size, const char*, int) {
+    return allocate(size);
+  }
+
+  void* opensslRealloc(void* ptr, size_t size, const char*, int) {
+    return reallocate(ptr, size);
+  }
+
+  void opensslFree(void* ptr, const char*, int) {
+    release(ptr);
+  }
+
+  void* allocateOrThrow(size_t size) {
+    void* ptr = allocate(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+} // namespace
+
+bool installOpenSSLHooks() {
+  return CRYPTO_set_mem_functions(opensslMalloc, opensslRealloc, opensslFree) == 1;
+}
+
+Counters snapshot() {
+  return {allocations.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed), live.load(std::memory_order_relaxed),
+          peak.load(std::memory_order_relaxed)};
+}
+
+void resetPeak() {
+  peak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+} // namespace allocation
+
+// Over-aligned new/delete keep the standard library's implementation; nothing
+// in the library asks for more than 16-byte alignment.
+void* operator new(size_t size) {
+  return allocation::allocateOrThrow(size);
+}
+
+void* operator new[](size_t size) {
+  return allocation::allocateOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocation::allocate(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocation::allocate(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept {
+  allocation::release(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  allocation::release(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  allocation::release(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  allocation::release(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  allocation::release(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  allocation::release(ptr);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Counting allocator for the memory benchmark. Linking AllocationShim.cpp into
+// an executable replaces the global operator new/delete; installOpenSSLHooks()
+// routes OpenSSL's allocations (OPENSSL_malloc and friends, which is where
+// EVP contexts, BIGNUMs and scrypt's scratch space come from) through it too.
+//
+// Counters are process-wide, so work done on the thread pool is included.
+namespace allocation {
+
+struct Counters {
+  uint64_t allocations = 0; // calls to new / malloc / realloc
+  uint64_t bytes = 0;       // bytes requested by those calls
+  int64_t live = 0;         // bytes currently allocated
+  int64_t peak = 0;         // high-water mark of `live` since resetPeak()
+};
+
+// Must run before OpenSSL allocates anything, i.e. first thing in main().
+// Returns false if that was too late; OpenSSL is then not counted.
+bool installOpenSSLHooks();
+
+Counters snapshot();
+// Restarts the high-water mark at the current live size
+void resetPeak();
+
+} // namespace allocation
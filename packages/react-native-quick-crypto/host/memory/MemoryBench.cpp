@@ -0,0 +1,243 @@
+// Memory footprint per operation, next to the throughput numbers of
+// quickcrypto_bench. AllocationShim counts every C++ and OpenSSL allocation;
+// per case and input size this reports:
+//   allocs/op    allocations per operation
+//   bytes/op     bytes allocated per operation
+//   peak/op      most memory live at once during one operation, above what
+//                was live before it (what the operation adds to the heap)
+//   retained/op  growth in live memory per operation once it returned
+//   max RSS      process high-water mark after the case (monotonic)
+//
+// Each case runs once unmeasured first, so one-time setup (algorithm fetch
+// caches, the thread pool) is not counted against it.
+//
+//   host/build/quickcrypto_memory [iterations] [name-filter]
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+#include "AllocationShim.hpp"
+#include "HybridCipherFactory.hpp"
+#include "HybridHash.hpp"
+#include "HybridHmac.hpp"
+#include "HybridRandom.hpp"
+#ifndef RNQC_DISABLE_KEYS
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+
+#include "HybridKeyObjectHandle.hpp"
+#include "HybridSignHandle.hpp"
+#endif
+#ifndef RNQC_DISABLE_PBKDF2
+#include "HybridPbkdf2.hpp"
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
+#include "HybridScrypt.hpp"
+#endif
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::crypto;
+
+namespace {
+
+std::shared_ptr<ArrayBuffer> filled(size_t size) {
+  auto buffer = ArrayBuffer::allocate(size);
+  std::memset(buffer->data(), 0x61, size);
+  return buffer;
+}
+
+struct Case {
+  std::string name;
+  size_t size; // input bytes, or derived key length for KDFs
+  std::function<void()> run;
+};
+
+constexpr size_t kSizes[] = {64, 16 * 1024, 1024 * 1024};
+
+struct CipherCase {
+  const char* name;
+  size_t ivLength;
+  bool aead;
+  bool ccm;
+};
+
+// One per HybridCipher subclass that owns its own EVP context setup
+constexpr CipherCase kCiphers[] = {
+    {"aes-256-cbc", 16, false, false}, {"aes-256-gcm", 12, true, false},       {"aes-256-ccm", 12, true, true},
+    {"chacha20", 16, false, false},    {"chacha20-poly1305", 12, true, false},
+};
+
+void streaming(std::vector<Case>& cases) {
+  for (size_t size : kSizes) {
+    auto data = filled(size);
+    cases.push_back({"hash sha256", size, [data]() {
+                       auto hash = std::make_shared<HybridHash>();
+                       hash->createHash("sha256", std::nullopt);
+                       hash->update(data, std::nullopt, std::nullopt);
+                       hash->digest();
+                     }});
+    cases.push_back({"hmac sha256", size, [data, key = filled(32)]() {
+                       auto hmac = std::make_shared<HybridHmac>();
+                       hmac->createHmac("sha256", key);
+                       hmac->update(data, std::nullopt, std::nullopt);
+                       hmac->digest();
+                     }});
+    for (const auto& c : kCiphers) {
+      cases.push_back({std::string("cipher ") + c.name, size, [data, c, key = filled(32), iv = filled(c.ivLength)]() {
+                         HybridCipherFactory factory;
+                         std::optional<double> tagLength = c.aead ? std::optional<double>(16) : std::nullopt;
+                         auto cipher = factory.createCipher(CipherArgs(true, c.name, key, iv, tagLength));
+                         if (c.ccm) {
+                           cipher->setAAD(ArrayBuffer::allocate(0), static_cast<double>(data->size()));
+                         }
+                         cipher->update(data, std::nullopt, std::nullopt);
+                         cipher->final();
+                       }});
+    }
+    cases.push_back({"randomFillSync", size, [data, random = std::make_shared<HybridRandom>()]() {
+                       random->randomFillSync(data, 0, static_cast<double>(data->size()));
+                     }});
+  }
+}
+
+void kdfs(std::vector<Case>& cases) {
+  auto password = filled(16);
+  auto salt = filled(16);
+#ifndef RNQC_DISABLE_PBKDF2
+  auto pbkdf2 = std::make_shared<HybridPbkdf2>();
+  cases.push_back({"pbkdf2 sha256 1000x", 32, [=]() { pbkdf2->pbkdf2Sync(password, salt, 1000, 32, "sha256"); }});
+  cases.push_back({"pbkdf2 sha256 1000x async", 32, [=]() { pbkdf2->pbkdf2(password, salt, 1000, 32, "sha256")->await().get(); }});
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
+  // Scratch space is 128 * N * r bytes: 1 MB and 16 MB
+  auto scrypt = std::make_shared<HybridScrypt>();
+  cases.push_back({"scrypt N=1024 r=8", 64, [=]() { scrypt->deriveKeySync(password, salt, 1024, 8, 1, 64.0 * 1024 * 1024, 64); }});
+  cases.push_back({"scrypt N=16384 r=8", 64, [=]() { scrypt->deriveKeySync(password, salt, 16384, 8, 1, 64.0 * 1024 * 1024, 64); }});
+#endif
+}
+
+#ifndef RNQC_DISABLE_KEYS
+struct KeyCase {
+  const char* name;
+  const char* type;
+  const char* curve;
+  const char* digest;
+};
+
+constexpr KeyCase kKeys[] = {
+    {"ec-p256", "EC", "P-256", "sha256"},
+    {"ed25519", "ED25519", nullptr, ""},
+};
+
+std::string privatePem(const KeyCase& k) {
+  EVP_PKEY* pkey = k.curve != nullptr ? EVP_PKEY_Q_keygen(nullptr, nullptr, k.type, k.curve) : EVP_PKEY_Q_keygen(nullptr, nullptr, k.type);
+  if (pkey == nullptr) {
+    throw std::runtime_error(std::string("Failed to generate ") + k.name);
+  }
+  BIO* bio = BIO_new(BIO_s_mem());
+  PEM_write_bio_PrivateKey(bio, pkey, nullptr, nullptr, 0, nullptr, nullptr);
+  char* data = nullptr;
+  long len = BIO_get_mem_data(bio, &data);
+  std::string pem(data, len);
+  BIO_free(bio);
+  EVP_PKEY_free(pkey);
+  return pem;
+}
+
+std::shared_ptr<HybridKeyObjectHandle> importKey(const std::string& pem) {
+  auto handle = std::make_shared<HybridKeyObjectHandle>();
+  handle->init(KeyType::PRIVATE, pem, KFormatType::PEM, KeyEncoding::PKCS8, std::nullopt);
+  return handle;
+}
+
+// Sign buffers every update for Ed25519/Ed448 (one-shot EVP_DigestSign), so
+// its footprint grows with the message; EC streams through the digest
+void keys(std::vector<Case>& cases) {
+  for (const auto& k : kKeys) {
+    std::string pem = privatePem(k);
+    auto key = importKey(pem);
+    std::string name = k.name;
+    for (size_t size : kSizes) {
+      cases.push_back({"sign " + name, size, [k, key, data = filled(size)]() {
+                         auto sign = std::make_shared<HybridSignHandle>();
+                         sign->init(k.digest);
+                         sign->update(data, std::nullopt, std::nullopt);
+                         sign->sign(key, std::nullopt, std::nullopt, std::nullopt);
+                       }});
+    }
+    cases.push_back({"import " + name + " pkcs8-pem", pem.size(), [pem]() { importKey(pem); }});
+    cases.push_back({"export " + name + " pkcs8-der", 0, [key]() {
+                       key->exportKey(KFormatType::DER, KeyEncoding::PKCS8, std::nullopt, std::nullopt);
+                     }});
+  }
+}
+#endif
+
+// KB on Linux, bytes on macOS
+long maxRssKb() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+void measure(const Case& c, int iterations) {
+  c.run();
+
+  auto before = allocation::snapshot();
+  int64_t peak = 0;
+  for (int i = 0; i < iterations; i++) {
+    int64_t live = allocation::snapshot().live;
+    allocation::resetPeak();
+    c.run();
+    peak = std::max(peak, allocation::snapshot().peak - live);
+  }
+  auto after = allocation::snapshot();
+
+  std::printf("%-28s %9zu %10.1f %12.0f %12lld %12.0f %10ld\n", c.name.c_str(), c.size,
+              static_cast<double>(after.allocations - before.allocations) / iterations,
+              static_cast<double>(after.bytes - before.bytes) / iterations, static_cast<long long>(peak),
+              static_cast<double>(after.live - before.live) / iterations, maxRssKb());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  // Before anything touches OpenSSL
+  bool openssl = allocation::installOpenSSLHooks();
+  int iterations = argc >= 2 ? std::max(1, std::atoi(argv[1])) : 20;
+  std::string filter = argc >= 3 ? argv[2] : "";
+
+  if (!openssl) {
+    std::fprintf(stderr, "OpenSSL allocated before the hooks were installed; only C++ allocations are counted\n");
+  }
+
+  std::vector<Case> cases;
+  streaming(cases);
+  kdfs(cases);
+#ifndef RNQC_DISABLE_KEYS
+  keys(cases);
+#endif
+
+  std::printf("%d iterations per case; bytes unless noted\n", iterations);
+  std::printf("%-28s %9s %10s %12s %12s %12s %10s\n", "case", "size", "allocs/op", "bytes/op", "peak/op", "retained/op",
+              "maxRSS KB");
+  for (const auto& c : cases) {
+    if (c.name.find(filter) != std::string::npos) {
+      measure(c, iterations);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+// Host stand-in for Nitro's ArrayBuffer. Only the native side exists here:
+// every buffer is a NativeArrayBuffer that owns (or borrows) plain memory.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace margelo::nitro {
+
+using DeleteFn = std::function<void()>;
+
+class ArrayBuffer {
+ public:
+  ArrayBuffer() = default;
+  ArrayBuffer(const ArrayBuffer&) = delete;
+  ArrayBuffer(ArrayBuffer&&) = delete;
+  virtual ~ArrayBuffer() = default;
+
+  virtual uint8_t* data() = 0;
+  virtual size_t size() const = 0;
+  virtual bool isOwner() const noexcept = 0;
+
+  static std::shared_ptr<ArrayBuffer> wrap(uint8_t* data, size_t size, DeleteFn&& deleteFunc);
+  static std::shared_ptr<ArrayBuffer> copy(const uint8_t* data, size_t size);
+  static std::shared_ptr<ArrayBuffer> copy(const std::vector<uint8_t>& data);
+  static std::shared_ptr<ArrayBuffer> copy(const std::shared_ptr<ArrayBuffer>& buffer);
+  static std::shared_ptr<ArrayBuffer> allocate(size_t size);
+};
+
+class NativeArrayBuffer final : public ArrayBuffer {
+ public:
+  NativeArrayBuffer(uint8_t* data, size_t size, DeleteFn&& deleteFunc)
+      : _data(data), _size(size), _deleteFunc(std::move(deleteFunc)) {}
+  ~NativeArrayBuffer() override {
+    if (_deleteFunc != nullptr) {
+      _deleteFunc();
+    }
+  }
+
+  uint8_t* data() override {
+    return _data;
+  }
+  size_t size() const override {
+    return _size;
+  }
+  bool isOwner() const noexcept override {
+    return _deleteFunc != nullptr;
+  }
+
+ private:
+  uint8_t* _data;
+  size_t _size;
+  DeleteFn _deleteFunc;
+};
+
+} // namespace margelo::nitro
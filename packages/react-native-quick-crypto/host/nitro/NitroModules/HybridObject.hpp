@@ -0,0 +1,52 @@
+#pragma once
+
+// Host stand-in for Nitro's HybridObject: no JS prototype, so method
+// registration is a no-op and objects are plain C++ instances.
+
+#include <memory>
+#include <string>
+
+#include "JSIConverter.hpp"
+#include "NitroDefines.hpp"
+
+namespace margelo::nitro {
+
+class Prototype {
+ public:
+  template <typename Method>
+  void registerHybridMethod(const char*, Method) {}
+  template <typename Getter>
+  void registerHybridGetter(const char*, Getter) {}
+  template <typename Setter>
+  void registerHybridSetter(const char*, Setter) {}
+};
+
+class HybridObject : public std::enable_shared_from_this<HybridObject> {
+ public:
+  explicit HybridObject(const char* name) : _name(name) {}
+  virtual ~HybridObject() = default;
+
+  std::string getName() const {
+    return _name;
+  }
+  std::shared_ptr<HybridObject> shared() {
+    return weak_from_this().lock();
+  }
+  virtual std::string toString() {
+    return "[HybridObject " + getName() + "]";
+  }
+  virtual size_t getExternalMemorySize() noexcept {
+    return 0;
+  }
+  virtual void dispose() {}
+
+ protected:
+  virtual void loadHybridMethods() {}
+  template <typename Derived>
+  void registerHybrids(Derived*, void (*)(Prototype&)) {}
+
+ private:
+  const char* _name;
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,64 @@
+#pragma once
+
+// Host stand-in: just enough of jsi and JSIConverter for nitrogen's generated
+// converters to parse. Nothing here is ever called on the host.
+
+#include <memory>
+#include <string>
+
+#include "NitroHash.hpp"
+
+namespace facebook::jsi {
+
+class Runtime;
+class Value;
+
+class String {
+ public:
+  std::string utf8(Runtime&) const;
+};
+
+class Object {
+ public:
+  explicit Object(Runtime&);
+  Value getProperty(Runtime&, const char*) const;
+  bool hasProperty(Runtime&, const char*) const;
+  template <typename V>
+  void setProperty(Runtime&, const char*, V&&);
+};
+
+class Value {
+ public:
+  Value();
+  Value(Object&&);
+  Value(String&&);
+  bool isUndefined() const;
+  bool isNull() const;
+  bool isBool() const;
+  bool isNumber() const;
+  bool isString() const;
+  bool isObject() const;
+  bool getBool() const;
+  double getNumber() const;
+  String asString(Runtime&) const;
+  String getString(Runtime&) const;
+  Object asObject(Runtime&) const;
+  Object getObject(Runtime&) const;
+  static Value undefined();
+  static Value null();
+};
+
+} // namespace facebook::jsi
+
+namespace margelo::nitro {
+
+namespace jsi = facebook::jsi;
+
+template <typename T, typename Enable = void>
+struct JSIConverter {
+  static T fromJSI(jsi::Runtime&, const jsi::Value&);
+  static jsi::Value toJSI(jsi::Runtime&, const T&);
+  static bool canConvert(jsi::Runtime&, const jsi::Value&);
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,6 @@
+#pragma once
+
+// Host stand-in: Swift interop annotations used by nitrogen output.
+#define SWIFT_PRIVATE
+#define SWIFT_NAME(_name)
+#define CLOSED_ENUM
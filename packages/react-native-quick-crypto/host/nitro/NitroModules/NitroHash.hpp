@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro {
+
+// FNV-1a, same contract as Nitro's hashString(): usable in `case` labels.
+constexpr uint64_t hashString(const char* str, size_t length) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+constexpr uint64_t hashString(const char* str) {
+  size_t length = 0;
+  while (str[length] != '\0') {
+    ++length;
+  }
+  return hashString(str, length);
+}
+
+} // namespace margelo::nitro
@@ -0,0 +1,230 @@
+#pragma once
+
+// Host stand-in for Nitro's Promise. async() runs on ThreadPool::shared() just
+// like on device; await() lets native callers block on the result.
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+namespace margelo::nitro {
+
+template <typename TResult>
+class Promise final {
+ public:
+  using OnResolvedFunc = std::function<void(const TResult&)>;
+  using OnRejectedFunc = std::function<void(const std::exception_ptr&)>;
+
+  static std::shared_ptr<Promise> create() {
+    return std::shared_ptr<Promise>(new Promise());
+  }
+
+  template <typename Run>
+  static std::shared_ptr<Promise> async(Run&& run) {
+    auto promise = create();
+    ThreadPool::shared().run([promise, run = std::forward<Run>(run)]() mutable {
+      try {
+        promise->resolve(run());
+      } catch (...) {
+        promise->reject(std::current_exception());
+      }
+    });
+    return promise;
+  }
+
+  static std::shared_ptr<Promise> resolved(TResult&& result) {
+    auto promise = create();
+    promise->resolve(std::move(result));
+    return promise;
+  }
+
+  static std::shared_ptr<Promise> rejected(const std::exception_ptr& error) {
+    auto promise = create();
+    promise->reject(error);
+    return promise;
+  }
+
+  void resolve(TResult&& result) {
+    std::vector<OnResolvedFunc> listeners;
+    {
+      std::unique_lock lock(_mutex);
+      _result.emplace(std::move(result));
+      listeners.swap(_onResolved);
+      _onRejected.clear();
+    }
+    for (auto& listener : listeners) {
+      listener(*_result);
+    }
+  }
+
+  void resolve(const TResult& result) {
+    resolve(TResult(result));
+  }
+
+  void reject(const std::exception_ptr& error) {
+    std::vector<OnRejectedFunc> listeners;
+    {
+      std::unique_lock lock(_mutex);
+      _error = error;
+      listeners.swap(_onRejected);
+      _onResolved.clear();
+    }
+    for (auto& listener : listeners) {
+      listener(error);
+    }
+  }
+
+  void addOnResolvedListener(OnResolvedFunc&& onResolved) {
+    std::unique_lock lock(_mutex);
+    if (_result.has_value()) {
+      lock.unlock();
+      onResolved(*_result);
+    } else if (_error == nullptr) {
+      _onResolved.push_back(std::move(onResolved));
+    }
+  }
+
+  void addOnRejectedListener(OnRejectedFunc&& onRejected) {
+    std::unique_lock lock(_mutex);
+    if (_error != nullptr) {
+      lock.unlock();
+      onRejected(_error);
+    } else if (!_result.has_value()) {
+      _onRejected.push_back(std::move(onRejected));
+    }
+  }
+
+  std::future<TResult> await() {
+    auto state = std::make_shared<std::promise<TResult>>();
+    addOnResolvedListener([state](const TResult& result) { state->set_value(result); });
+    addOnRejectedListener([state](const std::exception_ptr& error) { state->set_exception(error); });
+    return state->get_future();
+  }
+
+  bool isPending() {
+    std::unique_lock lock(_mutex);
+    return !_result.has_value() && _error == nullptr;
+  }
+
+ private:
+  Promise() = default;
+
+  std::mutex _mutex;
+  std::optional<TResult> _result;
+  std::exception_ptr _error;
+  std::vector<OnResolvedFunc> _onResolved;
+  std::vector<OnRejectedFunc> _onRejected;
+};
+
+template <>
+class Promise<void> final {
+ public:
+  using OnResolvedFunc = std::function<void()>;
+  using OnRejectedFunc = std::function<void(const std::exception_ptr&)>;
+
+  static std::shared_ptr<Promise> create() {
+    return std::shared_ptr<Promise>(new Promise());
+  }
+
+  template <typename Run>
+  static std::shared_ptr<Promise> async(Run&& run) {
+    auto promise = create();
+    ThreadPool::shared().run([promise, run = std::forward<Run>(run)]() mutable {
+      try {
+        run();
+        promise->resolve();
+      } catch (...) {
+        promise->reject(std::current_exception());
+      }
+    });
+    return promise;
+  }
+
+  static std::shared_ptr<Promise> resolved() {
+    auto promise = create();
+    promise->resolve();
+    return promise;
+  }
+
+  static std::shared_ptr<Promise> rejected(const std::exception_ptr& error) {
+    auto promise = create();
+    promise->reject(error);
+    return promise;
+  }
+
+  void resolve() {
+    std::vector<OnResolvedFunc> listeners;
+    {
+      std::unique_lock lock(_mutex);
+      _resolved = true;
+      listeners.swap(_onResolved);
+      _onRejected.clear();
+    }
+    for (auto& listener : listeners) {
+      listener();
+    }
+  }
+
+  void reject(const std::exception_ptr& error) {
+    std::vector<OnRejectedFunc> listeners;
+    {
+      std::unique_lock lock(_mutex);
+      _error = error;
+      listeners.swap(_onRejected);
+      _onResolved.clear();
+    }
+    for (auto& listener : listeners) {
+      listener(error);
+    }
+  }
+
+  void addOnResolvedListener(OnResolvedFunc&& onResolved) {
+    std::unique_lock lock(_mutex);
+    if (_resolved) {
+      lock.unlock();
+      onResolved();
+    } else if (_error == nullptr) {
+      _onResolved.push_back(std::move(onResolved));
+    }
+  }
+
+  void addOnRejectedListener(OnRejectedFunc&& onRejected) {
+    std::unique_lock lock(_mutex);
+    if (_error != nullptr) {
+      lock.unlock();
+      onRejected(_error);
+    } else if (!_resolved) {
+      _onRejected.push_back(std::move(onRejected));
+    }
+  }
+
+  std::future<void> await() {
+    auto state = std::make_shared<std::promise<void>>();
+    addOnResolvedListener([state]() { state->set_value(); });
+    addOnRejectedListener([state](const std::exception_ptr& error) { state->set_exception(error); });
+    return state->get_future();
+  }
+
+  bool isPending() {
+    std::unique_lock lock(_mutex);
+    return !_resolved && _error == nullptr;
+  }
+
+ private:
+  Promise() = default;
+
+  std::mutex _mutex;
+  bool _resolved = false;
+  std::exception_ptr _error;
+  std::vector<OnResolvedFunc> _onResolved;
+  std::vector<OnRejectedFunc> _onRejected;
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro {
+
+// Host stand-in for Nitro's shared worker pool.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void run(std::function<void()>&& task);
+
+  static ThreadPool& shared();
+
+ private:
+  std::vector<std::thread> _workers;
+  std::queue<std::function<void()>> _tasks;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _stopped = false;
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,81 @@
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/ThreadPool.hpp>
+#include <algorithm>
+
+namespace margelo::nitro {
+
+// ArrayBuffer
+
+std::shared_ptr<ArrayBuffer> ArrayBuffer::wrap(uint8_t* data, size_t size, DeleteFn&& deleteFunc) {
+  return std::make_shared<NativeArrayBuffer>(data, size, std::move(deleteFunc));
+}
+
+std::shared_ptr<ArrayBuffer> ArrayBuffer::copy(const uint8_t* data, size_t size) {
+  auto buffer = allocate(size);
+  if (size > 0) {
+    std::memcpy(buffer->data(), data, size);
+  }
+  return buffer;
+}
+
+std::shared_ptr<ArrayBuffer> ArrayBuffer::copy(const std::vector<uint8_t>& data) {
+  return copy(data.data(), data.size());
+}
+
+std::shared_ptr<ArrayBuffer> ArrayBuffer::copy(const std::shared_ptr<ArrayBuffer>& buffer) {
+  return copy(buffer->data(), buffer->size());
+}
+
+std::shared_ptr<ArrayBuffer> ArrayBuffer::allocate(size_t size) {
+  uint8_t* data = new uint8_t[size];
+  return std::make_shared<NativeArrayBuffer>(data, size, [=]() { delete[] data; });
+}
+
+// ThreadPool
+
+ThreadPool::ThreadPool(size_t threads) {
+  for (size_t i = 0; i < threads; ++i) {
+    _workers.emplace_back([this]() {
+      while (true) {
+        std::function<void()> task;
+        {
+          std::unique_lock lock(_mutex);
+          _condition.wait(lock, [this]() { return _stopped || !_tasks.empty(); });
+          if (_stopped && _tasks.empty()) {
+            return;
+          }
+          task = std::move(_tasks.front());
+          _tasks.pop();
+        }
+        task();
+      }
+    });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock lock(_mutex);
+    _stopped = true;
+  }
+  _condition.notify_all();
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::run(std::function<void()>&& task) {
+  {
+    std::unique_lock lock(_mutex);
+    _tasks.push(std::move(task));
+  }
+  _condition.notify_one();
+}
+
+ThreadPool& ThreadPool::shared() {
+  // Nitro sizes its pool from the core count as well
+  static ThreadPool pool(std::max<size_t>(std::thread::hardware_concurrency(), 2));
+  return pool;
+}
+
+} // namespace margelo::nitro
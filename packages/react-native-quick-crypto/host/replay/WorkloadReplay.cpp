@@ -0,0 +1,627 @@
+// Replays a workload trace recorded on a device with
+// startWorkloadRecording() / stopWorkloadRecording() (see WorkloadRecorder.hpp).
+// Every operation is re-run with synthetic data of the recorded sizes through
+// the same HybridObjects, async ones through the async API, and timings are
+// grouped by operation, algorithm, size bucket and sync/async.
+//
+// Save a run with --save and compare a later build against it with
+// --baseline to see how a change affects a production mix rather than a
+// microbenchmark. By default operations run back to back; --paced sleeps
+// for the recorded gaps between them.
+//
+//   host/build/quickcrypto_replay trace.bin [--repeat N] [--paced] [--save out.tsv] [--baseline old.tsv]
+//   host/build/quickcrypto_replay --self-test
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <openssl/evp.h>
+
+#include "HybridCipherFactory.hpp"
+#ifndef RNQC_DISABLE_ED25519
+#include "HybridEdKeyPair.hpp"
+#endif
+#include "HybridHash.hpp"
+#ifndef RNQC_DISABLE_HKDF
+#include "HybridHkdf.hpp"
+#endif
+#include "HybridHmac.hpp"
+#ifndef RNQC_DISABLE_PBKDF2
+#include "HybridPbkdf2.hpp"
+#endif
+#include "HybridRandom.hpp"
+#ifndef RNQC_DISABLE_SCRYPT
+#include "HybridScrypt.hpp"
+#endif
+#include "LibraryContext.hpp"
+#include "WorkloadRecorder.hpp"
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::crypto;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Op = WorkloadRecorder::Op;
+using Entry = WorkloadRecorder::Entry;
+
+std::shared_ptr<ArrayBuffer> filled(size_t size) {
+  auto buffer = ArrayBuffer::allocate(size);
+  std::memset(buffer->data(), 0x61, size);
+  return buffer;
+}
+
+// "<=4KB": the power of two at or above size
+std::string sizeBucket(uint64_t size) {
+  uint64_t bucket = 1;
+  while (bucket < size) {
+    bucket <<= 1;
+  }
+  if (bucket >= 1024 * 1024) {
+    return "<=" + std::to_string(bucket / (1024 * 1024)) + "MB";
+  }
+  if (bucket >= 1024) {
+    return "<=" + std::to_string(bucket / 1024) + "KB";
+  }
+  return "<=" + std::to_string(bucket) + "B";
+}
+
+std::string groupName(const Entry& entry) {
+  std::string name = std::string(WorkloadRecorder::opName(entry.op)) + " ";
+  name += entry.algorithm.empty() ? "-" : entry.algorithm;
+  name += " " + sizeBucket(entry.size);
+  if (entry.op == Op::Cipher) {
+    name += entry.p2 != 0 ? " encrypt" : " decrypt";
+  }
+  name += entry.async ? " async" : " sync";
+  return name;
+}
+
+struct CipherShape {
+  size_t keyLength;
+  size_t ivLength;
+  size_t blockSize;
+  bool aead;
+  bool ccm;
+};
+
+std::optional<CipherShape> cipherShape(const std::string& name) {
+#ifdef BLSALLOC_SODIUM
+  if (name == "xsalsa20") {
+    return CipherShape{32, 24, 1, false, false};
+  }
+#endif
+  std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)> cipher(fetchCipher(name), EVP_CIPHER_free);
+  if (!cipher) {
+    return std::nullopt;
+  }
+  int mode = EVP_CIPHER_get_mode(cipher.get());
+  bool aead = (EVP_CIPHER_get_flags(cipher.get()) & EVP_CIPH_FLAG_AEAD_CIPHER) != 0;
+  return CipherShape{static_cast<size_t>(EVP_CIPHER_get_key_length(cipher.get())),
+                     static_cast<size_t>(EVP_CIPHER_get_iv_length(cipher.get())),
+                     static_cast<size_t>(EVP_CIPHER_get_block_size(cipher.get())), aead, mode == EVP_CIPH_CCM_MODE};
+}
+
+// Re-runs trace entries with synthetic inputs. Everything an entry needs
+// besides the timed call itself (keys, ciphertexts, signatures) is prepared
+// before the clock starts and cached across repeats.
+class Replayer {
+ public:
+  Replayer() : password_(filled(16)), salt_(filled(16)), key_(filled(32)), info_(filled(16)) {}
+
+  // Returns false if the entry cannot be replayed in this build
+  bool prepare(const Entry& entry) {
+    switch (entry.op) {
+      case Op::Hash:
+      case Op::Hmac:
+      case Op::RandomFill:
+        grow(entry.size);
+        return true;
+      case Op::Cipher:
+        return prepareCipher(entry) != nullptr;
+      case Op::Pbkdf2:
+#ifndef RNQC_DISABLE_PBKDF2
+        return true;
+#else
+        return false;
+#endif
+      case Op::Scrypt:
+#ifndef RNQC_DISABLE_SCRYPT
+        return true;
+#else
+        return false;
+#endif
+      case Op::Hkdf:
+#ifndef RNQC_DISABLE_HKDF
+        ikm(entry.p1);
+        return true;
+#else
+        return false;
+#endif
+      case Op::EdSign:
+      case Op::EdVerify:
+#ifndef RNQC_DISABLE_ED25519
+        prepareEd(entry);
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+  }
+
+  void run(const Entry& entry) {
+    switch (entry.op) {
+      case Op::Hash:
+        runHash(entry);
+        break;
+      case Op::Hmac:
+        runHmac(entry);
+        break;
+      case Op::Cipher:
+        runCipher(entry);
+        break;
+      case Op::RandomFill:
+        if (entry.async) {
+          random_->randomFill(buffer_, 0, static_cast<double>(entry.size))->await().get();
+        } else {
+          random_->randomFillSync(buffer_, 0, static_cast<double>(entry.size));
+        }
+        break;
+#ifndef RNQC_DISABLE_PBKDF2
+      case Op::Pbkdf2:
+        if (entry.async) {
+          pbkdf2_->pbkdf2(password_, salt_, entry.p1, entry.size, entry.algorithm)->await().get();
+        } else {
+          pbkdf2_->pbkdf2Sync(password_, salt_, entry.p1, entry.size, entry.algorithm);
+        }
+        break;
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
+      case Op::Scrypt: {
+        // What EVP_PBE_scrypt needs, plus headroom
+        double maxmem = 128.0 * entry.p2 * (entry.p1 + entry.p3 + 2) + 1024 * 1024;
+        if (entry.async) {
+          scrypt_->deriveKey(password_, salt_, entry.p1, entry.p2, entry.p3, maxmem, entry.size)->await().get();
+        } else {
+          scrypt_->deriveKeySync(password_, salt_, entry.p1, entry.p2, entry.p3, maxmem, entry.size);
+        }
+        break;
+      }
+#endif
+#ifndef RNQC_DISABLE_HKDF
+      case Op::Hkdf:
+        if (entry.async) {
+          hkdf_->deriveKey(entry.algorithm, ikm(entry.p1), salt_, info_, entry.size)->await().get();
+        } else {
+          hkdf_->deriveKeySync(entry.algorithm, ikm(entry.p1), salt_, info_, entry.size);
+        }
+        break;
+#endif
+#ifndef RNQC_DISABLE_ED25519
+      case Op::EdSign:
+      case Op::EdVerify:
+        runEd(entry);
+        break;
+#endif
+      default:
+        throw std::runtime_error(std::string("Cannot replay ") + WorkloadRecorder::opName(entry.op));
+    }
+  }
+
+ private:
+  struct PreparedCipher {
+    CipherShape shape;
+    size_t size;
+    std::shared_ptr<ArrayBuffer> input;
+    std::shared_ptr<ArrayBuffer> tag;
+  };
+
+  // Shared input for the streaming operations, read through byteLength
+  void grow(uint64_t size) {
+    if (!buffer_ || buffer_->size() < size) {
+      buffer_ = filled(std::max<uint64_t>(size, 1));
+    }
+  }
+
+  const std::shared_ptr<ArrayBuffer>& ikm(uint64_t size) {
+    auto& buffer = ikms_[size];
+    if (!buffer) {
+      buffer = filled(std::max<uint64_t>(size, 1));
+    }
+    return buffer;
+  }
+
+  // Splits size bytes over the recorded number of update calls
+  template <typename Update>
+  void chunks(uint64_t size, uint64_t updates, Update&& update) {
+    updates = std::max<uint64_t>(updates, 1);
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < updates; i++) {
+      uint64_t length = size / updates + (i < size % updates ? 1 : 0);
+      update(offset, length);
+      offset += length;
+    }
+  }
+
+  void runHash(const Entry& entry) {
+    auto hash = std::make_shared<HybridHash>();
+    hash->createHash(entry.algorithm, std::nullopt);
+    chunks(entry.size, entry.p1, [&](uint64_t offset, uint64_t length) {
+      hash->update(buffer_, static_cast<double>(offset), static_cast<double>(length));
+    });
+    hash->digest();
+  }
+
+  void runHmac(const Entry& entry) {
+    auto hmac = std::make_shared<HybridHmac>();
+    hmac->createHmac(entry.algorithm, key_);
+    chunks(entry.size, entry.p1, [&](uint64_t offset, uint64_t length) {
+      hmac->update(buffer_, static_cast<double>(offset), static_cast<double>(length));
+    });
+    hmac->digest();
+  }
+
+  std::shared_ptr<HybridCipherSpec> createCipher(const PreparedCipher& prepared, const std::string& name, bool encrypt) {
+    HybridCipherFactory factory;
+    auto key = filled(prepared.shape.keyLength);
+    auto iv = filled(prepared.shape.ivLength);
+    std::optional<double> tagLength = prepared.shape.aead ? std::optional<double>(16) : std::nullopt;
+    auto cipher = factory.createCipher(CipherArgs(encrypt, name, key, iv, tagLength));
+    if (prepared.shape.ccm) {
+      cipher->setAAD(filled(0), static_cast<double>(prepared.size));
+    }
+    return cipher;
+  }
+
+  // Decryption replays real ciphertext (and tag) so AEAD modes authenticate;
+  // padded block modes run without padding on block-aligned input instead
+  PreparedCipher* prepareCipher(const Entry& entry) {
+    auto id = std::make_tuple(entry.algorithm, entry.size, entry.p2 != 0);
+    auto it = ciphers_.find(id);
+    if (it != ciphers_.end()) {
+      return &it->second;
+    }
+    auto shape = cipherShape(entry.algorithm);
+    if (!shape) {
+      return nullptr;
+    }
+    PreparedCipher prepared{*shape, entry.size, nullptr, nullptr};
+    bool padded = !shape->aead && shape->blockSize > 1;
+    if (entry.p2 == 0 && padded) {
+      prepared.size = std::max<size_t>(1, (entry.size + shape->blockSize - 1) / shape->blockSize) * shape->blockSize;
+    }
+    prepared.input = filled(std::max<size_t>(prepared.size, 1));
+    if (entry.p2 == 0 && shape->aead) {
+      auto cipher = createCipher(prepared, entry.algorithm, true);
+      auto head = cipher->update(prepared.input, 0, static_cast<double>(prepared.size));
+      auto tail = cipher->final();
+      std::vector<uint8_t> ciphertext(head->data(), head->data() + head->size());
+      ciphertext.insert(ciphertext.end(), tail->data(), tail->data() + tail->size());
+      ciphertext.resize(std::max<size_t>(ciphertext.size(), 1));
+      prepared.input = ArrayBuffer::copy(ciphertext);
+      prepared.tag = cipher->getAuthTag();
+    }
+    return &ciphers_.emplace(id, prepared).first->second;
+  }
+
+  void runCipher(const Entry& entry) {
+    PreparedCipher* prepared = prepareCipher(entry);
+    bool encrypt = entry.p2 != 0;
+    auto cipher = createCipher(*prepared, entry.algorithm, encrypt);
+    if (!encrypt && prepared->tag) {
+      cipher->setAuthTag(prepared->tag);
+    }
+    if (!encrypt && !prepared->shape.aead && prepared->shape.blockSize > 1) {
+      cipher->setAutoPadding(false);
+    }
+    // CCM takes its whole input in one update
+    uint64_t updates = prepared->shape.ccm ? 1 : entry.p1;
+    chunks(prepared->size, updates, [&](uint64_t offset, uint64_t length) {
+      if (entry.async) {
+        cipher->updateAsync(prepared->input, static_cast<double>(offset), static_cast<double>(length))->await().get();
+      } else {
+        cipher->update(prepared->input, static_cast<double>(offset), static_cast<double>(length));
+      }
+    });
+    if (entry.async) {
+      cipher->finalAsync()->await().get();
+    } else {
+      cipher->final();
+    }
+  }
+
+#ifndef RNQC_DISABLE_ED25519
+  struct PreparedEd {
+    std::shared_ptr<HybridEdKeyPairSpec> keyPair;
+    std::map<uint64_t, std::pair<std::shared_ptr<ArrayBuffer>, std::shared_ptr<ArrayBuffer>>> messages;
+  };
+
+  // One key pair per curve, and a message and its signature per size
+  std::pair<std::shared_ptr<ArrayBuffer>, std::shared_ptr<ArrayBuffer>>& prepareEd(const Entry& entry) {
+    auto& ed = eds_[entry.algorithm];
+    if (!ed.keyPair) {
+      ed.keyPair = std::make_shared<HybridEdKeyPair>();
+      ed.keyPair->setCurve(entry.algorithm);
+      ed.keyPair->generateKeyPairSync(-1, -1, -1, -1, std::nullopt, std::nullopt);
+    }
+    auto& message = ed.messages[entry.size];
+    if (!message.first) {
+      message.first = filled(entry.size);
+      message.second = ed.keyPair->signSync(message.first, std::nullopt);
+    }
+    return message;
+  }
+
+  void runEd(const Entry& entry) {
+    auto& keyPair = eds_[entry.algorithm].keyPair;
+    auto& [message, signature] = prepareEd(entry);
+    if (entry.op == Op::EdSign) {
+      if (entry.async) {
+        keyPair->sign(message, std::nullopt)->await().get();
+      } else {
+        keyPair->signSync(message, std::nullopt);
+      }
+    } else if (entry.async) {
+      keyPair->verify(signature, message, std::nullopt)->await().get();
+    } else {
+      keyPair->verifySync(signature, message, std::nullopt);
+    }
+  }
+
+  std::map<std::string, PreparedEd> eds_;
+#endif
+
+  std::shared_ptr<ArrayBuffer> password_;
+  std::shared_ptr<ArrayBuffer> salt_;
+  std::shared_ptr<ArrayBuffer> key_;
+  std::shared_ptr<ArrayBuffer> info_;
+  std::shared_ptr<ArrayBuffer> buffer_;
+  std::map<uint64_t, std::shared_ptr<ArrayBuffer>> ikms_;
+  std::map<std::tuple<std::string, uint64_t, bool>, PreparedCipher> ciphers_;
+  std::shared_ptr<HybridRandom> random_ = std::make_shared<HybridRandom>();
+#ifndef RNQC_DISABLE_PBKDF2
+  std::shared_ptr<HybridPbkdf2> pbkdf2_ = std::make_shared<HybridPbkdf2>();
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
+  std::shared_ptr<HybridScrypt> scrypt_ = std::make_shared<HybridScrypt>();
+#endif
+#ifndef RNQC_DISABLE_HKDF
+  std::shared_ptr<HybridHkdf> hkdf_ = std::make_shared<HybridHkdf>();
+#endif
+};
+
+struct Group {
+  size_t count = 0; // per pass
+  std::vector<double> micros;
+};
+
+double median(std::vector<double> samples) {
+  if (samples.empty()) {
+    return 0;
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+// Runs the trace `repeat` times after one untimed warm-up pass
+std::map<std::string, Group> replay(const std::vector<Entry>& entries, int repeat, bool paced) {
+  Replayer replayer;
+  std::vector<const Entry*> runnable;
+  std::map<std::string, size_t> skipped;
+  for (const auto& entry : entries) {
+    if (replayer.prepare(entry)) {
+      runnable.push_back(&entry);
+    } else {
+      skipped[groupName(entry)]++;
+    }
+  }
+  for (const auto& [name, count] : skipped) {
+    std::fprintf(stderr, "skipped %zu x %s (not in this build)\n", count, name.c_str());
+  }
+
+  std::map<std::string, Group> groups;
+  for (const Entry* entry : runnable) {
+    replayer.run(*entry);
+    groups[groupName(*entry)].count++;
+  }
+  for (int pass = 0; pass < repeat; pass++) {
+    for (const Entry* entry : runnable) {
+      if (paced && entry->deltaMicros > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(entry->deltaMicros));
+      }
+      auto start = Clock::now();
+      replayer.run(*entry);
+      double micros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+      groups[groupName(*entry)].micros.push_back(micros);
+    }
+  }
+  return groups;
+}
+
+// Baseline files: one "group<TAB>count<TAB>median us" line per group
+std::map<std::string, double> loadBaseline(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("Cannot read baseline " + path);
+  }
+  std::map<std::string, double> baseline;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t first = line.find('\t');
+    size_t last = line.rfind('\t');
+    if (first == std::string::npos || first == last) {
+      continue;
+    }
+    baseline[line.substr(0, first)] = std::strtod(line.c_str() + last + 1, nullptr);
+  }
+  return baseline;
+}
+
+void report(const std::map<std::string, Group>& groups, const std::optional<std::map<std::string, double>>& baseline) {
+  double total = 0;
+  double baselineTotal = 0;
+  std::printf("%-48s %7s %12s %12s", "group", "count", "median us", "total ms");
+  if (baseline) {
+    std::printf(" %12s %8s", "base us", "change");
+  }
+  std::printf("\n");
+  for (const auto& [name, group] : groups) {
+    double us = median(group.micros);
+    total += us * group.count;
+    std::printf("%-48s %7zu %12.2f %12.3f", name.c_str(), group.count, us, us * group.count / 1000);
+    if (baseline) {
+      auto it = baseline->find(name);
+      if (it != baseline->end() && it->second > 0) {
+        baselineTotal += it->second * group.count;
+        std::printf(" %12.2f %+7.1f%%", it->second, (us / it->second - 1) * 100);
+      } else {
+        std::printf(" %12s %8s", "-", "new");
+      }
+    }
+    std::printf("\n");
+  }
+  std::printf("total %.3f ms per pass", total / 1000);
+  if (baseline && baselineTotal > 0) {
+    std::printf(" (groups in the baseline: %+.1f%%)", (total / baselineTotal - 1) * 100);
+  }
+  std::printf("\n");
+}
+
+void save(const std::map<std::string, Group>& groups, const std::string& path) {
+  std::ofstream out(path);
+  for (const auto& [name, group] : groups) {
+    out << name << '\t' << group.count << '\t' << median(group.micros) << '\n';
+  }
+  if (!out) {
+    throw std::runtime_error("Cannot write " + path);
+  }
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Cannot read trace " + path);
+  }
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Records a small mixed workload through the HybridObjects, then checks the
+// trace decodes to what was run and replays it
+int selfTest() {
+  WorkloadRecorder::start();
+  auto data = filled(1000);
+  auto hash = std::make_shared<HybridHash>();
+  hash->createHash("sha256", std::nullopt);
+  hash->update(data, 0, 600);
+  hash->update(data, 600, 400);
+  hash->digest();
+  auto hmac = std::make_shared<HybridHmac>();
+  hmac->createHmac("sha512", filled(32));
+  hmac->update(data, std::nullopt, std::nullopt);
+  hmac->digest();
+  HybridCipherFactory factory;
+  auto cipher = factory.createCipher(CipherArgs(true, "aes-256-gcm", filled(32), filled(12), 16.0));
+  cipher->updateAsync(data, std::nullopt, std::nullopt)->await().get();
+  cipher->finalAsync()->await().get();
+  auto random = std::make_shared<HybridRandom>();
+  random->randomFillSync(filled(64), 0, 64);
+  size_t expected = 4;
+#ifndef RNQC_DISABLE_PBKDF2
+  std::make_shared<HybridPbkdf2>()->pbkdf2(filled(16), filled(16), 10, 32, "sha256")->await().get();
+  expected++;
+#endif
+  std::vector<uint8_t> trace = WorkloadRecorder::stop();
+  auto entries = WorkloadRecorder::decode(trace.data(), trace.size());
+
+  auto check = [](bool ok, const char* what) {
+    if (!ok) {
+      std::fprintf(stderr, "self-test failed: %s\n", what);
+      std::exit(1);
+    }
+  };
+  check(entries.size() == expected, "entry count");
+  check(entries[0].op == Op::Hash && entries[0].algorithm == "sha256", "hash entry");
+  check(entries[0].size == 1000 && entries[0].p1 == 2 && !entries[0].async, "hash size and updates");
+  check(entries[1].op == Op::Hmac && entries[1].algorithm == "sha512", "hmac entry");
+  check(entries[2].op == Op::Cipher && entries[2].async && entries[2].p2 == 1, "async cipher entry");
+  check(entries[3].op == Op::RandomFill && entries[3].size == 64, "randomFill entry");
+#ifndef RNQC_DISABLE_PBKDF2
+  check(entries[4].op == Op::Pbkdf2 && entries[4].async && entries[4].p1 == 10, "async pbkdf2 entry");
+#endif
+  check(WorkloadRecorder::stop().empty(), "recording stopped");
+
+  // Decryption, and every cipher shape replay prepares differently
+  entries.push_back({Op::Cipher, false, "aes-256-gcm", 1000, 3, 0, 0, 0});
+  entries.push_back({Op::Cipher, false, "aes-256-cbc", 1000, 2, 0, 0, 0});
+  entries.push_back({Op::Cipher, false, "aes-256-ccm", 100, 1, 1, 0, 0});
+  entries.push_back({Op::Cipher, false, "aes-256-ccm", 100, 1, 0, 0, 0});
+  report(replay(entries, 1, false), std::nullopt);
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::optional<std::string> tracePath;
+  std::optional<std::string> savePath;
+  std::optional<std::string> baselinePath;
+  int repeat = 3;
+  bool paced = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--self-test") {
+      return selfTest();
+    } else if (arg == "--repeat" && i + 1 < argc) {
+      repeat = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--paced") {
+      paced = true;
+    } else if (arg == "--save" && i + 1 < argc) {
+      savePath = argv[++i];
+    } else if (arg == "--baseline" && i + 1 < argc) {
+      baselinePath = argv[++i];
+    } else if (!tracePath && arg.rfind("--", 0) != 0) {
+      tracePath = arg;
+    } else {
+      std::fprintf(stderr, "unknown argument %s\n", arg.c_str());
+      return 2;
+    }
+  }
+  if (!tracePath) {
+    std::fprintf(stderr, "usage: %s trace.bin [--repeat N] [--paced] [--save out.tsv] [--baseline old.tsv] | --self-test\n", argv[0]);
+    return 2;
+  }
+
+  try {
+    std::vector<uint8_t> trace = readFile(*tracePath);
+    auto entries = WorkloadRecorder::decode(trace.data(), trace.size());
+    std::printf("%zu operations, %d passes\n", entries.size(), repeat);
+    auto groups = replay(entries, repeat, paced);
+    std::optional<std::map<std::string, double>> baseline;
+    if (baselinePath) {
+      baseline = loadBaseline(*baselinePath);
+    }
+    report(groups, baseline);
+    if (savePath) {
+      save(groups, *savePath);
+    }
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+// RSA key generation time distribution and private-key throughput, per prime
+// count and keygen parallelism (HybridRsaKeyPair::setPrimes/setParallelism).
+//
+// Keygen time is dominated by the prime search and varies a lot from key to
+// key, so it is reported as percentiles over `samples` keys. Parallel keygen
+// runs at most one search per core, so on one core both rows match.
+//
+//   host/build/quickcrypto_rsa [samples] [modulus-bits]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "HybridRsaKeyPair.hpp"
+
+using namespace margelo::nitro::crypto;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using KeyPtr = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+
+double percentile(std::vector<double> samples, double p) {
+  std::sort(samples.begin(), samples.end());
+  size_t index = std::min(samples.size() - 1, static_cast<size_t>(samples.size() * p));
+  return samples[index];
+}
+
+KeyPtr generate(int bits, int primes, int parallelism, double* ms) {
+  auto rsa = std::make_shared<HybridRsaKeyPair>();
+  rsa->setModulusLength(bits);
+  rsa->setPrimes(primes);
+  rsa->setParallelism(parallelism);
+  auto start = Clock::now();
+  rsa->generateKeyPairSync();
+  *ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  auto der = rsa->getPrivateKey();
+  const unsigned char* data = der->data();
+  KeyPtr key(d2i_AutoPrivateKey(nullptr, &data, static_cast<long>(der->size())), EVP_PKEY_free);
+  if (!key) {
+    throw std::runtime_error("Failed to parse generated key");
+  }
+  return key;
+}
+
+// Signatures (private key) or verifications (public key) per second
+double operationsPerSecond(EVP_PKEY* key, bool sign) {
+  unsigned char digest[32] = {0x61};
+  std::vector<unsigned char> signature(EVP_PKEY_get_size(key));
+  size_t signatureLength = signature.size();
+  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> signer(EVP_PKEY_CTX_new(key, nullptr), EVP_PKEY_CTX_free);
+  EVP_PKEY_sign_init(signer.get());
+  EVP_PKEY_sign(signer.get(), signature.data(), &signatureLength, digest, sizeof(digest));
+
+  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new(key, nullptr), EVP_PKEY_CTX_free);
+  sign ? EVP_PKEY_sign_init(ctx.get()) : EVP_PKEY_verify_init(ctx.get());
+
+  size_t operations = 0;
+  auto start = Clock::now();
+  double seconds = 0;
+  while (seconds < 0.5) {
+    size_t length = signature.size();
+    int ok = sign ? EVP_PKEY_sign(ctx.get(), signature.data(), &length, digest, sizeof(digest))
+                  : EVP_PKEY_verify(ctx.get(), signature.data(), signatureLength, digest, sizeof(digest));
+    if (ok != 1) {
+      throw std::runtime_error(sign ? "sign failed" : "verify failed");
+    }
+    operations++;
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  }
+  return operations / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  int samples = argc >= 2 ? std::max(1, std::atoi(argv[1])) : 10;
+  int bits = argc >= 3 ? std::atoi(argv[2]) : 2048;
+  int maxPrimes = bits < 1024 ? 2 : bits < 4096 ? 3 : bits < 8192 ? 4 : 5;
+  int cores = static_cast<int>(std::thread::hardware_concurrency());
+
+  std::printf("RSA-%d, %d keys per row, %d cores; keygen in ms\n", bits, samples, cores);
+  std::printf("%6s %11s %9s %9s %9s %9s %12s %12s\n", "primes", "parallelism", "p50", "p90", "max", "mean", "sign/s",
+              "verify/s");
+  for (int primes = 2; primes <= std::min(maxPrimes, 3); primes++) {
+    for (int parallelism : {1, 4}) {
+      std::vector<double> times;
+      KeyPtr key(nullptr, EVP_PKEY_free);
+      for (int i = 0; i < samples; i++) {
+        double ms = 0;
+        key = generate(bits, primes, parallelism, &ms);
+        times.push_back(ms);
+      }
+      double mean = 0;
+      for (double ms : times) {
+        mean += ms / times.size();
+      }
+      std::printf("%6d %11d %9.1f %9.1f %9.1f %9.1f %12.0f %12.0f\n", primes, parallelism, percentile(times, 0.5),
+                  percentile(times, 0.9), percentile(times, 1.0), mean, operationsPerSecond(key.get(), true),
+                  operationsPerSecond(key.get(), false));
+    }
+  }
+  return 0;
+}
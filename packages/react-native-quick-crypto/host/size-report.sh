@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+# Builds the C++ core as a shared library once per subsystem selection and
+# reports the stripped .so size and dlopen() time against the full build.
+#
+#   host/size-report.sh              # every subsystem
+#   host/size-report.sh blake3,keys  # treat these as always disabled
+#                                    # (e.g. when their submodules are absent)
+#
+# Host numbers (x86_64/arm64 Linux or macOS) are a proxy for the Android .so:
+# absolute sizes differ, the relative savings carry over. Needs bash 4+.
+
+set -euo pipefail
+
+HOST_DIR="$(cd "$(dirname "$0")" && pwd)"
+OUT_DIR="${HOST_DIR}/build-size"
+SAMPLES="${SAMPLES:-25}"
+ALWAYS_DISABLED="${1:-}"
+
+SUBSYSTEMS=(blake3 compress dh ec ed25519 hkdf keys mldsa noise oprf pagecipher pbkdf2 rsa scrypt)
+KEY_DEPENDENTS="ec,ed25519,mldsa,rsa"
+
+join() {
+  local IFS=,
+  echo "$*" | sed -e 's/^,*//' -e 's/,*$//' -e 's/,,*/,/g'
+}
+
+# name -> comma-separated disabled list
+declare -a NAMES=()
+declare -A CONFIGS=()
+add_config() {
+  NAMES+=("$1")
+  CONFIGS["$1"]="$(join "$ALWAYS_DISABLED" "$2")"
+}
+
+add_config "full" ""
+for subsystem in "${SUBSYSTEMS[@]}"; do
+  if [[ ",${ALWAYS_DISABLED}," == *",${subsystem},"* ]]; then
+    continue
+  fi
+  if [[ "$subsystem" == "keys" ]]; then
+    add_config "-keys (+ec,ed25519,mldsa,rsa)" "keys,${KEY_DEPENDENTS}"
+  else
+    add_config "-${subsystem}" "$subsystem"
+  fi
+done
+add_config "hash + hmac + ciphers only" "$(join "${SUBSYSTEMS[@]}")"
+
+file_size() {
+  if stat -c %s "$1" >/dev/null 2>&1; then stat -c %s "$1"; else stat -f %z "$1"; fi
+}
+
+declare -A SIZES=()
+declare -A LOADS=()
+for name in "${NAMES[@]}"; do
+  dir="${OUT_DIR}/$(echo "$name" | tr -c 'a-zA-Z0-9\n' '_')"
+  cmake -S "$HOST_DIR" -B "$dir" -DCMAKE_BUILD_TYPE=Release -DQUICKCRYPTO_HOST_SHARED=ON \
+    -DQUICKCRYPTO_HOST_BENCHMARKS=OFF -DQUICKCRYPTO_DISABLED_SUBSYSTEMS="${CONFIGS[$name]}" >/dev/null
+  if ! cmake --build "$dir" -j --target QuickCryptoHost quickcrypto_loadtime >"${dir}/build.log" 2>&1; then
+    echo "build failed for '${name}', see ${dir}/build.log" >&2
+    exit 1
+  fi
+  lib="$(find "$dir" -maxdepth 1 -name 'libQuickCryptoHost.*' \( -name '*.so' -o -name '*.dylib' \) | head -n 1)"
+  strip -x -o "${dir}/stripped" "$lib" 2>/dev/null || strip -x "$lib" -o "${dir}/stripped"
+  SIZES["$name"]="$(file_size "${dir}/stripped")"
+  LOADS["$name"]="$("${dir}/quickcrypto_loadtime" "$lib" "$SAMPLES")"
+done
+
+base_size="${SIZES[full]}"
+base_load="${LOADS[full]}"
+printf '| %-32s | %10s | %10s | %10s | %10s |\n' "configuration" "size (KB)" "saved (KB)" "load (ms)" "saved (ms)"
+printf '|%s|%s|%s|%s|%s|\n' "$(printf -- '-%.0s' {1..34})" "------------" "------------" "------------" "------------"
+for name in "${NAMES[@]}"; do
+  awk -v n="$name" -v s="${SIZES[$name]}" -v bs="$base_size" -v l="${LOADS[$name]}" -v bl="$base_load" \
+    'BEGIN { printf "| %-32s | %10.1f | %10.1f | %10.3f | %10.3f |\n", n, s / 1024, (bs - s) / 1024, l, bl - l }'
+done
@@ -0,0 +1,66 @@
+// dlopen() time of a QuickCrypto shared library, in a fresh process per sample
+// (a library only loads once per process). OpenSSL and zlib are linked into
+// this binary so their own load cost is not counted, as in an app where
+// something else loaded them first.
+//
+//   quickcrypto_loadtime <path/to/libQuickCryptoHost.so> [samples]
+//
+// Prints the median in milliseconds.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <openssl/crypto.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+namespace {
+
+int child(const char* path) {
+  auto start = std::chrono::steady_clock::now();
+  void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  auto end = std::chrono::steady_clock::now();
+  if (handle == nullptr) {
+    std::fprintf(stderr, "%s\n", dlerror());
+    return 1;
+  }
+  std::printf("%f\n", std::chrono::duration<double, std::milli>(end - start).count());
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  // Keep the dependencies mapped before the measured dlopen()
+  if (OpenSSL_version_num() == 0 || zlibVersion() == nullptr) {
+    return 1;
+  }
+  if (argc >= 3 && std::strcmp(argv[1], "--child") == 0) {
+    return child(argv[2]);
+  }
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <library> [samples]\n", argv[0]);
+    return 1;
+  }
+
+  int samples = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 25;
+  std::vector<double> times;
+  std::string command = "\"" + std::string(argv[0]) + "\" --child \"" + argv[1] + "\"";
+  for (int i = 0; i < samples; i++) {
+    FILE* pipe = popen(command.c_str(), "r");
+    double ms = -1;
+    int read = pipe != nullptr ? std::fscanf(pipe, "%lf", &ms) : 0;
+    if (pipe == nullptr || pclose(pipe) != 0 || read != 1) {
+      std::fprintf(stderr, "failed: %s\n", command.c_str());
+      return 1;
+    }
+    times.push_back(ms);
+  }
+  std::sort(times.begin(), times.end());
+  std::printf("%.3f\n", times[times.size() / 2]);
+  return 0;
+}
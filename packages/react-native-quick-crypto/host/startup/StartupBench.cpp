@@ -0,0 +1,151 @@
+// Cold-start benchmark: how long the first crypto call takes in a fresh
+// process, with and without api::prewarm() having run on a background thread.
+//
+// Every sample is a new process (this binary re-runs itself with `--child`),
+// since OpenSSL's one-time setup can only be observed once per process.
+//
+//   host/build/quickcrypto_startup [samples]
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "HybridCipherFactory.hpp"
+#include "HybridHash.hpp"
+#include "HybridHmac.hpp"
+#include "HybridRandom.hpp"
+#include "QuickCryptoApi.hpp"
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::crypto;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::shared_ptr<ArrayBuffer> filled(size_t size) {
+  auto buffer = ArrayBuffer::allocate(size);
+  std::memset(buffer->data(), 0x61, size);
+  return buffer;
+}
+
+// The first call each JS API makes, through the same HybridObjects
+struct FirstCall {
+  const char* name;
+  std::function<void()> run;
+};
+
+const std::vector<FirstCall>& firstCalls() {
+  static const std::vector<FirstCall> calls = {
+      {"sha256",
+       []() {
+         auto hash = std::make_shared<HybridHash>();
+         hash->createHash("sha256", std::nullopt);
+         hash->update(filled(64), std::nullopt, std::nullopt);
+         hash->digest();
+       }},
+      {"hmac-sha256",
+       []() {
+         auto hmac = std::make_shared<HybridHmac>();
+         hmac->createHmac("sha256", filled(32));
+         hmac->update(filled(64), std::nullopt, std::nullopt);
+         hmac->digest();
+       }},
+      {"aes-256-gcm",
+       []() {
+         HybridCipherFactory factory;
+         auto cipher = factory.createCipher(CipherArgs(true, "aes-256-gcm", filled(32), filled(12), 16.0));
+         cipher->update(filled(64), std::nullopt, std::nullopt);
+         cipher->final();
+       }},
+      {"randomFill",
+       []() {
+         auto random = std::make_shared<HybridRandom>();
+         auto buffer = filled(32);
+         random->randomFillSync(buffer, 0, 32);
+       }},
+  };
+  return calls;
+}
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Runs in the fresh process; prints the measured milliseconds
+int child(const std::string& call, bool prewarm) {
+  auto it = std::find_if(firstCalls().begin(), firstCalls().end(), [&](const FirstCall& c) { return call == c.name; });
+  if (it == firstCalls().end()) {
+    std::fprintf(stderr, "unknown call %s\n", call.c_str());
+    return 1;
+  }
+  if (prewarm) {
+    // As an app would at launch; the JS thread only waits if it needs crypto
+    // before the background work is done, which is not what is measured here
+    std::thread(api::prewarm).join();
+  }
+  auto start = Clock::now();
+  it->run();
+  std::printf("%f\n", elapsedMs(start));
+  return 0;
+}
+
+double spawn(const std::string& self, const std::string& args) {
+  std::string command = "\"" + self + "\" --child " + args;
+  FILE* pipe = popen(command.c_str(), "r");
+  if (pipe == nullptr) {
+    throw std::runtime_error("failed to spawn " + command);
+  }
+  double ms = -1;
+  int read = std::fscanf(pipe, "%lf", &ms);
+  if (pclose(pipe) != 0 || read != 1) {
+    throw std::runtime_error("child failed: " + command);
+  }
+  return ms;
+}
+
+double percentile(std::vector<double> samples, double p) {
+  std::sort(samples.begin(), samples.end());
+  size_t index = std::min(samples.size() - 1, static_cast<size_t>(samples.size() * p));
+  return samples[index];
+}
+
+void report(const char* name, const char* mode, const std::vector<double>& samples) {
+  std::printf("%-14s %-10s %10.3f %10.3f %10.3f\n", name, mode, percentile(samples, 0), percentile(samples, 0.5),
+              percentile(samples, 0.9));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc >= 3 && std::strcmp(argv[1], "--child") == 0) {
+    bool prewarm = argc >= 4 && std::strcmp(argv[3], "--prewarm") == 0;
+    return child(argv[2], prewarm);
+  }
+
+  int samples = argc >= 2 ? std::max(1, std::atoi(argv[1])) : 25;
+  std::printf("first call latency in a fresh process, %d samples (ms)\n", samples);
+  std::printf("%-14s %-10s %10s %10s %10s\n", "call", "mode", "min", "p50", "p90");
+  for (const auto& call : firstCalls()) {
+    std::vector<double> cold;
+    std::vector<double> warm;
+    for (int i = 0; i < samples; i++) {
+      // Interleaved so drift (thermal, page cache) hits both modes alike
+      cold.push_back(spawn(argv[0], call.name));
+      warm.push_back(spawn(argv[0], std::string(call.name) + " --prewarm"));
+    }
+    report(call.name, "cold", cold);
+    report(call.name, "prewarmed", warm);
+  }
+  return 0;
+}
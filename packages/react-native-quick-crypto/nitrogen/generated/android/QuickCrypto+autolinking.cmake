@@ -45,6 +45,16 @@ target_sources(
   ../nitrogen/generated/shared/c++/HybridSignHandleSpec.cpp
   ../nitrogen/generated/shared/c++/HybridVerifyHandleSpec.cpp
   ../nitrogen/generated/shared/c++/HybridUtilsSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridCompressCipherSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridPageCipherSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridDiffieHellmanSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridECDHSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridMacSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridKeyRotationSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridKeyWrapSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridOprfSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNoiseTransportSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNoiseHandshakeSpec.cpp
   # Android-specific Nitrogen C++ sources
   
 )
@@ -15,24 +15,73 @@
 #include <fbjni/fbjni.h>
 #include <NitroModules/HybridObjectRegistry.hpp>
 
+#ifndef RNQC_DISABLE_BLAKE3
 #include "HybridBlake3.hpp"
+#endif
 #include "HybridCipher.hpp"
 #include "HybridCipherFactory.hpp"
+#ifndef RNQC_DISABLE_EC
 #include "HybridEcKeyPair.hpp"
+#endif
+#ifndef RNQC_DISABLE_ED25519
 #include "HybridEdKeyPair.hpp"
+#endif
 #include "HybridHash.hpp"
 #include "HybridHmac.hpp"
+#ifndef RNQC_DISABLE_HKDF
 #include "HybridHkdf.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
 #include "HybridKeyObjectHandle.hpp"
+#endif
+#ifndef RNQC_DISABLE_PBKDF2
 #include "HybridPbkdf2.hpp"
+#endif
 #include "HybridRandom.hpp"
+#ifndef RNQC_DISABLE_RSA
 #include "HybridRsaCipher.hpp"
+#endif
+#ifndef RNQC_DISABLE_RSA
 #include "HybridRsaKeyPair.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
 #include "HybridSignHandle.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
 #include "HybridVerifyHandle.hpp"
+#endif
+#ifndef RNQC_DISABLE_MLDSA
 #include "HybridMlDsaKeyPair.hpp"
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
 #include "HybridScrypt.hpp"
+#endif
 #include "HybridUtils.hpp"
+#ifndef RNQC_DISABLE_COMPRESS
+#include "HybridCompressCipher.hpp"
+#endif
+#ifndef RNQC_DISABLE_PAGECIPHER
+#include "HybridPageCipher.hpp"
+#endif
+#ifndef RNQC_DISABLE_DH
+#include "HybridDiffieHellman.hpp"
+#endif
+#ifndef RNQC_DISABLE_DH
+#include "HybridECDH.hpp"
+#endif
+#include "HybridMac.hpp"
+#ifndef RNQC_DISABLE_PAGECIPHER
+#include "HybridKeyRotation.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
+#include "HybridKeyWrap.hpp"
+#endif
+#ifndef RNQC_DISABLE_OPRF
+#include "HybridOprf.hpp"
+#endif
+#ifndef RNQC_DISABLE_NOISE
+#include "HybridNoiseHandshake.hpp"
+#endif
 
 namespace margelo::nitro::crypto {
 
@@ -46,6 +95,7 @@ int initialize(JavaVM* vm) {
     
 
     // Register Nitro Hybrid Objects
+#ifndef RNQC_DISABLE_BLAKE3
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Blake3",
       []() -> std::shared_ptr<HybridObject> {
@@ -55,6 +105,7 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridBlake3>();
       }
     );
+#endif
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Cipher",
       []() -> std::shared_ptr<HybridObject> {
@@ -73,6 +124,7 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridCipherFactory>();
       }
     );
+#ifndef RNQC_DISABLE_EC
     HybridObjectRegistry::registerHybridObjectConstructor(
       "EcKeyPair",
       []() -> std::shared_ptr<HybridObject> {
@@ -82,6 +134,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridEcKeyPair>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_ED25519
     HybridObjectRegistry::registerHybridObjectConstructor(
       "EdKeyPair",
       []() -> std::shared_ptr<HybridObject> {
@@ -91,6 +145,7 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridEdKeyPair>();
       }
     );
+#endif
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Hash",
       []() -> std::shared_ptr<HybridObject> {
@@ -109,6 +164,7 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridHmac>();
       }
     );
+#ifndef RNQC_DISABLE_HKDF
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Hkdf",
       []() -> std::shared_ptr<HybridObject> {
@@ -118,6 +174,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridHkdf>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_KEYS
     HybridObjectRegistry::registerHybridObjectConstructor(
       "KeyObjectHandle",
       []() -> std::shared_ptr<HybridObject> {
@@ -127,6 +185,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridKeyObjectHandle>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_PBKDF2
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Pbkdf2",
       []() -> std::shared_ptr<HybridObject> {
@@ -136,6 +196,7 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridPbkdf2>();
       }
     );
+#endif
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Random",
       []() -> std::shared_ptr<HybridObject> {
@@ -145,6 +206,7 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridRandom>();
       }
     );
+#ifndef RNQC_DISABLE_RSA
     HybridObjectRegistry::registerHybridObjectConstructor(
       "RsaCipher",
       []() -> std::shared_ptr<HybridObject> {
@@ -154,6 +216,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridRsaCipher>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_RSA
     HybridObjectRegistry::registerHybridObjectConstructor(
       "RsaKeyPair",
       []() -> std::shared_ptr<HybridObject> {
@@ -163,6 +227,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridRsaKeyPair>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_KEYS
     HybridObjectRegistry::registerHybridObjectConstructor(
       "SignHandle",
       []() -> std::shared_ptr<HybridObject> {
@@ -172,6 +238,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridSignHandle>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_KEYS
     HybridObjectRegistry::registerHybridObjectConstructor(
       "VerifyHandle",
       []() -> std::shared_ptr<HybridObject> {
@@ -181,6 +249,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridVerifyHandle>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_MLDSA
     HybridObjectRegistry::registerHybridObjectConstructor(
       "MlDsaKeyPair",
       []() -> std::shared_ptr<HybridObject> {
@@ -190,6 +260,8 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridMlDsaKeyPair>();
       }
     );
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Scrypt",
       []() -> std::shared_ptr<HybridObject> {
@@ -199,6 +271,7 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridScrypt>();
       }
     );
+#endif
     HybridObjectRegistry::registerHybridObjectConstructor(
       "Utils",
       []() -> std::shared_ptr<HybridObject> {
@@ -208,6 +281,103 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridUtils>();
       }
     );
+#ifndef RNQC_DISABLE_COMPRESS
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "CompressCipher",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridCompressCipher>,
+                      "The HybridObject \"HybridCompressCipher\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridCompressCipher>();
+      }
+    );
+#endif
+#ifndef RNQC_DISABLE_PAGECIPHER
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "PageCipher",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridPageCipher>,
+                      "The HybridObject \"HybridPageCipher\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridPageCipher>();
+      }
+    );
+#endif
+#ifndef RNQC_DISABLE_DH
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "DiffieHellman",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridDiffieHellman>,
+                      "The HybridObject \"HybridDiffieHellman\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridDiffieHellman>();
+      }
+    );
+#endif
+#ifndef RNQC_DISABLE_DH
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "ECDH",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridECDH>,
+                      "The HybridObject \"HybridECDH\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridECDH>();
+      }
+    );
+#endif
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "Mac",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridMac>,
+                      "The HybridObject \"HybridMac\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridMac>();
+      }
+    );
+#ifndef RNQC_DISABLE_PAGECIPHER
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "KeyRotation",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridKeyRotation>,
+                      "The HybridObject \"HybridKeyRotation\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridKeyRotation>();
+      }
+    );
+#endif
+#ifndef RNQC_DISABLE_KEYS
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "KeyWrap",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridKeyWrap>,
+                      "The HybridObject \"HybridKeyWrap\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridKeyWrap>();
+      }
+    );
+#endif
+#ifndef RNQC_DISABLE_OPRF
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "Oprf",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridOprf>,
+                      "The HybridObject \"HybridOprf\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridOprf>();
+      }
+    );
+#endif
+#ifndef RNQC_DISABLE_NOISE
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "NoiseHandshake",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridNoiseHandshake>,
+                      "The HybridObject \"HybridNoiseHandshake\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridNoiseHandshake>();
+      }
+    );
+#endif
   });
 }
 
@@ -10,24 +10,73 @@
 
 #import <type_traits>
 
+#ifndef RNQC_DISABLE_BLAKE3
 #include "HybridBlake3.hpp"
+#endif
 #include "HybridCipher.hpp"
 #include "HybridCipherFactory.hpp"
+#ifndef RNQC_DISABLE_EC
 #include "HybridEcKeyPair.hpp"
+#endif
+#ifndef RNQC_DISABLE_ED25519
 #include "HybridEdKeyPair.hpp"
+#endif
 #include "HybridHash.hpp"
 #include "HybridHmac.hpp"
+#ifndef RNQC_DISABLE_HKDF
 #include "HybridHkdf.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
 #include "HybridKeyObjectHandle.hpp"
+#endif
+#ifndef RNQC_DISABLE_PBKDF2
 #include "HybridPbkdf2.hpp"
+#endif
 #include "HybridRandom.hpp"
+#ifndef RNQC_DISABLE_RSA
 #include "HybridRsaCipher.hpp"
+#endif
+#ifndef RNQC_DISABLE_RSA
 #include "HybridRsaKeyPair.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
 #include "HybridSignHandle.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
 #include "HybridVerifyHandle.hpp"
+#endif
+#ifndef RNQC_DISABLE_MLDSA
 #include "HybridMlDsaKeyPair.hpp"
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
 #include "HybridScrypt.hpp"
+#endif
 #include "HybridUtils.hpp"
+#ifndef RNQC_DISABLE_COMPRESS
+#include "HybridCompressCipher.hpp"
+#endif
+#ifndef RNQC_DISABLE_PAGECIPHER
+#include "HybridPageCipher.hpp"
+#endif
+#ifndef RNQC_DISABLE_DH
+#include "HybridDiffieHellman.hpp"
+#endif
+#ifndef RNQC_DISABLE_DH
+#include "HybridECDH.hpp"
+#endif
+#include "HybridMac.hpp"
+#ifndef RNQC_DISABLE_PAGECIPHER
+#include "HybridKeyRotation.hpp"
+#endif
+#ifndef RNQC_DISABLE_KEYS
+#include "HybridKeyWrap.hpp"
+#endif
+#ifndef RNQC_DISABLE_OPRF
+#include "HybridOprf.hpp"
+#endif
+#ifndef RNQC_DISABLE_NOISE
+#include "HybridNoiseHandshake.hpp"
+#endif
 
 @interface QuickCryptoAutolinking : NSObject
 @end
@@ -38,6 +87,7 @@
   using namespace margelo::nitro;
   using namespace margelo::nitro::crypto;
 
+#ifndef RNQC_DISABLE_BLAKE3
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Blake3",
     []() -> std::shared_ptr<HybridObject> {
@@ -47,6 +97,7 @@
       return std::make_shared<HybridBlake3>();
     }
   );
+#endif
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Cipher",
     []() -> std::shared_ptr<HybridObject> {
@@ -65,6 +116,7 @@
       return std::make_shared<HybridCipherFactory>();
     }
   );
+#ifndef RNQC_DISABLE_EC
   HybridObjectRegistry::registerHybridObjectConstructor(
     "EcKeyPair",
     []() -> std::shared_ptr<HybridObject> {
@@ -74,6 +126,8 @@
       return std::make_shared<HybridEcKeyPair>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_ED25519
   HybridObjectRegistry::registerHybridObjectConstructor(
     "EdKeyPair",
     []() -> std::shared_ptr<HybridObject> {
@@ -83,6 +137,7 @@
       return std::make_shared<HybridEdKeyPair>();
     }
   );
+#endif
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Hash",
     []() -> std::shared_ptr<HybridObject> {
@@ -101,6 +156,7 @@
       return std::make_shared<HybridHmac>();
     }
   );
+#ifndef RNQC_DISABLE_HKDF
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Hkdf",
     []() -> std::shared_ptr<HybridObject> {
@@ -110,6 +166,8 @@
       return std::make_shared<HybridHkdf>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_KEYS
   HybridObjectRegistry::registerHybridObjectConstructor(
     "KeyObjectHandle",
     []() -> std::shared_ptr<HybridObject> {
@@ -119,6 +177,8 @@
       return std::make_shared<HybridKeyObjectHandle>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_PBKDF2
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Pbkdf2",
     []() -> std::shared_ptr<HybridObject> {
@@ -128,6 +188,7 @@
       return std::make_shared<HybridPbkdf2>();
     }
   );
+#endif
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Random",
     []() -> std::shared_ptr<HybridObject> {
@@ -137,6 +198,7 @@
       return std::make_shared<HybridRandom>();
     }
   );
+#ifndef RNQC_DISABLE_RSA
   HybridObjectRegistry::registerHybridObjectConstructor(
     "RsaCipher",
     []() -> std::shared_ptr<HybridObject> {
@@ -146,6 +208,8 @@
       return std::make_shared<HybridRsaCipher>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_RSA
   HybridObjectRegistry::registerHybridObjectConstructor(
     "RsaKeyPair",
     []() -> std::shared_ptr<HybridObject> {
@@ -155,6 +219,8 @@
       return std::make_shared<HybridRsaKeyPair>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_KEYS
   HybridObjectRegistry::registerHybridObjectConstructor(
     "SignHandle",
     []() -> std::shared_ptr<HybridObject> {
@@ -164,6 +230,8 @@
       return std::make_shared<HybridSignHandle>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_KEYS
   HybridObjectRegistry::registerHybridObjectConstructor(
     "VerifyHandle",
     []() -> std::shared_ptr<HybridObject> {
@@ -173,6 +241,8 @@
       return std::make_shared<HybridVerifyHandle>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_MLDSA
   HybridObjectRegistry::registerHybridObjectConstructor(
     "MlDsaKeyPair",
     []() -> std::shared_ptr<HybridObject> {
@@ -182,6 +252,8 @@
       return std::make_shared<HybridMlDsaKeyPair>();
     }
   );
+#endif
+#ifndef RNQC_DISABLE_SCRYPT
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Scrypt",
     []() -> std::shared_ptr<HybridObject> {
@@ -191,6 +263,7 @@
       return std::make_shared<HybridScrypt>();
     }
   );
+#endif
   HybridObjectRegistry::registerHybridObjectConstructor(
     "Utils",
     []() -> std::shared_ptr<HybridObject> {
@@ -200,6 +273,103 @@
       return std::make_shared<HybridUtils>();
     }
   );
+#ifndef RNQC_DISABLE_COMPRESS
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "CompressCipher",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridCompressCipher>,
+                    "The HybridObject \"HybridCompressCipher\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridCompressCipher>();
+    }
+  );
+#endif
+#ifndef RNQC_DISABLE_PAGECIPHER
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "PageCipher",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridPageCipher>,
+                    "The HybridObject \"HybridPageCipher\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridPageCipher>();
+    }
+  );
+#endif
+#ifndef RNQC_DISABLE_DH
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "DiffieHellman",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridDiffieHellman>,
+                    "The HybridObject \"HybridDiffieHellman\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridDiffieHellman>();
+    }
+  );
+#endif
+#ifndef RNQC_DISABLE_DH
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "ECDH",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridECDH>,
+                    "The HybridObject \"HybridECDH\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridECDH>();
+    }
+  );
+#endif
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "Mac",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridMac>,
+                    "The HybridObject \"HybridMac\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridMac>();
+    }
+  );
+#ifndef RNQC_DISABLE_PAGECIPHER
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "KeyRotation",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridKeyRotation>,
+                    "The HybridObject \"HybridKeyRotation\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridKeyRotation>();
+    }
+  );
+#endif
+#ifndef RNQC_DISABLE_KEYS
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "KeyWrap",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridKeyWrap>,
+                    "The HybridObject \"HybridKeyWrap\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridKeyWrap>();
+    }
+  );
+#endif
+#ifndef RNQC_DISABLE_OPRF
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "Oprf",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridOprf>,
+                    "The HybridObject \"HybridOprf\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridOprf>();
+    }
+  );
+#endif
+#ifndef RNQC_DISABLE_NOISE
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "NoiseHandshake",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridNoiseHandshake>,
+                    "The HybridObject \"HybridNoiseHandshake\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridNoiseHandshake>();
+    }
+  );
+#endif
 }
 
 @end
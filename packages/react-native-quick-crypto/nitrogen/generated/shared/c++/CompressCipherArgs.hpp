@@ -0,0 +1,94 @@
+///
+/// CompressCipherArgs.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+
+namespace margelo::nitro::crypto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (CompressCipherArgs).
+   */
+  struct CompressCipherArgs {
+  public:
+    bool encrypt     SWIFT_PRIVATE;
+    std::string cipherType     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> cipherKey     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> iv     SWIFT_PRIVATE;
+    std::optional<double> authTagLen     SWIFT_PRIVATE;
+    std::optional<double> level     SWIFT_PRIVATE;
+    std::optional<double> maxOutputLength     SWIFT_PRIVATE;
+
+  public:
+    CompressCipherArgs() = default;
+    explicit CompressCipherArgs(bool encrypt, std::string cipherType, std::shared_ptr<ArrayBuffer> cipherKey, std::shared_ptr<ArrayBuffer> iv, std::optional<double> authTagLen, std::optional<double> level, std::optional<double> maxOutputLength): encrypt(encrypt), cipherType(cipherType), cipherKey(cipherKey), iv(iv), authTagLen(authTagLen), level(level), maxOutputLength(maxOutputLength) {}
+  };
+
+} // namespace margelo::nitro::crypto
+
+namespace margelo::nitro {
+
+  // C++ CompressCipherArgs <> JS CompressCipherArgs (object)
+  template <>
+  struct JSIConverter<margelo::nitro::crypto::CompressCipherArgs> final {
+    static inline margelo::nitro::crypto::CompressCipherArgs fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::crypto::CompressCipherArgs(
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "encrypt")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "cipherType")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "cipherKey")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "iv")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "authTagLen")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "level")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxOutputLength"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::crypto::CompressCipherArgs& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "encrypt", JSIConverter<bool>::toJSI(runtime, arg.encrypt));
+      obj.setProperty(runtime, "cipherType", JSIConverter<std::string>::toJSI(runtime, arg.cipherType));
+      obj.setProperty(runtime, "cipherKey", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.cipherKey));
+      obj.setProperty(runtime, "iv", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.iv));
+      obj.setProperty(runtime, "authTagLen", JSIConverter<std::optional<double>>::toJSI(runtime, arg.authTagLen));
+      obj.setProperty(runtime, "level", JSIConverter<std::optional<double>>::toJSI(runtime, arg.level));
+      obj.setProperty(runtime, "maxOutputLength", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxOutputLength));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "encrypt"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "cipherType"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "cipherKey"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "iv"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "authTagLen"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "level"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxOutputLength"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
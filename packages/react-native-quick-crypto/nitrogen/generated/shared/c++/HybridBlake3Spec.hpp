@@ -58,7 +58,7 @@ namespace margelo::nitro::crypto {
       virtual void initHash() = 0;
       virtual void initKeyed(const std::shared_ptr<ArrayBuffer>& key) = 0;
       virtual void initDeriveKey(const std::string& context) = 0;
-      virtual void update(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual void update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset, const std::optional<double>& byteLength) = 0;
       virtual std::shared_ptr<ArrayBuffer> digest(std::optional<double> length) = 0;
       virtual void reset() = 0;
       virtual std::shared_ptr<HybridBlake3Spec> copy() = 0;
@@ -16,6 +16,8 @@ namespace margelo::nitro::crypto {
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("update", &HybridCipherSpec::update);
       prototype.registerHybridMethod("final", &HybridCipherSpec::final);
+      prototype.registerHybridMethod("updateAsync", &HybridCipherSpec::updateAsync);
+      prototype.registerHybridMethod("finalAsync", &HybridCipherSpec::finalAsync);
       prototype.registerHybridMethod("setArgs", &HybridCipherSpec::setArgs);
       prototype.registerHybridMethod("setAAD", &HybridCipherSpec::setAAD);
       prototype.registerHybridMethod("setAutoPadding", &HybridCipherSpec::setAutoPadding);
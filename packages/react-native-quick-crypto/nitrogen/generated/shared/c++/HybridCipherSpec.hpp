@@ -19,6 +19,7 @@ namespace NitroModules { class ArrayBuffer; }
 namespace margelo::nitro::crypto { struct CipherArgs; }
 
 #include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
 #include "CipherArgs.hpp"
 #include <optional>
 #include <string>
@@ -55,8 +56,10 @@ namespace margelo::nitro::crypto {
 
     public:
       // Methods
-      virtual std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset, const std::optional<double>& byteLength) = 0;
       virtual std::shared_ptr<ArrayBuffer> final() = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> updateAsync(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset, const std::optional<double>& byteLength) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> finalAsync() = 0;
       virtual void setArgs(const CipherArgs& args) = 0;
       virtual bool setAAD(const std::shared_ptr<ArrayBuffer>& data, std::optional<double> plaintextLength) = 0;
       virtual bool setAutoPadding(bool autoPad) = 0;
@@ -0,0 +1,27 @@
+///
+/// HybridCompressCipherSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridCompressCipherSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridCompressCipherSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("init", &HybridCompressCipherSpec::init);
+      prototype.registerHybridMethod("setAAD", &HybridCompressCipherSpec::setAAD);
+      prototype.registerHybridMethod("update", &HybridCompressCipherSpec::update);
+      prototype.registerHybridMethod("final", &HybridCompressCipherSpec::final);
+      prototype.registerHybridMethod("process", &HybridCompressCipherSpec::process);
+      prototype.registerHybridMethod("setAuthTag", &HybridCompressCipherSpec::setAuthTag);
+      prototype.registerHybridMethod("getAuthTag", &HybridCompressCipherSpec::getAuthTag);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,72 @@
+///
+/// HybridCompressCipherSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `CompressCipherArgs` to properly resolve imports.
+namespace margelo::nitro::crypto { struct CompressCipherArgs; }
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include "CompressCipherArgs.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `CompressCipher`
+   * Inherit this class to create instances of `HybridCompressCipherSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridCompressCipher: public HybridCompressCipherSpec {
+   * public:
+   *   HybridCompressCipher(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridCompressCipherSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridCompressCipherSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridCompressCipherSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void init(const CompressCipherArgs& args) = 0;
+      virtual void setAAD(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual std::shared_ptr<ArrayBuffer> update(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual std::shared_ptr<ArrayBuffer> final() = 0;
+      virtual std::shared_ptr<ArrayBuffer> process(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual void setAuthTag(const std::shared_ptr<ArrayBuffer>& tag) = 0;
+      virtual std::shared_ptr<ArrayBuffer> getAuthTag() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "CompressCipher";
+  };
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,35 @@
+///
+/// HybridDiffieHellmanSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridDiffieHellmanSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridDiffieHellmanSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("initGroup", &HybridDiffieHellmanSpec::initGroup);
+      prototype.registerHybridMethod("init", &HybridDiffieHellmanSpec::init);
+      prototype.registerHybridMethod("generateParametersSync", &HybridDiffieHellmanSpec::generateParametersSync);
+      prototype.registerHybridMethod("generateParameters", &HybridDiffieHellmanSpec::generateParameters);
+      prototype.registerHybridMethod("generateKeys", &HybridDiffieHellmanSpec::generateKeys);
+      prototype.registerHybridMethod("computeSecret", &HybridDiffieHellmanSpec::computeSecret);
+      prototype.registerHybridMethod("computeSecrets", &HybridDiffieHellmanSpec::computeSecrets);
+      prototype.registerHybridMethod("computeSecretsAsync", &HybridDiffieHellmanSpec::computeSecretsAsync);
+      prototype.registerHybridMethod("getPrime", &HybridDiffieHellmanSpec::getPrime);
+      prototype.registerHybridMethod("getGenerator", &HybridDiffieHellmanSpec::getGenerator);
+      prototype.registerHybridMethod("getPublicKey", &HybridDiffieHellmanSpec::getPublicKey);
+      prototype.registerHybridMethod("getPrivateKey", &HybridDiffieHellmanSpec::getPrivateKey);
+      prototype.registerHybridMethod("setPublicKey", &HybridDiffieHellmanSpec::setPublicKey);
+      prototype.registerHybridMethod("setPrivateKey", &HybridDiffieHellmanSpec::setPrivateKey);
+      prototype.registerHybridMethod("getVerifyError", &HybridDiffieHellmanSpec::getVerifyError);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,31 @@
+///
+/// HybridECDHSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridECDHSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridECDHSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("setCurve", &HybridECDHSpec::setCurve);
+      prototype.registerHybridMethod("generateKeys", &HybridECDHSpec::generateKeys);
+      prototype.registerHybridMethod("computeSecret", &HybridECDHSpec::computeSecret);
+      prototype.registerHybridMethod("computeSecrets", &HybridECDHSpec::computeSecrets);
+      prototype.registerHybridMethod("computeSecretsAsync", &HybridECDHSpec::computeSecretsAsync);
+      prototype.registerHybridMethod("getPublicKey", &HybridECDHSpec::getPublicKey);
+      prototype.registerHybridMethod("getPrivateKey", &HybridECDHSpec::getPrivateKey);
+      prototype.registerHybridMethod("setPublicKey", &HybridECDHSpec::setPublicKey);
+      prototype.registerHybridMethod("setPrivateKey", &HybridECDHSpec::setPrivateKey);
+      prototype.registerHybridMethod("convertKey", &HybridECDHSpec::convertKey);
+      prototype.registerHybridMethod("convertKeys", &HybridECDHSpec::convertKeys);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,76 @@
+///
+/// HybridECDHSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <vector>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `ECDH`
+   * Inherit this class to create instances of `HybridECDHSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridECDH: public HybridECDHSpec {
+   * public:
+   *   HybridECDH(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridECDHSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridECDHSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridECDHSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void setCurve(const std::string& name) = 0;
+      virtual void generateKeys() = 0;
+      virtual std::shared_ptr<ArrayBuffer> computeSecret(const std::shared_ptr<ArrayBuffer>& publicKey) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> computeSecrets(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> computeSecretsAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& publicKeys) = 0;
+      virtual std::shared_ptr<ArrayBuffer> getPublicKey(double format) = 0;
+      virtual std::shared_ptr<ArrayBuffer> getPrivateKey() = 0;
+      virtual void setPublicKey(const std::shared_ptr<ArrayBuffer>& publicKey) = 0;
+      virtual void setPrivateKey(const std::shared_ptr<ArrayBuffer>& privateKey) = 0;
+      virtual std::shared_ptr<ArrayBuffer> convertKey(const std::string& curve, const std::shared_ptr<ArrayBuffer>& key, double format) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> convertKeys(const std::string& curve, const std::vector<std::shared_ptr<ArrayBuffer>>& keys, double format) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "ECDH";
+  };
+
+} // namespace margelo::nitro::crypto
@@ -58,7 +58,7 @@ namespace margelo::nitro::crypto {
     public:
       // Methods
       virtual void createHash(const std::string& algorithm, std::optional<double> outputLength) = 0;
-      virtual void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data) = 0;
+      virtual void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset, const std::optional<double>& byteLength) = 0;
       virtual std::shared_ptr<ArrayBuffer> digest(const std::optional<std::string>& encoding) = 0;
       virtual std::shared_ptr<HybridHashSpec> copy(std::optional<double> outputLength) = 0;
       virtual std::vector<std::string> getSupportedHashAlgorithms() = 0;
@@ -17,6 +17,8 @@ namespace margelo::nitro::crypto {
       prototype.registerHybridMethod("createHmac", &HybridHmacSpec::createHmac);
       prototype.registerHybridMethod("update", &HybridHmacSpec::update);
       prototype.registerHybridMethod("digest", &HybridHmacSpec::digest);
+      prototype.registerHybridMethod("hmacMany", &HybridHmacSpec::hmacMany);
+      prototype.registerHybridMethod("hmacManyAsync", &HybridHmacSpec::hmacManyAsync);
     });
   }
 
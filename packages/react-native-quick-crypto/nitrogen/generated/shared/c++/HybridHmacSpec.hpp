@@ -19,6 +19,9 @@ namespace NitroModules { class ArrayBuffer; }
 #include <string>
 #include <NitroModules/ArrayBuffer.hpp>
 #include <variant>
+#include <optional>
+#include <vector>
+#include <NitroModules/Promise.hpp>
 
 namespace margelo::nitro::crypto {
 
@@ -52,8 +55,10 @@ namespace margelo::nitro::crypto {
     public:
       // Methods
       virtual void createHmac(const std::string& algorithm, const std::shared_ptr<ArrayBuffer>& key) = 0;
-      virtual void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data) = 0;
+      virtual void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset, const std::optional<double>& byteLength) = 0;
       virtual std::shared_ptr<ArrayBuffer> digest() = 0;
+      virtual std::shared_ptr<ArrayBuffer> hmacMany(const std::string& algorithm, const std::shared_ptr<ArrayBuffer>& key, const std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>& messages, std::optional<double> truncateTo) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> hmacManyAsync(const std::string& algorithm, const std::shared_ptr<ArrayBuffer>& key, const std::vector<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>& messages, std::optional<double> truncateTo) = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,24 @@
+///
+/// HybridKeyRotationSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridKeyRotationSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridKeyRotationSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("init", &HybridKeyRotationSpec::init);
+      prototype.registerHybridMethod("getCounter", &HybridKeyRotationSpec::getCounter);
+      prototype.registerHybridMethod("reencryptBatch", &HybridKeyRotationSpec::reencryptBatch);
+      prototype.registerHybridMethod("reencryptBatchAsync", &HybridKeyRotationSpec::reencryptBatchAsync);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
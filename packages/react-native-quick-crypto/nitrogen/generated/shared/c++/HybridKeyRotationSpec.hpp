@@ -0,0 +1,72 @@
+///
+/// HybridKeyRotationSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `KeyRotationArgs` to properly resolve imports.
+namespace margelo::nitro::crypto { struct KeyRotationArgs; }
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include "KeyRotationArgs.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <vector>
+#include <optional>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `KeyRotation`
+   * Inherit this class to create instances of `HybridKeyRotationSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridKeyRotation: public HybridKeyRotationSpec {
+   * public:
+   *   HybridKeyRotation(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridKeyRotationSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridKeyRotationSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridKeyRotationSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void init(const KeyRotationArgs& args) = 0;
+      virtual double getCounter() = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> reencryptBatch(const std::vector<std::shared_ptr<ArrayBuffer>>& records, const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad, std::optional<double> parallelism) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> reencryptBatchAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& records, const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& aad, std::optional<double> parallelism) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "KeyRotation";
+  };
+
+} // namespace margelo::nitro::crypto
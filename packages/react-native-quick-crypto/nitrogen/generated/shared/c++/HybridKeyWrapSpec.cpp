@@ -0,0 +1,27 @@
+///
+/// HybridKeyWrapSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridKeyWrapSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridKeyWrapSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("init", &HybridKeyWrapSpec::init);
+      prototype.registerHybridMethod("wrapKeys", &HybridKeyWrapSpec::wrapKeys);
+      prototype.registerHybridMethod("wrapKeysAsync", &HybridKeyWrapSpec::wrapKeysAsync);
+      prototype.registerHybridMethod("unwrapKeys", &HybridKeyWrapSpec::unwrapKeys);
+      prototype.registerHybridMethod("unwrapKeysAsync", &HybridKeyWrapSpec::unwrapKeysAsync);
+      prototype.registerHybridMethod("getCachedCount", &HybridKeyWrapSpec::getCachedCount);
+      prototype.registerHybridMethod("clearCache", &HybridKeyWrapSpec::clearCache);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,75 @@
+///
+/// HybridKeyWrapSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `HybridKeyObjectHandleSpec` to properly resolve imports.
+namespace margelo::nitro::crypto { class HybridKeyObjectHandleSpec; }
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <memory>
+#include "HybridKeyObjectHandleSpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <vector>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `KeyWrap`
+   * Inherit this class to create instances of `HybridKeyWrapSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridKeyWrap: public HybridKeyWrapSpec {
+   * public:
+   *   HybridKeyWrap(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridKeyWrapSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridKeyWrapSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridKeyWrapSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void init(const std::shared_ptr<HybridKeyObjectHandleSpec>& kek, bool padded, double cacheSize) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> wrapKeys(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> wrapKeysAsync(const std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>& keys) = 0;
+      virtual std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>> unwrapKeys(const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<HybridKeyObjectHandleSpec>>>> unwrapKeysAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& wrapped) = 0;
+      virtual double getCachedCount() = 0;
+      virtual void clearCache() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "KeyWrap";
+  };
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,28 @@
+///
+/// HybridMacSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridMacSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridMacSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("init", &HybridMacSpec::init);
+      prototype.registerHybridMethod("update", &HybridMacSpec::update);
+      prototype.registerHybridMethod("digest", &HybridMacSpec::digest);
+      prototype.registerHybridMethod("copy", &HybridMacSpec::copy);
+      prototype.registerHybridMethod("getMacLength", &HybridMacSpec::getMacLength);
+      prototype.registerHybridMethod("compute", &HybridMacSpec::compute);
+      prototype.registerHybridMethod("computeMany", &HybridMacSpec::computeMany);
+      prototype.registerHybridMethod("computeManyAsync", &HybridMacSpec::computeManyAsync);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,82 @@
+///
+/// HybridMacSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `MacArgs` to properly resolve imports.
+namespace margelo::nitro::crypto { struct MacArgs; }
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `HybridMacSpec` to properly resolve imports.
+namespace margelo::nitro::crypto { class HybridMacSpec; }
+
+#include "MacArgs.hpp"
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <variant>
+#include <optional>
+#include <memory>
+#include "HybridMacSpec.hpp"
+#include <vector>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `Mac`
+   * Inherit this class to create instances of `HybridMacSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridMac: public HybridMacSpec {
+   * public:
+   *   HybridMac(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridMacSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridMacSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridMacSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void init(const MacArgs& args) = 0;
+      virtual void update(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& data, const std::optional<double>& byteOffset, const std::optional<double>& byteLength) = 0;
+      virtual std::shared_ptr<ArrayBuffer> digest() = 0;
+      virtual std::shared_ptr<HybridMacSpec> copy() = 0;
+      virtual double getMacLength() = 0;
+      virtual std::shared_ptr<ArrayBuffer> compute(const std::shared_ptr<ArrayBuffer>& data, const std::optional<std::shared_ptr<ArrayBuffer>>& iv) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> computeMany(const std::vector<std::shared_ptr<ArrayBuffer>>& messages, const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& ivs) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> computeManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& messages, const std::optional<std::vector<std::shared_ptr<ArrayBuffer>>>& ivs) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "Mac";
+  };
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,28 @@
+///
+/// HybridNoiseHandshakeSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridNoiseHandshakeSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridNoiseHandshakeSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("init", &HybridNoiseHandshakeSpec::init);
+      prototype.registerHybridMethod("generateKeyPair", &HybridNoiseHandshakeSpec::generateKeyPair);
+      prototype.registerHybridMethod("getAction", &HybridNoiseHandshakeSpec::getAction);
+      prototype.registerHybridMethod("writeMessage", &HybridNoiseHandshakeSpec::writeMessage);
+      prototype.registerHybridMethod("readMessage", &HybridNoiseHandshakeSpec::readMessage);
+      prototype.registerHybridMethod("getHandshakeHash", &HybridNoiseHandshakeSpec::getHandshakeHash);
+      prototype.registerHybridMethod("getRemoteStaticPublicKey", &HybridNoiseHandshakeSpec::getRemoteStaticPublicKey);
+      prototype.registerHybridMethod("split", &HybridNoiseHandshakeSpec::split);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,80 @@
+///
+/// HybridNoiseHandshakeSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NoiseHandshakeArgs` to properly resolve imports.
+namespace margelo::nitro::crypto { struct NoiseHandshakeArgs; }
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `HybridNoiseTransportSpec` to properly resolve imports.
+namespace margelo::nitro::crypto { class HybridNoiseTransportSpec; }
+
+#include "NoiseHandshakeArgs.hpp"
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <vector>
+#include <optional>
+#include <memory>
+#include "HybridNoiseTransportSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NoiseHandshake`
+   * Inherit this class to create instances of `HybridNoiseHandshakeSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNoiseHandshake: public HybridNoiseHandshakeSpec {
+   * public:
+   *   HybridNoiseHandshake(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNoiseHandshakeSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNoiseHandshakeSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNoiseHandshakeSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void init(const NoiseHandshakeArgs& args) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> generateKeyPair(const std::string& dh) = 0;
+      virtual std::string getAction() = 0;
+      virtual std::shared_ptr<ArrayBuffer> writeMessage(const std::shared_ptr<ArrayBuffer>& payload) = 0;
+      virtual std::shared_ptr<ArrayBuffer> readMessage(const std::shared_ptr<ArrayBuffer>& message) = 0;
+      virtual std::shared_ptr<ArrayBuffer> getHandshakeHash() = 0;
+      virtual std::optional<std::shared_ptr<ArrayBuffer>> getRemoteStaticPublicKey() = 0;
+      virtual std::shared_ptr<HybridNoiseTransportSpec> split() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NoiseHandshake";
+  };
+
+} // namespace margelo::nitro::crypto
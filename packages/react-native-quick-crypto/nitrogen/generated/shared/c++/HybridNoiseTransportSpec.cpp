@@ -0,0 +1,28 @@
+///
+/// HybridNoiseTransportSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridNoiseTransportSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridNoiseTransportSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("encrypt", &HybridNoiseTransportSpec::encrypt);
+      prototype.registerHybridMethod("decrypt", &HybridNoiseTransportSpec::decrypt);
+      prototype.registerHybridMethod("encryptMany", &HybridNoiseTransportSpec::encryptMany);
+      prototype.registerHybridMethod("encryptManyAsync", &HybridNoiseTransportSpec::encryptManyAsync);
+      prototype.registerHybridMethod("decryptMany", &HybridNoiseTransportSpec::decryptMany);
+      prototype.registerHybridMethod("decryptManyAsync", &HybridNoiseTransportSpec::decryptManyAsync);
+      prototype.registerHybridMethod("rekeySend", &HybridNoiseTransportSpec::rekeySend);
+      prototype.registerHybridMethod("rekeyReceive", &HybridNoiseTransportSpec::rekeyReceive);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
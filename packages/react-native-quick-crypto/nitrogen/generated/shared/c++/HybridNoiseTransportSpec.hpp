@@ -0,0 +1,73 @@
+///
+/// HybridNoiseTransportSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+#include <vector>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NoiseTransport`
+   * Inherit this class to create instances of `HybridNoiseTransportSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNoiseTransport: public HybridNoiseTransportSpec {
+   * public:
+   *   HybridNoiseTransport(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNoiseTransportSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNoiseTransportSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNoiseTransportSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual std::shared_ptr<ArrayBuffer> encrypt(const std::shared_ptr<ArrayBuffer>& plaintext, const std::optional<std::shared_ptr<ArrayBuffer>>& ad) = 0;
+      virtual std::shared_ptr<ArrayBuffer> decrypt(const std::shared_ptr<ArrayBuffer>& ciphertext, const std::optional<std::shared_ptr<ArrayBuffer>>& ad) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> encryptMany(const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> encryptManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& plaintexts) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> decryptMany(const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> decryptManyAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& ciphertexts) = 0;
+      virtual void rekeySend() = 0;
+      virtual void rekeyReceive() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NoiseTransport";
+  };
+
+} // namespace margelo::nitro::crypto
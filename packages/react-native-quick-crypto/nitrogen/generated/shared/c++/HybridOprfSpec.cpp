@@ -0,0 +1,32 @@
+///
+/// HybridOprfSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridOprfSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridOprfSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("init", &HybridOprfSpec::init);
+      prototype.registerHybridMethod("randomScalars", &HybridOprfSpec::randomScalars);
+      prototype.registerHybridMethod("deriveKeyPair", &HybridOprfSpec::deriveKeyPair);
+      prototype.registerHybridMethod("hashToGroup", &HybridOprfSpec::hashToGroup);
+      prototype.registerHybridMethod("blind", &HybridOprfSpec::blind);
+      prototype.registerHybridMethod("blindAsync", &HybridOprfSpec::blindAsync);
+      prototype.registerHybridMethod("finalize", &HybridOprfSpec::finalize);
+      prototype.registerHybridMethod("finalizeAsync", &HybridOprfSpec::finalizeAsync);
+      prototype.registerHybridMethod("verifyProof", &HybridOprfSpec::verifyProof);
+      prototype.registerHybridMethod("verifyProofAsync", &HybridOprfSpec::verifyProofAsync);
+      prototype.registerHybridMethod("blindEvaluate", &HybridOprfSpec::blindEvaluate);
+      prototype.registerHybridMethod("generateProof", &HybridOprfSpec::generateProof);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
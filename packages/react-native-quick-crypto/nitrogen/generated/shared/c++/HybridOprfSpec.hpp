@@ -0,0 +1,78 @@
+///
+/// HybridOprfSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <vector>
+#include <optional>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `Oprf`
+   * Inherit this class to create instances of `HybridOprfSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridOprf: public HybridOprfSpec {
+   * public:
+   *   HybridOprf(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridOprfSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridOprfSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridOprfSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void init(const std::string& suite, bool verifiable) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> randomScalars(double count) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> deriveKeyPair(const std::shared_ptr<ArrayBuffer>& seed, const std::shared_ptr<ArrayBuffer>& info) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> hashToGroup(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::optional<std::shared_ptr<ArrayBuffer>>& dst) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> blind(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> blindAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> finalize(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds, const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>> finalizeAsync(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::vector<std::shared_ptr<ArrayBuffer>>& blinds, const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements) = 0;
+      virtual bool verifyProof(const std::shared_ptr<ArrayBuffer>& publicKey, const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements, const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements, const std::shared_ptr<ArrayBuffer>& proof) = 0;
+      virtual std::shared_ptr<Promise<bool>> verifyProofAsync(const std::shared_ptr<ArrayBuffer>& publicKey, const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements, const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements, const std::shared_ptr<ArrayBuffer>& proof) = 0;
+      virtual std::vector<std::shared_ptr<ArrayBuffer>> blindEvaluate(const std::shared_ptr<ArrayBuffer>& privateKey, const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements) = 0;
+      virtual std::shared_ptr<ArrayBuffer> generateProof(const std::shared_ptr<ArrayBuffer>& privateKey, const std::vector<std::shared_ptr<ArrayBuffer>>& blindedElements, const std::vector<std::shared_ptr<ArrayBuffer>>& evaluatedElements, const std::optional<std::shared_ptr<ArrayBuffer>>& proofScalar) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "Oprf";
+  };
+
+} // namespace margelo::nitro::crypto
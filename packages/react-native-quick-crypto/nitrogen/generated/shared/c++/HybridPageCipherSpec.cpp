@@ -0,0 +1,26 @@
+///
+/// HybridPageCipherSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridPageCipherSpec.hpp"
+
+namespace margelo::nitro::crypto {
+
+  void HybridPageCipherSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("init", &HybridPageCipherSpec::init);
+      prototype.registerHybridMethod("getReserveSize", &HybridPageCipherSpec::getReserveSize);
+      prototype.registerHybridMethod("encryptPages", &HybridPageCipherSpec::encryptPages);
+      prototype.registerHybridMethod("decryptPages", &HybridPageCipherSpec::decryptPages);
+      prototype.registerHybridMethod("encryptPagesAsync", &HybridPageCipherSpec::encryptPagesAsync);
+      prototype.registerHybridMethod("decryptPagesAsync", &HybridPageCipherSpec::decryptPagesAsync);
+    });
+  }
+
+} // namespace margelo::nitro::crypto
@@ -0,0 +1,74 @@
+///
+/// HybridPageCipherSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `PageCipherArgs` to properly resolve imports.
+namespace margelo::nitro::crypto { struct PageCipherArgs; }
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include "PageCipherArgs.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <vector>
+#include <optional>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::crypto {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `PageCipher`
+   * Inherit this class to create instances of `HybridPageCipherSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridPageCipher: public HybridPageCipherSpec {
+   * public:
+   *   HybridPageCipher(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridPageCipherSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridPageCipherSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridPageCipherSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual void init(const PageCipherArgs& args) = 0;
+      virtual double getReserveSize() = 0;
+      virtual void encryptPages(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers, const std::vector<double>& writeCounters, std::optional<double> parallelism) = 0;
+      virtual void decryptPages(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers, std::optional<double> parallelism) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> encryptPagesAsync(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers, const std::vector<double>& writeCounters, std::optional<double> parallelism) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> decryptPagesAsync(const std::shared_ptr<ArrayBuffer>& pages, const std::vector<double>& pageNumbers, std::optional<double> parallelism) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "PageCipher";
+  };
+
+} // namespace margelo::nitro::crypto
@@ -19,6 +19,8 @@ namespace margelo::nitro::crypto {
       prototype.registerHybridMethod("setModulusLength", &HybridRsaKeyPairSpec::setModulusLength);
       prototype.registerHybridMethod("setPublicExponent", &HybridRsaKeyPairSpec::setPublicExponent);
       prototype.registerHybridMethod("setHashAlgorithm", &HybridRsaKeyPairSpec::setHashAlgorithm);
+      prototype.registerHybridMethod("setPrimes", &HybridRsaKeyPairSpec::setPrimes);
+      prototype.registerHybridMethod("setParallelism", &HybridRsaKeyPairSpec::setParallelism);
       prototype.registerHybridMethod("importKey", &HybridRsaKeyPairSpec::importKey);
       prototype.registerHybridMethod("exportKey", &HybridRsaKeyPairSpec::exportKey);
       prototype.registerHybridMethod("getPublicKey", &HybridRsaKeyPairSpec::getPublicKey);
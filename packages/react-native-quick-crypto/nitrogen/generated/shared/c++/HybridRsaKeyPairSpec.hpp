@@ -60,6 +60,8 @@ namespace margelo::nitro::crypto {
       virtual void setModulusLength(double modulusLength) = 0;
       virtual void setPublicExponent(const std::shared_ptr<ArrayBuffer>& publicExponent) = 0;
       virtual void setHashAlgorithm(const std::string& hashAlgorithm) = 0;
+      virtual void setPrimes(double primes) = 0;
+      virtual void setParallelism(double parallelism) = 0;
       virtual KeyObject importKey(const std::string& format, const std::shared_ptr<ArrayBuffer>& keyData, const std::string& algorithm, bool extractable, const std::vector<std::string>& keyUsages) = 0;
       virtual std::shared_ptr<ArrayBuffer> exportKey(const KeyObject& key, const std::string& format) = 0;
       virtual std::shared_ptr<ArrayBuffer> getPublicKey() = 0;
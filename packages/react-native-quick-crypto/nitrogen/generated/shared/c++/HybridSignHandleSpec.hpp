@@ -56,7 +56,7 @@ namespace margelo::nitro::crypto {
     public:
       // Methods
       virtual void init(const std::string& algorithm) = 0;
-      virtual void update(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual void update(const std::shared_ptr<ArrayBuffer>& data, const std::optional<double>& byteOffset, const std::optional<double>& byteLength) = 0;
       virtual std::shared_ptr<ArrayBuffer> sign(const std::shared_ptr<HybridKeyObjectHandleSpec>& keyHandle, std::optional<double> padding, std::optional<double> saltLength, std::optional<double> dsaEncoding) = 0;
 
     protected:
@@ -15,6 +15,16 @@ namespace margelo::nitro::crypto {
     // load custom methods/properties
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("timingSafeEqual", &HybridUtilsSpec::timingSafeEqual);
+      prototype.registerHybridMethod("benchmarkNoop", &HybridUtilsSpec::benchmarkNoop);
+      prototype.registerHybridMethod("benchmarkNative", &HybridUtilsSpec::benchmarkNative);
+      prototype.registerHybridMethod("prewarm", &HybridUtilsSpec::prewarm);
+      prototype.registerHybridMethod("getCpuCapabilities", &HybridUtilsSpec::getCpuCapabilities);
+      prototype.registerHybridMethod("getCryptoImplementations", &HybridUtilsSpec::getCryptoImplementations);
+      prototype.registerHybridMethod("preferredAead", &HybridUtilsSpec::preferredAead);
+      prototype.registerHybridMethod("setQueueWaitTracking", &HybridUtilsSpec::setQueueWaitTracking);
+      prototype.registerHybridMethod("takeQueueWaits", &HybridUtilsSpec::takeQueueWaits);
+      prototype.registerHybridMethod("startWorkloadRecording", &HybridUtilsSpec::startWorkloadRecording);
+      prototype.registerHybridMethod("stopWorkloadRecording", &HybridUtilsSpec::stopWorkloadRecording);
     });
   }
 
@@ -17,6 +17,11 @@
 namespace NitroModules { class ArrayBuffer; }
 
 #include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace margelo::nitro::crypto {
 
@@ -50,6 +55,16 @@ namespace margelo::nitro::crypto {
     public:
       // Methods
       virtual bool timingSafeEqual(const std::shared_ptr<ArrayBuffer>& a, const std::shared_ptr<ArrayBuffer>& b) = 0;
+      virtual void benchmarkNoop(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual std::shared_ptr<ArrayBuffer> benchmarkNative(const std::string& operation, const std::shared_ptr<ArrayBuffer>& data, double iterations) = 0;
+      virtual std::shared_ptr<Promise<void>> prewarm() = 0;
+      virtual std::unordered_map<std::string, bool> getCpuCapabilities() = 0;
+      virtual std::unordered_map<std::string, std::string> getCryptoImplementations() = 0;
+      virtual std::shared_ptr<Promise<std::string>> preferredAead() = 0;
+      virtual void setQueueWaitTracking(bool enabled) = 0;
+      virtual std::unordered_map<std::string, std::vector<double>> takeQueueWaits() = 0;
+      virtual void startWorkloadRecording(std::optional<double> maxBytes) = 0;
+      virtual std::shared_ptr<ArrayBuffer> stopWorkloadRecording() = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,90 @@
+///
+/// KeyRotationArgs.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <optional>
+#include <NitroModules/ArrayBuffer.hpp>
+
+namespace margelo::nitro::crypto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (KeyRotationArgs).
+   */
+  struct KeyRotationArgs {
+  public:
+    std::string cipherType     SWIFT_PRIVATE;
+    std::optional<std::string> oldCipherType     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> oldKey     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> newKey     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> noncePrefix     SWIFT_PRIVATE;
+    double counter     SWIFT_PRIVATE;
+
+  public:
+    KeyRotationArgs() = default;
+    explicit KeyRotationArgs(std::string cipherType, std::optional<std::string> oldCipherType, std::shared_ptr<ArrayBuffer> oldKey, std::shared_ptr<ArrayBuffer> newKey, std::optional<std::shared_ptr<ArrayBuffer>> noncePrefix, double counter): cipherType(cipherType), oldCipherType(oldCipherType), oldKey(oldKey), newKey(newKey), noncePrefix(noncePrefix), counter(counter) {}
+  };
+
+} // namespace margelo::nitro::crypto
+
+namespace margelo::nitro {
+
+  // C++ KeyRotationArgs <> JS KeyRotationArgs (object)
+  template <>
+  struct JSIConverter<margelo::nitro::crypto::KeyRotationArgs> final {
+    static inline margelo::nitro::crypto::KeyRotationArgs fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::crypto::KeyRotationArgs(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "cipherType")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "oldCipherType")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "oldKey")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "newKey")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "noncePrefix")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "counter"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::crypto::KeyRotationArgs& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "cipherType", JSIConverter<std::string>::toJSI(runtime, arg.cipherType));
+      obj.setProperty(runtime, "oldCipherType", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.oldCipherType));
+      obj.setProperty(runtime, "oldKey", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.oldKey));
+      obj.setProperty(runtime, "newKey", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.newKey));
+      obj.setProperty(runtime, "noncePrefix", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.noncePrefix));
+      obj.setProperty(runtime, "counter", JSIConverter<double>::toJSI(runtime, arg.counter));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "cipherType"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "oldCipherType"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "oldKey"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "newKey"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "noncePrefix"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "counter"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,98 @@
+///
+/// MacArgs.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+
+namespace margelo::nitro::crypto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (MacArgs).
+   */
+  struct MacArgs {
+  public:
+    std::string algorithm     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> key     SWIFT_PRIVATE;
+    std::optional<std::string> digest     SWIFT_PRIVATE;
+    std::optional<std::string> cipher     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> iv     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> customization     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> salt     SWIFT_PRIVATE;
+    std::optional<double> outputLength     SWIFT_PRIVATE;
+
+  public:
+    MacArgs() = default;
+    explicit MacArgs(std::string algorithm, std::shared_ptr<ArrayBuffer> key, std::optional<std::string> digest, std::optional<std::string> cipher, std::optional<std::shared_ptr<ArrayBuffer>> iv, std::optional<std::shared_ptr<ArrayBuffer>> customization, std::optional<std::shared_ptr<ArrayBuffer>> salt, std::optional<double> outputLength): algorithm(algorithm), key(key), digest(digest), cipher(cipher), iv(iv), customization(customization), salt(salt), outputLength(outputLength) {}
+  };
+
+} // namespace margelo::nitro::crypto
+
+namespace margelo::nitro {
+
+  // C++ MacArgs <> JS MacArgs (object)
+  template <>
+  struct JSIConverter<margelo::nitro::crypto::MacArgs> final {
+    static inline margelo::nitro::crypto::MacArgs fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::crypto::MacArgs(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "algorithm")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "key")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "digest")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "cipher")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "iv")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "customization")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "salt")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "outputLength"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::crypto::MacArgs& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "algorithm", JSIConverter<std::string>::toJSI(runtime, arg.algorithm));
+      obj.setProperty(runtime, "key", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.key));
+      obj.setProperty(runtime, "digest", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.digest));
+      obj.setProperty(runtime, "cipher", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.cipher));
+      obj.setProperty(runtime, "iv", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.iv));
+      obj.setProperty(runtime, "customization", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.customization));
+      obj.setProperty(runtime, "salt", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.salt));
+      obj.setProperty(runtime, "outputLength", JSIConverter<std::optional<double>>::toJSI(runtime, arg.outputLength));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "algorithm"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "key"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "digest"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "cipher"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "iv"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "customization"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "salt"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "outputLength"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,90 @@
+///
+/// NoiseHandshakeArgs.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+
+namespace margelo::nitro::crypto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NoiseHandshakeArgs).
+   */
+  struct NoiseHandshakeArgs {
+  public:
+    std::string protocolName     SWIFT_PRIVATE;
+    bool initiator     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> prologue     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> staticPrivateKey     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> remoteStaticPublicKey     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> ephemeralPrivateKey     SWIFT_PRIVATE;
+
+  public:
+    NoiseHandshakeArgs() = default;
+    explicit NoiseHandshakeArgs(std::string protocolName, bool initiator, std::optional<std::shared_ptr<ArrayBuffer>> prologue, std::optional<std::shared_ptr<ArrayBuffer>> staticPrivateKey, std::optional<std::shared_ptr<ArrayBuffer>> remoteStaticPublicKey, std::optional<std::shared_ptr<ArrayBuffer>> ephemeralPrivateKey): protocolName(protocolName), initiator(initiator), prologue(prologue), staticPrivateKey(staticPrivateKey), remoteStaticPublicKey(remoteStaticPublicKey), ephemeralPrivateKey(ephemeralPrivateKey) {}
+  };
+
+} // namespace margelo::nitro::crypto
+
+namespace margelo::nitro {
+
+  // C++ NoiseHandshakeArgs <> JS NoiseHandshakeArgs (object)
+  template <>
+  struct JSIConverter<margelo::nitro::crypto::NoiseHandshakeArgs> final {
+    static inline margelo::nitro::crypto::NoiseHandshakeArgs fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::crypto::NoiseHandshakeArgs(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "protocolName")),
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "initiator")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "prologue")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "staticPrivateKey")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "remoteStaticPublicKey")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "ephemeralPrivateKey"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::crypto::NoiseHandshakeArgs& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "protocolName", JSIConverter<std::string>::toJSI(runtime, arg.protocolName));
+      obj.setProperty(runtime, "initiator", JSIConverter<bool>::toJSI(runtime, arg.initiator));
+      obj.setProperty(runtime, "prologue", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.prologue));
+      obj.setProperty(runtime, "staticPrivateKey", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.staticPrivateKey));
+      obj.setProperty(runtime, "remoteStaticPublicKey", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.remoteStaticPublicKey));
+      obj.setProperty(runtime, "ephemeralPrivateKey", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.ephemeralPrivateKey));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "protocolName"))) return false;
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "initiator"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "prologue"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "staticPrivateKey"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "remoteStaticPublicKey"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "ephemeralPrivateKey"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,82 @@
+///
+/// PageCipherArgs.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+
+namespace margelo::nitro::crypto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PageCipherArgs).
+   */
+  struct PageCipherArgs {
+  public:
+    std::string cipherType     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> cipherKey     SWIFT_PRIVATE;
+    double pageSize     SWIFT_PRIVATE;
+    std::optional<double> reserveSize     SWIFT_PRIVATE;
+
+  public:
+    PageCipherArgs() = default;
+    explicit PageCipherArgs(std::string cipherType, std::shared_ptr<ArrayBuffer> cipherKey, double pageSize, std::optional<double> reserveSize): cipherType(cipherType), cipherKey(cipherKey), pageSize(pageSize), reserveSize(reserveSize) {}
+  };
+
+} // namespace margelo::nitro::crypto
+
+namespace margelo::nitro {
+
+  // C++ PageCipherArgs <> JS PageCipherArgs (object)
+  template <>
+  struct JSIConverter<margelo::nitro::crypto::PageCipherArgs> final {
+    static inline margelo::nitro::crypto::PageCipherArgs fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::crypto::PageCipherArgs(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "cipherType")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "cipherKey")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pageSize")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "reserveSize"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::crypto::PageCipherArgs& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "cipherType", JSIConverter<std::string>::toJSI(runtime, arg.cipherType));
+      obj.setProperty(runtime, "cipherKey", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.cipherKey));
+      obj.setProperty(runtime, "pageSize", JSIConverter<double>::toJSI(runtime, arg.pageSize));
+      obj.setProperty(runtime, "reserveSize", JSIConverter<std::optional<double>>::toJSI(runtime, arg.reserveSize));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "cipherType"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "cipherKey"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pageSize"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "reserveSize"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
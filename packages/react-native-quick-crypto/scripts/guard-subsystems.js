@@ -0,0 +1,68 @@
+#!/usr/bin/env node
+// Wraps the autolinking of every optional HybridObject in
+// `#ifndef RNQC_DISABLE_<SUBSYSTEM>` so a build that leaves a subsystem out
+// (QUICKCRYPTO_DISABLED_SUBSYSTEMS) neither includes nor registers it.
+//
+// nitrogen rewrites the autolinking files on every run, so `bun specs` runs
+// this right after nitro-codegen. It is idempotent: existing guards are
+// stripped and applied again from the table below.
+//
+// Subsystem names match cpp/QuickCryptoSubsystems.cmake; HybridObjects missing
+// from the table are always registered.
+
+const fs = require('fs');
+const path = require('path');
+
+const subsystems = {
+  Blake3: 'blake3',
+  CompressCipher: 'compress',
+  DiffieHellman: 'dh',
+  ECDH: 'dh',
+  EcKeyPair: 'ec',
+  EdKeyPair: 'ed25519',
+  Hkdf: 'hkdf',
+  KeyObjectHandle: 'keys',
+  KeyWrap: 'keys',
+  SignHandle: 'keys',
+  VerifyHandle: 'keys',
+  MlDsaKeyPair: 'mldsa',
+  NoiseHandshake: 'noise',
+  Oprf: 'oprf',
+  KeyRotation: 'pagecipher',
+  PageCipher: 'pagecipher',
+  Pbkdf2: 'pbkdf2',
+  RsaCipher: 'rsa',
+  RsaKeyPair: 'rsa',
+  Scrypt: 'scrypt',
+};
+
+const files = [
+  'nitrogen/generated/android/QuickCryptoOnLoad.cpp',
+  'nitrogen/generated/ios/QuickCryptoAutolinking.mm',
+];
+
+const guard = (name, block) => {
+  const subsystem = subsystems[name];
+  if (subsystem === undefined) {
+    return block;
+  }
+  return `#ifndef RNQC_DISABLE_${subsystem.toUpperCase()}\n${block}#endif\n`;
+};
+
+const root = path.resolve(__dirname, '..');
+for (const file of files) {
+  const fullPath = path.join(root, file);
+  const generated = fs
+    .readFileSync(fullPath, 'utf8')
+    .replace(/^#ifndef RNQC_DISABLE_\w+\n([\s\S]*?)^#endif\n/gm, '$1');
+  const guarded = generated
+    .replace(/^#include "Hybrid(\w+)\.hpp"\n/gm, (block, name) =>
+      guard(name, block),
+    )
+    .replace(
+      /^( *)HybridObjectRegistry::registerHybridObjectConstructor\(\n\s*"(\w+)",\n[\s\S]*?^\1\);\n/gm,
+      (block, _indent, name) => guard(name, block),
+    );
+  fs.writeFileSync(fullPath, guarded);
+  console.log(`Guarded optional subsystems in ${file}`);
+}
@@ -2,7 +2,7 @@ import { NitroModules } from 'react-native-nitro-modules';
 import { Buffer } from '@craftzdog/react-native-buffer';
 import type { Blake3 as NativeBlake3 } from './specs/blake3.nitro';
 import type { BinaryLike, Encoding } from './utils';
-import { binaryLikeToArrayBuffer, ab2str } from './utils';
+import { binaryLikeToView, ab2str } from './utils';
 
 const BLAKE3_KEY_LEN = 32;
 const BLAKE3_OUT_LEN = 32;
@@ -49,8 +49,7 @@ export class Blake3 {
   }
 
   update(data: BinaryLike, inputEncoding?: Encoding): this {
-    const buffer = binaryLikeToArrayBuffer(data, inputEncoding ?? 'utf8');
-    this.native.update(buffer);
+    this.native.update(...binaryLikeToView(data, inputEncoding ?? 'utf8'));
     return this;
   }
 
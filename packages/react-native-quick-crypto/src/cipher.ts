@@ -1,7 +1,7 @@
 import { NitroModules } from 'react-native-nitro-modules';
 import Stream, { type TransformOptions } from 'readable-stream';
 import { Buffer } from '@craftzdog/react-native-buffer';
-import type { BinaryLike, BinaryLikeNode, Encoding } from './utils';
+import type { BinaryLike, BinaryLikeNode, ByteView, Encoding } from './utils';
 import type {
   CipherCCMOptions,
   CipherCCMTypes,
@@ -14,7 +14,7 @@ import type {
   Cipher as NativeCipher,
   CipherFactory,
 } from './specs/cipher.nitro';
-import { ab2str, binaryLikeToArrayBuffer } from './utils';
+import { ab2str, binaryLikeToArrayBuffer, binaryLikeToView } from './utils';
 import {
   getDefaultEncoding,
   getUIntOption,
@@ -28,14 +28,28 @@ export type CipherOptions =
   | CipherGCMOptions
   | TransformOptions;
 
+// Created on first use rather than at import, to keep app startup free of
+// native work
 class CipherUtils {
-  private static native =
-    NitroModules.createHybridObject<NativeCipher>('Cipher');
+  private static native: NativeCipher | undefined;
   public static getSupportedCiphers(): string[] {
+    if (this.native == null) {
+      this.native = NitroModules.createHybridObject<NativeCipher>('Cipher');
+    }
     return this.native.getSupportedCiphers();
   }
 }
 
+const encodeOutput = (
+  ret: ArrayBuffer,
+  outputEncoding?: string,
+): Buffer | string => {
+  if (outputEncoding && outputEncoding !== 'buffer') {
+    return ab2str(ret, outputEncoding);
+  }
+  return Buffer.from(ret);
+};
+
 export function getCiphers(): string[] {
   return CipherUtils.getSupportedCiphers();
 }
@@ -109,36 +123,64 @@ class CipherCommon extends Stream.Transform {
     outputEncoding?: Encoding,
   ): Buffer | string {
     const defaultEncoding = getDefaultEncoding();
-    inputEncoding = inputEncoding ?? defaultEncoding;
     outputEncoding = outputEncoding ?? defaultEncoding;
 
-    if (typeof data === 'string') {
-      validateEncoding(data, inputEncoding);
-    } else if (!ArrayBuffer.isView(data)) {
-      throw new Error('Invalid data argument');
-    }
-
-    const ret = this.native.update(
-      binaryLikeToArrayBuffer(data, inputEncoding),
-    );
-
-    if (outputEncoding && outputEncoding !== 'buffer') {
-      return ab2str(ret, outputEncoding);
-    }
-
-    return Buffer.from(ret);
+    const ret = this.native.update(...this.toInput(data, inputEncoding));
+    return encodeOutput(ret, outputEncoding);
   }
 
   final(): Buffer;
   final(outputEncoding: BufferEncoding | 'buffer'): string;
   final(outputEncoding?: BufferEncoding | 'buffer'): Buffer | string {
-    const ret = this.native.final();
+    return encodeOutput(this.native.final(), outputEncoding);
+  }
 
-    if (outputEncoding && outputEncoding !== 'buffer') {
-      return ab2str(ret, outputEncoding);
+  /**
+   * Same as `update()`, but the cipher runs on a worker thread so large
+   * chunks do not block the JS thread. The input is copied before the call
+   * returns. Until the promise settles, any other call on this object throws.
+   */
+  updateAsync(data: BinaryLike, inputEncoding?: Encoding): Promise<Buffer>;
+  updateAsync(
+    data: BinaryLike,
+    inputEncoding: Encoding,
+    outputEncoding: Encoding,
+  ): Promise<string>;
+  async updateAsync(
+    data: BinaryLike,
+    inputEncoding?: Encoding,
+    outputEncoding?: Encoding,
+  ): Promise<Buffer | string> {
+    const defaultEncoding = getDefaultEncoding();
+    outputEncoding = outputEncoding ?? defaultEncoding;
+
+    const input = this.toInput(data, inputEncoding);
+    const ret = await this.native.updateAsync(...input);
+    return encodeOutput(ret, outputEncoding);
+  }
+
+  /**
+   * Same as `final()`, but runs on a worker thread. Must not be called while
+   * an `updateAsync()` is still pending.
+   */
+  finalAsync(): Promise<Buffer>;
+  finalAsync(outputEncoding: BufferEncoding | 'buffer'): Promise<string>;
+  async finalAsync(
+    outputEncoding?: BufferEncoding | 'buffer',
+  ): Promise<Buffer | string> {
+    return encodeOutput(await this.native.finalAsync(), outputEncoding);
+  }
+
+  private toInput(data: BinaryLike, inputEncoding?: Encoding): ByteView {
+    inputEncoding = inputEncoding ?? getDefaultEncoding();
+
+    if (typeof data === 'string') {
+      validateEncoding(data, inputEncoding);
+    } else if (!ArrayBuffer.isView(data)) {
+      throw new Error('Invalid data argument');
     }
 
-    return Buffer.from(ret);
+    return binaryLikeToView(data, inputEncoding);
   }
 
   _transform(
@@ -330,6 +372,6 @@ export function xsalsa20(
     cipherKey: binaryLikeToArrayBuffer(key),
     iv: binaryLikeToArrayBuffer(nonce),
   });
-  const result = native.update(binaryLikeToArrayBuffer(data));
+  const result = native.update(...binaryLikeToView(data));
   return new Uint8Array(result);
 }
@@ -0,0 +1,183 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import { Buffer } from '@craftzdog/react-native-buffer';
+import type {
+  CompressCipher as NativeCompressCipher,
+} from './specs/compressCipher.nitro';
+import type { BinaryLike, BinaryLikeNode } from './utils';
+import { binaryLikeToArrayBuffer } from './utils';
+
+export type CompressCipherAlgorithm =
+  | 'aes-128-gcm'
+  | 'aes-192-gcm'
+  | 'aes-256-gcm'
+  | 'chacha20-poly1305';
+
+export interface CompressCipherOptions {
+  /** zlib compression level, -1 (default) to 9 */
+  level?: number;
+  /** Authentication tag length in bytes, defaults to 16 */
+  authTagLength?: number;
+  /** Additional authenticated data */
+  aad?: BinaryLike;
+}
+
+export interface DecompressDecipherOptions {
+  /**
+   * Maximum number of decompressed bytes. Decryption fails once the inflated
+   * output grows past this limit (decompression-bomb guard). Defaults to 64 MiB.
+   */
+  maxOutputLength?: number;
+  /** Authentication tag length in bytes, defaults to 16 */
+  authTagLength?: number;
+  /** Additional authenticated data */
+  aad?: BinaryLike;
+}
+
+export interface CompressEncryptResult {
+  ciphertext: Buffer;
+  authTag: Buffer;
+}
+
+function createNative(
+  encrypt: boolean,
+  algorithm: CompressCipherAlgorithm,
+  key: BinaryLikeNode,
+  iv: BinaryLike,
+  options: CompressCipherOptions & DecompressDecipherOptions,
+): NativeCompressCipher {
+  const native =
+    NitroModules.createHybridObject<NativeCompressCipher>('CompressCipher');
+  native.init({
+    encrypt,
+    cipherType: algorithm,
+    cipherKey: binaryLikeToArrayBuffer(key),
+    iv: binaryLikeToArrayBuffer(iv),
+    authTagLen: options.authTagLength,
+    level: options.level,
+    maxOutputLength: options.maxOutputLength,
+  });
+  if (options.aad !== undefined) {
+    native.setAAD(binaryLikeToArrayBuffer(options.aad));
+  }
+  return native;
+}
+
+/**
+ * Streaming deflate + AEAD encryption. Compression and encryption both run
+ * natively, so the plaintext crosses the JS bridge once.
+ */
+export class CompressCipher {
+  private native: NativeCompressCipher;
+
+  constructor(
+    algorithm: CompressCipherAlgorithm,
+    key: BinaryLikeNode,
+    iv: BinaryLike,
+    options: CompressCipherOptions = {},
+  ) {
+    this.native = createNative(true, algorithm, key, iv, options);
+  }
+
+  update(data: BinaryLike): Buffer {
+    return Buffer.from(this.native.update(binaryLikeToArrayBuffer(data)));
+  }
+
+  final(): Buffer {
+    return Buffer.from(this.native.final());
+  }
+
+  getAuthTag(): Buffer {
+    return Buffer.from(this.native.getAuthTag());
+  }
+}
+
+/**
+ * Streaming AEAD decryption + inflate, bounded by `maxOutputLength`.
+ * As with Node's AEAD deciphers, output from `update()` is unauthenticated
+ * until `final()` succeeds.
+ */
+export class DecompressDecipher {
+  private native: NativeCompressCipher;
+
+  constructor(
+    algorithm: CompressCipherAlgorithm,
+    key: BinaryLikeNode,
+    iv: BinaryLike,
+    options: DecompressDecipherOptions = {},
+  ) {
+    this.native = createNative(false, algorithm, key, iv, options);
+  }
+
+  setAuthTag(tag: BinaryLike): this {
+    this.native.setAuthTag(binaryLikeToArrayBuffer(tag));
+    return this;
+  }
+
+  update(data: BinaryLike): Buffer {
+    return Buffer.from(this.native.update(binaryLikeToArrayBuffer(data)));
+  }
+
+  final(): Buffer {
+    return Buffer.from(this.native.final());
+  }
+}
+
+export function createCompressCipheriv(
+  algorithm: CompressCipherAlgorithm,
+  key: BinaryLikeNode,
+  iv: BinaryLike,
+  options?: CompressCipherOptions,
+): CompressCipher {
+  return new CompressCipher(algorithm, key, iv, options);
+}
+
+export function createDecompressDecipheriv(
+  algorithm: CompressCipherAlgorithm,
+  key: BinaryLikeNode,
+  iv: BinaryLike,
+  options?: DecompressDecipherOptions,
+): DecompressDecipher {
+  return new DecompressDecipher(algorithm, key, iv, options);
+}
+
+/**
+ * One-shot compress-then-encrypt: a single native call deflates and seals
+ * `data`.
+ */
+export function compressAndEncrypt(
+  algorithm: CompressCipherAlgorithm,
+  key: BinaryLikeNode,
+  iv: BinaryLike,
+  data: BinaryLike,
+  options: CompressCipherOptions = {},
+): CompressEncryptResult {
+  const native = createNative(true, algorithm, key, iv, options);
+  const ciphertext = Buffer.from(
+    native.process(binaryLikeToArrayBuffer(data)),
+  );
+  return { ciphertext, authTag: Buffer.from(native.getAuthTag()) };
+}
+
+/**
+ * One-shot decrypt-then-decompress. Throws if authentication fails, the
+ * compressed stream is truncated or the output exceeds `maxOutputLength`.
+ */
+export function decryptAndDecompress(
+  algorithm: CompressCipherAlgorithm,
+  key: BinaryLikeNode,
+  iv: BinaryLike,
+  data: BinaryLike,
+  authTag: BinaryLike,
+  options: DecompressDecipherOptions = {},
+): Buffer {
+  const native = createNative(false, algorithm, key, iv, options);
+  native.setAuthTag(binaryLikeToArrayBuffer(authTag));
+  return Buffer.from(native.process(binaryLikeToArrayBuffer(data)));
+}
+
+export const compressExports = {
+  createCompressCipheriv,
+  createDecompressDecipheriv,
+  compressAndEncrypt,
+  decryptAndDecompress,
+};
@@ -0,0 +1,434 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import { Buffer } from '@craftzdog/react-native-buffer';
+import type {
+  DiffieHellman as NativeDiffieHellman,
+} from './specs/diffieHellman.nitro';
+import type { ECDH as NativeECDH } from './specs/ecdh.nitro';
+import { constants } from './constants';
+import type { BinaryLike, Encoding } from './utils';
+import { binaryLikeToArrayBuffer } from './utils';
+
+/**
+ * Well-known groups accepted by `getDiffieHellman()`: the RFC 2409/3526 MODP
+ * groups Node.js supports, plus the RFC 7919 FFDHE groups used by TLS.
+ */
+export type DiffieHellmanGroupName =
+  | 'modp1'
+  | 'modp2'
+  | 'modp5'
+  | 'modp14'
+  | 'modp15'
+  | 'modp16'
+  | 'modp17'
+  | 'modp18'
+  | 'ffdhe2048'
+  | 'ffdhe3072'
+  | 'ffdhe4096'
+  | 'ffdhe6144'
+  | 'ffdhe8192';
+
+type KeyEncoding = Encoding | 'buffer';
+
+const kDefaultGenerator = 2;
+
+function createNative(): NativeDiffieHellman {
+  return NitroModules.createHybridObject<NativeDiffieHellman>('DiffieHellman');
+}
+
+function toArrayBuffer(
+  value: BinaryLike,
+  encoding?: KeyEncoding,
+): ArrayBuffer {
+  return binaryLikeToArrayBuffer(
+    value,
+    !encoding || encoding === 'buffer' ? 'utf-8' : encoding,
+  );
+}
+
+function encode(value: ArrayBuffer, encoding?: KeyEncoding): Buffer | string {
+  const buffer = Buffer.from(value);
+  return encoding && encoding !== 'buffer' ? buffer.toString(encoding) : buffer;
+}
+
+// Generator as big-endian bytes; numbers are limited to int32 like Node
+function generatorToArrayBuffer(
+  generator: number | BinaryLike,
+  encoding?: KeyEncoding,
+): ArrayBuffer {
+  if (typeof generator !== 'number') {
+    return toArrayBuffer(generator, encoding);
+  }
+  if (!Number.isInteger(generator) || generator < 0 || generator > 0x7fffffff) {
+    throw new RangeError(
+      `The value of "generator" is out of range. Received ${generator}`,
+    );
+  }
+  const bytes = new Uint8Array(4);
+  new DataView(bytes.buffer).setUint32(0, generator);
+  return bytes.buffer;
+}
+
+class DiffieHellmanBase {
+  protected native: NativeDiffieHellman;
+
+  constructor(native: NativeDiffieHellman) {
+    this.native = native;
+  }
+
+  /**
+   * Generates private and public key values unless a private key was set,
+   * in which case only the public key is (re)computed. Returns the public key.
+   */
+  generateKeys(): Buffer;
+  generateKeys(encoding: KeyEncoding): Buffer | string;
+  generateKeys(encoding?: KeyEncoding): Buffer | string {
+    return encode(this.native.generateKeys(), encoding);
+  }
+
+  /**
+   * Computes the shared secret with `otherPublicKey`, zero-padded to the
+   * size of the prime.
+   */
+  computeSecret(otherPublicKey: BinaryLike): Buffer;
+  computeSecret(
+    otherPublicKey: BinaryLike,
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): Buffer | string;
+  computeSecret(
+    otherPublicKey: BinaryLike,
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): Buffer | string {
+    const secret = this.native.computeSecret(
+      toArrayBuffer(otherPublicKey, inputEncoding),
+    );
+    return encode(secret, outputEncoding);
+  }
+
+  /**
+   * Computes the shared secrets with many peers in one native call, e.g. a
+   * server answering a batch of handshakes. Throws on the first invalid key.
+   */
+  computeSecrets(
+    otherPublicKeys: BinaryLike[],
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): (Buffer | string)[] {
+    const secrets = this.native.computeSecrets(
+      otherPublicKeys.map(key => toArrayBuffer(key, inputEncoding)),
+    );
+    return secrets.map(secret => encode(secret, outputEncoding));
+  }
+
+  /**
+   * Like `computeSecrets()`, on a worker thread. The key pair in use when
+   * this is called is the one used for the whole batch.
+   */
+  async computeSecretsAsync(
+    otherPublicKeys: BinaryLike[],
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): Promise<(Buffer | string)[]> {
+    const secrets = await this.native.computeSecretsAsync(
+      otherPublicKeys.map(key => toArrayBuffer(key, inputEncoding)),
+    );
+    return secrets.map(secret => encode(secret, outputEncoding));
+  }
+
+  getPrime(encoding?: KeyEncoding): Buffer | string {
+    return encode(this.native.getPrime(), encoding);
+  }
+
+  getGenerator(encoding?: KeyEncoding): Buffer | string {
+    return encode(this.native.getGenerator(), encoding);
+  }
+
+  getPublicKey(encoding?: KeyEncoding): Buffer | string {
+    return encode(this.native.getPublicKey(), encoding);
+  }
+
+  getPrivateKey(encoding?: KeyEncoding): Buffer | string {
+    return encode(this.native.getPrivateKey(), encoding);
+  }
+
+  /**
+   * `DH_CHECK_*` flags from `constants`, 0 if the parameters look sound.
+   * Checked on first access, since testing a custom prime takes a while.
+   */
+  get verifyError(): number {
+    return this.native.getVerifyError();
+  }
+}
+
+/**
+ * Finite-field Diffie-Hellman with custom parameters, as Node's
+ * `crypto.DiffieHellman`.
+ */
+export class DiffieHellman extends DiffieHellmanBase {
+  constructor(
+    sizeOrKey: number | BinaryLike,
+    keyEncoding?: KeyEncoding | number | BinaryLike,
+    generator?: number | BinaryLike,
+    genEncoding?: KeyEncoding,
+  ) {
+    super(createNative());
+    // (prime, generator[, genEncoding]) without a prime encoding
+    if (
+      keyEncoding !== undefined &&
+      (typeof keyEncoding !== 'string' ||
+        !(keyEncoding === 'buffer' || Buffer.isEncoding(keyEncoding)))
+    ) {
+      genEncoding = generator as KeyEncoding | undefined;
+      generator = keyEncoding as number | BinaryLike;
+      keyEncoding = undefined;
+    }
+    const gen = generator ?? kDefaultGenerator;
+
+    if (typeof sizeOrKey === 'number') {
+      if (typeof gen !== 'number') {
+        throw new TypeError(
+          'The "generator" argument must be a number when generating a prime',
+        );
+      }
+      this.native.generateParametersSync(sizeOrKey, gen);
+      return;
+    }
+    this.native.init(
+      toArrayBuffer(sizeOrKey, keyEncoding as KeyEncoding | undefined),
+      generatorToArrayBuffer(gen, genEncoding),
+    );
+  }
+
+  setPublicKey(publicKey: BinaryLike, encoding?: KeyEncoding): void {
+    this.native.setPublicKey(toArrayBuffer(publicKey, encoding));
+  }
+
+  /**
+   * Does not compute the public key; call `generateKeys()` or
+   * `setPublicKey()` afterwards.
+   */
+  setPrivateKey(privateKey: BinaryLike, encoding?: KeyEncoding): void {
+    this.native.setPrivateKey(toArrayBuffer(privateKey, encoding));
+  }
+}
+
+/**
+ * Diffie-Hellman over a well-known group, as Node's
+ * `crypto.DiffieHellmanGroup`. The group's parameters and Montgomery context
+ * are built once per process and shared by every instance.
+ */
+export class DiffieHellmanGroup extends DiffieHellmanBase {
+  constructor(name: DiffieHellmanGroupName) {
+    super(createNative());
+    this.native.initGroup(name);
+  }
+}
+
+export function createDiffieHellman(
+  primeLength: number,
+  generator?: number,
+): DiffieHellman;
+export function createDiffieHellman(
+  prime: BinaryLike,
+  generator?: number | BinaryLike,
+  generatorEncoding?: KeyEncoding,
+): DiffieHellman;
+export function createDiffieHellman(
+  prime: BinaryLike,
+  primeEncoding: KeyEncoding,
+  generator?: number | BinaryLike,
+  generatorEncoding?: KeyEncoding,
+): DiffieHellman;
+export function createDiffieHellman(
+  sizeOrKey: number | BinaryLike,
+  keyEncoding?: KeyEncoding | number | BinaryLike,
+  generator?: number | BinaryLike,
+  genEncoding?: KeyEncoding,
+): DiffieHellman {
+  return new DiffieHellman(sizeOrKey, keyEncoding, generator, genEncoding);
+}
+
+/**
+ * Generates a new `primeLength`-bit safe prime on a worker thread instead of
+ * blocking JS like `createDiffieHellman(primeLength)`.
+ */
+export async function createDiffieHellmanAsync(
+  primeLength: number,
+  generator: number = kDefaultGenerator,
+): Promise<DiffieHellman> {
+  const native = createNative();
+  await native.generateParameters(primeLength, generator);
+  return new DiffieHellman(native.getPrime(), native.getGenerator());
+}
+
+export function getDiffieHellman(
+  groupName: DiffieHellmanGroupName,
+): DiffieHellmanGroup {
+  return new DiffieHellmanGroup(groupName);
+}
+
+export const createDiffieHellmanGroup = getDiffieHellman;
+
+/** Point encodings accepted by `ECDH`, as in Node. */
+export type ECDHKeyFormat = 'compressed' | 'uncompressed' | 'hybrid';
+
+function pointFormat(format: ECDHKeyFormat = 'uncompressed'): number {
+  switch (format) {
+    case 'compressed':
+      return constants.POINT_CONVERSION_COMPRESSED;
+    case 'uncompressed':
+      return constants.POINT_CONVERSION_UNCOMPRESSED;
+    case 'hybrid':
+      return constants.POINT_CONVERSION_HYBRID;
+  }
+  throw new TypeError(`Invalid ECDH format: ${format}`);
+}
+
+function createNativeECDH(): NativeECDH {
+  return NitroModules.createHybridObject<NativeECDH>('ECDH');
+}
+
+// convertKey() holds no key state, so one native object serves every call
+let converter: NativeECDH | undefined;
+
+/**
+ * Elliptic-curve Diffie-Hellman over a named prime curve, as Node's
+ * `crypto.ECDH`. Peer keys may use any point encoding; parsed peer points are
+ * cached per curve, so computing several secrets against the same peer only
+ * decodes its key once.
+ */
+export class ECDH {
+  private native: NativeECDH;
+
+  constructor(curve: string) {
+    this.native = createNativeECDH();
+    this.native.setCurve(curve);
+  }
+
+  /**
+   * Converts a public key between point encodings, e.g. to decompress a
+   * 33-byte P-256 key into the 65-byte form.
+   */
+  static convertKey(
+    key: BinaryLike,
+    curve: string,
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+    format?: ECDHKeyFormat,
+  ): Buffer | string {
+    converter ??= createNativeECDH();
+    const converted = converter.convertKey(
+      curve,
+      toArrayBuffer(key, inputEncoding),
+      pointFormat(format),
+    );
+    return encode(converted, outputEncoding);
+  }
+
+  /** Like `convertKey()` for many keys in one native call. */
+  static convertKeys(
+    keys: BinaryLike[],
+    curve: string,
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+    format?: ECDHKeyFormat,
+  ): (Buffer | string)[] {
+    converter ??= createNativeECDH();
+    const converted = converter.convertKeys(
+      curve,
+      keys.map(key => toArrayBuffer(key, inputEncoding)),
+      pointFormat(format),
+    );
+    return converted.map(key => encode(key, outputEncoding));
+  }
+
+  /** Generates a new key pair and returns the public key. */
+  generateKeys(): Buffer;
+  generateKeys(encoding: KeyEncoding, format?: ECDHKeyFormat): Buffer | string;
+  generateKeys(
+    encoding?: KeyEncoding,
+    format?: ECDHKeyFormat,
+  ): Buffer | string {
+    this.native.generateKeys();
+    return this.getPublicKey(encoding, format);
+  }
+
+  /**
+   * Computes the shared secret with `otherPublicKey`: the x coordinate of the
+   * shared point, zero-padded to the field size.
+   */
+  computeSecret(otherPublicKey: BinaryLike): Buffer;
+  computeSecret(
+    otherPublicKey: BinaryLike,
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): Buffer | string;
+  computeSecret(
+    otherPublicKey: BinaryLike,
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): Buffer | string {
+    const secret = this.native.computeSecret(
+      toArrayBuffer(otherPublicKey, inputEncoding),
+    );
+    return encode(secret, outputEncoding);
+  }
+
+  /**
+   * Computes the shared secrets with many peers in one native call. Throws on
+   * the first invalid key.
+   */
+  computeSecrets(
+    otherPublicKeys: BinaryLike[],
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): (Buffer | string)[] {
+    const secrets = this.native.computeSecrets(
+      otherPublicKeys.map(key => toArrayBuffer(key, inputEncoding)),
+    );
+    return secrets.map(secret => encode(secret, outputEncoding));
+  }
+
+  /**
+   * Like `computeSecrets()`, on a worker thread. The key pair in use when
+   * this is called is the one used for the whole batch.
+   */
+  async computeSecretsAsync(
+    otherPublicKeys: BinaryLike[],
+    inputEncoding?: KeyEncoding,
+    outputEncoding?: KeyEncoding,
+  ): Promise<(Buffer | string)[]> {
+    const secrets = await this.native.computeSecretsAsync(
+      otherPublicKeys.map(key => toArrayBuffer(key, inputEncoding)),
+    );
+    return secrets.map(secret => encode(secret, outputEncoding));
+  }
+
+  getPublicKey(
+    encoding?: KeyEncoding,
+    format?: ECDHKeyFormat,
+  ): Buffer | string {
+    return encode(this.native.getPublicKey(pointFormat(format)), encoding);
+  }
+
+  getPrivateKey(encoding?: KeyEncoding): Buffer | string {
+    return encode(this.native.getPrivateKey(), encoding);
+  }
+
+  /** Also derives and sets the matching public key. */
+  setPrivateKey(privateKey: BinaryLike, encoding?: KeyEncoding): void {
+    this.native.setPrivateKey(toArrayBuffer(privateKey, encoding));
+  }
+
+  /**
+   * Deprecated in Node; the key is not checked against the private key.
+   */
+  setPublicKey(publicKey: BinaryLike, encoding?: KeyEncoding): void {
+    this.native.setPublicKey(toArrayBuffer(publicKey, encoding));
+  }
+}
+
+export function createECDH(curveName: string): ECDH {
+  return new ECDH(curveName);
+}
@@ -171,6 +171,20 @@ export class Ed {
   }
 }
 
+// An Ed used only with explicitly passed keys holds no key of its own. Those
+// calls import a fresh native key each time and never wait on each other, so
+// one per curve serves every call
+const sharedEds = new Map<CFRGKeyPairType, Ed>();
+
+export function sharedEd(type: CFRGKeyPairType): Ed {
+  let ed = sharedEds.get(type);
+  if (!ed) {
+    ed = new Ed(type, {});
+    sharedEds.set(type, ed);
+  }
+  return ed;
+}
+
 // Node API
 export function diffieHellman(
   options: DiffieHellmanOptions,
@@ -178,8 +192,7 @@ export function diffieHellman(
 ): Buffer | void {
   const privateKey = options.privateKey as PrivateKeyObject;
   const type = privateKey.asymmetricKeyType as CFRGKeyPairType;
-  const ed = new Ed(type, {});
-  return ed.diffieHellman(options, callback);
+  return sharedEd(type).diffieHellman(options, callback);
 }
 
 // Node API
@@ -439,7 +452,7 @@ export function xDeriveBits(
   }
 
   const type = baseKey.algorithm.name.toLowerCase() as 'x25519' | 'x448';
-  const ed = new Ed(type, {});
+  const ed = sharedEd(type);
 
   // Export raw keys
   const privateKeyBytes = baseKey.keyObject.handle.exportKey();
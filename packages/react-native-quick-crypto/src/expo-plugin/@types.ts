@@ -1,7 +1,31 @@
+/**
+ * Optional native subsystems that can be left out of the build.
+ * Keep in sync with `cpp/QuickCryptoSubsystems.cmake`.
+ */
+export type QuickCryptoSubsystem =
+  | 'blake3'
+  | 'compress'
+  | 'dh'
+  | 'ec'
+  | 'ed25519'
+  | 'hkdf'
+  | 'keys'
+  | 'mldsa'
+  | 'pagecipher'
+  | 'pbkdf2'
+  | 'rsa'
+  | 'scrypt';
+
 export type ConfigProps = {
   /**
    * Enable libsodium support
    * @default false
    */
   sodiumEnabled?: boolean;
+  /**
+   * Native subsystems to leave out of the binary. Their JS APIs throw when
+   * used. `ec`, `ed25519`, `mldsa` and `rsa` depend on `keys`.
+   * @default []
+   */
+  disabledSubsystems?: QuickCryptoSubsystem[];
 };
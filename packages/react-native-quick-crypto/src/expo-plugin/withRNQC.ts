@@ -3,6 +3,7 @@ import type { ConfigPlugin } from 'expo/config-plugins';
 import type { ConfigProps } from './@types';
 import { withSodiumIos } from './withSodiumIos';
 import { withSodiumAndroid } from './withSodiumAndroid';
+import { withSubsystems } from './withSubsystems';
 import { withXCode } from './withXCode';
 
 const withRNQCInternal: ConfigPlugin<ConfigProps> = (config, props = {}) => {
@@ -15,6 +16,11 @@ const withRNQCInternal: ConfigPlugin<ConfigProps> = (config, props = {}) => {
     config = withSodiumAndroid(config, props);
   }
 
+  // leave unused native subsystems out of the binary
+  if (props.disabledSubsystems?.length) {
+    config = withSubsystems(config, props);
+  }
+
   return config;
 };
 
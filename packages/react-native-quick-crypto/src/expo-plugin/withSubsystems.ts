@@ -0,0 +1,61 @@
+import type { ConfigPlugin } from 'expo/config-plugins';
+import { withDangerousMod, withGradleProperties } from 'expo/config-plugins';
+import fs from 'fs';
+import path from 'path';
+import type { ConfigProps } from './@types';
+
+const withSubsystemsAndroid: ConfigPlugin<string> = (config, value) => {
+  return withGradleProperties(config, config => {
+    config.modResults = config.modResults || [];
+    config.modResults = config.modResults.filter(
+      item =>
+        !(
+          item.type === 'property' &&
+          item.key === 'quickCryptoDisabledSubsystems'
+        ),
+    );
+    config.modResults.push({
+      type: 'property',
+      key: 'quickCryptoDisabledSubsystems',
+      value,
+    });
+    return config;
+  });
+};
+
+const withSubsystemsIos: ConfigPlugin<string> = (config, value) => {
+  return withDangerousMod(config, [
+    'ios',
+    config => {
+      const podfilePath = path.join(
+        config.modRequest.platformProjectRoot,
+        'Podfile',
+      );
+      let contents = fs.readFileSync(podfilePath, 'utf-8');
+      const line = `ENV['QUICKCRYPTO_DISABLED_SUBSYSTEMS'] = '${value}'`;
+
+      if (contents.includes("ENV['QUICKCRYPTO_DISABLED_SUBSYSTEMS']")) {
+        contents = contents.replace(
+          /^ENV\['QUICKCRYPTO_DISABLED_SUBSYSTEMS'\].*$/m,
+          line,
+        );
+      } else {
+        // Add it right after the RCT_NEW_ARCH_ENABLED ENV variable
+        contents = contents.replace(
+          /^(ENV\['RCT_NEW_ARCH_ENABLED'\].*$)/m,
+          `$1\n${line}`,
+        );
+      }
+      fs.writeFileSync(podfilePath, contents);
+
+      return config;
+    },
+  ]);
+};
+
+export const withSubsystems: ConfigPlugin<ConfigProps> = (config, props) => {
+  const value = (props.disabledSubsystems ?? []).join(',');
+  config = withSubsystemsAndroid(config, value);
+  config = withSubsystemsIos(config, value);
+  return config;
+};
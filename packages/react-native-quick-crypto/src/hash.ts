@@ -10,16 +10,21 @@ import type {
 } from './utils';
 import {
   ab2str,
-  binaryLikeToArrayBuffer,
+  binaryLikeToView,
   bufferLikeToArrayBuffer,
 } from './utils';
 import { validateMaxBufferLength } from './utils/validation';
 import { lazyDOMException } from './utils/errors';
 import { normalizeHashName } from './utils/hashnames';
 
+// Created on first use rather than at import, to keep app startup free of
+// native work
 class HashUtils {
-  private static native = NitroModules.createHybridObject<NativeHash>('Hash');
+  private static native: NativeHash | undefined;
   public static getSupportedHashAlgorithms(): string[] {
+    if (this.native == null) {
+      this.native = NitroModules.createHybridObject<NativeHash>('Hash');
+    }
     return this.native.getSupportedHashAlgorithms();
   }
 }
@@ -102,7 +107,7 @@ class Hash extends Stream.Transform {
     if (typeof data === 'string' && inputEncoding === 'utf8') {
       this.native.update(data);
     } else {
-      this.native.update(binaryLikeToArrayBuffer(data, inputEncoding));
+      this.native.update(...binaryLikeToView(data, inputEncoding));
     }
 
     return this; // to support chaining syntax createHash().update().digest()
@@ -4,7 +4,11 @@ import { NitroModules } from 'react-native-nitro-modules';
 import type { TransformOptions } from 'readable-stream';
 import type { Hmac as NativeHmac } from './specs/hmac.nitro';
 import type { BinaryLike, Encoding } from './utils/types';
-import { ab2str, binaryLikeToArrayBuffer } from './utils/conversion';
+import {
+  ab2str,
+  binaryLikeToArrayBuffer,
+  binaryLikeToView,
+} from './utils/conversion';
 
 interface HmacArgs {
   algorithm: string;
@@ -58,7 +62,7 @@ class Hmac extends Stream.Transform {
     if (typeof data === 'string' && inputEncoding === 'utf8') {
       this.native.update(data);
     } else {
-      this.native.update(binaryLikeToArrayBuffer(data, inputEncoding));
+      this.native.update(...binaryLikeToView(data, inputEncoding));
     }
 
     return this; // to support chaining syntax createHmac().update().digest()
@@ -135,6 +139,65 @@ export function createHmac(
   });
 }
 
+let batcher: NativeHmac | undefined;
+
+function toMessages(messages: BinaryLike[]): (ArrayBuffer | string)[] {
+  // UTF-8 strings cross as-is and are read in place natively
+  return messages.map(message =>
+    typeof message === 'string' ? message : binaryLikeToArrayBuffer(message),
+  );
+}
+
+/**
+ * Computes the HMAC of every message under one key and returns the tags
+ * packed back to back: tag `i` is `tags.subarray(i * n, (i + 1) * n)` where
+ * `n` is the digest size, or `truncateTo` if given.
+ *
+ * The key is set up once for the whole batch instead of once per message,
+ * and large batches are split across threads. Suited to blind indexes and
+ * signing many requests with the same key.
+ *
+ * ```js
+ * const tags = hmacMany('sha256', indexKey, emails, 16);
+ * const first = tags.subarray(0, 16);
+ * ```
+ */
+export function hmacMany(
+  algorithm: string,
+  key: BinaryLike,
+  messages: BinaryLike[],
+  truncateTo?: number,
+): Buffer {
+  batcher ??= NitroModules.createHybridObject<NativeHmac>('Hmac');
+  return Buffer.from(
+    batcher.hmacMany(
+      algorithm,
+      binaryLikeToArrayBuffer(key),
+      toMessages(messages),
+      truncateTo,
+    ),
+  );
+}
+
+/** Like `hmacMany()`, off the JS thread. */
+export async function hmacManyAsync(
+  algorithm: string,
+  key: BinaryLike,
+  messages: BinaryLike[],
+  truncateTo?: number,
+): Promise<Buffer> {
+  batcher ??= NitroModules.createHybridObject<NativeHmac>('Hmac');
+  const tags = await batcher.hmacManyAsync(
+    algorithm,
+    binaryLikeToArrayBuffer(key),
+    toMessages(messages),
+    truncateTo,
+  );
+  return Buffer.from(tags);
+}
+
 export const hmacExports = {
   createHmac,
+  hmacMany,
+  hmacManyAsync,
 };
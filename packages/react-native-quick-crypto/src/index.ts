@@ -5,10 +5,17 @@ import { Buffer } from '@craftzdog/react-native-buffer';
 import * as keys from './keys';
 import * as blake3 from './blake3';
 import * as cipher from './cipher';
+import { compressExports as compress } from './compress';
+import * as diffieHellman from './diffieHellman';
 import * as ed from './ed';
 import { hashExports as hash } from './hash';
 import { hmacExports as hmac } from './hmac';
 import * as hkdf from './hkdf';
+import { keyRotationExports as keyRotation } from './keyRotation';
+import { macExports as mac } from './mac';
+import { noiseExports as noise } from './noise';
+import { oprfExports as oprf } from './oprf';
+import { pageCipherExports as pageCipher } from './pageCipher';
 import * as pbkdf2 from './pbkdf2';
 import * as scrypt from './scrypt';
 import * as random from './random';
@@ -26,10 +33,17 @@ const QuickCrypto = {
   ...keys,
   ...blake3,
   ...cipher,
+  ...compress,
+  ...diffieHellman,
   ...ed,
   ...hash,
   ...hmac,
   ...hkdf,
+  ...keyRotation,
+  ...mac,
+  ...noise,
+  ...oprf,
+  ...pageCipher,
   ...pbkdf2,
   ...scrypt,
   ...random,
@@ -63,11 +77,18 @@ if (global.process.nextTick == null) {
 export default QuickCrypto;
 export * from './blake3';
 export * from './cipher';
+export * from './compress';
+export * from './diffieHellman';
 export * from './ed';
 export * from './keys';
 export * from './hash';
 export * from './hmac';
 export * from './hkdf';
+export * from './keyRotation';
+export * from './mac';
+export * from './noise';
+export * from './oprf';
+export * from './pageCipher';
 export * from './pbkdf2';
 export * from './scrypt';
 export * from './random';
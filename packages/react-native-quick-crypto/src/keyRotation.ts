@@ -0,0 +1,151 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import { NitroModules } from 'react-native-nitro-modules';
+import type { KeyRotation as NativeKeyRotation } from './specs/keyRotation.nitro';
+import type { BinaryLike } from './utils/types';
+import { binaryLikeToArrayBuffer } from './utils/conversion';
+
+export type RecordCipherAlgorithm =
+  | 'aes-128-gcm'
+  | 'aes-256-gcm'
+  | 'chacha20-poly1305';
+
+export interface KeyRotationOptions {
+  /** Algorithm of the new key, defaults to `'aes-256-gcm'` */
+  algorithm?: RecordCipherAlgorithm;
+  /** Algorithm the records are sealed with, defaults to `algorithm` */
+  oldAlgorithm?: RecordCipherAlgorithm;
+  /**
+   * 4-byte fixed field at the start of every new nonce. Give each writer
+   * that shares the new key its own prefix. Defaults to 4 random bytes per
+   * rotation.
+   */
+  noncePrefix?: BinaryLike;
+  /**
+   * First invocation counter to use with the new key: the `counter` persisted
+   * after its previous batch, or 0 for a key that has never encrypted.
+   */
+  counter: number;
+}
+
+export interface ReencryptOptions {
+  /** Additional authenticated data, one entry per record, for both keys */
+  aad?: BinaryLike[];
+  /** Number of threads used to process the batch, defaults to 1 */
+  parallelism?: number;
+}
+
+export interface ReencryptResult {
+  records: Buffer[];
+  /** Next unused counter of the new key; persist it before storing records */
+  counter: number;
+}
+
+/**
+ * Moves AEAD records from an old data-encryption key to a new one without
+ * the plaintext ever reaching JS. Records are `nonce (12) || ciphertext ||
+ * tag (16)`; new nonces are `noncePrefix (4) || counter (8, big-endian)`.
+ */
+export class KeyRotation {
+  private native: NativeKeyRotation;
+
+  constructor(
+    oldKey: BinaryLike,
+    newKey: BinaryLike,
+    options: KeyRotationOptions,
+  ) {
+    // A default of 0 would reuse every nonce of an earlier rotation
+    if (typeof options?.counter !== 'number') {
+      throw new Error(
+        'KeyRotation: counter is required; pass the counter persisted for the new key',
+      );
+    }
+    const algorithm = options.algorithm ?? 'aes-256-gcm';
+    this.native =
+      NitroModules.createHybridObject<NativeKeyRotation>('KeyRotation');
+    this.native.init({
+      cipherType: algorithm,
+      oldCipherType: options.oldAlgorithm,
+      oldKey: binaryLikeToArrayBuffer(oldKey),
+      newKey: binaryLikeToArrayBuffer(newKey),
+      noncePrefix:
+        options.noncePrefix === undefined
+          ? undefined
+          : binaryLikeToArrayBuffer(options.noncePrefix),
+      counter: options.counter,
+    });
+  }
+
+  /**
+   * Next unused invocation counter of the new key. Every batch reserves one
+   * counter per record up front, including batches that later throw.
+   */
+  get counter(): number {
+    return this.native.getCounter();
+  }
+
+  /**
+   * Re-encrypts every record under the new key. Throws, returning nothing,
+   * if any record fails to authenticate under the old key.
+   */
+  reencryptBatch(
+    records: BinaryLike[],
+    options: ReencryptOptions = {},
+  ): Buffer[] {
+    return this.native
+      .reencryptBatch(
+        records.map(record => binaryLikeToArrayBuffer(record)),
+        options.aad?.map(aad => binaryLikeToArrayBuffer(aad)),
+        options.parallelism,
+      )
+      .map(record => Buffer.from(record));
+  }
+
+  /** Like `reencryptBatch()`, off the JS thread. Inputs are copied first. */
+  async reencryptBatchAsync(
+    records: BinaryLike[],
+    options: ReencryptOptions = {},
+  ): Promise<Buffer[]> {
+    const sealed = await this.native.reencryptBatchAsync(
+      records.map(record => binaryLikeToArrayBuffer(record)),
+      options.aad?.map(aad => binaryLikeToArrayBuffer(aad)),
+      options.parallelism,
+    );
+    return sealed.map(record => Buffer.from(record));
+  }
+}
+
+export function createKeyRotation(
+  oldKey: BinaryLike,
+  newKey: BinaryLike,
+  options: KeyRotationOptions,
+): KeyRotation {
+  return new KeyRotation(oldKey, newKey, options);
+}
+
+/**
+ * One-shot `createKeyRotation(oldKey, newKey, options).reencryptBatch()`.
+ *
+ * ```js
+ * const { records, counter } = reencryptBatch(oldKey, newKey, stored, {
+ *   counter: savedCounter,
+ * });
+ * ```
+ */
+export function reencryptBatch(
+  oldKey: BinaryLike,
+  newKey: BinaryLike,
+  records: BinaryLike[],
+  options: KeyRotationOptions & ReencryptOptions,
+): ReencryptResult {
+  const { aad, parallelism, ...keyOptions } = options;
+  const rotation = new KeyRotation(oldKey, newKey, keyOptions);
+  return {
+    records: rotation.reencryptBatch(records, { aad, parallelism }),
+    counter: rotation.counter,
+  };
+}
+
+export const keyRotationExports = {
+  createKeyRotation,
+  reencryptBatch,
+};
@@ -8,6 +8,7 @@ import {
 } from './classes';
 import { generateKeyPair, generateKeyPairSync } from './generateKeyPair';
 import { createSign, createVerify, Sign, Verify } from './signVerify';
+import { createKeyWrap, KeyWrap } from './keyWrap';
 import {
   publicEncrypt,
   publicDecrypt,
@@ -243,6 +244,10 @@ export {
   privateEncrypt,
   privateDecrypt,
 
+  // Batch key wrap
+  createKeyWrap,
+  KeyWrap,
+
   // Node Internal API
   parsePublicKeyEncoding,
   parsePrivateKeyEncoding,
@@ -252,3 +257,5 @@ export {
   PrivateKeyObject,
   isCryptoKey,
 };
+
+export type { KeyWrapOptions } from './keyWrap';
@@ -0,0 +1,95 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import { NitroModules } from 'react-native-nitro-modules';
+import type { KeyWrap as NativeKeyWrap } from '../specs/keyWrap.nitro';
+import { CryptoKey, KeyObject, SecretKeyObject } from './classes';
+import { isCryptoKey } from './utils';
+import type { BinaryLike } from '../utils';
+import { binaryLikeToArrayBuffer as toAB } from '../utils';
+
+type WrapKeyInput = KeyObject | CryptoKey;
+
+export interface KeyWrapOptions {
+  /**
+   * Use RFC 5649 (AES key wrap with padding), which wraps keys of any
+   * length. Defaults to `false`: RFC 3394, keys of 16 bytes or more in
+   * multiples of 8.
+   */
+  padding?: boolean;
+  /** Unwrapped keys remembered by their wrapped bytes, defaults to 256 */
+  cacheSize?: number;
+}
+
+function toKeyObject(key: WrapKeyInput): KeyObject {
+  const keyObject = isCryptoKey(key) ? (key as CryptoKey).keyObject : key;
+  if (!(keyObject instanceof KeyObject) || keyObject.type !== 'secret') {
+    throw new Error('KeyWrap: keys must be secret KeyObjects or CryptoKeys');
+  }
+  return keyObject;
+}
+
+/**
+ * Wraps and unwraps data keys under one AES key-encryption key (KEK), a
+ * whole batch per native call. Unwrapped keys are cached natively by their
+ * wrapped bytes, so reopening the same envelopes does no AES work.
+ */
+export class KeyWrap {
+  private native: NativeKeyWrap;
+
+  constructor(kek: WrapKeyInput, options: KeyWrapOptions = {}) {
+    this.native = NitroModules.createHybridObject<NativeKeyWrap>('KeyWrap');
+    this.native.init(
+      toKeyObject(kek).handle,
+      options.padding ?? false,
+      options.cacheSize ?? 256,
+    );
+  }
+
+  /** Number of unwrapped keys currently held in the cache */
+  get cachedCount(): number {
+    return this.native.getCachedCount();
+  }
+
+  /** Wraps every key; the wrapped keys also seed the unwrap cache. */
+  wrapKeys(keys: WrapKeyInput[]): Buffer[] {
+    return this.native
+      .wrapKeys(keys.map(key => toKeyObject(key).handle))
+      .map(wrapped => Buffer.from(wrapped));
+  }
+
+  async wrapKeysAsync(keys: WrapKeyInput[]): Promise<Buffer[]> {
+    const wrapped = await this.native.wrapKeysAsync(
+      keys.map(key => toKeyObject(key).handle),
+    );
+    return wrapped.map(key => Buffer.from(key));
+  }
+
+  /**
+   * Unwraps every key. Throws, returning nothing, if any wrapped key fails
+   * its integrity check.
+   */
+  unwrapKeys(wrapped: BinaryLike[]): SecretKeyObject[] {
+    return this.native
+      .unwrapKeys(wrapped.map(key => toAB(key)))
+      .map(handle => new SecretKeyObject(handle));
+  }
+
+  /** Like `unwrapKeys()`, off the JS thread. Inputs are copied first. */
+  async unwrapKeysAsync(wrapped: BinaryLike[]): Promise<SecretKeyObject[]> {
+    const handles = await this.native.unwrapKeysAsync(
+      wrapped.map(key => toAB(key)),
+    );
+    return handles.map(handle => new SecretKeyObject(handle));
+  }
+
+  /** Drops every cached key, e.g. when the folder they belong to closes. */
+  clearCache(): void {
+    this.native.clearCache();
+  }
+}
+
+export function createKeyWrap(
+  kek: WrapKeyInput,
+  options: KeyWrapOptions = {},
+): KeyWrap {
+  return new KeyWrap(kek, options);
+}
@@ -9,6 +9,7 @@ import { isCryptoKey } from './utils';
 import type { BinaryLike } from '../utils';
 import {
   binaryLikeToArrayBuffer as toAB,
+  binaryLikeToView,
   isStringOrBuffer,
   KFormatType,
   KeyEncoding,
@@ -158,8 +159,7 @@ export class Sign {
   }
 
   update(data: BinaryLike): this {
-    const dataBuffer = toAB(data);
-    this.handle.update(dataBuffer);
+    this.handle.update(...binaryLikeToView(data));
     return this;
   }
 
@@ -196,8 +196,7 @@ export class Verify {
   }
 
   update(data: BinaryLike): this {
-    const dataBuffer = toAB(data);
-    this.handle.update(dataBuffer);
+    this.handle.update(...binaryLikeToView(data));
     return this;
   }
 
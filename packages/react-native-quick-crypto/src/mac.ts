@@ -0,0 +1,185 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import { NitroModules } from 'react-native-nitro-modules';
+import type { Mac as NativeMac } from './specs/mac.nitro';
+import type { BinaryLike, Encoding } from './utils/types';
+import {
+  ab2str,
+  binaryLikeToArrayBuffer,
+  binaryLikeToView,
+} from './utils/conversion';
+
+export type MacAlgorithm =
+  | 'HMAC'
+  | 'CMAC'
+  | 'GMAC'
+  | 'KMAC-128'
+  | 'KMAC-256'
+  | 'POLY1305'
+  | 'SIPHASH'
+  | 'BLAKE2BMAC'
+  | 'BLAKE2SMAC';
+
+export interface MacOptions {
+  /** Digest for HMAC, e.g. `'SHA256'` */
+  digest?: string;
+  /** Block cipher for CMAC (`'AES-128-CBC'`) or GMAC (`'AES-256-GCM'`) */
+  cipher?: string;
+  /** GMAC IV used by `update()` / `digest()` */
+  iv?: BinaryLike;
+  /** KMAC and BLAKE2 customization string */
+  customization?: BinaryLike;
+  /** BLAKE2 salt */
+  salt?: BinaryLike;
+  /** Tag length in bytes for KMAC, SipHash (8 or 16) and BLAKE2 */
+  outputLength?: number;
+}
+
+function encode(buffer: ArrayBuffer, encoding?: Encoding): Buffer | string {
+  if (encoding && encoding !== 'buffer') {
+    return ab2str(buffer, encoding);
+  }
+  return Buffer.from(buffer);
+}
+
+/**
+ * A keyed MAC over any OpenSSL `EVP_MAC`. The key is set up once; `compute()`
+ * and `computeMany()` then tag independent messages without repeating the
+ * key schedule, while `update()` / `digest()` stream a single message.
+ *
+ * Poly1305 keys are one-time: a Poly1305 `Mac` produces exactly one tag.
+ * GMAC's one-shot methods take a fresh IV per message.
+ */
+export class Mac {
+  private native: NativeMac;
+
+  /**
+   * @internal use `createMac()` instead
+   */
+  private constructor(native: NativeMac) {
+    this.native = native;
+  }
+
+  /** Length of the tags this Mac produces, in bytes. */
+  get macLength(): number {
+    return this.native.getMacLength();
+  }
+
+  /**
+   * Adds `data` to the streamed message. Strings are UTF-8 unless
+   * `inputEncoding` says otherwise.
+   */
+  update(data: BinaryLike): Mac;
+  update(data: BinaryLike, inputEncoding: Encoding): Mac;
+  update(data: BinaryLike, inputEncoding?: Encoding): Mac {
+    inputEncoding = inputEncoding ?? 'utf8';
+    if (typeof data === 'string' && inputEncoding === 'utf8') {
+      this.native.update(data);
+    } else {
+      this.native.update(...binaryLikeToView(data, inputEncoding));
+    }
+    return this;
+  }
+
+  /**
+   * Returns the tag of the streamed message. Like `Hmac`, it can only be
+   * called once.
+   */
+  digest(): Buffer;
+  digest(encoding: Encoding): string;
+  digest(encoding?: Encoding): Buffer | string {
+    return encode(this.native.digest(), encoding);
+  }
+
+  /**
+   * Returns an independent `Mac` in the same state, e.g. to tag several
+   * messages that share a prefix.
+   */
+  copy(): Mac {
+    return new Mac(this.native.copy());
+  }
+
+  /** Tags one complete message. Does not affect streamed state. */
+  compute(data: BinaryLike, iv?: BinaryLike): Buffer {
+    return Buffer.from(
+      this.native.compute(
+        binaryLikeToArrayBuffer(data),
+        iv === undefined ? undefined : binaryLikeToArrayBuffer(iv),
+      ),
+    );
+  }
+
+  /** Tags each message in one native call. GMAC needs one IV per message. */
+  computeMany(messages: BinaryLike[], ivs?: BinaryLike[]): Buffer[] {
+    return this.native
+      .computeMany(
+        messages.map(message => binaryLikeToArrayBuffer(message)),
+        ivs?.map(iv => binaryLikeToArrayBuffer(iv)),
+      )
+      .map(tag => Buffer.from(tag));
+  }
+
+  /** Like `computeMany()`, off the JS thread. */
+  async computeManyAsync(
+    messages: BinaryLike[],
+    ivs?: BinaryLike[],
+  ): Promise<Buffer[]> {
+    const tags = await this.native.computeManyAsync(
+      messages.map(message => binaryLikeToArrayBuffer(message)),
+      ivs?.map(iv => binaryLikeToArrayBuffer(iv)),
+    );
+    return tags.map(tag => Buffer.from(tag));
+  }
+}
+
+/**
+ * Creates a `Mac` for `algorithm` keyed with `key`.
+ *
+ * ```js
+ * const cmac = createMac('CMAC', key, { cipher: 'AES-128-CBC' });
+ * const tags = cmac.computeMany(packets);
+ * ```
+ */
+export function createMac(
+  algorithm: MacAlgorithm,
+  key: BinaryLike,
+  options: MacOptions = {},
+): Mac {
+  const native = NitroModules.createHybridObject<NativeMac>('Mac');
+  native.init({
+    algorithm,
+    key: binaryLikeToArrayBuffer(key),
+    digest: options.digest,
+    cipher: options.cipher,
+    iv:
+      options.iv === undefined
+        ? undefined
+        : binaryLikeToArrayBuffer(options.iv),
+    customization:
+      options.customization === undefined
+        ? undefined
+        : binaryLikeToArrayBuffer(options.customization),
+    salt:
+      options.salt === undefined
+        ? undefined
+        : binaryLikeToArrayBuffer(options.salt),
+    outputLength: options.outputLength,
+  });
+  // @ts-expect-error private constructor
+  return new Mac(native);
+}
+
+/** One-shot `createMac(algorithm, key, options).compute(data, options.iv)`. */
+export function mac(
+  algorithm: MacAlgorithm,
+  key: BinaryLike,
+  data: BinaryLike,
+  options: MacOptions = {},
+): Buffer {
+  const { iv, ...rest } = options;
+  return createMac(algorithm, key, rest).compute(data, iv);
+}
+
+export const macExports = {
+  createMac,
+  mac,
+};
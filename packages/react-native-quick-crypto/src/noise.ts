@@ -0,0 +1,206 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import { NitroModules } from 'react-native-nitro-modules';
+import type {
+  NoiseHandshake as NativeNoiseHandshake,
+  NoiseTransport as NativeNoiseTransport,
+} from './specs/noise.nitro';
+import type { BinaryLike } from './utils/types';
+import { binaryLikeToArrayBuffer as toAB } from './utils/conversion';
+
+/** The DH functions of the Noise Protocol Framework that are supported. */
+export type NoiseDh = '25519' | '448';
+
+export type NoiseRole = 'initiator' | 'responder';
+
+/**
+ * What the handshake expects next: write or read a message, `split()` into
+ * a transport, or nothing (`'done'`, after `split()` or a failed message).
+ */
+export type NoiseAction = 'write' | 'read' | 'split' | 'done';
+
+export interface NoiseKeyPair {
+  privateKey: Buffer;
+  publicKey: Buffer;
+}
+
+export interface NoiseHandshakeOptions {
+  prologue?: BinaryLike;
+  /** Raw private key; required when the pattern sends or pre-shares `s` */
+  staticPrivateKey?: BinaryLike;
+  /** Raw public key; required when the pattern pre-shares the peer's `s` */
+  remoteStaticPublicKey?: BinaryLike;
+  /** Fixed ephemeral key, for test vectors only. Generated when omitted. */
+  ephemeralPrivateKey?: BinaryLike;
+}
+
+function toBuffers(buffers: ArrayBuffer[]): Buffer[] {
+  return buffers.map(buffer => Buffer.from(buffer));
+}
+
+function toABs(items: BinaryLike[]): ArrayBuffer[] {
+  return items.map(item => toAB(item));
+}
+
+function optionalAB(value?: BinaryLike): ArrayBuffer | undefined {
+  return value === undefined ? undefined : toAB(value);
+}
+
+/**
+ * The transport phase of a Noise session: one CipherState per direction,
+ * each keyed once in native code. Nonces advance with every message, so
+ * messages must be decrypted in the order they were encrypted.
+ *
+ * Encryption batches take their nonces when called. Decryption, single or
+ * batched, advances the nonce only once every message authenticated, so a
+ * forged message does not desynchronize the channel. While a
+ * `decryptManyAsync()` is pending, the other receive calls throw.
+ */
+export class NoiseTransport {
+  private native: NativeNoiseTransport;
+
+  /**
+   * @internal use `NoiseHandshake.split()` instead
+   */
+  private constructor(native: NativeNoiseTransport) {
+    this.native = native;
+  }
+
+  encrypt(plaintext: BinaryLike, ad?: BinaryLike): Buffer {
+    return Buffer.from(this.native.encrypt(toAB(plaintext), optionalAB(ad)));
+  }
+
+  /** Throws if the message was not authenticated. */
+  decrypt(ciphertext: BinaryLike, ad?: BinaryLike): Buffer {
+    return Buffer.from(this.native.decrypt(toAB(ciphertext), optionalAB(ad)));
+  }
+
+  /** Encrypts a burst of messages with consecutive nonces in one call. */
+  encryptMany(plaintexts: BinaryLike[]): Buffer[] {
+    return toBuffers(this.native.encryptMany(toABs(plaintexts)));
+  }
+
+  /** Like `encryptMany()`, off the JS thread. */
+  async encryptManyAsync(plaintexts: BinaryLike[]): Promise<Buffer[]> {
+    return toBuffers(await this.native.encryptManyAsync(toABs(plaintexts)));
+  }
+
+  /** Throws, keeping the nonce, if any message was not authenticated. */
+  decryptMany(ciphertexts: BinaryLike[]): Buffer[] {
+    return toBuffers(this.native.decryptMany(toABs(ciphertexts)));
+  }
+
+  /** Like `decryptMany()`, off the JS thread. */
+  async decryptManyAsync(ciphertexts: BinaryLike[]): Promise<Buffer[]> {
+    return toBuffers(await this.native.decryptManyAsync(toABs(ciphertexts)));
+  }
+
+  /** Rekey() of the sending CipherState; the peer calls `rekeyReceive()`. */
+  rekeySend(): void {
+    this.native.rekeySend();
+  }
+
+  rekeyReceive(): void {
+    this.native.rekeyReceive();
+  }
+}
+
+/**
+ * A Noise handshake, e.g. `Noise_XX_25519_ChaChaPoly_BLAKE2s`. Each
+ * `writeMessage()` and `readMessage()` processes a whole handshake message
+ * natively; the ephemeral, static and chaining keys stay in native memory.
+ */
+export class NoiseHandshake {
+  private native: NativeNoiseHandshake;
+
+  /**
+   * @internal use `createNoiseHandshake()` instead
+   */
+  private constructor(native: NativeNoiseHandshake) {
+    this.native = native;
+  }
+
+  get action(): NoiseAction {
+    return this.native.getAction() as NoiseAction;
+  }
+
+  /** Returns the handshake message carrying `payload`. */
+  writeMessage(payload: BinaryLike = Buffer.alloc(0)): Buffer {
+    return Buffer.from(this.native.writeMessage(toAB(payload)));
+  }
+
+  /** Returns the message's payload; throws if it fails to authenticate. */
+  readMessage(message: BinaryLike): Buffer {
+    return Buffer.from(this.native.readMessage(toAB(message)));
+  }
+
+  /** The handshake hash `h`, for channel binding. */
+  get handshakeHash(): Buffer {
+    return Buffer.from(this.native.getHandshakeHash());
+  }
+
+  /** The peer's static public key, once known. */
+  get remoteStaticPublicKey(): Buffer | undefined {
+    const key = this.native.getRemoteStaticPublicKey();
+    return key === undefined ? undefined : Buffer.from(key);
+  }
+
+  /** Ends the handshake and returns the keyed transport. */
+  split(): NoiseTransport {
+    // @ts-expect-error private constructor
+    return new NoiseTransport(this.native.split());
+  }
+}
+
+/**
+ * Starts a Noise handshake. The fundamental patterns (N, K, X, NN … IX) are
+ * supported with 25519/448, ChaChaPoly/AESGCM and
+ * SHA256/SHA512/BLAKE2s/BLAKE2b; PSK and fallback modifiers are not.
+ *
+ * ```js
+ * const handshake = createNoiseHandshake(
+ *   'Noise_XX_25519_ChaChaPoly_BLAKE2s',
+ *   'initiator',
+ *   { staticPrivateKey },
+ * );
+ * send(handshake.writeMessage());
+ * handshake.readMessage(await receive());
+ * send(handshake.writeMessage());
+ * const transport = handshake.split();
+ * ```
+ */
+export function createNoiseHandshake(
+  protocolName: string,
+  role: NoiseRole,
+  options: NoiseHandshakeOptions = {},
+): NoiseHandshake {
+  const native = NitroModules.createHybridObject<NativeNoiseHandshake>(
+    'NoiseHandshake',
+  );
+  native.init({
+    protocolName,
+    initiator: role === 'initiator',
+    prologue: optionalAB(options.prologue),
+    staticPrivateKey: optionalAB(options.staticPrivateKey),
+    remoteStaticPublicKey: optionalAB(options.remoteStaticPublicKey),
+    ephemeralPrivateKey: optionalAB(options.ephemeralPrivateKey),
+  });
+  // @ts-expect-error private constructor
+  return new NoiseHandshake(native);
+}
+
+/** Generates a raw static key pair for `staticPrivateKey`. */
+export function generateNoiseKeyPair(dh: NoiseDh = '25519'): NoiseKeyPair {
+  const native = NitroModules.createHybridObject<NativeNoiseHandshake>(
+    'NoiseHandshake',
+  );
+  const [privateKey, publicKey] = native.generateKeyPair(dh);
+  return {
+    privateKey: Buffer.from(privateKey!),
+    publicKey: Buffer.from(publicKey!),
+  };
+}
+
+export const noiseExports = {
+  createNoiseHandshake,
+  generateNoiseKeyPair,
+};
@@ -0,0 +1,271 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import { NitroModules } from 'react-native-nitro-modules';
+import type { Oprf as NativeOprf } from './specs/oprf.nitro';
+import type { BinaryLike } from './utils/types';
+import { binaryLikeToArrayBuffer as toAB } from './utils/conversion';
+import { randomBytes } from './random';
+
+/**
+ * RFC 9497 ciphersuites. Each one's HashToGroup is the RFC 9380 suite of the
+ * same curve, e.g. `P256_XMD:SHA-256_SSWU_RO_` for `'P256-SHA256'`.
+ */
+export type OprfSuite = 'P256-SHA256' | 'P384-SHA384' | 'P521-SHA512';
+
+export interface OprfKeyPair {
+  privateKey: Buffer;
+  publicKey: Buffer;
+}
+
+export interface OprfBlindResult {
+  /** Secret; keep them until `finalize()` */
+  blinds: Buffer[];
+  /** Sent to the server */
+  blindedElements: Buffer[];
+}
+
+export interface OprfEvaluation {
+  evaluatedElements: Buffer[];
+  /** One DLEQ proof for the whole batch, in VOPRF mode */
+  proof?: Buffer;
+}
+
+export interface OprfClientOptions {
+  /** The server's public key. Selects VOPRF mode, which checks every proof. */
+  publicKey?: BinaryLike;
+}
+
+export interface OprfServerOptions {
+  /** VOPRF mode: attach a proof to every evaluation. Defaults to `false`. */
+  verifiable?: boolean;
+}
+
+function createNative(suite: OprfSuite, verifiable: boolean): NativeOprf {
+  const native = NitroModules.createHybridObject<NativeOprf>('Oprf');
+  native.init(suite, verifiable);
+  return native;
+}
+
+function toBuffers(buffers: ArrayBuffer[]): Buffer[] {
+  return buffers.map(buffer => Buffer.from(buffer));
+}
+
+function toABs(items: BinaryLike[]): ArrayBuffer[] {
+  return items.map(item => toAB(item));
+}
+
+/**
+ * The client side of an OPRF or VOPRF. Every step takes the whole batch in
+ * one native call: blinding hashes and blinds all inputs together, and
+ * finalize inverts all blinds with a single field inversion. In VOPRF mode
+ * the batch's proof is checked with multi-scalar multiplications before
+ * anything is unblinded.
+ */
+export class OprfClient {
+  private native: NativeOprf;
+  private publicKey?: ArrayBuffer;
+
+  /**
+   * @internal use `createOprfClient()` instead
+   */
+  private constructor(native: NativeOprf, publicKey?: ArrayBuffer) {
+    this.native = native;
+    this.publicKey = publicKey;
+  }
+
+  /** Blinds every input with a fresh random scalar. */
+  blind(inputs: BinaryLike[]): OprfBlindResult {
+    const blinds = this.native.randomScalars(inputs.length);
+    return {
+      blinds: toBuffers(blinds),
+      blindedElements: toBuffers(this.native.blind(toABs(inputs), blinds)),
+    };
+  }
+
+  /** Like `blind()`, off the JS thread. */
+  async blindAsync(inputs: BinaryLike[]): Promise<OprfBlindResult> {
+    const blinds = this.native.randomScalars(inputs.length);
+    const blinded = await this.native.blindAsync(toABs(inputs), blinds);
+    return { blinds: toBuffers(blinds), blindedElements: toBuffers(blinded) };
+  }
+
+  /**
+   * Unblinds the server's evaluation into one PRF output per input. In VOPRF
+   * mode, throws if the proof does not cover the batch.
+   */
+  finalize(
+    inputs: BinaryLike[],
+    blinded: OprfBlindResult,
+    evaluation: OprfEvaluation,
+  ): Buffer[] {
+    const evaluated = toABs(evaluation.evaluatedElements);
+    if (this.publicKey !== undefined) {
+      const verified = this.native.verifyProof(
+        this.publicKey,
+        toABs(blinded.blindedElements),
+        evaluated,
+        toAB(this.requireProof(evaluation)),
+      );
+      if (!verified) {
+        throw new Error('OPRF: Proof verification failed');
+      }
+    }
+    return toBuffers(
+      this.native.finalize(toABs(inputs), toABs(blinded.blinds), evaluated),
+    );
+  }
+
+  /** Like `finalize()`, off the JS thread. */
+  async finalizeAsync(
+    inputs: BinaryLike[],
+    blinded: OprfBlindResult,
+    evaluation: OprfEvaluation,
+  ): Promise<Buffer[]> {
+    const evaluated = toABs(evaluation.evaluatedElements);
+    if (this.publicKey !== undefined) {
+      const verified = await this.native.verifyProofAsync(
+        this.publicKey,
+        toABs(blinded.blindedElements),
+        evaluated,
+        toAB(this.requireProof(evaluation)),
+      );
+      if (!verified) {
+        throw new Error('OPRF: Proof verification failed');
+      }
+    }
+    const outputs = await this.native.finalizeAsync(
+      toABs(inputs),
+      toABs(blinded.blinds),
+      evaluated,
+    );
+    return toBuffers(outputs);
+  }
+
+  private requireProof(evaluation: OprfEvaluation): Buffer {
+    if (evaluation.proof === undefined) {
+      throw new Error('OPRF: VOPRF evaluation is missing its proof');
+    }
+    return evaluation.proof;
+  }
+}
+
+/**
+ * The server side: evaluates blinded elements under its private key and, in
+ * VOPRF mode, proves the whole batch with one DLEQ proof.
+ */
+export class OprfServer {
+  private native: NativeOprf;
+  private privateKey: ArrayBuffer;
+  private verifiable: boolean;
+
+  /**
+   * @internal use `createOprfServer()` instead
+   */
+  private constructor(
+    native: NativeOprf,
+    privateKey: ArrayBuffer,
+    verifiable: boolean,
+  ) {
+    this.native = native;
+    this.privateKey = privateKey;
+    this.verifiable = verifiable;
+  }
+
+  blindEvaluate(blindedElements: BinaryLike[]): OprfEvaluation {
+    const blinded = toABs(blindedElements);
+    const evaluated = this.native.blindEvaluate(this.privateKey, blinded);
+    if (!this.verifiable) {
+      return { evaluatedElements: toBuffers(evaluated) };
+    }
+    const proof = this.native.generateProof(
+      this.privateKey,
+      blinded,
+      evaluated,
+    );
+    return {
+      evaluatedElements: toBuffers(evaluated),
+      proof: Buffer.from(proof),
+    };
+  }
+}
+
+/**
+ * Creates an OPRF client, or a VOPRF client when `options.publicKey` is set.
+ *
+ * ```js
+ * const client = createOprfClient('P256-SHA256', { publicKey });
+ * const blinded = client.blind(phoneNumbers);
+ * const evaluation = await lookup(blinded.blindedElements);
+ * const outputs = client.finalize(phoneNumbers, blinded, evaluation);
+ * ```
+ */
+export function createOprfClient(
+  suite: OprfSuite,
+  options: OprfClientOptions = {},
+): OprfClient {
+  const verifiable = options.publicKey !== undefined;
+  // @ts-expect-error private constructor
+  return new OprfClient(
+    createNative(suite, verifiable),
+    verifiable ? toAB(options.publicKey!) : undefined,
+  );
+}
+
+export function createOprfServer(
+  suite: OprfSuite,
+  privateKey: BinaryLike,
+  options: OprfServerOptions = {},
+): OprfServer {
+  const verifiable = options.verifiable ?? false;
+  // @ts-expect-error private constructor
+  return new OprfServer(
+    createNative(suite, verifiable),
+    toAB(privateKey),
+    verifiable,
+  );
+}
+
+/**
+ * DeriveKeyPair of RFC 9497: the same seed and info always give the same
+ * key. The mode is part of the derivation, so OPRF and VOPRF keys differ.
+ */
+export function deriveOprfKeyPair(
+  suite: OprfSuite,
+  seed: BinaryLike,
+  info: BinaryLike,
+  options: OprfServerOptions = {},
+): OprfKeyPair {
+  const native = createNative(suite, options.verifiable ?? false);
+  const [privateKey, publicKey] = native.deriveKeyPair(toAB(seed), toAB(info));
+  return {
+    privateKey: Buffer.from(privateKey!),
+    publicKey: Buffer.from(publicKey!),
+  };
+}
+
+export function generateOprfKeyPair(
+  suite: OprfSuite,
+  options: OprfServerOptions = {},
+): OprfKeyPair {
+  return deriveOprfKeyPair(suite, randomBytes(32), Buffer.alloc(0), options);
+}
+
+/**
+ * RFC 9380 hash_to_curve (random-oracle SSWU) of every input under `dst`, as
+ * compressed points.
+ */
+export function hashToCurve(
+  suite: OprfSuite,
+  inputs: BinaryLike[],
+  dst: BinaryLike,
+): Buffer[] {
+  const native = createNative(suite, false);
+  return toBuffers(native.hashToGroup(toABs(inputs), toAB(dst)));
+}
+
+export const oprfExports = {
+  createOprfClient,
+  createOprfServer,
+  deriveOprfKeyPair,
+  generateOprfKeyPair,
+  hashToCurve,
+};
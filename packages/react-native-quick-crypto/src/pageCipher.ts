@@ -0,0 +1,168 @@
+import { Buffer } from '@craftzdog/react-native-buffer';
+import { NitroModules } from 'react-native-nitro-modules';
+import type { PageCipher as NativePageCipher } from './specs/pageCipher.nitro';
+import type { ABV, BinaryLikeNode } from './utils';
+import { binaryLikeToArrayBuffer } from './utils';
+
+export type PageCipherAlgorithm =
+  | 'aes-128-gcm'
+  | 'aes-256-gcm'
+  | 'aes-128-xts'
+  | 'aes-256-xts'
+  | 'chacha20-poly1305';
+
+export interface PageCipherOptions {
+  /** Size of one page in bytes, including the reserved area (e.g. 4096) */
+  pageSize: number;
+  /**
+   * Bytes reserved at the end of every page. AEAD modes need at least 20
+   * (4-byte write counter + 16-byte tag); XTS defaults to 0.
+   */
+  reserveSize?: number;
+}
+
+export interface PageBatchOptions {
+  /** Number of threads used to process the batch, defaults to 1 */
+  parallelism?: number;
+}
+
+/**
+ * The exact bytes of `pages` as an ArrayBuffer. Views that do not span their
+ * whole ArrayBuffer are copied.
+ */
+function pageArrayBuffer(pages: ABV): ArrayBuffer {
+  if (pages instanceof ArrayBuffer) {
+    return pages;
+  }
+  const view = pages as ArrayBufferView;
+  if (view.byteOffset === 0 && view.byteLength === view.buffer.byteLength) {
+    return view.buffer as ArrayBuffer;
+  }
+  const bytes = new Uint8Array(view.buffer, view.byteOffset, view.byteLength);
+  return bytes.slice().buffer as ArrayBuffer;
+}
+
+/**
+ * Runs `fn` against the exact bytes of `pages`. Views that do not span their
+ * whole ArrayBuffer go through a temporary copy that is written back.
+ */
+function withPageBuffer(pages: ABV, fn: (buffer: ArrayBuffer) => void): void {
+  const buffer = pageArrayBuffer(pages);
+  fn(buffer);
+  if (ArrayBuffer.isView(pages) && buffer !== pages.buffer) {
+    new Uint8Array(pages.buffer, pages.byteOffset, pages.byteLength).set(
+      new Uint8Array(buffer),
+    );
+  }
+}
+
+/**
+ * Encrypts fixed-size database pages in place. The key schedule is set up
+ * once; each page gets its own nonce derived from its page number and write
+ * counter, and AEAD tags live in the page's reserved area.
+ */
+export class PageCipher {
+  private native: NativePageCipher;
+
+  constructor(
+    algorithm: PageCipherAlgorithm,
+    key: BinaryLikeNode,
+    options: PageCipherOptions,
+  ) {
+    this.native =
+      NitroModules.createHybridObject<NativePageCipher>('PageCipher');
+    this.native.init({
+      cipherType: algorithm,
+      cipherKey: binaryLikeToArrayBuffer(key),
+      pageSize: options.pageSize,
+      reserveSize: options.reserveSize,
+    });
+  }
+
+  /** Bytes at the end of every page that are not encrypted payload. */
+  get reserveSize(): number {
+    return this.native.getReserveSize();
+  }
+
+  /**
+   * Encrypts `pageNumbers.length` consecutive pages of `pages` in place.
+   * `writeCounters` must grow every time a page is rewritten (ignored for XTS).
+   */
+  encryptPages(
+    pages: ABV,
+    pageNumbers: number[],
+    writeCounters: number[] = [],
+    options: PageBatchOptions = {},
+  ): void {
+    withPageBuffer(pages, buffer =>
+      this.native.encryptPages(
+        buffer,
+        pageNumbers,
+        writeCounters,
+        options.parallelism,
+      ),
+    );
+  }
+
+  /**
+   * Decrypts pages in place. Throws if any AEAD page fails authentication;
+   * such pages are zeroed rather than left half-decrypted.
+   */
+  decryptPages(
+    pages: ABV,
+    pageNumbers: number[],
+    options: PageBatchOptions = {},
+  ): void {
+    withPageBuffer(pages, buffer =>
+      this.native.decryptPages(buffer, pageNumbers, options.parallelism),
+    );
+  }
+
+  /**
+   * Like encryptPages() but off the JS thread. `pages` is copied and left
+   * untouched; the encrypted pages are returned in a new Buffer.
+   */
+  async encryptPagesAsync(
+    pages: ABV,
+    pageNumbers: number[],
+    writeCounters: number[] = [],
+    options: PageBatchOptions = {},
+  ): Promise<Buffer> {
+    const result = await this.native.encryptPagesAsync(
+      pageArrayBuffer(pages),
+      pageNumbers,
+      writeCounters,
+      options.parallelism,
+    );
+    return Buffer.from(result);
+  }
+
+  /**
+   * Like decryptPages() but off the JS thread. `pages` is copied and left
+   * untouched; the decrypted pages are returned in a new Buffer.
+   */
+  async decryptPagesAsync(
+    pages: ABV,
+    pageNumbers: number[],
+    options: PageBatchOptions = {},
+  ): Promise<Buffer> {
+    const result = await this.native.decryptPagesAsync(
+      pageArrayBuffer(pages),
+      pageNumbers,
+      options.parallelism,
+    );
+    return Buffer.from(result);
+  }
+}
+
+export function createPageCipher(
+  algorithm: PageCipherAlgorithm,
+  key: BinaryLikeNode,
+  options: PageCipherOptions,
+): PageCipher {
+  return new PageCipher(algorithm, key, options);
+}
+
+export const pageCipherExports = {
+  createPageCipher,
+};
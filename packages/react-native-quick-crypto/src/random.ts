@@ -14,6 +14,10 @@ function getNative(): Random {
   return random;
 }
 
+// offsets are relative to the view, native fills the backing ArrayBuffer
+const byteOffset = (buffer: ABV): number =>
+  ArrayBuffer.isView(buffer) ? buffer.byteOffset : 0;
+
 export function randomFill<T extends ABV>(
   buffer: T,
   callback: RandomCallback<T>,
@@ -52,17 +56,20 @@ export function randomFill(buffer: ABV, ...rest: unknown[]): void {
 
   if (typeof rest[1] === 'function') {
     offset = rest[0] as number;
+    size = buffer.byteLength - offset;
   }
 
   getNative();
-  random.randomFill(abvToArrayBuffer(buffer), offset, size).then(
-    (res: ArrayBuffer) => {
-      callback(null, res);
-    },
-    (e: Error) => {
-      callback(e);
-    },
-  );
+  random
+    .randomFill(abvToArrayBuffer(buffer), byteOffset(buffer) + offset, size)
+    .then(
+      (res: ArrayBuffer) => {
+        callback(null, res);
+      },
+      (e: Error) => {
+        callback(e);
+      },
+    );
 }
 
 export function randomFillSync<T extends ABV>(
@@ -73,8 +80,11 @@ export function randomFillSync<T extends ABV>(
 
 export function randomFillSync(buffer: ABV, offset: number = 0, size?: number) {
   getNative();
-  buffer = abvToArrayBuffer(buffer);
-  const res = random.randomFillSync(buffer, offset, size ?? buffer.byteLength);
+  const res = random.randomFillSync(
+    abvToArrayBuffer(buffer),
+    byteOffset(buffer) + offset,
+    size ?? buffer.byteLength - offset,
+  );
   buffer = res;
   return buffer;
 }
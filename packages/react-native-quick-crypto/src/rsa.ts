@@ -30,6 +30,8 @@ export class Rsa {
     modulusLength: number,
     publicExponent: Uint8Array,
     hashAlgorithm: string,
+    primes = 2,
+    parallelism = 1,
   ) {
     this.native = NitroModules.createHybridObject<RsaKeyPair>('RsaKeyPair');
     this.native.setModulusLength(modulusLength);
@@ -40,6 +42,8 @@ export class Rsa {
       ) as ArrayBuffer,
     );
     this.native.setHashAlgorithm(hashAlgorithm);
+    this.native.setPrimes(primes);
+    this.native.setParallelism(parallelism);
   }
 
   async generateKeyPair(): Promise<CryptoKeyPair> {
@@ -191,10 +195,14 @@ function rsa_prepareKeyGenParams(
     modulusLength,
     publicExponent,
     hash = 'sha256',
+    primes = 2,
+    parallelism = 1,
   } = options as {
     modulusLength?: number;
     publicExponent?: number;
     hash?: string;
+    primes?: number;
+    parallelism?: number;
   };
 
   if (!modulusLength || modulusLength < 256) {
@@ -210,7 +218,7 @@ function rsa_prepareKeyGenParams(
 
   const hashName = typeof hash === 'string' ? hash : hash;
 
-  return new Rsa(modulusLength, pubExpBytes, hashName);
+  return new Rsa(modulusLength, pubExpBytes, hashName, primes, parallelism);
 }
 
 function rsa_formatKeyPairOutput(
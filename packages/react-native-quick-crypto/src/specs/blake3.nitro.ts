@@ -4,7 +4,7 @@ export interface Blake3 extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   initHash(): void;
   initKeyed(key: ArrayBuffer): void;
   initDeriveKey(context: string): void;
-  update(data: ArrayBuffer): void;
+  update(data: ArrayBuffer, byteOffset?: number, byteLength?: number): void;
   digest(length?: number): ArrayBuffer;
   reset(): void;
   copy(): Blake3;
@@ -9,8 +9,18 @@ type CipherArgs = {
 };
 
 export interface Cipher extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
-  update(data: ArrayBuffer): ArrayBuffer;
+  update(
+    data: ArrayBuffer,
+    byteOffset?: number,
+    byteLength?: number,
+  ): ArrayBuffer;
   final(): ArrayBuffer;
+  updateAsync(
+    data: ArrayBuffer,
+    byteOffset?: number,
+    byteLength?: number,
+  ): Promise<ArrayBuffer>;
+  finalAsync(): Promise<ArrayBuffer>;
   setArgs(args: CipherArgs): void;
   setAAD(data: ArrayBuffer, plaintextLength?: number): boolean;
   setAutoPadding(autoPad: boolean): boolean;
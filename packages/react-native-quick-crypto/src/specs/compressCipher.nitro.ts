@@ -0,0 +1,22 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+type CompressCipherArgs = {
+  encrypt: boolean;
+  cipherType: string;
+  cipherKey: ArrayBuffer;
+  iv: ArrayBuffer;
+  authTagLen?: number;
+  level?: number;
+  maxOutputLength?: number;
+};
+
+export interface CompressCipher
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  init(args: CompressCipherArgs): void;
+  setAAD(data: ArrayBuffer): void;
+  update(data: ArrayBuffer): ArrayBuffer;
+  final(): ArrayBuffer;
+  process(data: ArrayBuffer): ArrayBuffer;
+  setAuthTag(tag: ArrayBuffer): void;
+  getAuthTag(): ArrayBuffer;
+}
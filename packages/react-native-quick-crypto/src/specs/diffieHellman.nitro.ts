@@ -0,0 +1,22 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+export interface DiffieHellman
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  initGroup(name: string): void;
+  init(prime: ArrayBuffer, generator: ArrayBuffer): void;
+  generateParametersSync(primeLength: number, generator: number): void;
+  generateParameters(primeLength: number, generator: number): Promise<void>;
+
+  generateKeys(): ArrayBuffer;
+  computeSecret(publicKey: ArrayBuffer): ArrayBuffer;
+  computeSecrets(publicKeys: ArrayBuffer[]): ArrayBuffer[];
+  computeSecretsAsync(publicKeys: ArrayBuffer[]): Promise<ArrayBuffer[]>;
+
+  getPrime(): ArrayBuffer;
+  getGenerator(): ArrayBuffer;
+  getPublicKey(): ArrayBuffer;
+  getPrivateKey(): ArrayBuffer;
+  setPublicKey(publicKey: ArrayBuffer): void;
+  setPrivateKey(privateKey: ArrayBuffer): void;
+  getVerifyError(): number;
+}
@@ -0,0 +1,18 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+export interface ECDH extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  setCurve(name: string): void;
+
+  generateKeys(): void;
+  computeSecret(publicKey: ArrayBuffer): ArrayBuffer;
+  computeSecrets(publicKeys: ArrayBuffer[]): ArrayBuffer[];
+  computeSecretsAsync(publicKeys: ArrayBuffer[]): Promise<ArrayBuffer[]>;
+
+  getPublicKey(format: number): ArrayBuffer;
+  getPrivateKey(): ArrayBuffer;
+  setPublicKey(publicKey: ArrayBuffer): void;
+  setPrivateKey(privateKey: ArrayBuffer): void;
+
+  convertKey(curve: string, key: ArrayBuffer, format: number): ArrayBuffer;
+  convertKeys(curve: string, keys: ArrayBuffer[], format: number): ArrayBuffer[];
+}
@@ -2,6 +2,22 @@ import type { HybridObject } from 'react-native-nitro-modules';
 
 export interface Hmac extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   createHmac(algorithm: string, key: ArrayBuffer): void;
-  update(data: ArrayBuffer | string): void;
+  update(
+    data: ArrayBuffer | string,
+    byteOffset?: number,
+    byteLength?: number,
+  ): void;
   digest(): ArrayBuffer;
+  hmacMany(
+    algorithm: string,
+    key: ArrayBuffer,
+    messages: (ArrayBuffer | string)[],
+    truncateTo?: number,
+  ): ArrayBuffer;
+  hmacManyAsync(
+    algorithm: string,
+    key: ArrayBuffer,
+    messages: (ArrayBuffer | string)[],
+    truncateTo?: number,
+  ): Promise<ArrayBuffer>;
 }
@@ -0,0 +1,26 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+type KeyRotationArgs = {
+  cipherType: string;
+  oldCipherType?: string;
+  oldKey: ArrayBuffer;
+  newKey: ArrayBuffer;
+  noncePrefix?: ArrayBuffer;
+  counter: number;
+};
+
+export interface KeyRotation
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  init(args: KeyRotationArgs): void;
+  getCounter(): number;
+  reencryptBatch(
+    records: ArrayBuffer[],
+    aad?: ArrayBuffer[],
+    parallelism?: number,
+  ): ArrayBuffer[];
+  reencryptBatchAsync(
+    records: ArrayBuffer[],
+    aad?: ArrayBuffer[],
+    parallelism?: number,
+  ): Promise<ArrayBuffer[]>;
+}
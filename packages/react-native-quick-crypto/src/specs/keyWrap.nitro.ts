@@ -0,0 +1,12 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+import type { KeyObjectHandle } from './keyObjectHandle.nitro';
+
+export interface KeyWrap extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  init(kek: KeyObjectHandle, padded: boolean, cacheSize: number): void;
+  wrapKeys(keys: KeyObjectHandle[]): ArrayBuffer[];
+  wrapKeysAsync(keys: KeyObjectHandle[]): Promise<ArrayBuffer[]>;
+  unwrapKeys(wrapped: ArrayBuffer[]): KeyObjectHandle[];
+  unwrapKeysAsync(wrapped: ArrayBuffer[]): Promise<KeyObjectHandle[]>;
+  getCachedCount(): number;
+  clearCache(): void;
+}
@@ -0,0 +1,31 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+type MacArgs = {
+  algorithm: string;
+  key: ArrayBuffer;
+  digest?: string;
+  cipher?: string;
+  iv?: ArrayBuffer;
+  customization?: ArrayBuffer;
+  salt?: ArrayBuffer;
+  outputLength?: number;
+};
+
+export interface Mac extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  init(args: MacArgs): void;
+  update(
+    data: ArrayBuffer | string,
+    byteOffset?: number,
+    byteLength?: number,
+  ): void;
+  digest(): ArrayBuffer;
+  copy(): Mac;
+  getMacLength(): number;
+
+  compute(data: ArrayBuffer, iv?: ArrayBuffer): ArrayBuffer;
+  computeMany(messages: ArrayBuffer[], ivs?: ArrayBuffer[]): ArrayBuffer[];
+  computeManyAsync(
+    messages: ArrayBuffer[],
+    ivs?: ArrayBuffer[],
+  ): Promise<ArrayBuffer[]>;
+}
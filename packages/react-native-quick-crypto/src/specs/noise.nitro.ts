@@ -0,0 +1,35 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+type NoiseHandshakeArgs = {
+  protocolName: string;
+  initiator: boolean;
+  prologue?: ArrayBuffer;
+  staticPrivateKey?: ArrayBuffer;
+  remoteStaticPublicKey?: ArrayBuffer;
+  ephemeralPrivateKey?: ArrayBuffer;
+};
+
+export interface NoiseTransport
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  encrypt(plaintext: ArrayBuffer, ad?: ArrayBuffer): ArrayBuffer;
+  decrypt(ciphertext: ArrayBuffer, ad?: ArrayBuffer): ArrayBuffer;
+  encryptMany(plaintexts: ArrayBuffer[]): ArrayBuffer[];
+  encryptManyAsync(plaintexts: ArrayBuffer[]): Promise<ArrayBuffer[]>;
+  decryptMany(ciphertexts: ArrayBuffer[]): ArrayBuffer[];
+  decryptManyAsync(ciphertexts: ArrayBuffer[]): Promise<ArrayBuffer[]>;
+  rekeySend(): void;
+  rekeyReceive(): void;
+}
+
+export interface NoiseHandshake
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  init(args: NoiseHandshakeArgs): void;
+  generateKeyPair(dh: string): ArrayBuffer[];
+
+  getAction(): string;
+  writeMessage(payload: ArrayBuffer): ArrayBuffer;
+  readMessage(message: ArrayBuffer): ArrayBuffer;
+  getHandshakeHash(): ArrayBuffer;
+  getRemoteStaticPublicKey(): ArrayBuffer | undefined;
+  split(): NoiseTransport;
+}
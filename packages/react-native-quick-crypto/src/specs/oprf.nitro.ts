@@ -0,0 +1,48 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+export interface Oprf extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  init(suite: string, verifiable: boolean): void;
+
+  randomScalars(count: number): ArrayBuffer[];
+  deriveKeyPair(seed: ArrayBuffer, info: ArrayBuffer): ArrayBuffer[];
+  hashToGroup(inputs: ArrayBuffer[], dst?: ArrayBuffer): ArrayBuffer[];
+
+  blind(inputs: ArrayBuffer[], blinds: ArrayBuffer[]): ArrayBuffer[];
+  blindAsync(
+    inputs: ArrayBuffer[],
+    blinds: ArrayBuffer[],
+  ): Promise<ArrayBuffer[]>;
+  finalize(
+    inputs: ArrayBuffer[],
+    blinds: ArrayBuffer[],
+    evaluatedElements: ArrayBuffer[],
+  ): ArrayBuffer[];
+  finalizeAsync(
+    inputs: ArrayBuffer[],
+    blinds: ArrayBuffer[],
+    evaluatedElements: ArrayBuffer[],
+  ): Promise<ArrayBuffer[]>;
+  verifyProof(
+    publicKey: ArrayBuffer,
+    blindedElements: ArrayBuffer[],
+    evaluatedElements: ArrayBuffer[],
+    proof: ArrayBuffer,
+  ): boolean;
+  verifyProofAsync(
+    publicKey: ArrayBuffer,
+    blindedElements: ArrayBuffer[],
+    evaluatedElements: ArrayBuffer[],
+    proof: ArrayBuffer,
+  ): Promise<boolean>;
+
+  blindEvaluate(
+    privateKey: ArrayBuffer,
+    blindedElements: ArrayBuffer[],
+  ): ArrayBuffer[];
+  generateProof(
+    privateKey: ArrayBuffer,
+    blindedElements: ArrayBuffer[],
+    evaluatedElements: ArrayBuffer[],
+    proofScalar?: ArrayBuffer,
+  ): ArrayBuffer;
+}
@@ -0,0 +1,36 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+type PageCipherArgs = {
+  cipherType: string;
+  cipherKey: ArrayBuffer;
+  pageSize: number;
+  reserveSize?: number;
+};
+
+export interface PageCipher
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  init(args: PageCipherArgs): void;
+  getReserveSize(): number;
+  encryptPages(
+    pages: ArrayBuffer,
+    pageNumbers: number[],
+    writeCounters: number[],
+    parallelism?: number,
+  ): void;
+  decryptPages(
+    pages: ArrayBuffer,
+    pageNumbers: number[],
+    parallelism?: number,
+  ): void;
+  encryptPagesAsync(
+    pages: ArrayBuffer,
+    pageNumbers: number[],
+    writeCounters: number[],
+    parallelism?: number,
+  ): Promise<ArrayBuffer>;
+  decryptPagesAsync(
+    pages: ArrayBuffer,
+    pageNumbers: number[],
+    parallelism?: number,
+  ): Promise<ArrayBuffer>;
+}
@@ -15,6 +15,10 @@ export interface RsaKeyPair
   setModulusLength(modulusLength: number): void;
   setPublicExponent(publicExponent: ArrayBuffer): void;
   setHashAlgorithm(hashAlgorithm: string): void;
+  // Multi-prime RSA: 2 (default) up to 5, depending on modulusLength
+  setPrimes(primes: number): void;
+  // Concurrent key searches; the first to finish wins. 0 = automatic
+  setParallelism(parallelism: number): void;
 
   // importKey
   importKey(
@@ -5,7 +5,7 @@ export interface SignHandle
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   init(algorithm: string): void;
 
-  update(data: ArrayBuffer): void;
+  update(data: ArrayBuffer, byteOffset?: number, byteLength?: number): void;
 
   sign(
     keyHandle: KeyObjectHandle,
@@ -19,7 +19,7 @@ export interface VerifyHandle
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   init(algorithm: string): void;
 
-  update(data: ArrayBuffer): void;
+  update(data: ArrayBuffer, byteOffset?: number, byteLength?: number): void;
 
   verify(
     keyHandle: KeyObjectHandle,
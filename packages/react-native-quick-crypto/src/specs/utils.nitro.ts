@@ -2,4 +2,31 @@ import { type HybridObject } from 'react-native-nitro-modules';
 
 export interface Utils extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   timingSafeEqual(a: ArrayBuffer, b: ArrayBuffer): boolean;
+  /** Does nothing natively; measures the cost of crossing JSI. */
+  benchmarkNoop(data: ArrayBuffer): void;
+  /**
+   * Runs `operation` on `data` `iterations` times in C++ and returns the
+   * per-iteration latency in milliseconds (Float64).
+   */
+  benchmarkNative(
+    operation: string,
+    data: ArrayBuffer,
+    iterations: number,
+  ): ArrayBuffer;
+  /** One-time OpenSSL initialization, run on a background thread. */
+  prewarm(): Promise<void>;
+  /** Crypto-relevant CPU features (aes, pmull, sha1, sha2, ...). */
+  getCpuCapabilities(): Record<string, boolean>;
+  /** OpenSSL version, its CPU mask and the implementation per primitive. */
+  getCryptoImplementations(): Record<string, string>;
+  /** Faster AEAD on this device, from a cached native microbenchmark. */
+  preferredAead(): Promise<string>;
+  /** Starts or stops recording how long async jobs wait for a worker. */
+  setQueueWaitTracking(enabled: boolean): void;
+  /** Queue waits (ms) recorded since the last call, keyed by API. */
+  takeQueueWaits(): Record<string, number[]>;
+  /** Starts a workload trace (operation metadata only), capped at maxBytes. */
+  startWorkloadRecording(maxBytes?: number): void;
+  /** Stops recording and returns the binary trace. */
+  stopWorkloadRecording(): ArrayBuffer;
 }
@@ -46,7 +46,7 @@ import {
   ed_generateKeyPairWebCrypto,
   x_generateKeyPairWebCrypto,
   xDeriveBits,
-  Ed,
+  sharedEd,
 } from './ed';
 import { mldsa_generateKeyPairWebCrypto, type MlDsaVariant } from './mldsa';
 import { hkdfDeriveBits, type HkdfAlgorithm } from './hkdf';
@@ -1384,8 +1384,7 @@ function edSignVerify(
   const algorithmName = key.algorithm.name;
   const curveType = algorithmName.toLowerCase() as 'ed25519' | 'ed448';
 
-  // Create Ed instance with the curve
-  const ed = new Ed(curveType, {});
+  const ed = sharedEd(curveType);
 
   // Export raw key bytes (exportKey with no format returns raw for Ed keys)
   const rawKey = key.keyObject.handle.exportKey();
@@ -0,0 +1,73 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import type { Utils } from '../specs/utils.nitro';
+
+export type NativeBenchmarkOperation =
+  | 'noop'
+  | 'sha256'
+  | 'hmac-sha256'
+  | 'aes-256-gcm'
+  | 'randomFill';
+
+let utils: Utils;
+function getNative(): Utils {
+  if (utils == null) {
+    utils = NitroModules.createHybridObject<Utils>('Utils');
+  }
+  return utils;
+}
+
+/**
+ * Crosses the JSI boundary with `data` and returns without doing any work.
+ * Baseline for per-call overhead in benchmarks.
+ */
+export function benchmarkNoop(data: ArrayBuffer): void {
+  getNative().benchmarkNoop(data);
+}
+
+/**
+ * Runs `operation` natively `iterations` times, without crossing JSI per
+ * call, and returns each iteration's latency in milliseconds.
+ */
+export function benchmarkNative(
+  operation: NativeBenchmarkOperation,
+  data: ArrayBuffer,
+  iterations: number,
+): Float64Array {
+  return new Float64Array(
+    getNative().benchmarkNative(operation, data, iterations),
+  );
+}
+
+/**
+ * Starts or stops recording how long async jobs (pbkdf2, scrypt, hkdf,
+ * randomFill, Ed sign/verify, Cipher updateAsync/finalAsync) wait in the
+ * native worker queue before a thread picks them up. Off by default.
+ */
+export function setQueueWaitTracking(enabled: boolean): void {
+  getNative().setQueueWaitTracking(enabled);
+}
+
+/**
+ * Queue waits in milliseconds recorded since the last call, keyed by API
+ * (`pbkdf2`, `scrypt`, `hkdf`, `randomFill`, `ed.sign`, `ed.verify`,
+ * `cipher`).
+ */
+export function takeQueueWaits(): Record<string, number[]> {
+  return getNative().takeQueueWaits();
+}
+
+/**
+ * Starts recording a workload trace: operation, algorithm, sizes, cost
+ * parameters, sync/async and timing of each crypto call. Never inputs,
+ * outputs or keys. Recording stops by itself once the trace would exceed
+ * `maxBytes` (8 MiB by default). Replay it on a desktop with the host
+ * `quickcrypto_replay` tool.
+ */
+export function startWorkloadRecording(maxBytes?: number): void {
+  getNative().startWorkloadRecording(maxBytes);
+}
+
+/** Stops recording and returns the trace started by startWorkloadRecording. */
+export function stopWorkloadRecording(): ArrayBuffer {
+  return getNative().stopWorkloadRecording();
+}
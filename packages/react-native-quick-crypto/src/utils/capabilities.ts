@@ -0,0 +1,74 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import type { Utils } from '../specs/utils.nitro';
+
+let utils: Utils;
+function getNative(): Utils {
+  if (utils == null) {
+    utils = NitroModules.createHybridObject<Utils>('Utils');
+  }
+  return utils;
+}
+
+export type PreferredAead = 'aes-256-gcm' | 'chacha20-poly1305';
+
+export interface CryptoCapabilities {
+  /** CPU features as reported by the OS. `pmull` also covers x86 PCLMULQDQ. */
+  cpu: {
+    aes: boolean;
+    pmull: boolean;
+    sha1: boolean;
+    sha2: boolean;
+    sha512: boolean;
+    sha3: boolean;
+    neon: boolean;
+    avx2: boolean;
+  };
+  /** OpenSSL version and the capability mask it selected. */
+  openssl: {
+    version: string;
+    cpuInfo: string;
+  };
+  /** Implementation each primitive runs on, e.g. `aes: 'hardware'`. */
+  implementations: {
+    aes: string;
+    ghash: string;
+    chacha20: string;
+    sha1: string;
+    sha256: string;
+    sha512: string;
+    sha3: string;
+  };
+}
+
+/**
+ * Reports the crypto-relevant CPU features of this device and which
+ * implementation OpenSSL uses for the hot primitives.
+ */
+export function getCryptoCapabilities(): CryptoCapabilities {
+  const native = getNative();
+  const cpu = native.getCpuCapabilities();
+  const { openssl, cpuinfo, ...implementations } =
+    native.getCryptoImplementations();
+  return {
+    cpu: cpu as CryptoCapabilities['cpu'],
+    openssl: { version: openssl ?? '', cpuInfo: cpuinfo ?? '' },
+    implementations:
+      implementations as unknown as CryptoCapabilities['implementations'],
+  };
+}
+
+let preferred: Promise<PreferredAead> | undefined;
+
+/**
+ * The faster of AES-256-GCM and ChaCha20-Poly1305 on this device, for
+ * protocols that negotiate a cipher. Measured once natively (a few
+ * milliseconds, off the JS thread) and cached.
+ */
+export function preferredAead(): Promise<PreferredAead> {
+  if (preferred == null) {
+    preferred = getNative()
+      .preferredAead()
+      .then(aead => aead as PreferredAead);
+  }
+  return preferred;
+}
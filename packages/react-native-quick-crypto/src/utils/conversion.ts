@@ -1,6 +1,6 @@
 import { Buffer as CraftzdogBuffer } from '@craftzdog/react-native-buffer';
 import { Buffer as SafeBuffer } from 'safe-buffer';
-import type { ABV, BinaryLikeNode, BufferLike } from './types';
+import type { ABV, BinaryLike, BinaryLikeNode, BufferLike } from './types';
 import { KeyObject } from '../keys/classes';
 
 /**
@@ -143,6 +143,46 @@ export function binaryLikeToArrayBuffer(
   );
 }
 
+/**
+ * A window into an ArrayBuffer, in the argument order native `update()`
+ * methods take it: `native.update(...binaryLikeToView(data))`.
+ */
+export type ByteView = [
+  buffer: ArrayBuffer,
+  byteOffset: number,
+  byteLength: number,
+];
+
+/**
+ * Like binaryLikeToArrayBuffer, but a Buffer or TypedArray that covers only
+ * part of its backing store (e.g. a pooled Buffer or a subarray) is passed as
+ * an offset/length into that store instead of being sliced into a copy.  Only
+ * for native calls that read the bytes synchronously and do not keep them.
+ * @param input
+ * @param encoding used when `input` is a string
+ * @returns ByteView
+ */
+export function binaryLikeToView(
+  input: BinaryLike,
+  encoding: string = 'utf-8',
+): ByteView {
+  if (typeof input === 'string') {
+    if (encoding === 'buffer') {
+      throw new Error(
+        'Cannot create a buffer from a string with a buffer encoding',
+      );
+    }
+    input = CraftzdogBuffer.from(input, encoding);
+  }
+
+  if (ArrayBuffer.isView(input) && input.buffer instanceof ArrayBuffer) {
+    return [input.buffer, input.byteOffset, input.byteLength];
+  }
+
+  const buffer = binaryLikeToArrayBuffer(input, encoding);
+  return [buffer, 0, buffer.byteLength];
+}
+
 export function ab2str(buf: ArrayBuffer, encoding: string = 'hex') {
   return CraftzdogBuffer.from(buf).toString(encoding);
 }
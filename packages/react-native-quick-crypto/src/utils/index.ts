@@ -2,6 +2,9 @@ export * from './conversion';
 export * from './errors';
 export * from './hashnames';
 export * from './timingSafeEqual';
+export * from './benchmark';
+export * from './capabilities';
+export * from './prewarm';
 export * from './types';
 export * from './validation';
 export * from './cipher';
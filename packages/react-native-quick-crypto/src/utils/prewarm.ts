@@ -0,0 +1,29 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import type { Utils } from '../specs/utils.nitro';
+
+let utils: Utils;
+function getNative(): Utils {
+  if (utils == null) {
+    utils = NitroModules.createHybridObject<Utils>('Utils');
+  }
+  return utils;
+}
+
+let prewarmed: Promise<void> | undefined;
+
+/**
+ * Moves OpenSSL's one-time setup (library init, provider load, DRBG seeding,
+ * algorithm fetching) off the JS thread. Call it early at launch without
+ * awaiting; the first crypto call no longer pays for it. Safe to call more
+ * than once.
+ */
+export function prewarm(): Promise<void> {
+  if (prewarmed == null) {
+    prewarmed = getNative().prewarm();
+    prewarmed.catch(() => {
+      // allow a retry after a failed attempt
+      prewarmed = undefined;
+    });
+  }
+  return prewarmed;
+}
@@ -328,6 +328,8 @@ export interface KeyDetail {
 export type GenerateKeyPairOptions = {
   modulusLength?: number; // Key size in bits (RSA, DSA).
   publicExponent?: number; // Public exponent (RSA). Default: 0x10001.
+  primes?: number; // Number of primes (RSA, not in Node). Default: 2.
+  parallelism?: number; // Concurrent key searches (RSA, not in Node). Default: 1.
   hashAlgorithm?: string; // Name of the message digest (RSA-PSS).
   mgf1HashAlgorithm?: string; // string Name of the message digest used by MGF1 (RSA-PSS).
   saltLength?: number; // Minimal salt length in bytes (RSA-PSS).